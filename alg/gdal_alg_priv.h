@@ -201,6 +201,12 @@ typedef struct
     bool bReversed;
     double dfOversampleFactor;
 
+    // Number of threads used to generate the backmap.
+    int nThreads;
+
+    // File in which the backmap is persisted, or nullptr.
+    char *pszBackMapFilename;
+
     // Map from target georef coordinates back to geolocation array
     // pixel line coordinates.  Built only if needed.
     int nBackMapWidth;
@@ -318,6 +324,19 @@ void *GDALCreateGeoLocTransformerEx(GDALDatasetH hBaseDS,
                                     int bReversed, const char *pszSourceDataset,
                                     CSLConstList papszTransformOptions);
 
+// State of the cutline masker kept across the chunks of a warp operation.
+struct GDALWarpCutlineCache;
+
+GDALWarpCutlineCache *GDALCreateWarpCutlineCache();
+
+void GDALDestroyWarpCutlineCache(GDALWarpCutlineCache *psCache);
+
+CPLErr GDALWarpCutlineMaskerWithCache(void *pMaskFuncArg,
+                                      GDALWarpCutlineCache *psCache, int nXOff,
+                                      int nYOff, int nXSize, int nYSize,
+                                      float *pafValidityMask,
+                                      int *pnValidityFlag);
+
 #endif /* #ifndef DOXYGEN_SKIP */
 
 #endif /* ndef GDAL_ALG_PRIV_H_INCLUDED */
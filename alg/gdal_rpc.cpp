@@ -38,6 +38,7 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -289,8 +290,28 @@ typedef struct
     OGRGeometry *poRPCFootprintGeom;
     OGRPreparedGeometry *poRPCFootprintPreparedGeom;
 
+    // Coarse grid of (long, lat) solutions of the inverse transform, used as
+    // initial guesses. Lazily filled. NaN = node not yet computed,
+    // HUGE_VAL = computation failed.
+    int nInverseGridStep;
+    double dfInverseGridStep;
+    double dfInverseGridHeight;
+    int nInverseGridXSize;
+    int nInverseGridYSize;
+    std::vector<double> *padfInverseGrid;
+
 } GDALRPCTransformInfo;
 
+// Window of DEM values extracted once for a batch of points.
+struct GDALRPCDEMWindow
+{
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+    std::vector<double> adfValues{};
+};
+
 static bool GDALRPCOpenDEM(GDALRPCTransformInfo *psTransform);
 
 /************************************************************************/
@@ -359,20 +380,16 @@ static double RPCEvaluate(const double *padfTerms, const double *padfCoefs)
 #endif
 
 /************************************************************************/
-/*                         RPCTransformPoint()                          */
+/*                     RPCNormalizeLongLatHeight()                      */
 /************************************************************************/
 
-static void RPCTransformPoint(const GDALRPCTransformInfo *psRPCTransformInfo,
-                              double dfLong, double dfLat, double dfHeight,
-                              double *pdfPixel, double *pdfLine)
+static void
+RPCNormalizeLongLatHeight(const GDALRPCTransformInfo *psRPCTransformInfo,
+                          double dfLong, double dfLat, double dfHeight,
+                          double &dfNormalizedLong, double &dfNormalizedLat,
+                          double &dfNormalizedHeight)
 
 {
-    double adfTermsWithMargin[20 + 1] = {};
-    // Make padfTerms aligned on 16-byte boundary for SSE2 aligned loads.
-    double *padfTerms =
-        adfTermsWithMargin +
-        (reinterpret_cast<GUIntptr_t>(adfTermsWithMargin) % 16) / 8;
-
     // Avoid dateline issues.
     double diffLong = dfLong - psRPCTransformInfo->sRPC.dfLONG_OFF;
     if (diffLong < -270)
@@ -384,14 +401,11 @@ static void RPCTransformPoint(const GDALRPCTransformInfo *psRPCTransformInfo,
         diffLong -= 360;
     }
 
-    const double dfNormalizedLong =
-        diffLong / psRPCTransformInfo->sRPC.dfLONG_SCALE;
-    const double dfNormalizedLat =
-        (dfLat - psRPCTransformInfo->sRPC.dfLAT_OFF) /
-        psRPCTransformInfo->sRPC.dfLAT_SCALE;
-    const double dfNormalizedHeight =
-        (dfHeight - psRPCTransformInfo->sRPC.dfHEIGHT_OFF) /
-        psRPCTransformInfo->sRPC.dfHEIGHT_SCALE;
+    dfNormalizedLong = diffLong / psRPCTransformInfo->sRPC.dfLONG_SCALE;
+    dfNormalizedLat = (dfLat - psRPCTransformInfo->sRPC.dfLAT_OFF) /
+                      psRPCTransformInfo->sRPC.dfLAT_SCALE;
+    dfNormalizedHeight = (dfHeight - psRPCTransformInfo->sRPC.dfHEIGHT_OFF) /
+                         psRPCTransformInfo->sRPC.dfHEIGHT_SCALE;
 
     // The absolute values of the 3 above normalized values are supposed to be
     // below 1. Warn (as debug message) if it is not the case. We allow for some
@@ -441,6 +455,29 @@ static void RPCTransformPoint(const GDALRPCTransformInfo *psRPCTransformInfo,
             }
         }
     }
+}
+
+/************************************************************************/
+/*                         RPCTransformPoint()                          */
+/************************************************************************/
+
+static void RPCTransformPoint(const GDALRPCTransformInfo *psRPCTransformInfo,
+                              double dfLong, double dfLat, double dfHeight,
+                              double *pdfPixel, double *pdfLine)
+
+{
+    double adfTermsWithMargin[20 + 1] = {};
+    // Make padfTerms aligned on 16-byte boundary for SSE2 aligned loads.
+    double *padfTerms =
+        adfTermsWithMargin +
+        (reinterpret_cast<GUIntptr_t>(adfTermsWithMargin) % 16) / 8;
+
+    double dfNormalizedLong = 0.0;
+    double dfNormalizedLat = 0.0;
+    double dfNormalizedHeight = 0.0;
+    RPCNormalizeLongLatHeight(psRPCTransformInfo, dfLong, dfLat, dfHeight,
+                              dfNormalizedLong, dfNormalizedLat,
+                              dfNormalizedHeight);
 
     RPCComputeTerms(dfNormalizedLong, dfNormalizedLat, dfNormalizedHeight,
                     padfTerms);
@@ -472,6 +509,159 @@ static void RPCTransformPoint(const GDALRPCTransformInfo *psRPCTransformInfo,
                psRPCTransformInfo->sRPC.dfLINE_OFF + 0.5;
 }
 
+#ifdef USE_SSE2_OPTIM
+
+/************************************************************************/
+/*                       RPCTransformTwoPoints()                        */
+/************************************************************************/
+
+// Same computation as RPCTransformPoint() for 2 points at once, one point
+// per SSE2 lane. The summation order of RPCEvaluate4() is preserved (even and
+// odd terms accumulated separately, then added), so that results are
+// identical to the ones of the single point code path.
+static void
+RPCTransformTwoPoints(const GDALRPCTransformInfo *psRPCTransformInfo,
+                      double *padfX, double *padfY, const double *padfHeight,
+                      int i0, int i1)
+
+{
+    double adfLong[2] = {};
+    double adfLat[2] = {};
+    double adfHeight[2] = {};
+    RPCNormalizeLongLatHeight(psRPCTransformInfo, padfX[i0], padfY[i0],
+                              padfHeight[i0], adfLong[0], adfLat[0],
+                              adfHeight[0]);
+    RPCNormalizeLongLatHeight(psRPCTransformInfo, padfX[i1], padfY[i1],
+                              padfHeight[i1], adfLong[1], adfLat[1],
+                              adfHeight[1]);
+
+    const auto L = XMMReg2Double::Load2Val(adfLong);
+    const auto P = XMMReg2Double::Load2Val(adfLat);
+    const auto H = XMMReg2Double::Load2Val(adfHeight);
+    const double dfOne = 1.0;
+
+    XMMReg2Double aTerms[20];
+    aTerms[0] = XMMReg2Double::Load1ValHighAndLow(&dfOne);
+    aTerms[1] = L;
+    aTerms[2] = P;
+    aTerms[3] = H;
+    aTerms[4] = L * P;
+    aTerms[5] = L * H;
+    aTerms[6] = P * H;
+    aTerms[7] = L * L;
+    aTerms[8] = P * P;
+    aTerms[9] = H * H;
+
+    aTerms[10] = L * P * H;
+    aTerms[11] = L * L * L;
+    aTerms[12] = L * P * P;
+    aTerms[13] = L * H * H;
+    aTerms[14] = L * L * P;
+    aTerms[15] = P * P * P;
+    aTerms[16] = P * H * H;
+    aTerms[17] = L * L * H;
+    aTerms[18] = P * P * H;
+    aTerms[19] = H * H * H;
+
+    // LINE_NUM_COEFF, LINE_DEN_COEFF, SAMP_NUM_COEFF, SAMP_DEN_COEFF
+    XMMReg2Double aSumsEven[4] = {
+        XMMReg2Double::Zero(), XMMReg2Double::Zero(), XMMReg2Double::Zero(),
+        XMMReg2Double::Zero()};
+    XMMReg2Double aSumsOdd[4] = {
+        XMMReg2Double::Zero(), XMMReg2Double::Zero(), XMMReg2Double::Zero(),
+        XMMReg2Double::Zero()};
+    const double *padfCoefs = psRPCTransformInfo->padfCoeffs;
+    for (int i = 0; i < 20; i += 2)
+    {
+        for (int k = 0; k < 4; ++k)
+        {
+            aSumsEven[k] +=
+                aTerms[i] *
+                XMMReg2Double::Load1ValHighAndLow(padfCoefs + 20 * k + i);
+            aSumsOdd[k] +=
+                aTerms[i + 1] *
+                XMMReg2Double::Load1ValHighAndLow(padfCoefs + 20 * k + i + 1);
+        }
+    }
+
+    const auto lineNum = aSumsEven[0] + aSumsOdd[0];
+    const auto lineDen = aSumsEven[1] + aSumsOdd[1];
+    const auto sampNum = aSumsEven[2] + aSumsOdd[2];
+    const auto sampDen = aSumsEven[3] + aSumsOdd[3];
+
+    const double dfHalf = 0.5;
+    const auto half = XMMReg2Double::Load1ValHighAndLow(&dfHalf);
+    const auto pixel =
+        sampNum / sampDen * XMMReg2Double::Load1ValHighAndLow(
+                                &psRPCTransformInfo->sRPC.dfSAMP_SCALE) +
+        XMMReg2Double::Load1ValHighAndLow(
+            &psRPCTransformInfo->sRPC.dfSAMP_OFF) +
+        half;
+    const auto line =
+        lineNum / lineDen * XMMReg2Double::Load1ValHighAndLow(
+                                &psRPCTransformInfo->sRPC.dfLINE_SCALE) +
+        XMMReg2Double::Load1ValHighAndLow(
+            &psRPCTransformInfo->sRPC.dfLINE_OFF) +
+        half;
+
+    double adfPixel[2];
+    double adfLine[2];
+    pixel.Store2Val(adfPixel);
+    line.Store2Val(adfLine);
+    padfX[i0] = adfPixel[0];
+    padfX[i1] = adfPixel[1];
+    padfY[i0] = adfLine[0];
+    padfY[i1] = adfLine[1];
+}
+
+#endif
+
+/************************************************************************/
+/*                         RPCTransformPoints()                         */
+/************************************************************************/
+
+// Transform in place the (long, lat) points for which panSuccess[i] is set,
+// using padfHeight[] as the height.
+static void RPCTransformPoints(const GDALRPCTransformInfo *psRPCTransformInfo,
+                               int nPointCount, double *padfX, double *padfY,
+                               const double *padfHeight, const int *panSuccess)
+
+{
+#ifdef USE_SSE2_OPTIM
+    int iPending = -1;
+    for (int i = 0; i < nPointCount; i++)
+    {
+        if (!panSuccess[i])
+            continue;
+        if (iPending < 0)
+        {
+            iPending = i;
+        }
+        else
+        {
+            RPCTransformTwoPoints(psRPCTransformInfo, padfX, padfY, padfHeight,
+                                  iPending, i);
+            iPending = -1;
+        }
+    }
+    if (iPending >= 0)
+    {
+        RPCTransformPoint(psRPCTransformInfo, padfX[iPending],
+                          padfY[iPending], padfHeight[iPending],
+                          padfX + iPending, padfY + iPending);
+    }
+#else
+    for (int i = 0; i < nPointCount; i++)
+    {
+        if (panSuccess[i])
+        {
+            RPCTransformPoint(psRPCTransformInfo, padfX[i], padfY[i],
+                              padfHeight[i], padfX + i, padfY + i);
+        }
+    }
+#endif
+}
+
 /************************************************************************/
 /*                     GDALSerializeRPCDEMResample()                    */
 /************************************************************************/
@@ -536,6 +726,10 @@ static void *GDALCreateSimilarRPCTransformer(void *hTransformArg,
     }
     papszOptions = CSLSetNameValue(papszOptions, "RPC_MAX_ITERATIONS",
                                    CPLSPrintf("%d", psInfo->nMaxIterations));
+    if (psInfo->nInverseGridStep > 0)
+        papszOptions =
+            CSLSetNameValue(papszOptions, "RPC_INVERSE_GRID_STEP",
+                            CPLSPrintf("%d", psInfo->nInverseGridStep));
 
     GDALRPCTransformInfo *psNewInfo =
         static_cast<GDALRPCTransformInfo *>(GDALCreateRPCTransformerV2(
@@ -551,7 +745,8 @@ static void *GDALCreateSimilarRPCTransformer(void *hTransformArg,
 
 static int GDALRPCGetDEMHeight(GDALRPCTransformInfo *psTransform,
                                const double dfXIn, const double dfYIn,
-                               double *pdfDEMH);
+                               double *pdfDEMH,
+                               const GDALRPCDEMWindow *psWindow = nullptr);
 
 static bool GDALRPCGetHeightAtLongLat(GDALRPCTransformInfo *psTransform,
                                       const double dfXIn, const double dfYIn,
@@ -794,6 +989,15 @@ void *GDALCreateRPCTransformerV1(GDALRPCInfoV1 *psRPCInfo, int bReversed,
  against
  * GEOS.</li>
  *
+ * <li> RPC_INVERSE_GRID_STEP: (GDAL >= 3.8) spacing, in pixels, of a coarse
+ * grid of pixel/line to long/lat solutions (taking into account the DEM if
+ * specified) that is lazily computed, kept for the lifetime of the
+ * transformer, and bilinearly interpolated to get the starting point of the
+ * iterative solution. This reduces the number of iterations, and thus of DEM
+ * lookups, when transforming many points, such as when warping a large scene.
+ * The grid is used for the height of the first transformed point only,
+ * typically 0. Defaults to 0 (disabled).</li>
+ *
  * </ul>
  *
  * @param psRPCInfo Definition of the RPC parameters.
@@ -937,6 +1141,9 @@ void *GDALCreateRPCTransformerV2(const GDALRPCInfoV2 *psRPCInfo, int bReversed,
     psTransform->nMaxIterations =
         atoi(CSLFetchNameValueDef(papszOptions, "RPC_MAX_ITERATIONS", "0"));
 
+    psTransform->nInverseGridStep =
+        atoi(CSLFetchNameValueDef(papszOptions, "RPC_INVERSE_GRID_STEP", "0"));
+
     /* -------------------------------------------------------------------- */
     /*      Debug                                                           */
     /* -------------------------------------------------------------------- */
@@ -1118,6 +1325,8 @@ void GDALDestroyRPCTransformer(void *pTransformAlg)
     delete psTransform->poRPCFootprintGeom;
     OGRDestroyPreparedGeometry(psTransform->poRPCFootprintPreparedGeom);
 
+    delete psTransform->padfInverseGrid;
+
     CPLFree(pTransformAlg);
 }
 
@@ -1128,7 +1337,8 @@ void GDALDestroyRPCTransformer(void *pTransformAlg)
 static bool RPCInverseTransformPoint(GDALRPCTransformInfo *psTransform,
                                      double dfPixel, double dfLine,
                                      double dfUserHeight, double *pdfLong,
-                                     double *pdfLat)
+                                     double *pdfLat,
+                                     const double *padfInitialGuess = nullptr)
 
 {
     // Memo:
@@ -1137,7 +1347,8 @@ static bool RPCInverseTransformPoint(GDALRPCTransformInfo *psTransform,
 
     /* -------------------------------------------------------------------- */
     /*      Compute an initial approximation based on linear                */
-    /*      interpolation from our reference point.                         */
+    /*      interpolation from our reference point, unless the caller      */
+    /*      has a better one.                                               */
     /* -------------------------------------------------------------------- */
     double dfResultX = psTransform->adfPLToLatLongGeoTransform[0] +
                        psTransform->adfPLToLatLongGeoTransform[1] * dfPixel +
@@ -1147,6 +1358,12 @@ static bool RPCInverseTransformPoint(GDALRPCTransformInfo *psTransform,
                        psTransform->adfPLToLatLongGeoTransform[4] * dfPixel +
                        psTransform->adfPLToLatLongGeoTransform[5] * dfLine;
 
+    if (padfInitialGuess)
+    {
+        dfResultX = padfInitialGuess[0];
+        dfResultY = padfInitialGuess[1];
+    }
+
     if (psTransform->bRPCInverseVerbose)
     {
         CPLDebug("RPC", "Computing inverse transform for (pixel,line)=(%f,%f)",
@@ -1369,6 +1586,107 @@ static bool RPCInverseTransformPoint(GDALRPCTransformInfo *psTransform,
     return true;
 }
 
+/************************************************************************/
+/*                     RPCGetInverseGridGuess()                         */
+/************************************************************************/
+
+// Returns in padfGuess an initial guess for the inverse transform of
+// (dfPixel, dfLine), bilinearly interpolated from a coarse grid of inverse
+// solutions spaced every psTransform->dfInverseGridStep pixels. Grid nodes
+// are solved on demand and kept for the lifetime of the transformer, so
+// that they are reused across the successive chunks of a warp.
+static bool RPCGetInverseGridGuess(GDALRPCTransformInfo *psTransform,
+                                   double dfPixel, double dfLine,
+                                   double dfUserHeight, double *padfGuess)
+{
+    constexpr int MAX_GRID_SIZE = 1024;
+
+    if (psTransform->nInverseGridStep <= 0 ||
+        psTransform->pszRPCInverseLog != nullptr)
+        return false;
+
+    if (psTransform->padfInverseGrid == nullptr)
+    {
+        // Extent of the image, from the RPC normalization parameters.
+        const double dfXExtent =
+            psTransform->sRPC.dfSAMP_OFF + psTransform->sRPC.dfSAMP_SCALE + 1;
+        const double dfYExtent =
+            psTransform->sRPC.dfLINE_OFF + psTransform->sRPC.dfLINE_SCALE + 1;
+        if (!(dfXExtent > 0 && dfYExtent > 0 && dfXExtent < INT_MAX &&
+              dfYExtent < INT_MAX))
+        {
+            psTransform->nInverseGridStep = 0;
+            return false;
+        }
+        double dfStep = psTransform->nInverseGridStep;
+        dfStep = std::max(dfStep, std::max(dfXExtent, dfYExtent) /
+                                      (MAX_GRID_SIZE - 2));
+        psTransform->dfInverseGridStep = dfStep;
+        psTransform->nInverseGridXSize =
+            static_cast<int>(ceil(dfXExtent / dfStep)) + 1;
+        psTransform->nInverseGridYSize =
+            static_cast<int>(ceil(dfYExtent / dfStep)) + 1;
+        psTransform->dfInverseGridHeight = dfUserHeight;
+        psTransform->padfInverseGrid = new std::vector<double>(
+            2 * static_cast<size_t>(psTransform->nInverseGridXSize) *
+                psTransform->nInverseGridYSize,
+            std::numeric_limits<double>::quiet_NaN());
+        CPLDebug("RPC", "Using inverse grid of %dx%d nodes, step=%.1f",
+                 psTransform->nInverseGridXSize,
+                 psTransform->nInverseGridYSize, dfStep);
+    }
+
+    // The grid is only valid for the height it has been computed for.
+    if (dfUserHeight != psTransform->dfInverseGridHeight)
+        return false;
+
+    const double dfStep = psTransform->dfInverseGridStep;
+    const double dfGridX = dfPixel / dfStep;
+    const double dfGridY = dfLine / dfStep;
+    if (!(dfGridX >= 0 && dfGridY >= 0 &&
+          dfGridX < psTransform->nInverseGridXSize - 1 &&
+          dfGridY < psTransform->nInverseGridYSize - 1))
+        return false;
+    const int nGridX = static_cast<int>(dfGridX);
+    const int nGridY = static_cast<int>(dfGridY);
+
+    double adfNodes[4][2] = {};
+    for (int k = 0; k < 4; k++)
+    {
+        const int iX = nGridX + (k % 2);
+        const int iY = nGridY + (k / 2);
+        double *padfNode =
+            psTransform->padfInverseGrid->data() +
+            2 * (static_cast<size_t>(iY) * psTransform->nInverseGridXSize + iX);
+        if (std::isnan(padfNode[0]))
+        {
+            if (!RPCInverseTransformPoint(psTransform, iX * dfStep,
+                                          iY * dfStep, dfUserHeight,
+                                          padfNode, padfNode + 1))
+            {
+                padfNode[0] = HUGE_VAL;
+                padfNode[1] = HUGE_VAL;
+            }
+        }
+        if (padfNode[0] == HUGE_VAL)
+            return false;
+        adfNodes[k][0] = padfNode[0];
+        adfNodes[k][1] = padfNode[1];
+    }
+
+    const double dfDeltaX = dfGridX - nGridX;
+    const double dfDeltaY = dfGridY - nGridY;
+    for (int i = 0; i < 2; i++)
+    {
+        const double dfTop =
+            adfNodes[0][i] * (1 - dfDeltaX) + adfNodes[1][i] * dfDeltaX;
+        const double dfBottom =
+            adfNodes[2][i] * (1 - dfDeltaX) + adfNodes[3][i] * dfDeltaX;
+        padfGuess[i] = dfTop * (1 - dfDeltaY) + dfBottom * dfDeltaY;
+    }
+    return true;
+}
+
 static double BiCubicKernel(double dfVal)
 {
     if (dfVal > 2.0)
@@ -1493,13 +1811,45 @@ static bool GDALRPCExtractDEMWindow(GDALRPCTransformInfo *psTransform, int nX,
     return true;
 }
 
+/************************************************************************/
+/*                        GDALRPCReadDEMWindow()                        */
+/************************************************************************/
+
+// Same as GDALRPCExtractDEMWindow(), but first try to serve the request from
+// a window of DEM values that has been extracted beforehand.
+static bool GDALRPCReadDEMWindow(GDALRPCTransformInfo *psTransform,
+                                 const GDALRPCDEMWindow *psWindow, int nX,
+                                 int nY, int nWidth, int nHeight,
+                                 double *padfOut)
+{
+    if (psWindow != nullptr && nX >= psWindow->nXOff &&
+        nY >= psWindow->nYOff &&
+        nX + nWidth <= psWindow->nXOff + psWindow->nXSize &&
+        nY + nHeight <= psWindow->nYOff + psWindow->nYSize)
+    {
+        for (int j = 0; j < nHeight; j++)
+        {
+            memcpy(padfOut + j * nWidth,
+                   psWindow->adfValues.data() +
+                       static_cast<size_t>(nY - psWindow->nYOff + j) *
+                           psWindow->nXSize +
+                       (nX - psWindow->nXOff),
+                   nWidth * sizeof(double));
+        }
+        return true;
+    }
+    return GDALRPCExtractDEMWindow(psTransform, nX, nY, nWidth, nHeight,
+                                   padfOut);
+}
+
 /************************************************************************/
 /*                        GDALRPCGetDEMHeight()                         */
 /************************************************************************/
 
 static int GDALRPCGetDEMHeight(GDALRPCTransformInfo *psTransform,
                                const double dfXIn, const double dfYIn,
-                               double *pdfDEMH)
+                               double *pdfDEMH,
+                               const GDALRPCDEMWindow *psWindow)
 {
     const int nRasterXSize = psTransform->poDS->GetRasterXSize();
     const int nRasterYSize = psTransform->poDS->GetRasterYSize();
@@ -1527,8 +1877,8 @@ static int GDALRPCGetDEMHeight(GDALRPCTransformInfo *psTransform,
         }
         // Cubic interpolation.
         double adfElevData[16] = {0.0};
-        if (!GDALRPCExtractDEMWindow(psTransform, dXNew, dYNew, 4, 4,
-                                     adfElevData))
+        if (!GDALRPCReadDEMWindow(psTransform, psWindow, dXNew, dYNew, 4, 4,
+                                  adfElevData))
         {
             return FALSE;
         }
@@ -1588,7 +1938,8 @@ static int GDALRPCGetDEMHeight(GDALRPCTransformInfo *psTransform,
 
         // Bilinear interpolation.
         double adfElevData[4] = {0.0, 0.0, 0.0, 0.0};
-        if (!GDALRPCExtractDEMWindow(psTransform, dX, dY, 2, 2, adfElevData))
+        if (!GDALRPCReadDEMWindow(psTransform, psWindow, dX, dY, 2, 2,
+                                  adfElevData))
         {
             return FALSE;
         }
@@ -1630,7 +1981,8 @@ static int GDALRPCGetDEMHeight(GDALRPCTransformInfo *psTransform,
             return FALSE;
         }
         double dfDEMH = 0.0;
-        if (!GDALRPCExtractDEMWindow(psTransform, dX, dY, 1, 1, &dfDEMH) ||
+        if (!GDALRPCReadDEMWindow(psTransform, psWindow, dX, dY, 1, 1,
+                                  &dfDEMH) ||
             (bGotNoDataValue && ARE_REAL_EQUAL(dfNoDataValue, dfDEMH)))
         {
             return FALSE;
@@ -1642,6 +1994,142 @@ static int GDALRPCGetDEMHeight(GDALRPCTransformInfo *psTransform,
     }
 }
 
+/************************************************************************/
+/*                     GDALRPCGetHeightsAtLongLats()                    */
+/************************************************************************/
+
+// Batched version of GDALRPCGetHeightAtLongLat(), for the points for which
+// panSuccess[i] is set on input. The coordinate transformation to the DEM SRS
+// is done in a single call, and the DEM window covering all points is
+// extracted once, instead of going through the block cache for each point.
+// Points that cannot be served that way go through
+// GDALRPCGetHeightAtLongLat(), so that results are unchanged.
+static void GDALRPCGetHeightsAtLongLats(GDALRPCTransformInfo *psTransform,
+                                        int nPointCount, const double *padfX,
+                                        const double *padfY,
+                                        double *padfHeight, int *panSuccess)
+{
+    constexpr int MIN_POINTS_FOR_BATCH = 8;
+    constexpr int MAX_WINDOW_PIXELS = 512 * 512;
+
+    if (psTransform->poDS == nullptr || nPointCount < MIN_POINTS_FOR_BATCH)
+    {
+        for (int i = 0; i < nPointCount; i++)
+        {
+            if (panSuccess[i] &&
+                !GDALRPCGetHeightAtLongLat(psTransform, padfX[i], padfY[i],
+                                           padfHeight + i))
+            {
+                panSuccess[i] = FALSE;
+            }
+        }
+        return;
+    }
+
+    std::vector<double> adfDEMX(padfX, padfX + nPointCount);
+    std::vector<double> adfDEMY(padfY, padfY + nPointCount);
+    std::vector<double> adfDEMZ(nPointCount);
+    std::vector<int> abDEMOK(panSuccess, panSuccess + nPointCount);
+    if (psTransform->poCT)
+    {
+        std::vector<int> abCTSuccess(nPointCount, FALSE);
+        psTransform->poCT->Transform(nPointCount, adfDEMX.data(),
+                                     adfDEMY.data(), adfDEMZ.data(),
+                                     abCTSuccess.data());
+        for (int i = 0; i < nPointCount; i++)
+        {
+            if (!abCTSuccess[i])
+                abDEMOK[i] = FALSE;
+        }
+    }
+
+    // Convert to DEM pixel/line and compute the extent of the points that
+    // fall within the DEM.
+    const int nRasterXSize = psTransform->poDS->GetRasterXSize();
+    const int nRasterYSize = psTransform->poDS->GetRasterYSize();
+    double dfMinX = std::numeric_limits<double>::max();
+    double dfMinY = std::numeric_limits<double>::max();
+    double dfMaxX = -std::numeric_limits<double>::max();
+    double dfMaxY = -std::numeric_limits<double>::max();
+    for (int i = 0; i < nPointCount; i++)
+    {
+        if (!abDEMOK[i])
+            continue;
+        double dfX = 0.0;
+        double dfY = 0.0;
+        GDALApplyGeoTransform(psTransform->adfDEMReverseGeoTransform,
+                              adfDEMX[i], adfDEMY[i], &dfX, &dfY);
+        adfDEMX[i] = dfX;
+        adfDEMY[i] = dfY;
+        if (!(dfX >= 0 && dfX <= nRasterXSize && dfY >= 0 &&
+              dfY <= nRasterYSize))
+        {
+            abDEMOK[i] = FALSE;
+            continue;
+        }
+        dfMinX = std::min(dfMinX, dfX);
+        dfMinY = std::min(dfMinY, dfY);
+        dfMaxX = std::max(dfMaxX, dfX);
+        dfMaxY = std::max(dfMaxY, dfY);
+    }
+
+    GDALRPCDEMWindow oWindow;
+    const GDALRPCDEMWindow *psWindow = nullptr;
+    if (dfMinX <= dfMaxX)
+    {
+        // Margins large enough for the 4x4 kernel of cubic interpolation.
+        const int nXMin =
+            std::max(0, static_cast<int>(floor(dfMinX - 0.5)) - 1);
+        const int nYMin =
+            std::max(0, static_cast<int>(floor(dfMinY - 0.5)) - 1);
+        const int nXMax =
+            std::min(nRasterXSize - 1, static_cast<int>(floor(dfMaxX)) + 2);
+        const int nYMax =
+            std::min(nRasterYSize - 1, static_cast<int>(floor(dfMaxY)) + 2);
+        const int nXSize = nXMax - nXMin + 1;
+        const int nYSize = nYMax - nYMin + 1;
+        if (nXSize > 0 && nYSize > 0 &&
+            static_cast<GIntBig>(nXSize) * nYSize <= MAX_WINDOW_PIXELS)
+        {
+            oWindow.nXOff = nXMin;
+            oWindow.nYOff = nYMin;
+            oWindow.nXSize = nXSize;
+            oWindow.nYSize = nYSize;
+            oWindow.adfValues.resize(static_cast<size_t>(nXSize) * nYSize);
+            if (GDALRPCExtractDEMWindow(psTransform, nXMin, nYMin, nXSize,
+                                        nYSize, oWindow.adfValues.data()))
+            {
+                psWindow = &oWindow;
+            }
+        }
+    }
+
+    for (int i = 0; i < nPointCount; i++)
+    {
+        if (!panSuccess[i])
+            continue;
+
+        double dfDEMH = 0.0;
+        if (abDEMOK[i] && GDALRPCGetDEMHeight(psTransform, adfDEMX[i],
+                                              adfDEMY[i], &dfDEMH, psWindow))
+        {
+            // See GDALRPCGetHeightAtLongLat() regarding the sign.
+            const double dfVDatumShift =
+                (psTransform->poCT && psTransform->bApplyDEMVDatumShift)
+                    ? -adfDEMZ[i]
+                    : 0.0;
+            padfHeight[i] =
+                dfVDatumShift + (psTransform->dfHeightOffset +
+                                 dfDEMH * psTransform->dfHeightScale);
+        }
+        else if (!GDALRPCGetHeightAtLongLat(psTransform, padfX[i], padfY[i],
+                                            padfHeight + i))
+        {
+            panSuccess[i] = FALSE;
+        }
+    }
+}
+
 /************************************************************************/
 /*                           RPCIsValidLongLat()                        */
 /************************************************************************/
@@ -2148,30 +2636,39 @@ int GDALRPCTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
             }
         }
 
+        // Fetch the heights of all points first, so that DEM accesses can
+        // be batched, and then evaluate the RPC polynomials on all points.
+        std::vector<double> adfHeight;
+        try
+        {
+            adfHeight.resize(nPointCount);
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALRPCTransform()");
+            return FALSE;
+        }
         for (int i = 0; i < nPointCount; i++)
         {
-            if (!RPCIsValidLongLat(psTransform, padfX[i], padfY[i]))
+            panSuccess[i] = RPCIsValidLongLat(psTransform, padfX[i], padfY[i]);
+        }
+        GDALRPCGetHeightsAtLongLats(psTransform, nPointCount, padfX, padfY,
+                                    adfHeight.data(), panSuccess);
+        for (int i = 0; i < nPointCount; i++)
+        {
+            if (panSuccess[i])
             {
-                panSuccess[i] = FALSE;
-                padfX[i] = HUGE_VAL;
-                padfY[i] = HUGE_VAL;
-                continue;
+                adfHeight[i] += padfZ ? padfZ[i] : 0.0;
             }
-            double dfHeight = 0.0;
-            if (!GDALRPCGetHeightAtLongLat(psTransform, padfX[i], padfY[i],
-                                           &dfHeight))
+            else
             {
-                panSuccess[i] = FALSE;
                 padfX[i] = HUGE_VAL;
                 padfY[i] = HUGE_VAL;
-                continue;
             }
-
-            RPCTransformPoint(psTransform, padfX[i], padfY[i],
-                              (padfZ ? padfZ[i] : 0.0) + dfHeight, padfX + i,
-                              padfY + i);
-            panSuccess[i] = TRUE;
         }
+        RPCTransformPoints(psTransform, nPointCount, padfX, padfY,
+                           adfHeight.data(), panSuccess);
 
         return TRUE;
     }
@@ -2193,8 +2690,12 @@ int GDALRPCTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
         double dfResultX = 0.0;
         double dfResultY = 0.0;
 
+        double adfGuess[2] = {0.0, 0.0};
+        const bool bHasGuess = RPCGetInverseGridGuess(
+            psTransform, padfX[i], padfY[i], padfZ[i], adfGuess);
         if (!RPCInverseTransformPoint(psTransform, padfX[i], padfY[i], padfZ[i],
-                                      &dfResultX, &dfResultY))
+                                      &dfResultX, &dfResultY,
+                                      bHasGuess ? adfGuess : nullptr))
         {
             panSuccess[i] = FALSE;
             padfX[i] = HUGE_VAL;
@@ -2300,6 +2801,14 @@ CPLXMLNode *GDALSerializeRPCTransformer(void *pTransformArg)
         psTree, "PixErrThreshold",
         CPLString().Printf("%.15g", psInfo->dfPixErrThreshold));
 
+    /* -------------------------------------------------------------------- */
+    /*      Serialize inverse grid step.                                    */
+    /* -------------------------------------------------------------------- */
+    if (psInfo->nInverseGridStep > 0)
+        CPLCreateXMLElementAndValue(
+            psTree, "InverseGridStep",
+            CPLSPrintf("%d", psInfo->nInverseGridStep));
+
     /* -------------------------------------------------------------------- */
     /*      RPC metadata.                                                   */
     /* -------------------------------------------------------------------- */
@@ -2404,6 +2913,11 @@ void *GDALDeserializeRPCTransformer(CPLXMLNode *psTree)
     const char *pszDEMSRS = CPLGetXMLValue(psTree, "DEMSRS", nullptr);
     if (pszDEMSRS != nullptr)
         papszOptions = CSLSetNameValue(papszOptions, "RPC_DEM_SRS", pszDEMSRS);
+    const char *pszInverseGridStep =
+        CPLGetXMLValue(psTree, "InverseGridStep", nullptr);
+    if (pszInverseGridStep != nullptr)
+        papszOptions = CSLSetNameValue(papszOptions, "RPC_INVERSE_GRID_STEP",
+                                       pszInverseGridStep);
 
     /* -------------------------------------------------------------------- */
     /*      Generate transformation.                                        */
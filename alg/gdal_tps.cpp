@@ -32,8 +32,10 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include "cpl_atomic_ops.h"
 #include "cpl_conv.h"
@@ -41,10 +43,12 @@
 #include "cpl_minixml.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -62,11 +66,18 @@ typedef struct
     bool bForwardSolved;
     bool bReverseSolved;
 
+    // Used instead of poForward/poReverse when TPS_METHOD=LOCAL
+    VizGeorefLocalSpline2D *poLocalForward;
+    VizGeorefLocalSpline2D *poLocalReverse;
+
     bool bReversed;
 
     int nGCPCount;
     GDAL_GCP *pasGCPList;
 
+    int nThreads;
+    char **papszOptions;
+
     volatile int nRefCount;
 
 } TPSTransformInfo;
@@ -98,8 +109,9 @@ static void *GDALCreateSimilarTPSTransformer(void *hTransformArg,
             pasGCPList[i].dfGCPPixel /= dfRatioX;
             pasGCPList[i].dfGCPLine /= dfRatioY;
         }
-        psInfo = static_cast<TPSTransformInfo *>(GDALCreateTPSTransformer(
-            psInfo->nGCPCount, pasGCPList, psInfo->bReversed));
+        psInfo = static_cast<TPSTransformInfo *>(GDALCreateTPSTransformerInt(
+            psInfo->nGCPCount, pasGCPList, psInfo->bReversed,
+            psInfo->papszOptions));
         GDALDeinitGCPs(psInfo->nGCPCount, pasGCPList);
         CPLFree(pasGCPList);
     }
@@ -126,6 +138,12 @@ static void *GDALCreateSimilarTPSTransformer(void *hTransformArg,
  * for large numbers of GCPs.  For instance, for reference, it takes on the
  * order of 10s for 400 GCPs on a 2GHz Athlon processor.
  *
+ * For large numbers of GCPs (several thousands and more), the TPS_METHOD=LOCAL
+ * option of GDALCreateGenImgProjTransformer2() can be used to compute
+ * thin plate splines on a grid of tiles, each from the GCPs of the tile and
+ * its surroundings, whose values are smoothly blended. This scales linearly
+ * with the number of GCPs, instead of cubically.
+ *
  * TPS Transformers are serializable.
  *
  * The GDAL Thin Plate Spline transformer is based on code provided by
@@ -167,8 +185,44 @@ void *GDALCreateTPSTransformerInt(int nGCPCount, const GDAL_GCP *pasGCPList,
     psInfo->nGCPCount = nGCPCount;
 
     psInfo->bReversed = CPL_TO_BOOL(bReversed);
-    psInfo->poForward = new VizGeorefSpline2D(2);
-    psInfo->poReverse = new VizGeorefSpline2D(2);
+
+    const char *pszMethod =
+        CSLFetchNameValueDef(papszOptions, "TPS_METHOD", "GLOBAL");
+    if (EQUAL(pszMethod, "LOCAL"))
+    {
+        const int nGCPsPerTile = atoi(CSLFetchNameValueDef(
+            papszOptions, "TPS_LOCAL_GCPS_PER_TILE", "64"));
+        if (nGCPsPerTile <= 0)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "Invalid value for TPS_LOCAL_GCPS_PER_TILE");
+            GDALDeinitGCPs(nGCPCount, psInfo->pasGCPList);
+            CPLFree(psInfo->pasGCPList);
+            CPLFree(psInfo);
+            return nullptr;
+        }
+        psInfo->poLocalForward = new VizGeorefLocalSpline2D(2, nGCPsPerTile);
+        psInfo->poLocalReverse = new VizGeorefLocalSpline2D(2, nGCPsPerTile);
+        psInfo->papszOptions = CSLSetNameValue(
+            psInfo->papszOptions, "TPS_LOCAL_GCPS_PER_TILE",
+            CPLSPrintf("%d", nGCPsPerTile));
+    }
+    else if (EQUAL(pszMethod, "GLOBAL"))
+    {
+        psInfo->poForward = new VizGeorefSpline2D(2);
+        psInfo->poReverse = new VizGeorefSpline2D(2);
+    }
+    else
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "Invalid value for TPS_METHOD: %s", pszMethod);
+        GDALDeinitGCPs(nGCPCount, psInfo->pasGCPList);
+        CPLFree(psInfo->pasGCPList);
+        CPLFree(psInfo);
+        return nullptr;
+    }
+    psInfo->papszOptions =
+        CSLSetNameValue(psInfo->papszOptions, "TPS_METHOD", pszMethod);
 
     memcpy(psInfo->sTI.abySignature, GDAL_GTI2_SIGNATURE,
            strlen(GDAL_GTI2_SIGNATURE));
@@ -232,7 +286,16 @@ void *GDALCreateTPSTransformerInt(int nGCPCount, const GDAL_GCP *pasGCPList,
         }
 
         bool bOK = true;
-        if (bReversed)
+        if (psInfo->poLocalForward)
+        {
+            auto poLocalPLToXY = bReversed ? psInfo->poLocalReverse
+                                           : psInfo->poLocalForward;
+            auto poLocalXYToPL = bReversed ? psInfo->poLocalForward
+                                           : psInfo->poLocalReverse;
+            bOK &= poLocalPLToXY->add_point(afPL[0], afPL[1], afXY);
+            bOK &= poLocalXYToPL->add_point(afXY[0], afXY[1], afPL);
+        }
+        else if (bReversed)
         {
             bOK &= psInfo->poReverse->add_point(afPL[0], afPL[1], afXY);
             bOK &= psInfo->poForward->add_point(afXY[0], afXY[1], afPL);
@@ -261,17 +324,39 @@ void *GDALCreateTPSTransformerInt(int nGCPCount, const GDAL_GCP *pasGCPList,
         if (EQUAL(pszWarpThreads, "ALL_CPUS"))
             nThreads = CPLGetNumCPUs();
         else
-            nThreads = atoi(pszWarpThreads);
+            nThreads = std::min(atoi(pszWarpThreads), CPLGetNumCPUs());
+        // Do not add parallelism when already running inside a job of a
+        // thread pool (typically a multi-threaded warp)
+        if (CPLWorkerThreadPool::IsCurrentThreadWorker())
+            nThreads = 1;
     }
 
-    if (nThreads > 1)
+    psInfo->nThreads = nThreads;
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads)
+        psInfo->papszOptions = CSLSetNameValue(psInfo->papszOptions,
+                                               "NUM_THREADS", pszNumThreads);
+
+    if (psInfo->poLocalForward)
+    {
+        // Tiles are solved in parallel by the thread pool.
+        psInfo->bForwardSolved =
+            psInfo->poLocalForward->solve(nThreads) != 0;
+        psInfo->bReverseSolved =
+            psInfo->bForwardSolved &&
+            psInfo->poLocalReverse->solve(nThreads) != 0;
+    }
+    else if (nThreads > 1)
     {
         // Compute direct and reverse transforms in parallel.
-        CPLJoinableThread *hThread =
-            CPLCreateJoinableThread(GDALTPSComputeForwardInThread, psInfo);
+        auto poPool = GDALGetGlobalThreadPool(nThreads);
+        auto poJobQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+        const bool bSubmitted =
+            poJobQueue &&
+            poJobQueue->SubmitJob(GDALTPSComputeForwardInThread, psInfo);
         psInfo->bReverseSolved = psInfo->poReverse->solve() != 0;
-        if (hThread != nullptr)
-            CPLJoinThread(hThread);
+        if (bSubmitted)
+            poJobQueue->WaitCompletion();
         else
             psInfo->bForwardSolved = psInfo->poForward->solve() != 0;
     }
@@ -316,6 +401,9 @@ void GDALDestroyTPSTransformer(void *pTransformArg)
     {
         delete psInfo->poForward;
         delete psInfo->poReverse;
+        delete psInfo->poLocalForward;
+        delete psInfo->poLocalReverse;
+        CSLDestroy(psInfo->papszOptions);
 
         GDALDeinitGCPs(psInfo->nGCPCount, psInfo->pasGCPList);
         CPLFree(psInfo->pasGCPList);
@@ -324,6 +412,58 @@ void GDALDestroyTPSTransformer(void *pTransformArg)
     }
 }
 
+/************************************************************************/
+/*                       GDALTPSTransformPoints()                       */
+/************************************************************************/
+
+static void GDALTPSTransformPoints(const TPSTransformInfo *psInfo,
+                                   bool bDstToSrc, int nPointCount, double *x,
+                                   double *y, int *panSuccess)
+{
+    for (int i = 0; i < nPointCount; i++)
+    {
+        double xy_out[2] = {0.0, 0.0};
+
+        if (psInfo->poLocalForward)
+        {
+            (bDstToSrc ? psInfo->poLocalReverse : psInfo->poLocalForward)
+                ->get_point(x[i], y[i], xy_out);
+        }
+        else if (bDstToSrc)
+        {
+            psInfo->poReverse->get_point(x[i], y[i], xy_out);
+        }
+        else
+        {
+            psInfo->poForward->get_point(x[i], y[i], xy_out);
+        }
+        x[i] = xy_out[0];
+        y[i] = xy_out[1];
+        panSuccess[i] = TRUE;
+    }
+}
+
+namespace
+{
+struct TPSTransformJob
+{
+    const TPSTransformInfo *psInfo = nullptr;
+    bool bDstToSrc = false;
+    int nPointCount = 0;
+    double *x = nullptr;
+    double *y = nullptr;
+    int *panSuccess = nullptr;
+};
+}  // namespace
+
+static void GDALTPSTransformPointsInThread(void *pData)
+{
+    const TPSTransformJob *psJob = static_cast<const TPSTransformJob *>(pData);
+    GDALTPSTransformPoints(psJob->psInfo, psJob->bDstToSrc,
+                           psJob->nPointCount, psJob->x, psJob->y,
+                           psJob->panSuccess);
+}
+
 /************************************************************************/
 /*                          GDALTPSTransform()                          */
 /************************************************************************/
@@ -357,23 +497,48 @@ int GDALTPSTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
 
     TPSTransformInfo *psInfo = static_cast<TPSTransformInfo *>(pTransformArg);
 
-    for (int i = 0; i < nPointCount; i++)
+    // Evaluating the splines is costly with many GCPs, so split large
+    // requests into jobs of the global thread pool, unless we are already
+    // running in a worker thread.
+    constexpr int MIN_POINTS_PER_THREAD = 4096;
+    const int nThreads =
+        CPLWorkerThreadPool::IsCurrentThreadWorker()
+            ? 1
+            : std::min(psInfo->nThreads, nPointCount / MIN_POINTS_PER_THREAD);
+    if (nThreads > 1)
     {
-        double xy_out[2] = {0.0, 0.0};
-
-        if (bDstToSrc)
+        // Jobs that cannot be queued are run by the calling thread.
+        auto poPool = GDALGetGlobalThreadPool(nThreads);
+        auto poJobQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+        std::vector<TPSTransformJob> asJobs(nThreads);
+        const int nPointsPerThread = DIV_ROUND_UP(nPointCount, nThreads);
+        for (int iThread = 0; iThread < nThreads; ++iThread)
         {
-            psInfo->poReverse->get_point(x[i], y[i], xy_out);
-            x[i] = xy_out[0];
-            y[i] = xy_out[1];
-        }
-        else
-        {
-            psInfo->poForward->get_point(x[i], y[i], xy_out);
-            x[i] = xy_out[0];
-            y[i] = xy_out[1];
+            const int iStart = iThread * nPointsPerThread;
+            TPSTransformJob &sJob = asJobs[iThread];
+            sJob.psInfo = psInfo;
+            sJob.bDstToSrc = CPL_TO_BOOL(bDstToSrc);
+            sJob.nPointCount =
+                std::min(nPointsPerThread, nPointCount - iStart);
+            sJob.x = x + iStart;
+            sJob.y = y + iStart;
+            sJob.panSuccess = panSuccess + iStart;
+            // The first chunk is processed by the calling thread.
+            if (iThread > 0 &&
+                (!poJobQueue ||
+                 !poJobQueue->SubmitJob(GDALTPSTransformPointsInThread, &sJob)))
+            {
+                GDALTPSTransformPointsInThread(&sJob);
+            }
         }
-        panSuccess[i] = TRUE;
+        GDALTPSTransformPointsInThread(&asJobs[0]);
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+    }
+    else
+    {
+        GDALTPSTransformPoints(psInfo, CPL_TO_BOOL(bDstToSrc), nPointCount, x,
+                               y, panSuccess);
     }
 
     return TRUE;
@@ -400,6 +565,17 @@ CPLXMLNode *GDALSerializeTPSTransformer(void *pTransformArg)
         psTree, "Reversed",
         CPLString().Printf("%d", static_cast<int>(psInfo->bReversed)));
 
+    /* -------------------------------------------------------------------- */
+    /*      Serialize method, if not the default one.                       */
+    /* -------------------------------------------------------------------- */
+    if (psInfo->poLocalForward)
+    {
+        CPLCreateXMLElementAndValue(psTree, "Method", "LOCAL");
+        CPLCreateXMLElementAndValue(
+            psTree, "LocalGCPsPerTile",
+            CSLFetchNameValue(psInfo->papszOptions, "TPS_LOCAL_GCPS_PER_TILE"));
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Attach GCP List.                                                */
     /* -------------------------------------------------------------------- */
@@ -437,10 +613,19 @@ void *GDALDeserializeTPSTransformer(CPLXMLNode *psTree)
     /* -------------------------------------------------------------------- */
     const int bReversed = atoi(CPLGetXMLValue(psTree, "Reversed", "0"));
 
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("TPS_METHOD",
+                            CPLGetXMLValue(psTree, "Method", "GLOBAL"));
+    const char *pszGCPsPerTile =
+        CPLGetXMLValue(psTree, "LocalGCPsPerTile", nullptr);
+    if (pszGCPsPerTile)
+        aosOptions.SetNameValue("TPS_LOCAL_GCPS_PER_TILE", pszGCPsPerTile);
+
     /* -------------------------------------------------------------------- */
     /*      Generate transformation.                                        */
     /* -------------------------------------------------------------------- */
-    void *pResult = GDALCreateTPSTransformer(nGCPCount, pasGCPList, bReversed);
+    void *pResult = GDALCreateTPSTransformerInt(nGCPCount, pasGCPList,
+                                                bReversed, aosOptions.List());
 
     /* -------------------------------------------------------------------- */
     /*      Cleanup GCP copy.                                               */
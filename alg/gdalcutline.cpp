@@ -34,12 +34,19 @@
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_mem_cache.h"
 #include "cpl_string.h"
 #include "gdal.h"
 #include "gdal_alg.h"
+#include "gdal_alg_priv.h"
 #include "gdal_priv.h"
 #include "memdataset.h"
 #include "ogr_api.h"
@@ -232,6 +239,249 @@ static int CutlineTransformer(void *pTransformArg, int bDstToSrc,
     return TRUE;
 }
 
+/************************************************************************/
+/*                        GDALWarpCutlineCache                          */
+/************************************************************************/
+
+struct GDALWarpCutlineCache
+{
+    std::mutex oMutex{};
+
+    // Cutline for which the below members have been computed.
+    OGRGeometryH hCutline = nullptr;
+
+    OGRPreparedGeometryUniquePtr poPreparedCutline{};
+
+    // Identifies the content of the cutline, so that masks rasterized for
+    // another warp operation using an identical cutline can be reused.
+    std::string osCutlineKey{};
+
+    // WKB of the cutline, compared on cache hits, since osCutlineKey is
+    // only derived from a hash of it.
+    std::shared_ptr<const std::string> poCutlineWKB{};
+};
+
+GDALWarpCutlineCache *GDALCreateWarpCutlineCache()
+{
+    return new GDALWarpCutlineCache();
+}
+
+void GDALDestroyWarpCutlineCache(GDALWarpCutlineCache *psCache)
+{
+    delete psCache;
+}
+
+/************************************************************************/
+/*                         GetCutlineMaskCache()                        */
+/************************************************************************/
+
+// Rasterized cutline masks of chunks partially covered by a cutline, shared
+// by all warp operations. Only masks of up to CUTLINE_MASK_CACHE_MAX_PIXELS
+// pixels are cached, so that the cache does not hold more than 16 MB.
+constexpr size_t CUTLINE_MASK_CACHE_MAX_ENTRIES = 8;
+constexpr size_t CUTLINE_MASK_CACHE_MAX_PIXELS = 2 * 1024 * 1024;
+
+struct CutlineMaskCacheEntry
+{
+    // WKB of the cutline from which the mask was rasterized.
+    std::shared_ptr<const std::string> poCutlineWKB{};
+    std::vector<GByte> abyMask{};
+};
+
+typedef lru11::Cache<std::string, std::shared_ptr<CutlineMaskCacheEntry>,
+                     std::mutex>
+    CutlineMaskCacheType;
+
+static CutlineMaskCacheType &GetCutlineMaskCache()
+{
+    static CutlineMaskCacheType oCache(CUTLINE_MASK_CACHE_MAX_ENTRIES, 0);
+    return oCache;
+}
+
+/************************************************************************/
+/*                      PrepareCutlineCache()                           */
+/*                                                                      */
+/*      Must be called with psCache->oMutex held.                       */
+/************************************************************************/
+
+static void PrepareCutlineCache(GDALWarpCutlineCache *psCache,
+                                OGRGeometryH hPolygon)
+{
+    if (psCache->hCutline == hPolygon)
+        return;
+
+    psCache->hCutline = hPolygon;
+    psCache->poPreparedCutline.reset();
+    psCache->osCutlineKey.clear();
+    psCache->poCutlineWKB.reset();
+
+    if (OGRHasPreparedGeometrySupport())
+        psCache->poPreparedCutline.reset(OGRCreatePreparedGeometry(hPolygon));
+
+    const OGRGeometry *poPolygon = OGRGeometry::FromHandle(hPolygon);
+
+    const size_t nWKBSize = poPolygon->WkbSize();
+    auto poWKB = std::make_shared<std::string>();
+    poWKB->resize(nWKBSize);
+    if (poPolygon->exportToWkb(wkbNDR, reinterpret_cast<GByte *>(&(*poWKB)[0]),
+                               wkbVariantIso) == OGRERR_NONE)
+    {
+        psCache->osCutlineKey = std::to_string(nWKBSize);
+        psCache->osCutlineKey += '_';
+        psCache->osCutlineKey +=
+            std::to_string(std::hash<std::string>()(*poWKB));
+        psCache->poCutlineWKB = std::move(poWKB);
+    }
+}
+
+/************************************************************************/
+/*                            ClipRing()                                */
+/*                                                                      */
+/*      Clip a ring against a rectangle with the Sutherland-Hodgman     */
+/*      algorithm. The result may have degenerate edges along the       */
+/*      rectangle boundary, which does not matter for rasterization     */
+/*      as long as the rectangle is larger than the raster.             */
+/************************************************************************/
+
+static void ClipRing(const OGRLinearRing *poRing, const OGREnvelope &sRect,
+                     std::vector<OGRRawPoint> &aoOut)
+{
+    std::vector<OGRRawPoint> aoIn;
+    aoOut.resize(poRing->getNumPoints());
+    poRing->getPoints(aoOut.data());
+
+    // Clip successively against x >= MinX, x <= MaxX, y >= MinY, y <= MaxY
+    for (int iEdge = 0; iEdge < 4 && !aoOut.empty(); iEdge++)
+    {
+        std::swap(aoIn, aoOut);
+        aoOut.clear();
+
+        const bool bX = iEdge < 2;
+        const double dfLimit = iEdge == 0   ? sRect.MinX
+                               : iEdge == 1 ? sRect.MaxX
+                               : iEdge == 2 ? sRect.MinY
+                                            : sRect.MaxY;
+        const auto IsInside = [bX, dfLimit, iEdge](const OGRRawPoint &p)
+        {
+            const double dfVal = bX ? p.x : p.y;
+            return (iEdge % 2) == 0 ? dfVal >= dfLimit : dfVal <= dfLimit;
+        };
+        const auto Intersect =
+            [bX, dfLimit](const OGRRawPoint &p0, const OGRRawPoint &p1)
+        {
+            OGRRawPoint p;
+            if (bX)
+            {
+                p.x = dfLimit;
+                p.y = p0.y + (p1.y - p0.y) * (dfLimit - p0.x) / (p1.x - p0.x);
+            }
+            else
+            {
+                p.x = p0.x + (p1.x - p0.x) * (dfLimit - p0.y) / (p1.y - p0.y);
+                p.y = dfLimit;
+            }
+            return p;
+        };
+
+        const size_t nPoints = aoIn.size();
+        for (size_t i = 0; i < nPoints; i++)
+        {
+            const OGRRawPoint &oCur = aoIn[i];
+            const OGRRawPoint &oPrev = aoIn[i == 0 ? nPoints - 1 : i - 1];
+            const bool bCurInside = IsInside(oCur);
+            const bool bPrevInside = IsInside(oPrev);
+            if (bCurInside)
+            {
+                if (!bPrevInside)
+                    aoOut.push_back(Intersect(oPrev, oCur));
+                aoOut.push_back(oCur);
+            }
+            else if (bPrevInside)
+            {
+                aoOut.push_back(Intersect(oPrev, oCur));
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                          ClipCutline()                               */
+/*                                                                      */
+/*      Return the part of the (multi)polygon relevant to rasterize     */
+/*      it within sRect, or nullptr if the geometry does not need to    */
+/*      be clipped. The returned geometry is not necessarily valid      */
+/*      in the OGC sense, but rasterizes the same within sRect.         */
+/************************************************************************/
+
+static std::unique_ptr<OGRGeometry> ClipCutline(const OGRGeometry *poGeom,
+                                                const OGREnvelope &sRect)
+{
+    OGREnvelope sEnvelope;
+    poGeom->getEnvelope(&sEnvelope);
+    if (sRect.Contains(sEnvelope))
+        return nullptr;
+
+    auto poRet = cpl::make_unique<OGRMultiPolygon>();
+    std::vector<OGRRawPoint> aoPoints;
+
+    const auto ClipPolygon =
+        [&sRect, &poRet, &aoPoints](const OGRPolygon *poPoly)
+    {
+        std::unique_ptr<OGRPolygon> poNewPoly;
+        bool bFirstRing = true;
+        for (const auto *poRing : *poPoly)
+        {
+            const bool bExteriorRing = bFirstRing;
+            bFirstRing = false;
+
+            OGREnvelope sRingEnvelope;
+            poRing->getEnvelope(&sRingEnvelope);
+            if (!sRingEnvelope.Intersects(sRect))
+            {
+                if (bExteriorRing)
+                    return;
+                continue;
+            }
+
+            auto poNewRing = cpl::make_unique<OGRLinearRing>();
+            if (sRect.Contains(sRingEnvelope))
+            {
+                poNewRing->addSubLineString(poRing);
+            }
+            else
+            {
+                ClipRing(poRing, sRect, aoPoints);
+                if (aoPoints.size() < 3)
+                {
+                    if (bExteriorRing)
+                        return;
+                    continue;
+                }
+                aoPoints.push_back(aoPoints.front());
+                poNewRing->setPoints(static_cast<int>(aoPoints.size()),
+                                     aoPoints.data());
+            }
+            if (!poNewPoly)
+                poNewPoly = cpl::make_unique<OGRPolygon>();
+            poNewPoly->addRingDirectly(poNewRing.release());
+        }
+        if (poNewPoly)
+            poRet->addGeometryDirectly(poNewPoly.release());
+    };
+
+    if (wkbFlatten(poGeom->getGeometryType()) == wkbPolygon)
+    {
+        ClipPolygon(poGeom->toPolygon());
+    }
+    else
+    {
+        for (const auto *poPoly : *(poGeom->toMultiPolygon()))
+            ClipPolygon(poPoly);
+    }
+
+    return poRet;
+}
+
 /************************************************************************/
 /*                       GDALWarpCutlineMasker()                        */
 /*                                                                      */
@@ -272,6 +522,30 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
         return CE_Failure;
     }
 
+    return GDALWarpCutlineMaskerWithCache(
+        pMaskFuncArg, nullptr, nXOff, nYOff, nXSize, nYSize,
+        static_cast<float *>(pValidityMask), pnValidityFlag);
+}
+
+/************************************************************************/
+/*                   GDALWarpCutlineMaskerWithCache()                   */
+/*                                                                      */
+/*      Same as GDALWarpCutlineMaskerEx(), using state cached across    */
+/*      the chunks of a warp operation if psCache is not null.          */
+/************************************************************************/
+
+CPLErr GDALWarpCutlineMaskerWithCache(void *pMaskFuncArg,
+                                      GDALWarpCutlineCache *psCache, int nXOff,
+                                      int nYOff, int nXSize, int nYSize,
+                                      float *pafMask, int *pnValidityFlag)
+
+{
+    if (pnValidityFlag)
+        *pnValidityFlag = GCMVF_PARTIAL_INTERSECTION;
+
+    if (nXSize < 1 || nYSize < 1)
+        return CE_None;
+
     GDALWarpOptions *psWO = static_cast<GDALWarpOptions *>(pMaskFuncArg);
 
     if (psWO == nullptr || psWO->hCutline == nullptr)
@@ -304,8 +578,6 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
     OGREnvelope sEnvelope;
     OGR_G_GetEnvelope(hPolygon, &sEnvelope);
 
-    float *pafMask = static_cast<float *>(pValidityMask);
-
     if (sEnvelope.MaxX + psWO->dfCutlineBlendDist < nXOff ||
         sEnvelope.MinX - psWO->dfCutlineBlendDist > nXOff + nXSize ||
         sEnvelope.MaxY + psWO->dfCutlineBlendDist < nYOff ||
@@ -321,8 +593,18 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
         return CE_None;
     }
 
-    // And now check if the chunk to warp is fully contained within the cutline
-    // to save rasterization.
+    std::string osCutlineKey;
+    std::shared_ptr<const std::string> poCutlineWKB;
+    if (psCache)
+    {
+        std::lock_guard<std::mutex> oLock(psCache->oMutex);
+        PrepareCutlineCache(psCache, hPolygon);
+        osCutlineKey = psCache->osCutlineKey;
+        poCutlineWKB = psCache->poCutlineWKB;
+    }
+
+    // And now check if the chunk to warp is fully contained within the cutline,
+    // or fully outside of it, to save rasterization.
     if (OGRGeometryFactory::haveGEOS()
 #ifdef DEBUG
         // Env var just for debugging purposes
@@ -346,8 +628,31 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
         oChunkFootprint.addRingDirectly(poRing);
         OGREnvelope sChunkEnvelope;
         oChunkFootprint.getEnvelope(&sChunkEnvelope);
-        if (sEnvelope.Contains(sChunkEnvelope) &&
-            OGRGeometry::FromHandle(hPolygon)->Contains(&oChunkFootprint))
+
+        bool bContains = false;
+        bool bIntersects = true;
+        if (psCache && psCache->poPreparedCutline)
+        {
+            // Prepared geometries are not safe to use concurrently.
+            std::lock_guard<std::mutex> oLock(psCache->oMutex);
+            OGRGeometryH hChunkFootprint =
+                OGRGeometry::ToHandle(&oChunkFootprint);
+            bContains = sEnvelope.Contains(sChunkEnvelope) &&
+                        OGRPreparedGeometryContains(
+                            psCache->poPreparedCutline.get(), hChunkFootprint);
+            bIntersects =
+                bContains ||
+                OGRPreparedGeometryIntersects(psCache->poPreparedCutline.get(),
+                                              hChunkFootprint);
+        }
+        else
+        {
+            bContains =
+                sEnvelope.Contains(sChunkEnvelope) &&
+                OGRGeometry::FromHandle(hPolygon)->Contains(&oChunkFootprint);
+        }
+
+        if (bContains)
         {
             if (pnValidityFlag)
                 *pnValidityFlag = GCMVF_CHUNK_FULLY_WITHIN_CUTLINE;
@@ -355,6 +660,16 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
             CPLDebug("WARP", "Source chunk fully contained within cutline.");
             return CE_None;
         }
+
+        if (!bIntersects)
+        {
+            if (pnValidityFlag)
+                *pnValidityFlag = GCMVF_NO_INTERSECTION;
+
+            CPLDebug("WARP", "Source chunk fully outside of cutline.");
+            memset(pafMask, 0, sizeof(float) * nXSize * nYSize);
+            return CE_None;
+        }
     }
 
     /* -------------------------------------------------------------------- */
@@ -363,37 +678,92 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
     /* -------------------------------------------------------------------- */
     GByte *pabyPolyMask = static_cast<GByte *>(CPLCalloc(nXSize, nYSize));
 
-    auto poMEMDS =
-        MEMDataset::Create("warp_temp", nXSize, nYSize, 0, GDT_Byte, nullptr);
-    GDALRasterBandH hMEMBand =
-        MEMCreateRasterBandEx(poMEMDS, 1, pabyPolyMask, GDT_Byte, 0, 0, false);
-    poMEMDS->AddMEMBand(hMEMBand);
-
-    GDALDatasetH hMemDS = GDALDataset::ToHandle(poMEMDS);
-    double adfGeoTransform[6] = {0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
-    GDALSetGeoTransform(hMemDS, adfGeoTransform);
-
-    /* -------------------------------------------------------------------- */
-    /*      Burn the polygon into the mask with 1.0 values.                 */
-    /* -------------------------------------------------------------------- */
-    int nTargetBand = 1;
-    double dfBurnValue = 255.0;
-    char **papszRasterizeOptions = nullptr;
+    const bool bAllTouched =
+        CPLFetchBool(psWO->papszWarpOptions, "CUTLINE_ALL_TOUCHED", false);
 
-    if (CPLFetchBool(psWO->papszWarpOptions, "CUTLINE_ALL_TOUCHED", false))
-        papszRasterizeOptions =
-            CSLSetNameValue(papszRasterizeOptions, "ALL_TOUCHED", "TRUE");
+    const size_t nPixels = static_cast<size_t>(nXSize) * nYSize;
+    std::string osMaskKey;
+    if (!osCutlineKey.empty() && nPixels <= CUTLINE_MASK_CACHE_MAX_PIXELS)
+    {
+        osMaskKey = osCutlineKey;
+        osMaskKey += CPLSPrintf("_%d_%d_%d_%d_%d", nXOff, nYOff, nXSize,
+                                nYSize, bAllTouched ? 1 : 0);
+    }
 
-    int anXYOff[2] = {nXOff, nYOff};
+    CPLErr eErr = CE_None;
+    std::shared_ptr<CutlineMaskCacheEntry> poCachedMask;
+    // The key is only a hash of the cutline, so check that the cached mask
+    // was really computed from the same cutline.
+    if (!osMaskKey.empty() &&
+        GetCutlineMaskCache().tryGet(osMaskKey, poCachedMask) &&
+        (poCachedMask->poCutlineWKB == poCutlineWKB ||
+         *(poCachedMask->poCutlineWKB) == *poCutlineWKB))
+    {
+        memcpy(pabyPolyMask, poCachedMask->abyMask.data(), nPixels);
+    }
+    else
+    {
+        auto poMEMDS = MEMDataset::Create("warp_temp", nXSize, nYSize, 0,
+                                          GDT_Byte, nullptr);
+        GDALRasterBandH hMEMBand = MEMCreateRasterBandEx(
+            poMEMDS, 1, pabyPolyMask, GDT_Byte, 0, 0, false);
+        poMEMDS->AddMEMBand(hMEMBand);
+
+        GDALDatasetH hMemDS = GDALDataset::ToHandle(poMEMDS);
+        double adfGeoTransform[6] = {0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+        GDALSetGeoTransform(hMemDS, adfGeoTransform);
+
+        /* ---------------------------------------------------------------- */
+        /*      Only keep the part of the cutline that intersects the       */
+        /*      chunk (with a margin), so that the cost of rasterization    */
+        /*      does not depend on the complexity of the whole cutline.     */
+        /* ---------------------------------------------------------------- */
+        OGREnvelope sClipRect;
+        constexpr double CLIP_MARGIN = 2;
+        sClipRect.MinX = nXOff - CLIP_MARGIN;
+        sClipRect.MinY = nYOff - CLIP_MARGIN;
+        sClipRect.MaxX = nXOff + nXSize + CLIP_MARGIN;
+        sClipRect.MaxY = nYOff + nYSize + CLIP_MARGIN;
+        auto poClippedCutline =
+            ClipCutline(OGRGeometry::FromHandle(hPolygon), sClipRect);
+        OGRGeometryH hPolygonToBurn =
+            poClippedCutline ? OGRGeometry::ToHandle(poClippedCutline.get())
+                             : hPolygon;
+
+        /* ---------------------------------------------------------------- */
+        /*      Burn the polygon into the mask with 1.0 values.             */
+        /* ---------------------------------------------------------------- */
+        int nTargetBand = 1;
+        double dfBurnValue = 255.0;
+        char **papszRasterizeOptions = nullptr;
+
+        if (bAllTouched)
+            papszRasterizeOptions =
+                CSLSetNameValue(papszRasterizeOptions, "ALL_TOUCHED", "TRUE");
+
+        int anXYOff[2] = {nXOff, nYOff};
+
+        if (!poClippedCutline || !poClippedCutline->IsEmpty())
+        {
+            eErr = GDALRasterizeGeometries(
+                hMemDS, 1, &nTargetBand, 1, &hPolygonToBurn,
+                CutlineTransformer, anXYOff, &dfBurnValue,
+                papszRasterizeOptions, nullptr, nullptr);
+        }
 
-    CPLErr eErr = GDALRasterizeGeometries(
-        hMemDS, 1, &nTargetBand, 1, &hPolygon, CutlineTransformer, anXYOff,
-        &dfBurnValue, papszRasterizeOptions, nullptr, nullptr);
+        CSLDestroy(papszRasterizeOptions);
 
-    CSLDestroy(papszRasterizeOptions);
+        // Close and ensure data flushed to underlying array.
+        GDALClose(hMemDS);
 
-    // Close and ensure data flushed to underlying array.
-    GDALClose(hMemDS);
+        if (eErr == CE_None && !osMaskKey.empty())
+        {
+            auto poEntry = std::make_shared<CutlineMaskCacheEntry>();
+            poEntry->poCutlineWKB = poCutlineWKB;
+            poEntry->abyMask.assign(pabyPolyMask, pabyPolyMask + nPixels);
+            GetCutlineMaskCache().insert(osMaskKey, poEntry);
+        }
+    }
 
     /* -------------------------------------------------------------------- */
     /*      In the case with no blend distance, we just apply this as a     */
@@ -404,14 +774,13 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
         for (int i = nXSize * nYSize - 1; i >= 0; i--)
         {
             if (pabyPolyMask[i] == 0)
-                static_cast<float *>(pValidityMask)[i] = 0.0;
+                pafMask[i] = 0.0;
         }
     }
     else
     {
         eErr = BlendMaskGenerator(nXOff, nYOff, nXSize, nYSize, pabyPolyMask,
-                                  static_cast<float *>(pValidityMask), hPolygon,
-                                  psWO->dfCutlineBlendDist);
+                                  pafMask, hPolygon, psWO->dfCutlineBlendDist);
     }
 
     /* -------------------------------------------------------------------- */
@@ -43,19 +43,51 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_md5.h"
 #include "cpl_minixml.h"
 #include "cpl_quad_tree.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "memdataset.h"
 
 constexpr float INVALID_BMXY = -10.0f;
 
+/************************************************************************/
+/*                     GDALGeoLocHasFloat32Values()                     */
+/************************************************************************/
+
+// Whether the values of the geolocation bands can be held as Float32 without
+// loss, which is the case of most swath products.
+static bool
+GDALGeoLocHasFloat32Values(const GDALGeoLocTransformInfo *psTransform)
+{
+    for (GDALRasterBandH hBand : {psTransform->hBand_X, psTransform->hBand_Y})
+    {
+        switch (GDALGetRasterDataType(hBand))
+        {
+            case GDT_Byte:
+            case GDT_Int8:
+            case GDT_UInt16:
+            case GDT_Int16:
+            case GDT_Float32:
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
 #include "gdalgeoloc_carray_accessor.h"
 #include "gdalgeoloc_dataset_accessor.h"
 
@@ -1010,16 +1042,389 @@ void GDALInverseBilinearInterpolation(const double x, const double y,
 }
 
 /************************************************************************/
-/*                       GeoLocGenerateBackMap()                        */
+/*                  GDALGeoLocGetBackMapSignature()                     */
+/************************************************************************/
+
+// Return a signature of the geolocation array and backmap parameters, used
+// to check that a persisted backmap can be reused.
+static std::string
+GDALGeoLocGetBackMapSignature(const GDALGeoLocTransformInfo *psTransform)
+{
+    CPLStringList aosMD(CSLDuplicate(psTransform->papszGeolocationInfo));
+    aosMD.Sort();
+
+    std::string osSig;
+    for (int i = 0; i < aosMD.size(); ++i)
+    {
+        osSig += aosMD[i];
+        osSig += '\n';
+    }
+    osSig += CPLSPrintf("%d,%d,%.17g\n", psTransform->nGeoLocXSize,
+                        psTransform->nGeoLocYSize,
+                        psTransform->dfOversampleFactor);
+    // State derived from the transformer options (GEOLOC_ARRAY/SRC_SRS,
+    // SWAP_XY, nodata of the geolocation bands) that affects the backmap.
+    osSig += CPLSPrintf(
+        "%d,%d,%d,%d,%.17g\n", psTransform->bSwapXY ? 1 : 0,
+        psTransform->bOriginIsTopLeftCorner ? 1 : 0,
+        psTransform->bGeographicSRSWithMinus180Plus180LongRange ? 1 : 0,
+        psTransform->bHasNoData ? 1 : 0,
+        psTransform->bHasNoData ? psTransform->dfNoDataX : 0.0);
+
+    // Take into account the modification time of the geolocation datasets,
+    // so that a stale backmap is not reused.
+    for (GDALDatasetH hDS : {psTransform->hDS_X, psTransform->hDS_Y})
+    {
+        VSIStatBufL sStat;
+        if (VSIStatL(GDALGetDescription(hDS), &sStat) == 0)
+        {
+            osSig += CPLSPrintf(CPL_FRMT_GUIB ",%" CPL_FRMT_GB_WITHOUT_PREFIX
+                                "d\n",
+                                static_cast<GUIntBig>(sStat.st_size),
+                                static_cast<GIntBig>(sStat.st_mtime));
+        }
+    }
+
+    return CPLMD5String(osSig.c_str());
+}
+
+/************************************************************************/
+/*                       GDALGeoLocSaveBackMap()                        */
+/************************************************************************/
+
+static void GDALGeoLocSaveBackMap(const GDALGeoLocTransformInfo *psTransform,
+                                  GDALDataset *poBackmapDS)
+{
+    auto poDriver = GDALDriver::FromHandle(GDALGetDriverByName("GTiff"));
+    if (poDriver == nullptr)
+        return;
+
+    double adfGT[6];
+    memcpy(adfGT, psTransform->adfBackMapGeoTransform, sizeof(adfGT));
+    poBackmapDS->SetGeoTransform(adfGT);
+    poBackmapDS->SetMetadataItem(
+        "GEOLOC_BACKMAP_SIGNATURE",
+        GDALGeoLocGetBackMapSignature(psTransform).c_str());
+
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("TILED", "YES");
+    aosOptions.SetNameValue("COMPRESS", "DEFLATE");
+    aosOptions.SetNameValue("PREDICTOR", "3");
+    std::unique_ptr<GDALDataset> poOutDS(
+        poDriver->CreateCopy(psTransform->pszBackMapFilename, poBackmapDS,
+                             false, aosOptions.List(), nullptr, nullptr));
+    if (poOutDS == nullptr || poOutDS->Close() != CE_None)
+    {
+        CPLError(CE_Warning, CPLE_FileIO, "Cannot save backmap to %s",
+                 psTransform->pszBackMapFilename);
+        poOutDS.reset();
+        VSIUnlink(psTransform->pszBackMapFilename);
+    }
+    else
+    {
+        CPLDebug("GEOLOC", "Backmap saved to %s",
+                 psTransform->pszBackMapFilename);
+    }
+}
+
+/************************************************************************/
+/*                     GDALGeoLoc::LoadBackMap()                        */
 /************************************************************************/
 
 /*! @cond Doxygen_Suppress */
 
+// Load the backmap persisted in psTransform->pszBackMapFilename, if it exists
+// and was generated for the same geolocation array and parameters.
+template <class Accessors>
+bool GDALGeoLoc<Accessors>::LoadBackMap(GDALGeoLocTransformInfo *psTransform)
+{
+    const char *pszFilename = psTransform->pszBackMapFilename;
+    VSIStatBufL sStat;
+    if (VSIStatL(pszFilename, &sStat) != 0)
+        return false;
+
+    std::unique_ptr<GDALDataset> poDS(
+        GDALDataset::Open(pszFilename, GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR));
+    if (poDS == nullptr)
+        return false;
+
+    const char *pszSignature =
+        poDS->GetMetadataItem("GEOLOC_BACKMAP_SIGNATURE");
+    double adfGT[6];
+    if (poDS->GetRasterCount() != 2 ||
+        poDS->GetRasterBand(1)->GetRasterDataType() != GDT_Float32 ||
+        poDS->GetRasterBand(2)->GetRasterDataType() != GDT_Float32 ||
+        poDS->GetGeoTransform(adfGT) != CE_None || pszSignature == nullptr ||
+        GDALGeoLocGetBackMapSignature(psTransform) != pszSignature)
+    {
+        CPLDebug("GEOLOC",
+                 "%s is not a backmap for this geolocation array. "
+                 "Regenerating it",
+                 pszFilename);
+        return false;
+    }
+
+    psTransform->nBackMapWidth = poDS->GetRasterXSize();
+    psTransform->nBackMapHeight = poDS->GetRasterYSize();
+    memcpy(psTransform->adfBackMapGeoTransform, adfGT, sizeof(adfGT));
+
+    auto pAccessors = static_cast<Accessors *>(psTransform->pAccessors);
+    if (!pAccessors->LoadBackMap(poDS.get()))
+        return false;
+
+    CPLDebug("GEOLOC", "Backmap loaded from %s", pszFilename);
+    return true;
+}
+
+/************************************************************************/
+/*                    GDALGeoLocBackMapJobParams                        */
+/************************************************************************/
+
+// Parameters shared by all the jobs of a backmap generation.
+struct GDALGeoLocBackMapJobParams
+{
+    const GDALGeoLocTransformInfo *psTransform = nullptr;
+    int nBMXSize = 0;
+    int nBMYSize = 0;
+    double dfMinX = 0;
+    double dfMaxY = 0;
+    double dfPixelXSize = 0;
+    double dfPixelYSize = 0;
+    double dfStep = 0;
+    double dfGeorefConventionOffset = 0;
+};
+
+/************************************************************************/
+/*                    GDALGeoLocBackMapContribution                     */
+/************************************************************************/
+
+// Contribution of a sample of the geolocation array to the backmap.
+struct GDALGeoLocBackMapContribution
+{
+    // Position of the sample in the geolocation array.
+    double dfX;
+    double dfY;
+    // Position of the sample in the backmap.
+    double dBMX;
+    double dBMY;
+    // Backmap values, only set when bExactMatch is true.
+    float fBMXValue;
+    float fBMYValue;
+    // Whether a geolocation cell containing the backmap node was found.
+    bool bExactMatch;
+};
+
+/************************************************************************/
+/*                       GDALGeoLocBackMapJob                           */
+/************************************************************************/
+
+struct GDALGeoLocBackMapJob
+{
+    const GDALGeoLocBackMapJobParams *psParams = nullptr;
+    std::vector<double> adfY{};
+    double dfXStart = 0;
+    double dfXEnd = 0;
+    std::vector<GDALGeoLocBackMapContribution> aoContributions{};
+};
+
+/************************************************************************/
+/*               GDALGeoLocComputeBackMapContributions()                */
+/************************************************************************/
+
+// Forward project the samples of a job. This does not modify the backmap,
+// and only reads the geolocation array, so it can run in a worker thread
+// when the geolocation array accessors are thread-safe.
+template <class Accessors>
+static void GDALGeoLocComputeBackMapContributions(void *pData)
+{
+    GDALGeoLocBackMapJob *psJob = static_cast<GDALGeoLocBackMapJob *>(pData);
+    const GDALGeoLocBackMapJobParams &sParams = *(psJob->psParams);
+    const GDALGeoLocTransformInfo *psTransform = sParams.psTransform;
+    const int nBMXSize = sParams.nBMXSize;
+    const int nBMYSize = sParams.nBMYSize;
+    const double dfMinX = sParams.dfMinX;
+    const double dfMaxY = sParams.dfMaxY;
+    const double dfPixelXSize = sParams.dfPixelXSize;
+    const double dfPixelYSize = sParams.dfPixelYSize;
+    const double dfGeorefConventionOffset = sParams.dfGeorefConventionOffset;
+
+    // Keep those objects in this outer scope, so they are re-used, to
+    // save memory allocations.
+    OGRPoint oPoint;
+    OGRLinearRing oRing;
+    oRing.setNumPoints(5);
+
+    for (const double dfY : psJob->adfY)
+    {
+        for (double dfX = psJob->dfXStart; dfX < psJob->dfXEnd;
+             dfX += sParams.dfStep)
+        {
+            // Use forward geolocation array interpolation to compute
+            // the georeferenced position corresponding to (dfX, dfY)
+            double dfGeoLocX;
+            double dfGeoLocY;
+            if (!GDALGeoLoc<Accessors>::PixelLineToXY(psTransform, dfX, dfY,
+                                                      dfGeoLocX, dfGeoLocY))
+                continue;
+
+            GDALGeoLocBackMapContribution sContrib;
+            sContrib.dfX = dfX;
+            sContrib.dfY = dfY;
+            sContrib.fBMXValue = 0;
+            sContrib.fBMYValue = 0;
+            sContrib.bExactMatch = false;
+
+            // Compute the floating point coordinates in the pixel space
+            // of the backmap
+            const double dBMX =
+                static_cast<double>((dfGeoLocX - dfMinX) / dfPixelXSize);
+
+            const double dBMY =
+                static_cast<double>((dfMaxY - dfGeoLocY) / dfPixelYSize);
+            sContrib.dBMX = dBMX;
+            sContrib.dBMY = dBMY;
+
+            // Get top left index by truncation
+            const int iBMX = static_cast<int>(std::floor(dBMX));
+            const int iBMY = static_cast<int>(std::floor(dBMY));
+
+            if (iBMX >= 0 && iBMX < nBMXSize && iBMY >= 0 && iBMY < nBMYSize)
+            {
+                // Compute the georeferenced position of the top-left
+                // index of the backmap
+                double dfGeoX = dfMinX + iBMX * dfPixelXSize;
+                const double dfGeoY = dfMaxY - iBMY * dfPixelYSize;
+
+                const int nOuterIters =
+                    psTransform->bGeographicSRSWithMinus180Plus180LongRange &&
+                            fabs(dfGeoX) >= 180
+                        ? 2
+                        : 1;
+
+                for (int iOuterIter = 0; iOuterIter < nOuterIters; ++iOuterIter)
+                {
+                    if (iOuterIter == 1 && dfGeoX >= 180)
+                        dfGeoX -= 360;
+                    else if (iOuterIter == 1 && dfGeoX <= -180)
+                        dfGeoX += 360;
+
+                    // Identify a cell (quadrilateral in georeferenced
+                    // space) in the geolocation array in which dfGeoX,
+                    // dfGeoY falls into.
+                    oPoint.setX(dfGeoX);
+                    oPoint.setY(dfGeoY);
+                    const int nX = static_cast<int>(std::floor(dfX));
+                    const int nY = static_cast<int>(std::floor(dfY));
+                    for (int sx = -1; !sContrib.bExactMatch && sx <= 0; sx++)
+                    {
+                        for (int sy = -1; !sContrib.bExactMatch && sy <= 0;
+                             sy++)
+                        {
+                            const int pixel = nX + sx;
+                            const int line = nY + sy;
+                            double x0, y0, x1, y1, x2, y2, x3, y3;
+                            if (!GDALGeoLoc<Accessors>::PixelLineToXY(
+                                    psTransform, pixel, line, x0, y0) ||
+                                !GDALGeoLoc<Accessors>::PixelLineToXY(
+                                    psTransform, pixel + 1, line, x2, y2) ||
+                                !GDALGeoLoc<Accessors>::PixelLineToXY(
+                                    psTransform, pixel, line + 1, x1, y1) ||
+                                !GDALGeoLoc<Accessors>::PixelLineToXY(
+                                    psTransform, pixel + 1, line + 1, x3, y3))
+                            {
+                                break;
+                            }
+
+                            int nIters = 1;
+                            if (psTransform
+                                    ->bGeographicSRSWithMinus180Plus180LongRange &&
+                                std::fabs(x0) > 170 && std::fabs(x1) > 170 &&
+                                std::fabs(x2) > 170 && std::fabs(x3) > 170 &&
+                                (std::fabs(x1 - x0) > 180 ||
+                                 std::fabs(x2 - x0) > 180 ||
+                                 std::fabs(x3 - x0) > 180))
+                            {
+                                nIters = 2;
+                                if (x0 > 0)
+                                    x0 -= 360;
+                                if (x1 > 0)
+                                    x1 -= 360;
+                                if (x2 > 0)
+                                    x2 -= 360;
+                                if (x3 > 0)
+                                    x3 -= 360;
+                            }
+                            for (int iIter = 0; iIter < nIters; ++iIter)
+                            {
+                                if (iIter == 1)
+                                {
+                                    x0 += 360;
+                                    x1 += 360;
+                                    x2 += 360;
+                                    x3 += 360;
+                                }
+
+                                oRing.setPoint(0, x0, y0);
+                                oRing.setPoint(1, x2, y2);
+                                oRing.setPoint(2, x3, y3);
+                                oRing.setPoint(3, x1, y1);
+                                oRing.setPoint(4, x0, y0);
+                                if (oRing.isPointInRing(&oPoint) ||
+                                    oRing.isPointOnRingBoundary(&oPoint))
+                                {
+                                    sContrib.bExactMatch = true;
+                                    double dfBMXValue = pixel;
+                                    double dfBMYValue = line;
+                                    GDALInverseBilinearInterpolation(
+                                        dfGeoX, dfGeoY, x0, y0, x1, y1, x2, y2,
+                                        x3, y3, dfBMXValue, dfBMYValue);
+
+                                    dfBMXValue = (dfBMXValue +
+                                                  dfGeorefConventionOffset) *
+                                                     psTransform->dfPIXEL_STEP +
+                                                 psTransform->dfPIXEL_OFFSET;
+                                    dfBMYValue = (dfBMYValue +
+                                                  dfGeorefConventionOffset) *
+                                                     psTransform->dfLINE_STEP +
+                                                 psTransform->dfLINE_OFFSET;
+
+                                    sContrib.fBMXValue =
+                                        static_cast<float>(dfBMXValue);
+                                    sContrib.fBMYValue =
+                                        static_cast<float>(dfBMYValue);
+                                }
+                            }
+                        }
+                    }
+                }
+                if (sContrib.bExactMatch)
+                {
+                    psJob->aoContributions.push_back(sContrib);
+                    continue;
+                }
+            }
+
+            // Check if the center is in range
+            if (iBMX < -1 || iBMY < -1 || iBMX > nBMXSize || iBMY > nBMYSize)
+                continue;
+
+            psJob->aoContributions.push_back(sContrib);
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GeoLocGenerateBackMap()                        */
+/************************************************************************/
+
 template <class Accessors>
 bool GDALGeoLoc<Accessors>::GenerateBackMap(
     GDALGeoLocTransformInfo *psTransform)
 
 {
+    if (psTransform->pszBackMapFilename && LoadBackMap(psTransform))
+        return true;
+
     CPLDebug("GEOLOC", "Starting backmap generation");
     const int nXSize = psTransform->nGeoLocXSize;
     const int nYSize = psTransform->nGeoLocYSize;
@@ -1154,12 +1559,6 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
         }
     };
 
-    // Keep those objects in this outer scope, so they are re-used, to
-    // save memory allocations.
-    OGRPoint oPoint;
-    OGRLinearRing oRing;
-    oRing.setNumPoints(5);
-
     /* -------------------------------------------------------------------- */
     /*      Run through the whole geoloc array forward projecting and       */
     /*      pushing into the backmap.                                       */
@@ -1217,223 +1616,158 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
         xStartEnd[iXBlock].second = dfX + dfStep / 10;
     }
 
-    for (int iYBlock = 0; iYBlock < nYBlocks; ++iYBlock)
+    // The forward projection of the geolocation array samples is split into
+    // jobs, that can be run in worker threads when the geolocation array is
+    // held in RAM (the cached pixel accessors of the temporary datasets are
+    // not thread-safe). The contributions computed by each job are merged
+    // into the backmap in the same order as a sequential scan would do, so
+    // the result does not depend on the number of threads.
+    const int nThreads = psTransform->bUseArray ? psTransform->nThreads : 1;
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    const size_t nMaxJobsInFlight =
+        poJobQueue ? static_cast<size_t>(4 * nThreads) : 1;
+    // Number of samples processed per job. Keeps the memory used by pending
+    // contributions to a few megabytes per job.
+    constexpr double SAMPLES_PER_JOB = 64 * 1024;
+
+    GDALGeoLocBackMapJobParams sParams;
+    sParams.psTransform = psTransform;
+    sParams.nBMXSize = nBMXSize;
+    sParams.nBMYSize = nBMYSize;
+    sParams.dfMinX = dfMinX;
+    sParams.dfMaxY = dfMaxY;
+    sParams.dfPixelXSize = dfPixelXSize;
+    sParams.dfPixelYSize = dfPixelYSize;
+    sParams.dfStep = dfStep;
+    sParams.dfGeorefConventionOffset = dfGeorefConventionOffset;
+
+    std::vector<std::unique_ptr<GDALGeoLocBackMapJob>> apoJobs;
+
+    const auto MergeJobs = [&]()
     {
-        for (int iXBlock = 0; iXBlock < nXBlocks; ++iXBlock)
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+        for (const auto &poJob : apoJobs)
         {
-#if 0
-        CPLDebug("Process geoloc block (y=%d,x=%d) for y in [%f, %f] and x in [%f, %f]",
-                 iYBlock, iXBlock,
-                 yStartEnd[iYBlock].first, yStartEnd[iYBlock].second,
-                 xStartEnd[iXBlock].first, xStartEnd[iXBlock].second);
-#endif
-            for (double dfY = yStartEnd[iYBlock].first;
-                 dfY < yStartEnd[iYBlock].second; dfY += dfStep)
+            for (const auto &sContrib : poJob->aoContributions)
             {
-                for (double dfX = xStartEnd[iXBlock].first;
-                     dfX < xStartEnd[iXBlock].second; dfX += dfStep)
-                {
-                    // Use forward geolocation array interpolation to compute
-                    // the georeferenced position corresponding to (dfX, dfY)
-                    double dfGeoLocX;
-                    double dfGeoLocY;
-                    if (!PixelLineToXY(psTransform, dfX, dfY, dfGeoLocX,
-                                       dfGeoLocY))
-                        continue;
-
-                    // Compute the floating point coordinates in the pixel space
-                    // of the backmap
-                    const double dBMX = static_cast<double>(
-                        (dfGeoLocX - dfMinX) / dfPixelXSize);
-
-                    const double dBMY = static_cast<double>(
-                        (dfMaxY - dfGeoLocY) / dfPixelYSize);
-
-                    // Get top left index by truncation
-                    const int iBMX = static_cast<int>(std::floor(dBMX));
-                    const int iBMY = static_cast<int>(std::floor(dBMY));
+                const double dfX = sContrib.dfX;
+                const double dfY = sContrib.dfY;
+                const int iBMX = static_cast<int>(std::floor(sContrib.dBMX));
+                const int iBMY = static_cast<int>(std::floor(sContrib.dBMY));
 
-                    if (iBMX >= 0 && iBMX < nBMXSize && iBMY >= 0 &&
-                        iBMY < nBMYSize)
-                    {
-                        // Compute the georeferenced position of the top-left
-                        // index of the backmap
-                        double dfGeoX = dfMinX + iBMX * dfPixelXSize;
-                        const double dfGeoY = dfMaxY - iBMY * dfPixelYSize;
+                if (sContrib.bExactMatch)
+                {
+                    pAccessors->backMapXAccessor.Set(iBMX, iBMY,
+                                                     sContrib.fBMXValue);
+                    pAccessors->backMapYAccessor.Set(iBMX, iBMY,
+                                                     sContrib.fBMYValue);
+                    pAccessors->backMapWeightAccessor.Set(iBMX, iBMY, 1.0f);
+                    continue;
+                }
 
-                        bool bMatchingGeoLocCellFound = false;
+                // We will end up here in non-nominal cases, with nodata,
+                // holes, etc.
 
-                        const int nOuterIters =
-                            psTransform->bGeographicSRSWithMinus180Plus180LongRange &&
-                                    fabs(dfGeoX) >= 180
-                                ? 2
-                                : 1;
+                const double fracBMX = sContrib.dBMX - iBMX;
+                const double fracBMY = sContrib.dBMY - iBMY;
 
-                        for (int iOuterIter = 0; iOuterIter < nOuterIters;
-                             ++iOuterIter)
-                        {
-                            if (iOuterIter == 1 && dfGeoX >= 180)
-                                dfGeoX -= 360;
-                            else if (iOuterIter == 1 && dfGeoX <= -180)
-                                dfGeoX += 360;
-
-                            // Identify a cell (quadrilateral in georeferenced
-                            // space) in the geolocation array in which dfGeoX,
-                            // dfGeoY falls into.
-                            oPoint.setX(dfGeoX);
-                            oPoint.setY(dfGeoY);
-                            const int nX = static_cast<int>(std::floor(dfX));
-                            const int nY = static_cast<int>(std::floor(dfY));
-                            for (int sx = -1;
-                                 !bMatchingGeoLocCellFound && sx <= 0; sx++)
-                            {
-                                for (int sy = -1;
-                                     !bMatchingGeoLocCellFound && sy <= 0; sy++)
-                                {
-                                    const int pixel = nX + sx;
-                                    const int line = nY + sy;
-                                    double x0, y0, x1, y1, x2, y2, x3, y3;
-                                    if (!PixelLineToXY(psTransform, pixel, line,
-                                                       x0, y0) ||
-                                        !PixelLineToXY(psTransform, pixel + 1,
-                                                       line, x2, y2) ||
-                                        !PixelLineToXY(psTransform, pixel,
-                                                       line + 1, x1, y1) ||
-                                        !PixelLineToXY(psTransform, pixel + 1,
-                                                       line + 1, x3, y3))
-                                    {
-                                        break;
-                                    }
-
-                                    int nIters = 1;
-                                    if (psTransform
-                                            ->bGeographicSRSWithMinus180Plus180LongRange &&
-                                        std::fabs(x0) > 170 &&
-                                        std::fabs(x1) > 170 &&
-                                        std::fabs(x2) > 170 &&
-                                        std::fabs(x3) > 170 &&
-                                        (std::fabs(x1 - x0) > 180 ||
-                                         std::fabs(x2 - x0) > 180 ||
-                                         std::fabs(x3 - x0) > 180))
-                                    {
-                                        nIters = 2;
-                                        if (x0 > 0)
-                                            x0 -= 360;
-                                        if (x1 > 0)
-                                            x1 -= 360;
-                                        if (x2 > 0)
-                                            x2 -= 360;
-                                        if (x3 > 0)
-                                            x3 -= 360;
-                                    }
-                                    for (int iIter = 0; iIter < nIters; ++iIter)
-                                    {
-                                        if (iIter == 1)
-                                        {
-                                            x0 += 360;
-                                            x1 += 360;
-                                            x2 += 360;
-                                            x3 += 360;
-                                        }
-
-                                        oRing.setPoint(0, x0, y0);
-                                        oRing.setPoint(1, x2, y2);
-                                        oRing.setPoint(2, x3, y3);
-                                        oRing.setPoint(3, x1, y1);
-                                        oRing.setPoint(4, x0, y0);
-                                        if (oRing.isPointInRing(&oPoint) ||
-                                            oRing.isPointOnRingBoundary(
-                                                &oPoint))
-                                        {
-                                            bMatchingGeoLocCellFound = true;
-                                            double dfBMXValue = pixel;
-                                            double dfBMYValue = line;
-                                            GDALInverseBilinearInterpolation(
-                                                dfGeoX, dfGeoY, x0, y0, x1, y1,
-                                                x2, y2, x3, y3, dfBMXValue,
-                                                dfBMYValue);
-
-                                            dfBMXValue =
-                                                (dfBMXValue +
-                                                 dfGeorefConventionOffset) *
-                                                    psTransform->dfPIXEL_STEP +
-                                                psTransform->dfPIXEL_OFFSET;
-                                            dfBMYValue =
-                                                (dfBMYValue +
-                                                 dfGeorefConventionOffset) *
-                                                    psTransform->dfLINE_STEP +
-                                                psTransform->dfLINE_OFFSET;
-
-                                            pAccessors->backMapXAccessor.Set(
-                                                iBMX, iBMY,
-                                                static_cast<float>(dfBMXValue));
-                                            pAccessors->backMapYAccessor.Set(
-                                                iBMX, iBMY,
-                                                static_cast<float>(dfBMYValue));
-                                            pAccessors->backMapWeightAccessor
-                                                .Set(iBMX, iBMY, 1.0f);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                        if (bMatchingGeoLocCellFound)
-                            continue;
-                    }
-
-                    // We will end up here in non-nominal cases, with nodata,
-                    // holes, etc.
-
-                    // Check if the center is in range
-                    if (iBMX < -1 || iBMY < -1 || iBMX > nBMXSize ||
-                        iBMY > nBMYSize)
-                        continue;
+                // Check logic for top left pixel
+                if ((iBMX >= 0) && (iBMY >= 0) && (iBMX < nBMXSize) &&
+                    (iBMY < nBMYSize) &&
+                    pAccessors->backMapWeightAccessor.Get(iBMX, iBMY) != 1.0f)
+                {
+                    const double tempwt = (1.0 - fracBMX) * (1.0 - fracBMY);
+                    UpdateBackmap(iBMX, iBMY, dfX, dfY, tempwt);
+                }
 
-                    const double fracBMX = dBMX - iBMX;
-                    const double fracBMY = dBMY - iBMY;
+                // Check logic for top right pixel
+                if ((iBMY >= 0) && (iBMX + 1 < nBMXSize) &&
+                    (iBMY < nBMYSize) &&
+                    pAccessors->backMapWeightAccessor.Get(iBMX + 1, iBMY) !=
+                        1.0f)
+                {
+                    const double tempwt = fracBMX * (1.0 - fracBMY);
+                    UpdateBackmap(iBMX + 1, iBMY, dfX, dfY, tempwt);
+                }
 
-                    // Check logic for top left pixel
-                    if ((iBMX >= 0) && (iBMY >= 0) && (iBMX < nBMXSize) &&
-                        (iBMY < nBMYSize) &&
-                        pAccessors->backMapWeightAccessor.Get(iBMX, iBMY) !=
-                            1.0f)
-                    {
-                        const double tempwt = (1.0 - fracBMX) * (1.0 - fracBMY);
-                        UpdateBackmap(iBMX, iBMY, dfX, dfY, tempwt);
-                    }
+                // Check logic for bottom right pixel
+                if ((iBMX + 1 < nBMXSize) && (iBMY + 1 < nBMYSize) &&
+                    pAccessors->backMapWeightAccessor.Get(iBMX + 1,
+                                                          iBMY + 1) != 1.0f)
+                {
+                    const double tempwt = fracBMX * fracBMY;
+                    UpdateBackmap(iBMX + 1, iBMY + 1, dfX, dfY, tempwt);
+                }
 
-                    // Check logic for top right pixel
-                    if ((iBMY >= 0) && (iBMX + 1 < nBMXSize) &&
-                        (iBMY < nBMYSize) &&
-                        pAccessors->backMapWeightAccessor.Get(iBMX + 1, iBMY) !=
-                            1.0f)
-                    {
-                        const double tempwt = fracBMX * (1.0 - fracBMY);
-                        UpdateBackmap(iBMX + 1, iBMY, dfX, dfY, tempwt);
-                    }
+                // Check logic for bottom left pixel
+                if ((iBMX >= 0) && (iBMX < nBMXSize) && (iBMY + 1 < nBMYSize) &&
+                    pAccessors->backMapWeightAccessor.Get(iBMX, iBMY + 1) !=
+                        1.0f)
+                {
+                    const double tempwt = (1.0 - fracBMX) * fracBMY;
+                    UpdateBackmap(iBMX, iBMY + 1, dfX, dfY, tempwt);
+                }
+            }
+        }
+        apoJobs.clear();
+    };
 
-                    // Check logic for bottom right pixel
-                    if ((iBMX + 1 < nBMXSize) && (iBMY + 1 < nBMYSize) &&
-                        pAccessors->backMapWeightAccessor.Get(iBMX + 1,
-                                                              iBMY + 1) != 1.0f)
-                    {
-                        const double tempwt = fracBMX * fracBMY;
-                        UpdateBackmap(iBMX + 1, iBMY + 1, dfX, dfY, tempwt);
-                    }
+    std::vector<double> adfY;
+    for (int iYBlock = 0; iYBlock < nYBlocks; ++iYBlock)
+    {
+        // Collect the line values of this block of the geolocation array,
+        // using the same accumulation as the sequential scan.
+        adfY.clear();
+        for (double dfY = yStartEnd[iYBlock].first;
+             dfY < yStartEnd[iYBlock].second; dfY += dfStep)
+        {
+            adfY.push_back(dfY);
+        }
 
-                    // Check logic for bottom left pixel
-                    if ((iBMX >= 0) && (iBMX < nBMXSize) &&
-                        (iBMY + 1 < nBMYSize) &&
-                        pAccessors->backMapWeightAccessor.Get(iBMX, iBMY + 1) !=
-                            1.0f)
-                    {
-                        const double tempwt = (1.0 - fracBMX) * fracBMY;
-                        UpdateBackmap(iBMX, iBMY + 1, dfX, dfY, tempwt);
-                    }
+        for (int iXBlock = 0; iXBlock < nXBlocks; ++iXBlock)
+        {
+#if 0
+        CPLDebug("Process geoloc block (y=%d,x=%d) for y in [%f, %f] and x in [%f, %f]",
+                 iYBlock, iXBlock,
+                 yStartEnd[iYBlock].first, yStartEnd[iYBlock].second,
+                 xStartEnd[iXBlock].first, xStartEnd[iXBlock].second);
+#endif
+            const double dfXCount =
+                (xStartEnd[iXBlock].second - xStartEnd[iXBlock].first) /
+                dfStep;
+            const size_t nLinesPerJob = static_cast<size_t>(
+                std::max(1.0, SAMPLES_PER_JOB / std::max(1.0, dfXCount)));
+            for (size_t iLine = 0; iLine < adfY.size(); iLine += nLinesPerJob)
+            {
+                auto poJob = cpl::make_unique<GDALGeoLocBackMapJob>();
+                poJob->psParams = &sParams;
+                poJob->adfY.assign(
+                    adfY.begin() + iLine,
+                    adfY.begin() + std::min(adfY.size(), iLine + nLinesPerJob));
+                poJob->dfXStart = xStartEnd[iXBlock].first;
+                poJob->dfXEnd = xStartEnd[iXBlock].second;
+                if (poJobQueue)
+                {
+                    poJobQueue->SubmitJob(
+                        GDALGeoLocComputeBackMapContributions<Accessors>,
+                        poJob.get());
+                }
+                else
+                {
+                    GDALGeoLocComputeBackMapContributions<Accessors>(
+                        poJob.get());
                 }
+                apoJobs.push_back(std::move(poJob));
+                if (apoJobs.size() == nMaxJobsInFlight)
+                    MergeJobs();
             }
         }
     }
+    MergeJobs();
 
     // Each pixel in the backmap may have multiple entries.
     // We now go in average it out using the weights
@@ -1576,6 +1910,12 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
     }
 #endif
 
+    if (psTransform->pszBackMapFilename)
+    {
+        pAccessors->FlushBackmapCaches();
+        GDALGeoLocSaveBackMap(psTransform, poBackmapDS);
+    }
+
     pAccessors->ReleaseBackmapDataset(poBackmapDS);
     CPLDebug("GEOLOC", "Ending backmap generation");
 
@@ -1796,6 +2136,18 @@ void *GDALCreateGeoLocTransformerEx(GDALDatasetH hBaseDS,
                      CPLGetConfigOption("GDAL_GEOLOC_BACKMAP_OVERSAMPLE_FACTOR",
                                         "1.3")))));
 
+    const char *pszThreads = CSLFetchNameValueDef(
+        papszTransformOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    psTransform->nThreads = std::max(
+        1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+
+    const char *pszBackMapFilename = CSLFetchNameValue(
+        papszTransformOptions, "GEOLOC_BACKMAP_FILENAME");
+    if (pszBackMapFilename && pszBackMapFilename[0] != '\0')
+        psTransform->pszBackMapFilename = CPLStrdup(pszBackMapFilename);
+
     memcpy(psTransform->sTI.abySignature, GDAL_GTI2_SIGNATURE,
            strlen(GDAL_GTI2_SIGNATURE));
     psTransform->sTI.pszClassName = "GDALGeoLocTransformer";
@@ -2067,6 +2419,7 @@ void GDALDestroyGeoLocTransformer(void *pTransformAlg)
         static_cast<GDALGeoLocTransformInfo *>(pTransformAlg);
 
     CSLDestroy(psTransform->papszGeolocationInfo);
+    CPLFree(psTransform->pszBackMapFilename);
 
     if (psTransform->bUseArray)
         delete static_cast<GDALGeoLocCArrayAccessors *>(
@@ -39,6 +39,8 @@ class GDALGeoLocCArrayAccessors
     GDALGeoLocTransformInfo *m_psTransform;
     double *m_padfGeoLocX = nullptr;
     double *m_padfGeoLocY = nullptr;
+    float *m_pafGeoLocX = nullptr;
+    float *m_pafGeoLocY = nullptr;
     float *m_pafBackMapX = nullptr;
     float *m_pafBackMapY = nullptr;
     float *m_wgtsBackMap = nullptr;
@@ -70,15 +72,31 @@ class GDALGeoLocCArrayAccessors
         }
     };
 
-    CArrayAccessor<double> geolocXAccessor;
-    CArrayAccessor<double> geolocYAccessor;
+    // Accessor to a geolocation array, held as Float32 when its values can
+    // be represented without loss, and as Float64 otherwise.
+    struct CArrayGeolocAccessor
+    {
+        double *m_padfArray = nullptr;
+        float *m_pafArray = nullptr;
+        size_t m_nXSize = 0;
+
+        inline double Get(int nX, int nY, bool *pbSuccess = nullptr)
+        {
+            if (pbSuccess)
+                *pbSuccess = true;
+            const size_t nIdx = nY * m_nXSize + nX;
+            return m_pafArray ? m_pafArray[nIdx] : m_padfArray[nIdx];
+        }
+    };
+
+    CArrayGeolocAccessor geolocXAccessor{};
+    CArrayGeolocAccessor geolocYAccessor{};
     CArrayAccessor<float> backMapXAccessor;
     CArrayAccessor<float> backMapYAccessor;
     CArrayAccessor<float> backMapWeightAccessor;
 
     explicit GDALGeoLocCArrayAccessors(GDALGeoLocTransformInfo *psTransform)
-        : m_psTransform(psTransform), geolocXAccessor(nullptr, 0),
-          geolocYAccessor(nullptr, 0), backMapXAccessor(nullptr, 0),
+        : m_psTransform(psTransform), backMapXAccessor(nullptr, 0),
           backMapYAccessor(nullptr, 0), backMapWeightAccessor(nullptr, 0)
     {
     }
@@ -89,6 +107,8 @@ class GDALGeoLocCArrayAccessors
         VSIFree(m_pafBackMapY);
         VSIFree(m_padfGeoLocX);
         VSIFree(m_padfGeoLocY);
+        VSIFree(m_pafGeoLocX);
+        VSIFree(m_pafGeoLocY);
         VSIFree(m_wgtsBackMap);
     }
 
@@ -99,6 +119,7 @@ class GDALGeoLocCArrayAccessors
     bool Load(bool bIsRegularGrid, bool bUseQuadtree);
 
     bool AllocateBackMap();
+    bool LoadBackMap(GDALDataset *poSrcDS);
 
     GDALDataset *GetBackmapDataset();
     static void FlushBackmapCaches()
@@ -157,6 +178,43 @@ bool GDALGeoLocCArrayAccessors::AllocateBackMap()
     return true;
 }
 
+/************************************************************************/
+/*                           LoadBackMap()                              */
+/************************************************************************/
+
+bool GDALGeoLocCArrayAccessors::LoadBackMap(GDALDataset *poSrcDS)
+{
+    const int nBMXSize = m_psTransform->nBackMapWidth;
+    const int nBMYSize = m_psTransform->nBackMapHeight;
+    m_pafBackMapX = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(nBMXSize, nBMYSize, sizeof(float)));
+    m_pafBackMapY = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(nBMXSize, nBMYSize, sizeof(float)));
+
+    if (m_pafBackMapX == nullptr || m_pafBackMapY == nullptr ||
+        poSrcDS->GetRasterBand(1)->RasterIO(
+            GF_Read, 0, 0, nBMXSize, nBMYSize, m_pafBackMapX, nBMXSize,
+            nBMYSize, GDT_Float32, 0, 0, nullptr) != CE_None ||
+        poSrcDS->GetRasterBand(2)->RasterIO(
+            GF_Read, 0, 0, nBMXSize, nBMYSize, m_pafBackMapY, nBMXSize,
+            nBMYSize, GDT_Float32, 0, 0, nullptr) != CE_None)
+    {
+        VSIFree(m_pafBackMapX);
+        m_pafBackMapX = nullptr;
+        VSIFree(m_pafBackMapY);
+        m_pafBackMapY = nullptr;
+        return false;
+    }
+
+    backMapXAccessor.m_array = m_pafBackMapX;
+    backMapXAccessor.m_nXSize = nBMXSize;
+
+    backMapYAccessor.m_array = m_pafBackMapY;
+    backMapYAccessor.m_nXSize = nBMXSize;
+
+    return true;
+}
+
 /************************************************************************/
 /*                         FreeWghtsBackMap()                           */
 /************************************************************************/
@@ -212,12 +270,25 @@ bool GDALGeoLocCArrayAccessors::LoadGeoloc(bool bIsRegularGrid)
     const int nXSize = m_psTransform->nGeoLocXSize;
     const int nYSize = m_psTransform->nGeoLocYSize;
 
-    m_padfGeoLocY = static_cast<double *>(
-        VSI_MALLOC3_VERBOSE(sizeof(double), nXSize, nYSize));
-    m_padfGeoLocX = static_cast<double *>(
-        VSI_MALLOC3_VERBOSE(sizeof(double), nXSize, nYSize));
+    // Halve the memory used by the geolocation arrays when they can be held
+    // as Float32 without loss.
+    const bool bFloat32 = GDALGeoLocHasFloat32Values(m_psTransform);
+    const GDALDataType eDT = bFloat32 ? GDT_Float32 : GDT_Float64;
+    const size_t nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    void *pGeoLocX = VSI_MALLOC3_VERBOSE(nDTSize, nXSize, nYSize);
+    void *pGeoLocY = VSI_MALLOC3_VERBOSE(nDTSize, nXSize, nYSize);
+    if (bFloat32)
+    {
+        m_pafGeoLocX = static_cast<float *>(pGeoLocX);
+        m_pafGeoLocY = static_cast<float *>(pGeoLocY);
+    }
+    else
+    {
+        m_padfGeoLocX = static_cast<double *>(pGeoLocX);
+        m_padfGeoLocY = static_cast<double *>(pGeoLocY);
+    }
 
-    if (m_padfGeoLocX == nullptr || m_padfGeoLocY == nullptr)
+    if (pGeoLocX == nullptr || pGeoLocY == nullptr)
     {
         return false;
     }
@@ -228,43 +299,45 @@ bool GDALGeoLocCArrayAccessors::LoadGeoloc(bool bIsRegularGrid)
         // The XBAND contains the x coordinates for all lines.
         // The YBAND contains the y coordinates for all columns.
 
-        double *padfTempX =
-            static_cast<double *>(VSI_MALLOC2_VERBOSE(nXSize, sizeof(double)));
-        double *padfTempY =
-            static_cast<double *>(VSI_MALLOC2_VERBOSE(nYSize, sizeof(double)));
-        if (padfTempX == nullptr || padfTempY == nullptr)
+        GByte *pabyTempX =
+            static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXSize, nDTSize));
+        GByte *pabyTempY =
+            static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nYSize, nDTSize));
+        if (pabyTempX == nullptr || pabyTempY == nullptr)
         {
-            CPLFree(padfTempX);
-            CPLFree(padfTempY);
+            CPLFree(pabyTempX);
+            CPLFree(pabyTempY);
             return false;
         }
 
         CPLErr eErr =
             GDALRasterIO(m_psTransform->hBand_X, GF_Read, 0, 0, nXSize, 1,
-                         padfTempX, nXSize, 1, GDT_Float64, 0, 0);
+                         pabyTempX, nXSize, 1, eDT, 0, 0);
 
         for (size_t j = 0; j < static_cast<size_t>(nYSize); j++)
         {
-            memcpy(m_padfGeoLocX + j * nXSize, padfTempX,
-                   nXSize * sizeof(double));
+            memcpy(static_cast<GByte *>(pGeoLocX) + j * nXSize * nDTSize,
+                   pabyTempX, nXSize * nDTSize);
         }
 
         if (eErr == CE_None)
         {
             eErr = GDALRasterIO(m_psTransform->hBand_Y, GF_Read, 0, 0, nYSize,
-                                1, padfTempY, nYSize, 1, GDT_Float64, 0, 0);
+                                1, pabyTempY, nYSize, 1, eDT, 0, 0);
 
             for (size_t j = 0; j < static_cast<size_t>(nYSize); j++)
             {
                 for (size_t i = 0; i < static_cast<size_t>(nXSize); i++)
                 {
-                    m_padfGeoLocY[j * nXSize + i] = padfTempY[j];
+                    memcpy(static_cast<GByte *>(pGeoLocY) +
+                               (j * nXSize + i) * nDTSize,
+                           pabyTempY + j * nDTSize, nDTSize);
                 }
             }
         }
 
-        CPLFree(padfTempX);
-        CPLFree(padfTempY);
+        CPLFree(pabyTempX);
+        CPLFree(pabyTempY);
 
         if (eErr != CE_None)
             return false;
@@ -272,18 +345,18 @@ bool GDALGeoLocCArrayAccessors::LoadGeoloc(bool bIsRegularGrid)
     else
     {
         if (GDALRasterIO(m_psTransform->hBand_X, GF_Read, 0, 0, nXSize, nYSize,
-                         m_padfGeoLocX, nXSize, nYSize, GDT_Float64, 0,
-                         0) != CE_None ||
+                         pGeoLocX, nXSize, nYSize, eDT, 0, 0) != CE_None ||
             GDALRasterIO(m_psTransform->hBand_Y, GF_Read, 0, 0, nXSize, nYSize,
-                         m_padfGeoLocY, nXSize, nYSize, GDT_Float64, 0,
-                         0) != CE_None)
+                         pGeoLocY, nXSize, nYSize, eDT, 0, 0) != CE_None)
             return false;
     }
 
-    geolocXAccessor.m_array = m_padfGeoLocX;
+    geolocXAccessor.m_padfArray = m_padfGeoLocX;
+    geolocXAccessor.m_pafArray = m_pafGeoLocX;
     geolocXAccessor.m_nXSize = m_psTransform->nGeoLocXSize;
 
-    geolocYAccessor.m_array = m_padfGeoLocY;
+    geolocYAccessor.m_padfArray = m_padfGeoLocY;
+    geolocYAccessor.m_pafArray = m_pafGeoLocY;
     geolocYAccessor.m_nXSize = m_psTransform->nGeoLocXSize;
 
     return GDALGeoLoc<GDALGeoLocCArrayAccessors>::LoadGeolocFinish(
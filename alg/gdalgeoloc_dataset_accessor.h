@@ -79,6 +79,7 @@ class GDALGeoLocDatasetAccessors
     bool Load(bool bIsRegularGrid, bool bUseQuadtree);
 
     bool AllocateBackMap();
+    bool LoadBackMap(GDALDataset *poSrcDS);
 
     GDALDataset *GetBackmapDataset();
     void FlushBackmapCaches();
@@ -148,6 +149,43 @@ bool GDALGeoLocDatasetAccessors::AllocateBackMap()
     return true;
 }
 
+/************************************************************************/
+/*                           LoadBackMap()                              */
+/************************************************************************/
+
+bool GDALGeoLocDatasetAccessors::LoadBackMap(GDALDataset *poSrcDS)
+{
+    auto poDriver = GDALDriver::FromHandle(GDALGetDriverByName("GTiff"));
+    if (poDriver == nullptr)
+        return false;
+
+    m_poBackmapTmpDataset = poDriver->Create(
+        CPLResetExtension(CPLGenerateTempFilename(nullptr), "tif"),
+        m_psTransform->nBackMapWidth, m_psTransform->nBackMapHeight, 2,
+        GDT_Float32, m_aosGTiffCreationOptions.List());
+    if (m_poBackmapTmpDataset == nullptr)
+    {
+        return false;
+    }
+    m_poBackmapTmpDataset->MarkSuppressOnClose();
+    VSIUnlink(m_poBackmapTmpDataset->GetDescription());
+
+    if (GDALDatasetCopyWholeRaster(
+            GDALDataset::ToHandle(poSrcDS),
+            GDALDataset::ToHandle(m_poBackmapTmpDataset), nullptr, nullptr,
+            nullptr) != CE_None)
+    {
+        delete m_poBackmapTmpDataset;
+        m_poBackmapTmpDataset = nullptr;
+        return false;
+    }
+
+    backMapXAccessor.SetBand(m_poBackmapTmpDataset->GetRasterBand(1));
+    backMapYAccessor.SetBand(m_poBackmapTmpDataset->GetRasterBand(2));
+
+    return true;
+}
+
 /************************************************************************/
 /*                         FreeWghtsBackMap()                           */
 /************************************************************************/
@@ -213,9 +251,14 @@ bool GDALGeoLocDatasetAccessors::LoadGeoloc(bool bIsRegularGrid)
         if (poDriver == nullptr)
             return false;
 
+        // Use Float32 when this can be done without loss, to halve the
+        // size of the temporary dataset.
         m_poGeolocTmpDataset = poDriver->Create(
             CPLResetExtension(CPLGenerateTempFilename(nullptr), "tif"), nXSize,
-            nYSize, 2, GDT_Float64, m_aosGTiffCreationOptions.List());
+            nYSize, 2,
+            GDALGeoLocHasFloat32Values(m_psTransform) ? GDT_Float32
+                                                      : GDT_Float64,
+            m_aosGTiffCreationOptions.List());
         if (m_poGeolocTmpDataset == nullptr)
         {
             return false;
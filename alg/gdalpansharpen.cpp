@@ -38,8 +38,10 @@
 #include <cstring>
 #include <limits>
 #include <new>
+#include <type_traits>
 
 #include "cpl_conv.h"
+#include "cpl_cpu_features.h"
 #include "cpl_error.h"
 #include "cpl_multiproc.h"
 #include "cpl_vsi.h"
@@ -528,6 +530,133 @@ GDALPansharpenOperation::Initialize(const GDALPansharpenOptions *psOptionsIn)
     return CE_None;
 }
 
+/************************************************************************/
+/*                       GetNoDataAndValidValue()                       */
+/************************************************************************/
+
+// Returns the nodata value in the working data type, and the value to which
+// pansharpened values equal to nodata must be mapped.
+template <class WorkDataType>
+static void GetNoDataAndValidValue(double dfNoData, WorkDataType &noData,
+                                   WorkDataType &validValue)
+{
+    GDALCopyWord(dfNoData, noData);
+
+    if (!(std::numeric_limits<WorkDataType>::is_integer))
+        validValue = static_cast<WorkDataType>(noData + 1e-5);
+    else if (noData == std::numeric_limits<WorkDataType>::min())
+        validValue = std::numeric_limits<WorkDataType>::min() + 1;
+    else
+        validValue = noData - 1;
+}
+
+/************************************************************************/
+/*                      WeightedBroveyVectorized()                      */
+/************************************************************************/
+
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+
+// Defined in gdalpansharpen_avx.cpp for the combinations of Byte, UInt16,
+// Int16, Float32 and Float64 working and output data types.
+template <class WorkDataType, class OutDataType>
+size_t GDALPansharpenWeightedBroveyAVX(
+    const WorkDataType *pPanBuffer,
+    const WorkDataType *pUpsampledSpectralBuffer, OutDataType *pDataBuf,
+    size_t nValues, size_t nBandValues, int nInputSpectralBands,
+    const double *padfWeights, int nOutPansharpenedBands,
+    const int *panOutPansharpenedBands, double dfMaxValue, bool bHasNoData,
+    double dfNoData, double dfValidValue);
+
+template <class T> struct GDALPansharpenHasAVXKernel : std::false_type
+{
+};
+
+template <> struct GDALPansharpenHasAVXKernel<GByte> : std::true_type
+{
+};
+
+template <> struct GDALPansharpenHasAVXKernel<GUInt16> : std::true_type
+{
+};
+
+template <> struct GDALPansharpenHasAVXKernel<GInt16> : std::true_type
+{
+};
+
+template <> struct GDALPansharpenHasAVXKernel<float> : std::true_type
+{
+};
+
+template <> struct GDALPansharpenHasAVXKernel<double> : std::true_type
+{
+};
+
+template <class WorkDataType, class OutDataType>
+static size_t
+WeightedBroveyAVX(const GDALPansharpenOptions *psOptions,
+                  const WorkDataType *pPanBuffer,
+                  const WorkDataType *pUpsampledSpectralBuffer,
+                  OutDataType *pDataBuf, size_t nValues, size_t nBandValues,
+                  WorkDataType nMaxValue, std::true_type)
+{
+    // As in gdalgrid.cpp, GDAL_USE_AVX=NO forces the use of the generic code.
+    if (!CPLHaveRuntimeAVX() ||
+        !CPLTestBool(CPLGetConfigOption("GDAL_USE_AVX", "YES")))
+        return 0;
+
+    WorkDataType noData = 0;
+    WorkDataType validValue = 0;
+    if (psOptions->bHasNoData)
+        GetNoDataAndValidValue(psOptions->dfNoData, noData, validValue);
+
+    return GDALPansharpenWeightedBroveyAVX(
+        pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues, nBandValues,
+        psOptions->nInputSpectralBands, psOptions->padfWeights,
+        psOptions->nOutPansharpenedBands, psOptions->panOutPansharpenedBands,
+        static_cast<double>(nMaxValue), CPL_TO_BOOL(psOptions->bHasNoData),
+        static_cast<double>(noData), static_cast<double>(validValue));
+}
+
+template <class WorkDataType, class OutDataType>
+static size_t WeightedBroveyAVX(const GDALPansharpenOptions *,
+                                const WorkDataType *, const WorkDataType *,
+                                OutDataType *, size_t, size_t, WorkDataType,
+                                std::false_type)
+{
+    return 0;
+}
+
+#endif
+
+// Processes the values that can be handled by a SIMD kernel selected at
+// runtime, and returns their number. The remaining values, at the end of the
+// buffer, must be processed by the caller. nMaxValue is the maximum value of
+// the bit depth, or 0 if no clamping must be done.
+template <class WorkDataType, class OutDataType>
+static size_t WeightedBroveyVectorized(
+    const GDALPansharpenOptions *psOptions, const WorkDataType *pPanBuffer,
+    const WorkDataType *pUpsampledSpectralBuffer, OutDataType *pDataBuf,
+    size_t nValues, size_t nBandValues, WorkDataType nMaxValue)
+{
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+    return WeightedBroveyAVX(
+        psOptions, pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
+        nBandValues, nMaxValue,
+        std::integral_constant<
+            bool, GDALPansharpenHasAVXKernel<WorkDataType>::value &&
+                      GDALPansharpenHasAVXKernel<OutDataType>::value>());
+#else
+    CPL_IGNORE_RET_VAL(psOptions);
+    CPL_IGNORE_RET_VAL(pPanBuffer);
+    CPL_IGNORE_RET_VAL(pUpsampledSpectralBuffer);
+    CPL_IGNORE_RET_VAL(pDataBuf);
+    CPL_IGNORE_RET_VAL(nValues);
+    CPL_IGNORE_RET_VAL(nBandValues);
+    CPL_IGNORE_RET_VAL(nMaxValue);
+    return 0;
+#endif
+}
+
 /************************************************************************/
 /*                    WeightedBroveyWithNoData()                        */
 /************************************************************************/
@@ -539,16 +668,13 @@ void GDALPansharpenOperation::WeightedBroveyWithNoData(
     size_t nValues, size_t nBandValues, WorkDataType nMaxValue) const
 {
     WorkDataType noData, validValue;
-    GDALCopyWord(psOptions->dfNoData, noData);
+    GetNoDataAndValidValue(psOptions->dfNoData, noData, validValue);
 
-    if (!(std::numeric_limits<WorkDataType>::is_integer))
-        validValue = static_cast<WorkDataType>(noData + 1e-5);
-    else if (noData == std::numeric_limits<WorkDataType>::min())
-        validValue = std::numeric_limits<WorkDataType>::min() + 1;
-    else
-        validValue = noData - 1;
+    const size_t nVectorizedValues = WeightedBroveyVectorized(
+        psOptions, pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
+        nBandValues, nMaxValue);
 
-    for (size_t j = 0; j < nValues; j++)
+    for (size_t j = nVectorizedValues; j < nValues; j++)
     {
         double dfPseudoPanchro = 0.0;
         for (int i = 0; i < psOptions->nInputSpectralBands; i++)
@@ -632,7 +758,12 @@ void GDALPansharpenOperation::WeightedBrovey3(
         return;
     }
 
-    for (size_t j = 0; j < nValues; j++)
+    const size_t nVectorizedValues = WeightedBroveyVectorized(
+        psOptions, pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
+        nBandValues,
+        bHasBitDepth ? nMaxValue : static_cast<WorkDataType>(0));
+
+    for (size_t j = nVectorizedValues; j < nValues; j++)
     {
         double dfFactor = 0.0;
         // if( pPanBuffer[j] == 0 )
@@ -814,8 +945,11 @@ void GDALPansharpenOperation::WeightedBroveyPositiveWeights(
 
     if (nMaxValue == 0)
         nMaxValue = std::numeric_limits<T>::max();
-    size_t j;
-    if (psOptions->nInputSpectralBands == 3 &&
+    // The AVX kernel, when available, handles any band configuration.
+    size_t j = WeightedBroveyVectorized(psOptions, pPanBuffer,
+                                        pUpsampledSpectralBuffer, pDataBuf,
+                                        nValues, nBandValues, nMaxValue);
+    if (j == 0 && psOptions->nInputSpectralBands == 3 &&
         psOptions->nOutPansharpenedBands == 3 &&
         psOptions->panOutPansharpenedBands[0] == 0 &&
         psOptions->panOutPansharpenedBands[1] == 1 &&
@@ -825,7 +959,7 @@ void GDALPansharpenOperation::WeightedBroveyPositiveWeights(
             pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
             nBandValues, nMaxValue);
     }
-    else if (psOptions->nInputSpectralBands == 4 &&
+    else if (j == 0 && psOptions->nInputSpectralBands == 4 &&
              psOptions->nOutPansharpenedBands == 4 &&
              psOptions->panOutPansharpenedBands[0] == 0 &&
              psOptions->panOutPansharpenedBands[1] == 1 &&
@@ -836,7 +970,7 @@ void GDALPansharpenOperation::WeightedBroveyPositiveWeights(
             pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
             nBandValues, nMaxValue);
     }
-    else if (psOptions->nInputSpectralBands == 4 &&
+    else if (j == 0 && psOptions->nInputSpectralBands == 4 &&
              psOptions->nOutPansharpenedBands == 3 &&
              psOptions->panOutPansharpenedBands[0] == 0 &&
              psOptions->panOutPansharpenedBands[1] == 1 &&
@@ -848,7 +982,7 @@ void GDALPansharpenOperation::WeightedBroveyPositiveWeights(
     }
     else
     {
-        for (j = 0; j + 1 < nValues; j += 2)
+        for (; j + 1 < nValues; j += 2)
         {
             double dfFactor = 0.0;
             double dfFactor2 = 0.0;
@@ -1140,6 +1274,45 @@ static void ClampValues(T *panBuffer, size_t nValues, T nMaxVal)
     }
 }
 
+/************************************************************************/
+/*                        ClampSpectralValues()                         */
+/************************************************************************/
+
+// Clamps to nBitDepth the first nValues values of each band of
+// panBandsToClamp[] in the upsampled spectral buffer, whose band stride
+// is nBandValues.
+static void ClampSpectralValues(GDALDataType eWorkDataType,
+                                GByte *pUpsampledSpectralBuffer, size_t nValues,
+                                size_t nBandValues, const int *panBandsToClamp,
+                                int nBandsToClamp, int nBitDepth)
+{
+    for (int iBand = 0; iBand < nBandsToClamp; iBand++)
+    {
+        const size_t nOffset =
+            static_cast<size_t>(panBandsToClamp[iBand]) * nBandValues;
+        if (eWorkDataType == GDT_Byte)
+        {
+            ClampValues(reinterpret_cast<GByte *>(pUpsampledSpectralBuffer) +
+                            nOffset,
+                        nValues, static_cast<GByte>((1 << nBitDepth) - 1));
+        }
+        else if (eWorkDataType == GDT_UInt16)
+        {
+            ClampValues(reinterpret_cast<GUInt16 *>(pUpsampledSpectralBuffer) +
+                            nOffset,
+                        nValues, static_cast<GUInt16>((1 << nBitDepth) - 1));
+        }
+#ifndef LIMIT_TYPES
+        else if (eWorkDataType == GDT_UInt32)
+        {
+            ClampValues(reinterpret_cast<GUInt32 *>(pUpsampledSpectralBuffer) +
+                            nOffset,
+                        nValues, static_cast<GUInt32>((1 << nBitDepth) - 1));
+        }
+#endif
+    }
+}
+
 /************************************************************************/
 /*                         ProcessRegion()                              */
 /************************************************************************/
@@ -1236,6 +1409,55 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
     if (nSpectralYSize == 0)
         nSpectralYSize = 1;
 
+    // In case NBITS was not set on the spectral bands, clamp the values
+    // if overshoot might have occurred.
+    const int nBitDepth = psOptions->nBitDepth;
+    std::vector<int> anBandsToClamp;
+    if (nBitDepth &&
+        (eResampleAlg == GRIORA_Cubic || eResampleAlg == GRIORA_CubicSpline ||
+         eResampleAlg == GRIORA_Lanczos))
+    {
+        for (int i = 0; i < psOptions->nInputSpectralBands; i++)
+        {
+            GDALRasterBand *poBand = aMSBands[i];
+            int nBandBitDepth = 0;
+            const char *pszNBITS =
+                poBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
+            if (pszNBITS)
+                nBandBitDepth = atoi(pszNBITS);
+            if (nBandBitDepth < nBitDepth)
+                anBandsToClamp.push_back(i);
+        }
+    }
+
+    GUInt32 nMaxValue = (1 << nBitDepth) - 1;
+
+    double *padfTempBuffer = nullptr;
+    GDALDataType eBufDataTypeOri = eBufDataType;
+    void *pDataBufOri = pDataBuf;
+    // CFloat64 is the query type used by gdallocationinfo...
+#ifdef LIMIT_TYPES
+    if (eBufDataType != GDT_Byte && eBufDataType != GDT_UInt16)
+#else
+    if (eBufDataType == GDT_CFloat64)
+#endif
+    {
+        padfTempBuffer = static_cast<double *>(VSI_MALLOC3_VERBOSE(
+            nXSize, nYSize, psOptions->nOutPansharpenedBands * sizeof(double)));
+        if (padfTempBuffer == nullptr)
+        {
+            VSIFree(pUpsampledSpectralBuffer);
+            VSIFree(pPanBuffer);
+            return CE_Failure;
+        }
+        pDataBuf = padfTempBuffer;
+        eBufDataType = GDT_Float64;
+    }
+
+    // Set when upsampling, clamping and pansharpening have been done
+    // together by each thread.
+    bool bPansharpeningDone = false;
+
     // When upsampling, extract the multispectral data at
     // full resolution in a temp buffer, and then do the upsampling.
     if (nSpectralXSize < nXSize && nSpectralYSize < nYSize &&
@@ -1267,6 +1489,7 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
             psOptions->nInputSpectralBands * nDataTypeSize));
         if (pSpectralBuffer == nullptr)
         {
+            VSIFree(padfTempBuffer);
             VSIFree(pUpsampledSpectralBuffer);
             VSIFree(pPanBuffer);
             return CE_Failure;
@@ -1297,6 +1520,7 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
         if (eErr != CE_None)
         {
             VSIFree(pSpectralBuffer);
+            VSIFree(padfTempBuffer);
             VSIFree(pUpsampledSpectralBuffer);
             VSIFree(pPanBuffer);
             return CE_Failure;
@@ -1352,9 +1576,11 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
                 poMEMDS->GetRasterBand(i + 1)->GetMaskFlags();
             }
 
-            std::vector<GDALPansharpenResampleJob> asJobs;
+            // Each job upsamples its range of lines, and pansharpens them
+            // right away, while they are still in the CPU caches.
+            std::vector<GDALPansharpenFusedJob> asJobs;
             asJobs.resize(nTasks);
-            GDALPansharpenResampleJob *pasJobs = &(asJobs[0]);
+            GDALPansharpenFusedJob *pasJobs = &(asJobs[0]);
             {
                 std::vector<void *> ahJobData;
                 ahJobData.resize(nTasks);
@@ -1368,59 +1594,94 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
                         (static_cast<size_t>(i) * nYSize) / nTasks;
                     const size_t iNextStartLine =
                         (static_cast<size_t>(i + 1) * nYSize) / nTasks;
-                    pasJobs[i].poMEMDS = poMEMDS;
-                    pasJobs[i].eResampleAlg = eResampleAlg;
-                    pasJobs[i].dfXOff = sExtraArg.dfXOff - nXOffExtract;
-                    pasJobs[i].dfYOff =
+                    GDALPansharpenResampleJob &sResampleJob =
+                        pasJobs[i].sResampleJob;
+                    sResampleJob.poMEMDS = poMEMDS;
+                    sResampleJob.eResampleAlg = eResampleAlg;
+                    sResampleJob.dfXOff = sExtraArg.dfXOff - nXOffExtract;
+                    sResampleJob.dfYOff =
                         m_adfPanToMSGT[3] +
                         (nYOff + iStartLine) * m_adfPanToMSGT[5] - nYOffExtract;
-                    pasJobs[i].dfXSize = sExtraArg.dfXSize;
-                    pasJobs[i].dfYSize =
+                    sResampleJob.dfXSize = sExtraArg.dfXSize;
+                    sResampleJob.dfYSize =
                         (iNextStartLine - iStartLine) * m_adfPanToMSGT[5];
-                    if (pasJobs[i].dfXOff + pasJobs[i].dfXSize >
+                    if (sResampleJob.dfXOff + sResampleJob.dfXSize >
                         aMSBands[0]->GetXSize())
                     {
-                        pasJobs[i].dfXOff =
-                            aMSBands[0]->GetXSize() - pasJobs[i].dfXSize;
+                        sResampleJob.dfXOff =
+                            aMSBands[0]->GetXSize() - sResampleJob.dfXSize;
                     }
-                    if (pasJobs[i].dfYOff + pasJobs[i].dfYSize >
+                    if (sResampleJob.dfYOff + sResampleJob.dfYSize >
                         aMSBands[0]->GetYSize())
                     {
-                        pasJobs[i].dfYOff =
-                            aMSBands[0]->GetYSize() - pasJobs[i].dfYSize;
+                        sResampleJob.dfYOff =
+                            aMSBands[0]->GetYSize() - sResampleJob.dfYSize;
                     }
-                    pasJobs[i].nXOff = static_cast<int>(pasJobs[i].dfXOff);
-                    pasJobs[i].nYOff = static_cast<int>(pasJobs[i].dfYOff);
-                    pasJobs[i].nXSize =
-                        static_cast<int>(0.4999 + pasJobs[i].dfXSize);
-                    pasJobs[i].nYSize =
-                        static_cast<int>(0.4999 + pasJobs[i].dfYSize);
-                    if (pasJobs[i].nXSize == 0)
-                        pasJobs[i].nXSize = 1;
-                    if (pasJobs[i].nYSize == 0)
-                        pasJobs[i].nYSize = 1;
-                    pasJobs[i].pBuffer = pUpsampledSpectralBuffer +
-                                         static_cast<size_t>(iStartLine) *
-                                             nXSize * nDataTypeSize;
-                    pasJobs[i].eDT = eWorkDataType;
-                    pasJobs[i].nBufXSize = nXSize;
-                    pasJobs[i].nBufYSize =
+                    sResampleJob.nXOff = static_cast<int>(sResampleJob.dfXOff);
+                    sResampleJob.nYOff = static_cast<int>(sResampleJob.dfYOff);
+                    sResampleJob.nXSize =
+                        static_cast<int>(0.4999 + sResampleJob.dfXSize);
+                    sResampleJob.nYSize =
+                        static_cast<int>(0.4999 + sResampleJob.dfYSize);
+                    if (sResampleJob.nXSize == 0)
+                        sResampleJob.nXSize = 1;
+                    if (sResampleJob.nYSize == 0)
+                        sResampleJob.nYSize = 1;
+                    sResampleJob.pBuffer = pUpsampledSpectralBuffer +
+                                           static_cast<size_t>(iStartLine) *
+                                               nXSize * nDataTypeSize;
+                    sResampleJob.eDT = eWorkDataType;
+                    sResampleJob.nBufXSize = nXSize;
+                    sResampleJob.nBufYSize =
                         static_cast<int>(iNextStartLine - iStartLine);
-                    pasJobs[i].nBandCount = psOptions->nInputSpectralBands;
-                    pasJobs[i].nBandSpace =
+                    sResampleJob.nBandCount = psOptions->nInputSpectralBands;
+                    sResampleJob.nBandSpace =
                         static_cast<GSpacing>(nXSize) * nYSize * nDataTypeSize;
+
+                    pasJobs[i].panBandsToClamp = anBandsToClamp.data();
+                    pasJobs[i].nBandsToClamp =
+                        static_cast<int>(anBandsToClamp.size());
+                    pasJobs[i].nBitDepth = nBitDepth;
+
+                    GDALPansharpenJob &sPansharpenJob =
+                        pasJobs[i].sPansharpenJob;
+                    sPansharpenJob.poPansharpenOperation = this;
+                    sPansharpenJob.eWorkDataType = eWorkDataType;
+                    sPansharpenJob.eBufDataType = eBufDataType;
+                    sPansharpenJob.pPanBuffer =
+                        pPanBuffer + iStartLine * nXSize * nDataTypeSize;
+                    sPansharpenJob.pUpsampledSpectralBuffer =
+                        sResampleJob.pBuffer;
+                    sPansharpenJob.pDataBuf =
+                        static_cast<GByte *>(pDataBuf) +
+                        iStartLine * nXSize *
+                            GDALGetDataTypeSizeBytes(eBufDataType);
+                    sPansharpenJob.nValues =
+                        (iNextStartLine - iStartLine) * nXSize;
+                    sPansharpenJob.nBandValues =
+                        static_cast<size_t>(nXSize) * nYSize;
+                    sPansharpenJob.nMaxValue = nMaxValue;
 #ifdef DEBUG_TIMING
-                    pasJobs[i].ptv = &tv;
+                    sResampleJob.ptv = &tv;
+                    sPansharpenJob.ptv = &tv;
 #endif
                     ahJobData[i] = &(pasJobs[i]);
                 }
 #ifdef DEBUG_TIMING
                 gettimeofday(&tv, nullptr);
 #endif
-                poThreadPool->SubmitJobs(PansharpenResampleJobThreadFunc,
+                poThreadPool->SubmitJobs(PansharpenFusedJobThreadFunc,
                                          ahJobData);
                 poThreadPool->WaitCompletion();
             }
+
+            eErr = CE_None;
+            for (int i = 0; i < nTasks; i++)
+            {
+                if (pasJobs[i].sPansharpenJob.eErr != CE_None)
+                    eErr = CE_Failure;
+            }
+            bPansharpeningDone = true;
         }
 
         GDALClose(poMEMDS);
@@ -1453,140 +1714,87 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
         }
         if (eErr != CE_None)
         {
+            VSIFree(padfTempBuffer);
             VSIFree(pUpsampledSpectralBuffer);
             VSIFree(pPanBuffer);
             return CE_Failure;
         }
     }
 
-    // In case NBITS was not set on the spectral bands, clamp the values
-    // if overshoot might have occurred.
-    int nBitDepth = psOptions->nBitDepth;
-    if (nBitDepth &&
-        (eResampleAlg == GRIORA_Cubic || eResampleAlg == GRIORA_CubicSpline ||
-         eResampleAlg == GRIORA_Lanczos))
+    if (!bPansharpeningDone)
     {
-        for (int i = 0; i < psOptions->nInputSpectralBands; i++)
+        if (!anBandsToClamp.empty())
         {
-            GDALRasterBand *poBand = aMSBands[i];
-            int nBandBitDepth = 0;
-            const char *pszNBITS =
-                poBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
-            if (pszNBITS)
-                nBandBitDepth = atoi(pszNBITS);
-            if (nBandBitDepth < nBitDepth)
-            {
-                if (eWorkDataType == GDT_Byte)
-                {
-                    ClampValues(
-                        reinterpret_cast<GByte *>(pUpsampledSpectralBuffer) +
-                            static_cast<size_t>(i) * nXSize * nYSize,
-                        static_cast<size_t>(nXSize) * nYSize,
-                        static_cast<GByte>((1 << nBitDepth) - 1));
-                }
-                else if (eWorkDataType == GDT_UInt16)
-                {
-                    ClampValues(
-                        reinterpret_cast<GUInt16 *>(pUpsampledSpectralBuffer) +
-                            static_cast<size_t>(i) * nXSize * nYSize,
-                        static_cast<size_t>(nXSize) * nYSize,
-                        static_cast<GUInt16>((1 << nBitDepth) - 1));
-                }
-#ifndef LIMIT_TYPES
-                else if (eWorkDataType == GDT_UInt32)
-                {
-                    ClampValues(reinterpret_cast<GUInt32*>(pUpsampledSpectralBuffer) +
-                                static_cast<size_t>(i) * nXSize * nYSize,
-                                static_cast<size_t>(nXSize)*nYSize,
-                                (static_cast<GUInt32>((1 << nBitDepth)-1));
-                }
-#endif
-            }
+            ClampSpectralValues(eWorkDataType, pUpsampledSpectralBuffer,
+                                static_cast<size_t>(nXSize) * nYSize,
+                                static_cast<size_t>(nXSize) * nYSize,
+                                anBandsToClamp.data(),
+                                static_cast<int>(anBandsToClamp.size()),
+                                nBitDepth);
         }
-    }
-
-    GUInt32 nMaxValue = (1 << nBitDepth) - 1;
 
-    double *padfTempBuffer = nullptr;
-    GDALDataType eBufDataTypeOri = eBufDataType;
-    void *pDataBufOri = pDataBuf;
-    // CFloat64 is the query type used by gdallocationinfo...
-#ifdef LIMIT_TYPES
-    if (eBufDataType != GDT_Byte && eBufDataType != GDT_UInt16)
-#else
-    if (eBufDataType == GDT_CFloat64)
-#endif
-    {
-        padfTempBuffer = static_cast<double *>(VSI_MALLOC3_VERBOSE(
-            nXSize, nYSize, psOptions->nOutPansharpenedBands * sizeof(double)));
-        if (padfTempBuffer == nullptr)
-        {
-            VSIFree(pUpsampledSpectralBuffer);
-            VSIFree(pPanBuffer);
-            return CE_Failure;
-        }
-        pDataBuf = padfTempBuffer;
-        eBufDataType = GDT_Float64;
-    }
-
-    if (nTasks > 1)
-    {
-        std::vector<GDALPansharpenJob> asJobs;
-        asJobs.resize(nTasks);
-        GDALPansharpenJob *pasJobs = &(asJobs[0]);
+        if (nTasks > 1)
         {
-            std::vector<void *> ahJobData;
-            ahJobData.resize(nTasks);
+            std::vector<GDALPansharpenJob> asJobs;
+            asJobs.resize(nTasks);
+            GDALPansharpenJob *pasJobs = &(asJobs[0]);
+            {
+                std::vector<void *> ahJobData;
+                ahJobData.resize(nTasks);
 #ifdef DEBUG_TIMING
-            struct timeval tv;
+                struct timeval tv;
 #endif
-            for (int i = 0; i < nTasks; i++)
-            {
-                const size_t iStartLine =
-                    (static_cast<size_t>(i) * nYSize) / nTasks;
-                const size_t iNextStartLine =
-                    (static_cast<size_t>(i + 1) * nYSize) / nTasks;
-                pasJobs[i].poPansharpenOperation = this;
-                pasJobs[i].eWorkDataType = eWorkDataType;
-                pasJobs[i].eBufDataType = eBufDataType;
-                pasJobs[i].pPanBuffer =
-                    pPanBuffer + iStartLine * nXSize * nDataTypeSize;
-                pasJobs[i].pUpsampledSpectralBuffer =
-                    pUpsampledSpectralBuffer +
-                    iStartLine * nXSize * nDataTypeSize;
-                pasJobs[i].pDataBuf =
-                    static_cast<GByte *>(pDataBuf) +
-                    iStartLine * nXSize *
-                        GDALGetDataTypeSizeBytes(eBufDataType);
-                pasJobs[i].nValues = (iNextStartLine - iStartLine) * nXSize;
-                pasJobs[i].nBandValues = static_cast<size_t>(nXSize) * nYSize;
-                pasJobs[i].nMaxValue = nMaxValue;
+                for (int i = 0; i < nTasks; i++)
+                {
+                    const size_t iStartLine =
+                        (static_cast<size_t>(i) * nYSize) / nTasks;
+                    const size_t iNextStartLine =
+                        (static_cast<size_t>(i + 1) * nYSize) / nTasks;
+                    pasJobs[i].poPansharpenOperation = this;
+                    pasJobs[i].eWorkDataType = eWorkDataType;
+                    pasJobs[i].eBufDataType = eBufDataType;
+                    pasJobs[i].pPanBuffer =
+                        pPanBuffer + iStartLine * nXSize * nDataTypeSize;
+                    pasJobs[i].pUpsampledSpectralBuffer =
+                        pUpsampledSpectralBuffer +
+                        iStartLine * nXSize * nDataTypeSize;
+                    pasJobs[i].pDataBuf =
+                        static_cast<GByte *>(pDataBuf) +
+                        iStartLine * nXSize *
+                            GDALGetDataTypeSizeBytes(eBufDataType);
+                    pasJobs[i].nValues =
+                        (iNextStartLine - iStartLine) * nXSize;
+                    pasJobs[i].nBandValues =
+                        static_cast<size_t>(nXSize) * nYSize;
+                    pasJobs[i].nMaxValue = nMaxValue;
 #ifdef DEBUG_TIMING
-                pasJobs[i].ptv = &tv;
+                    pasJobs[i].ptv = &tv;
 #endif
-                ahJobData[i] = &(pasJobs[i]);
-            }
+                    ahJobData[i] = &(pasJobs[i]);
+                }
 #ifdef DEBUG_TIMING
-            gettimeofday(&tv, nullptr);
+                gettimeofday(&tv, nullptr);
 #endif
-            poThreadPool->SubmitJobs(PansharpenJobThreadFunc, ahJobData);
-            poThreadPool->WaitCompletion();
-        }
+                poThreadPool->SubmitJobs(PansharpenJobThreadFunc, ahJobData);
+                poThreadPool->WaitCompletion();
+            }
 
-        eErr = CE_None;
-        for (int i = 0; i < nTasks; i++)
+            eErr = CE_None;
+            for (int i = 0; i < nTasks; i++)
+            {
+                if (pasJobs[i].eErr != CE_None)
+                    eErr = CE_Failure;
+            }
+        }
+        else
         {
-            if (pasJobs[i].eErr != CE_None)
-                eErr = CE_Failure;
+            eErr = PansharpenChunk(eWorkDataType, eBufDataType, pPanBuffer,
+                                   pUpsampledSpectralBuffer, pDataBuf,
+                                   static_cast<size_t>(nXSize) * nYSize,
+                                   static_cast<size_t>(nXSize) * nYSize,
+                                   nMaxValue);
         }
     }
-    else
-    {
-        eErr = PansharpenChunk(eWorkDataType, eBufDataType, pPanBuffer,
-                               pUpsampledSpectralBuffer, pDataBuf,
-                               static_cast<size_t>(nXSize) * nYSize,
-                               static_cast<size_t>(nXSize) * nYSize, nMaxValue);
-    }
 
     if (padfTempBuffer)
     {
@@ -1657,6 +1865,29 @@ void GDALPansharpenOperation::PansharpenResampleJobThreadFunc(void *pUserData)
 #endif
 }
 
+/************************************************************************/
+/*                    PansharpenFusedJobThreadFunc()                    */
+/************************************************************************/
+
+void GDALPansharpenOperation::PansharpenFusedJobThreadFunc(void *pUserData)
+{
+    GDALPansharpenFusedJob *psJob =
+        static_cast<GDALPansharpenFusedJob *>(pUserData);
+
+    PansharpenResampleJobThreadFunc(&(psJob->sResampleJob));
+
+    if (psJob->nBandsToClamp > 0)
+    {
+        ClampSpectralValues(
+            psJob->sPansharpenJob.eWorkDataType,
+            static_cast<GByte *>(psJob->sResampleJob.pBuffer),
+            psJob->sPansharpenJob.nValues, psJob->sPansharpenJob.nBandValues,
+            psJob->panBandsToClamp, psJob->nBandsToClamp, psJob->nBitDepth);
+    }
+
+    PansharpenJobThreadFunc(&(psJob->sPansharpenJob));
+}
+
 /************************************************************************/
 /*                      PansharpenJobThreadFunc()                       */
 /************************************************************************/
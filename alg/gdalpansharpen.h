@@ -180,6 +180,16 @@ typedef struct
     struct timeval *ptv;
 #endif
 } GDALPansharpenResampleJob;
+
+// Upsampling, clamping and pansharpening of a range of lines
+typedef struct
+{
+    GDALPansharpenResampleJob sResampleJob;
+    const int *panBandsToClamp;
+    int nBandsToClamp;
+    int nBitDepth;
+    GDALPansharpenJob sPansharpenJob;
+} GDALPansharpenFusedJob;
 //! @endcond
 
 /** Pansharpening operation class.
@@ -200,6 +210,7 @@ class GDALPansharpenOperation
 
     static void PansharpenJobThreadFunc(void *pUserData);
     static void PansharpenResampleJobThreadFunc(void *pUserData);
+    static void PansharpenFusedJobThreadFunc(void *pUserData);
 
     template <class WorkDataType, class OutDataType>
     void WeightedBroveyWithNoData(const WorkDataType *pPanBuffer,
@@ -0,0 +1,340 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Pansharpening module
+ * Purpose:  AVX implementation of the weighted Brovey pansharpening kernels
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// This file is compiled with AVX enabled, and its functions must only be
+// called after having checked CPLHaveRuntimeAVX(). Consequently it must not
+// instantiate inline functions or templates that are also used by other
+// translation units (such as GDALCopyWord()), since the linker could pick
+// the AVX version of them.
+
+#include "cpl_port.h"
+
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+#include <immintrin.h>
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+CPL_CVSID("$Id$")
+
+namespace
+{
+
+/************************************************************************/
+/*                        ConvertToInteger()                            */
+/************************************************************************/
+
+// Same as GDALCopyWord() from double to an integer type whose range is
+// [min, max]: NaN is mapped to 0, and values are rounded half away from zero
+// and clamped to [min, max]. The result is kept as a double.
+static inline __m256d ConvertToInteger(__m256d val, __m256d min, __m256d max)
+{
+    const __m256d half = _mm256_or_pd(
+        _mm256_and_pd(val, _mm256_set1_pd(-0.0)), _mm256_set1_pd(0.5));
+    val = _mm256_add_pd(val, half);
+    val = _mm256_andnot_pd(_mm256_cmp_pd(val, val, _CMP_UNORD_Q), val);
+    val = _mm256_min_pd(_mm256_max_pd(val, min), max);
+    return _mm256_round_pd(val, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+}
+
+/************************************************************************/
+/*                         ConvertToFloat()                             */
+/************************************************************************/
+
+// Same as GDALCopyWord() from double to float: values out of the range of
+// float are mapped to infinity. The result is kept as a double.
+static inline __m256d ConvertToFloat(__m256d val)
+{
+    const __m256d fltMax = _mm256_set1_pd(std::numeric_limits<float>::max());
+    const __m256d inf = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m256d res = _mm256_cvtps_pd(_mm256_cvtpd_ps(val));
+    res = _mm256_blendv_pd(res, inf, _mm256_cmp_pd(val, fltMax, _CMP_GT_OQ));
+    res = _mm256_blendv_pd(
+        res, _mm256_sub_pd(_mm256_setzero_pd(), inf),
+        _mm256_cmp_pd(val, _mm256_sub_pd(_mm256_setzero_pd(), fltMax),
+                      _CMP_LT_OQ));
+    return res;
+}
+
+/************************************************************************/
+/*                       PansharpenAVXType<T>                           */
+/************************************************************************/
+
+// Load/store of 4 values of the supported data types, converted from/to
+// double. FromDouble() does the same conversion as GDALCopyWord() from
+// double, but keeps the result as a double. Values passed to Store() must
+// have been converted with FromDouble().
+template <class T> struct PansharpenAVXType
+{
+};
+
+template <> struct PansharpenAVXType<GByte>
+{
+    static constexpr bool IS_INTEGER = true;
+    static constexpr double MIN_VALUE = 0.0;
+    static constexpr double MAX_VALUE = 255.0;
+
+    static inline __m256d Load(const GByte *ptr)
+    {
+        GInt32 nVal;
+        memcpy(&nVal, ptr, sizeof(nVal));
+        return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(nVal)));
+    }
+
+    static inline __m256d FromDouble(__m256d val)
+    {
+        return ConvertToInteger(val, _mm256_set1_pd(MIN_VALUE),
+                                _mm256_set1_pd(MAX_VALUE));
+    }
+
+    static inline void Store(__m256d val, GByte *ptr)
+    {
+        __m128i xmm_i = _mm256_cvttpd_epi32(val);
+        xmm_i = _mm_packus_epi32(xmm_i, xmm_i);
+        xmm_i = _mm_packus_epi16(xmm_i, xmm_i);
+        const GInt32 nVal = _mm_cvtsi128_si32(xmm_i);
+        memcpy(ptr, &nVal, sizeof(nVal));
+    }
+};
+
+template <> struct PansharpenAVXType<GUInt16>
+{
+    static constexpr bool IS_INTEGER = true;
+    static constexpr double MIN_VALUE = 0.0;
+    static constexpr double MAX_VALUE = 65535.0;
+
+    static inline __m256d Load(const GUInt16 *ptr)
+    {
+        const __m128i xmm_i =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(ptr));
+        return _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(xmm_i));
+    }
+
+    static inline __m256d FromDouble(__m256d val)
+    {
+        return ConvertToInteger(val, _mm256_set1_pd(MIN_VALUE),
+                                _mm256_set1_pd(MAX_VALUE));
+    }
+
+    static inline void Store(__m256d val, GUInt16 *ptr)
+    {
+        __m128i xmm_i = _mm256_cvttpd_epi32(val);
+        xmm_i = _mm_packus_epi32(xmm_i, xmm_i);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(ptr), xmm_i);
+    }
+};
+
+template <> struct PansharpenAVXType<GInt16>
+{
+    static constexpr bool IS_INTEGER = true;
+    static constexpr double MIN_VALUE = -32768.0;
+    static constexpr double MAX_VALUE = 32767.0;
+
+    static inline __m256d Load(const GInt16 *ptr)
+    {
+        const __m128i xmm_i =
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(ptr));
+        return _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(xmm_i));
+    }
+
+    static inline __m256d FromDouble(__m256d val)
+    {
+        return ConvertToInteger(val, _mm256_set1_pd(MIN_VALUE),
+                                _mm256_set1_pd(MAX_VALUE));
+    }
+
+    static inline void Store(__m256d val, GInt16 *ptr)
+    {
+        __m128i xmm_i = _mm256_cvttpd_epi32(val);
+        xmm_i = _mm_packs_epi32(xmm_i, xmm_i);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(ptr), xmm_i);
+    }
+};
+
+template <> struct PansharpenAVXType<float>
+{
+    static constexpr bool IS_INTEGER = false;
+    static constexpr double MIN_VALUE = 0.0;  // unused
+    static constexpr double MAX_VALUE = 0.0;  // unused
+
+    static inline __m256d Load(const float *ptr)
+    {
+        return _mm256_cvtps_pd(_mm_loadu_ps(ptr));
+    }
+
+    static inline __m256d FromDouble(__m256d val)
+    {
+        return ConvertToFloat(val);
+    }
+
+    static inline void Store(__m256d val, float *ptr)
+    {
+        _mm_storeu_ps(ptr, _mm256_cvtpd_ps(val));
+    }
+};
+
+template <> struct PansharpenAVXType<double>
+{
+    static constexpr bool IS_INTEGER = false;
+    static constexpr double MIN_VALUE = 0.0;  // unused
+    static constexpr double MAX_VALUE = 0.0;  // unused
+
+    static inline __m256d Load(const double *ptr)
+    {
+        return _mm256_loadu_pd(ptr);
+    }
+
+    static inline __m256d FromDouble(__m256d val)
+    {
+        return val;
+    }
+
+    static inline void Store(__m256d val, double *ptr)
+    {
+        _mm256_storeu_pd(ptr, val);
+    }
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                   GDALPansharpenWeightedBroveyAVX()                  */
+/************************************************************************/
+
+// Weighted Brovey kernel, processing 4 pixels at a time. Returns the number of
+// pixels processed (a multiple of 4), the remaining ones being left to the
+// caller.
+// dfMaxValue is the maximum value of the bit depth (0 if not applicable).
+// dfNoData and dfValidValue are only used if bHasNoData, and must be
+// representable in WorkDataType. Results are the same as the ones of the
+// generic C++ code.
+template <class WorkDataType, class OutDataType>
+size_t GDALPansharpenWeightedBroveyAVX(
+    const WorkDataType *pPanBuffer,
+    const WorkDataType *pUpsampledSpectralBuffer, OutDataType *pDataBuf,
+    size_t nValues, size_t nBandValues, int nInputSpectralBands,
+    const double *padfWeights, int nOutPansharpenedBands,
+    const int *panOutPansharpenedBands, double dfMaxValue, bool bHasNoData,
+    double dfNoData, double dfValidValue)
+{
+    typedef PansharpenAVXType<WorkDataType> WorkType;
+    typedef PansharpenAVXType<OutDataType> OutType;
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d outMin = _mm256_set1_pd(OutType::MIN_VALUE);
+    const __m256d outMax = _mm256_set1_pd(OutType::MAX_VALUE);
+    const __m256d maxValue = _mm256_set1_pd(dfMaxValue);
+    const __m256d noData = _mm256_set1_pd(dfNoData);
+    const __m256d validValue = _mm256_set1_pd(dfValidValue);
+
+    size_t j = 0;  // Used after for.
+    for (; j + 3 < nValues; j += 4)
+    {
+        __m256d pseudoPanchro = zero;
+        __m256d invalid = zero;
+        for (int i = 0; i < nInputSpectralBands; i++)
+        {
+            const __m256d val =
+                WorkType::Load(pUpsampledSpectralBuffer + i * nBandValues + j);
+            if (bHasNoData)
+                invalid = _mm256_or_pd(invalid,
+                                       _mm256_cmp_pd(val, noData, _CMP_EQ_OQ));
+            pseudoPanchro = _mm256_add_pd(
+                pseudoPanchro,
+                _mm256_mul_pd(_mm256_set1_pd(padfWeights[i]), val));
+        }
+
+        const __m256d pan = WorkType::Load(pPanBuffer + j);
+        const __m256d pseudoPanchroIsZero =
+            _mm256_cmp_pd(pseudoPanchro, zero, _CMP_EQ_OQ);
+        const __m256d factor = _mm256_andnot_pd(
+            pseudoPanchroIsZero, _mm256_div_pd(pan, pseudoPanchro));
+        if (bHasNoData)
+        {
+            invalid = _mm256_or_pd(invalid, pseudoPanchroIsZero);
+            invalid =
+                _mm256_or_pd(invalid, _mm256_cmp_pd(pan, noData, _CMP_EQ_OQ));
+        }
+
+        for (int i = 0; i < nOutPansharpenedBands; i++)
+        {
+            const __m256d rawValue = WorkType::Load(
+                pUpsampledSpectralBuffer +
+                panOutPansharpenedBands[i] * nBandValues + j);
+            __m256d val =
+                WorkType::FromDouble(_mm256_mul_pd(rawValue, factor));
+            // _mm256_min_pd() returns its second argument if one of them is
+            // NaN, so NaN is preserved as in the generic code.
+            if (dfMaxValue != 0)
+                val = _mm256_min_pd(maxValue, val);
+            if (bHasNoData)
+            {
+                // We don't want a valid value to be mapped to NoData.
+                val = _mm256_blendv_pd(val, validValue,
+                                       _mm256_cmp_pd(val, noData, _CMP_EQ_OQ));
+                val = _mm256_blendv_pd(val, noData, invalid);
+            }
+            // Same as GDALCopyWord() from WorkDataType to OutDataType.
+            // Integer values only need to be clamped.
+            if (WorkType::IS_INTEGER && OutType::IS_INTEGER)
+                val = _mm256_max_pd(_mm256_min_pd(val, outMax), outMin);
+            else
+                val = OutType::FromDouble(val);
+            OutType::Store(val, pDataBuf + i * nBandValues + j);
+        }
+    }
+
+    // GCC needs explicit zeroing.
+#if defined(__GNUC__) && !defined(__clang__)
+    _mm256_zeroupper();
+#endif
+
+    return j;
+}
+
+#define INSTANTIATE(WorkDataType, OutDataType)                                 \
+    template size_t GDALPansharpenWeightedBroveyAVX<WorkDataType,              \
+                                                    OutDataType>(              \
+        const WorkDataType *, const WorkDataType *, OutDataType *, size_t,     \
+        size_t, int, const double *, int, const int *, double, bool, double,   \
+        double);
+
+#define INSTANTIATE_WORK_TYPE(WorkDataType)                                    \
+    INSTANTIATE(WorkDataType, GByte)                                           \
+    INSTANTIATE(WorkDataType, GUInt16)                                         \
+    INSTANTIATE(WorkDataType, GInt16)                                          \
+    INSTANTIATE(WorkDataType, float)                                           \
+    INSTANTIATE(WorkDataType, double)
+
+INSTANTIATE_WORK_TYPE(GByte)
+INSTANTIATE_WORK_TYPE(GUInt16)
+INSTANTIATE_WORK_TYPE(GInt16)
+INSTANTIATE_WORK_TYPE(float)
+INSTANTIATE_WORK_TYPE(double)
+
+#endif /* HAVE_AVX_AT_COMPILE_TIME */
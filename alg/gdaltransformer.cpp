@@ -1662,6 +1662,14 @@ bool GDALComputeAreaOfInterest(OGRSpatialReference *poSRS, double dfX1,
  * <li> MAX_GCP_ORDER: the maximum order to use for GCP derived polynomials if
  * possible.  The default is to autoselect based on the number of GCPs.
  * A value of -1 triggers use of Thin Plate Spline instead of polynomials.
+ * <li> TPS_METHOD=GLOBAL/LOCAL: (GDAL &gt;= 3.8) Method used by the Thin Plate
+ * Spline transformer. GLOBAL, the default, solves a single system involving
+ * all GCPs, whose cost grows with the cube of the number of GCPs. LOCAL
+ * computes splines on a grid of tiles from the GCPs of each tile and its
+ * surroundings, and blends them, which is suitable for tens of thousands of
+ * GCPs and more.
+ * <li> TPS_LOCAL_GCPS_PER_TILE=integer: (GDAL &gt;= 3.8) Average number of
+ * GCPs per tile when TPS_METHOD=LOCAL. Defaults to 64.
  * <li> SRC_METHOD: may have a value which is one of GEOTRANSFORM,
  * GCP_POLYNOMIAL, GCP_TPS, GEOLOC_ARRAY, RPC to force only one geolocation
  * method to be considered on the source dataset. Will be used for pixel/line
@@ -1707,7 +1715,21 @@ bool GDALComputeAreaOfInterest(OGRSpatialReference *poSRS, double dfX1,
  * transformers. Default value is 1.3. <li> GEOLOC_USE_TEMP_DATASETS=YES/NO.
  * (GDAL &gt;= 3.5) Whether temporary GeoTIFF datasets should be used to store
  * the backmap. The default is NO, that is to use in-memory arrays, unless the
- * number of pixels of the geolocation array is greater than 16 megapixels. <li>
+ * number of pixels of the geolocation array is greater than 16 megapixels.
+ * Starting with GDAL 3.8, geolocation bands of type Byte, Int8, UInt16, Int16
+ * or Float32 are held as Float32 rather than Float64, halving their memory
+ * use. <li>
+ * GEOLOC_BACKMAP_FILENAME=filename. (GDAL &gt;= 3.8) Name of a GeoTIFF file
+ * in which the backmap of the geolocation array transformer is persisted. If
+ * the file exists and was generated for the same geolocation array and
+ * transformer options (oversample factor, SRS, nodata, ...), it is
+ * reused instead of computing the backmap again. Otherwise the backmap is
+ * computed and saved to that file. <li>
+ * NUM_THREADS=number_of_threads or ALL_CPUS. (GDAL &gt;= 3.8) Number of
+ * threads used to compute the backmap of geolocation array transformers, when
+ * the geolocation array is held in RAM, and to solve and evaluate thin plate
+ * spline transformers. Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option, or 1. <li>
  * GEOLOC_ARRAY/SRC_GEOLOC_ARRAY=filename. (GDAL &gt;= 3.5.2) Name of a GDAL
  * dataset containing a geolocation array and associated metadata. This is an
  * alternative to having geolocation information described in the GEOLOCATION
@@ -70,6 +70,16 @@ struct GDALWarpPrivateData
     std::vector<int> abSuccess{};
     std::vector<double> adfDstX{};
     std::vector<double> adfDstY{};
+    GDALWarpCutlineCache *psCutlineCache = nullptr;
+
+    GDALWarpPrivateData() = default;
+
+    ~GDALWarpPrivateData()
+    {
+        GDALDestroyWarpCutlineCache(psCutlineCache);
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALWarpPrivateData)
 };
 
 static std::mutex gMutex{};
@@ -584,6 +594,14 @@ CPLErr GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions)
     if (pszBD)
         psOptions->dfCutlineBlendDist = CPLAtof(pszBD);
 
+    if (psOptions->hCutline != nullptr)
+    {
+        // Created now, since WarpRegionToBuffer() may be called concurrently.
+        GDALWarpPrivateData *privateData = GetWarpPrivateData(this);
+        if (privateData->psCutlineCache == nullptr)
+            privateData->psCutlineCache = GDALCreateWarpCutlineCache();
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Set SRC_ALPHA_MAX if not provided.                              */
     /* -------------------------------------------------------------------- */
@@ -1259,6 +1277,52 @@ void GDALWarpOperation::WipeChunkList()
     nChunkListMax = 0;
 }
 
+/************************************************************************/
+/*                       GDALWarpIsSrcWindowEmpty()                     */
+/************************************************************************/
+
+// Returns whether all the source bands report the source window as empty
+// with GetDataCoverageStatus() (e.g. missing tiles of a sparse GeoTIFF file),
+// and their nodata value is the one used by the warper, in which case no
+// source pixel of the window is valid.
+static bool GDALWarpIsSrcWindowEmpty(const GDALWarpOptions *psOptions,
+                                     int nSrcXOff, int nSrcYOff, int nSrcXSize,
+                                     int nSrcYSize)
+{
+    if (psOptions->padfSrcNoDataReal == nullptr || psOptions->nBandCount == 0)
+        return false;
+    for (int i = 0; i < psOptions->nBandCount; ++i)
+    {
+        if (psOptions->padfSrcNoDataImag != nullptr &&
+            psOptions->padfSrcNoDataImag[i] != 0.0)
+        {
+            return false;
+        }
+        GDALRasterBandH hSrcBand =
+            GDALGetRasterBand(psOptions->hSrcDS, psOptions->panSrcBands[i]);
+        if (hSrcBand == nullptr)
+            return false;
+        int bHasNoData = FALSE;
+        const double dfNoDataValue =
+            GDALGetRasterNoDataValue(hSrcBand, &bHasNoData);
+        const double dfWarpNoDataValue = psOptions->padfSrcNoDataReal[i];
+        if (!bHasNoData ||
+            !(ARE_REAL_EQUAL(dfNoDataValue, dfWarpNoDataValue) ||
+              (std::isnan(dfNoDataValue) && std::isnan(dfWarpNoDataValue))))
+        {
+            return false;
+        }
+        if (GDALGetDataCoverageStatus(hSrcBand, nSrcXOff, nSrcYOff, nSrcXSize,
+                                      nSrcYSize, GDAL_DATA_COVERAGE_STATUS_DATA,
+                                      nullptr) !=
+            GDAL_DATA_COVERAGE_STATUS_EMPTY)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                       CollectChunkListInternal()                     */
 /************************************************************************/
@@ -1300,6 +1364,19 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
         CPLFetchBool(psOptions->papszWarpOptions, "SKIP_NOSOURCE", false))
         return CE_None;
 
+    // Same if the source window only contains nodata pixels.
+    if (nSrcXSize > 0 && nSrcYSize > 0 &&
+        CPLFetchBool(psOptions->papszWarpOptions, "SKIP_NOSOURCE", false) &&
+        GDALWarpIsSrcWindowEmpty(psOptions, nSrcXOff, nSrcYOff, nSrcXSize,
+                                 nSrcYSize))
+    {
+        CPLDebug("WARP",
+                 "Skipping destination window %d,%d,%d,%d whose source "
+                 "window is empty",
+                 nDstXOff, nDstYOff, nDstXSize, nDstYSize);
+        return CE_None;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Based on the types of masks in use, how many bits will each     */
     /*      source pixel cost us?                                           */
@@ -1985,11 +2062,10 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
         int nValidityFlag = 0;
         if (eErr == CE_None)
-            eErr = GDALWarpCutlineMaskerEx(
-                psOptions, psOptions->nBandCount, psOptions->eWorkingDataType,
+            eErr = GDALWarpCutlineMaskerWithCache(
+                psOptions, GetWarpPrivateData(this)->psCutlineCache,
                 oWK.nSrcXOff, oWK.nSrcYOff, oWK.nSrcXSize, oWK.nSrcYSize,
-                oWK.papabySrcImage, TRUE, oWK.pafUnifiedSrcDensity,
-                &nValidityFlag);
+                oWK.pafUnifiedSrcDensity, &nValidityFlag);
         if (nValidityFlag == GCMVF_CHUNK_FULLY_WITHIN_CUTLINE &&
             bUnifiedSrcDensityJustCreated)
         {
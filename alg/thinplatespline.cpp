@@ -37,6 +37,7 @@
 #include "gdallinearsystem.h"
 
 #include <climits>
+#include <cmath>
 #include <cstdio>
 #include <cstring>
 
@@ -46,6 +47,8 @@
 
 #include "cpl_error.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 CPL_CVSID("$Id$")
 
@@ -733,4 +736,295 @@ int VizGeorefSpline2D::get_point(const double Px, const double Py, double *vars)
     return 1;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+//// VizGeorefLocalSpline2D
+//////////////////////////////////////////////////////////////////////////////
+
+VizGeorefLocalSpline2D::VizGeorefLocalSpline2D(int nof_vars,
+                                               int nof_points_per_tile)
+    : _nof_vars(nof_vars), _nof_points_per_tile(std::max(1, nof_points_per_tile))
+{
+}
+
+bool VizGeorefLocalSpline2D::add_point(const double Px, const double Py,
+                                       const double *Pvars)
+{
+    try
+    {
+        _x.push_back(Px);
+        _y.push_back(Py);
+        _vars.insert(_vars.end(), Pvars, Pvars + _nof_vars);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Out of memory");
+        return false;
+    }
+    _tiles.clear();
+    return true;
+}
+
+namespace
+{
+struct VizGeorefLocalSpline2DJob
+{
+    VizGeorefLocalSpline2D *poSpline = nullptr;
+    int iTileX = 0;
+    int iTileY = 0;
+    const std::vector<std::vector<int>> *paanPointsPerTile = nullptr;
+    bool bOK = false;
+};
+}  // namespace
+
+void VizGeorefLocalSpline2D::SolveTileJob(void *pData)
+{
+    auto psJob = static_cast<VizGeorefLocalSpline2DJob *>(pData);
+    psJob->bOK = psJob->poSpline->solve_tile(psJob->iTileX, psJob->iTileY,
+                                             *(psJob->paanPointsPerTile));
+}
+
+int VizGeorefLocalSpline2D::solve(int nThreads)
+{
+    _tiles.clear();
+
+    const int nPoints = static_cast<int>(_x.size());
+    if (nPoints < 1)
+        return 0;
+
+    const double dfMinX = *std::min_element(_x.begin(), _x.end());
+    const double dfMaxX = *std::max_element(_x.begin(), _x.end());
+    const double dfMinY = *std::min_element(_y.begin(), _y.end());
+    const double dfMaxY = *std::max_element(_y.begin(), _y.end());
+    const double dfWidth = dfMaxX - dfMinX;
+    const double dfHeight = dfMaxY - dfMinY;
+
+    // Split the extent into tiles with roughly _nof_points_per_tile points
+    // each, and the same aspect ratio as the extent.
+    const int nTiles = std::max(1, nPoints / _nof_points_per_tile);
+    if (dfWidth > 0 && dfHeight > 0)
+    {
+        _nTilesX = static_cast<int>(
+            std::round(std::sqrt(nTiles * dfWidth / dfHeight)));
+        _nTilesX = std::max(1, std::min(nTiles, _nTilesX));
+        _nTilesY = std::max(1, nTiles / _nTilesX);
+    }
+    else
+    {
+        // 1D case: let VizGeorefSpline2D deal with it globally.
+        _nTilesX = 1;
+        _nTilesY = 1;
+    }
+    _minX = dfMinX;
+    _minY = dfMinY;
+    _tileWidth = dfWidth > 0 ? dfWidth / _nTilesX : 1.0;
+    _tileHeight = dfHeight > 0 ? dfHeight / _nTilesY : 1.0;
+
+    std::vector<std::vector<int>> aanPointsPerTile;
+    try
+    {
+        aanPointsPerTile.resize(static_cast<size_t>(_nTilesX) * _nTilesY);
+        for (int i = 0; i < nPoints; ++i)
+        {
+            const int iTileX = std::max(
+                0, std::min(_nTilesX - 1,
+                            static_cast<int>((_x[i] - _minX) / _tileWidth)));
+            const int iTileY = std::max(
+                0, std::min(_nTilesY - 1,
+                            static_cast<int>((_y[i] - _minY) / _tileHeight)));
+            aanPointsPerTile[static_cast<size_t>(iTileY) * _nTilesX + iTileX]
+                .push_back(i);
+        }
+        _tiles.resize(aanPointsPerTile.size());
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Out of memory");
+        _tiles.clear();
+        return 0;
+    }
+
+    std::vector<VizGeorefLocalSpline2DJob> asJobs(_tiles.size());
+    for (int iTileY = 0; iTileY < _nTilesY; ++iTileY)
+    {
+        for (int iTileX = 0; iTileX < _nTilesX; ++iTileX)
+        {
+            auto &sJob = asJobs[static_cast<size_t>(iTileY) * _nTilesX + iTileX];
+            sJob.poSpline = this;
+            sJob.iTileX = iTileX;
+            sJob.iTileY = iTileY;
+            sJob.paanPointsPerTile = &aanPointsPerTile;
+        }
+    }
+
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 && asJobs.size() > 1 ? GDALGetGlobalThreadPool(nThreads)
+                                          : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    for (auto &sJob : asJobs)
+    {
+        if (!poJobQueue || !poJobQueue->SubmitJob(SolveTileJob, &sJob))
+            SolveTileJob(&sJob);
+    }
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+
+    for (const auto &sJob : asJobs)
+    {
+        if (!sJob.bOK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot solve thin plate spline for tile (%d,%d)",
+                     sJob.iTileX, sJob.iTileY);
+            _tiles.clear();
+            return 0;
+        }
+    }
+
+    CPLDebug("GDAL", "Local thin plate spline: %d points, %d x %d tiles",
+             nPoints, _nTilesX, _nTilesY);
+    return 4;
+}
+
+bool VizGeorefLocalSpline2D::solve_tile(
+    int iTileX, int iTileY,
+    const std::vector<std::vector<int>> &aanPointsPerTile)
+{
+    const int nPoints = static_cast<int>(_x.size());
+    const int nMinPoints =
+        std::min(nPoints, std::max(10, _nof_points_per_tile / 2));
+    const double dfMaxX = _minX + _nTilesX * _tileWidth;
+    const double dfMaxY = _minY + _nTilesY * _tileHeight;
+
+    // Start with a margin of half a tile, which is the minimum required by
+    // the blending in get_point() to have an exact interpolation at the
+    // points, and enlarge it when there are not enough points around the
+    // tile, or if they are degenerate.
+    for (double dfMargin = 0.5;; dfMargin *= 2)
+    {
+        const double dfXMin = _minX + (iTileX - dfMargin) * _tileWidth;
+        const double dfXMax = _minX + (iTileX + 1 + dfMargin) * _tileWidth;
+        const double dfYMin = _minY + (iTileY - dfMargin) * _tileHeight;
+        const double dfYMax = _minY + (iTileY + 1 + dfMargin) * _tileHeight;
+        const bool bCoversAll = dfXMin <= _minX && dfXMax >= dfMaxX &&
+                                dfYMin <= _minY && dfYMax >= dfMaxY;
+        const int nRing = static_cast<int>(std::ceil(dfMargin));
+
+        std::vector<int> anIdx;
+        for (int iY = std::max(0, iTileY - nRing);
+             iY <= std::min(_nTilesY - 1, iTileY + nRing); ++iY)
+        {
+            for (int iX = std::max(0, iTileX - nRing);
+                 iX <= std::min(_nTilesX - 1, iTileX + nRing); ++iX)
+            {
+                for (const int i :
+                     aanPointsPerTile[static_cast<size_t>(iY) * _nTilesX + iX])
+                {
+                    if (_x[i] >= dfXMin && _x[i] <= dfXMax &&
+                        _y[i] >= dfYMin && _y[i] <= dfYMax)
+                    {
+                        anIdx.push_back(i);
+                    }
+                }
+            }
+        }
+        if (static_cast<int>(anIdx.size()) < nMinPoints && !bCoversAll)
+            continue;
+
+        std::unique_ptr<VizGeorefSpline2D> poSpline(
+            new VizGeorefSpline2D(_nof_vars));
+        for (const int i : anIdx)
+        {
+            if (!poSpline->add_point(_x[i], _y[i],
+                                     &_vars[static_cast<size_t>(i) *
+                                            _nof_vars]))
+                return false;
+        }
+
+        int nRet;
+        if (bCoversAll)
+        {
+            nRet = poSpline->solve();
+        }
+        else
+        {
+            // Degenerate configurations are retried with more points.
+            CPLErrorStateBackuper oBackuper;
+            CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+            nRet = poSpline->solve();
+        }
+        if (nRet != 0)
+        {
+            _tiles[static_cast<size_t>(iTileY) * _nTilesX + iTileX] =
+                std::move(poSpline);
+            return true;
+        }
+        if (bCoversAll)
+            return false;
+    }
+}
+
+// Return the indices of the 2 tiles whose centers surround dfTile (tile
+// coordinate), and the smoothed weight of the second one.
+static void VizGeorefLocalSpline2DGetBlending(double dfTile, int nTiles,
+                                              int &i0, int &i1, double &w1)
+{
+    const double dfCenter = dfTile - 0.5;
+    if (!(dfCenter > 0))
+    {
+        i0 = 0;
+        i1 = 0;
+        w1 = 0;
+        return;
+    }
+    i0 = static_cast<int>(std::min<double>(dfCenter, nTiles - 1));
+    if (i0 >= nTiles - 1)
+    {
+        i0 = nTiles - 1;
+        i1 = nTiles - 1;
+        w1 = 0;
+        return;
+    }
+    i1 = i0 + 1;
+    const double t = dfCenter - i0;
+    // Smoothstep, so that the blended surface is continuously differentiable
+    w1 = t * t * (3 - 2 * t);
+}
+
+int VizGeorefLocalSpline2D::get_point(const double Px, const double Py,
+                                      double *vars) const
+{
+    for (int v = 0; v < _nof_vars; v++)
+        vars[v] = 0.0;
+    if (_tiles.empty())
+        return 0;
+
+    int iX0, iX1, iY0, iY1;
+    double dfWX1, dfWY1;
+    VizGeorefLocalSpline2DGetBlending((Px - _minX) / _tileWidth, _nTilesX, iX0,
+                                      iX1, dfWX1);
+    VizGeorefLocalSpline2DGetBlending((Py - _minY) / _tileHeight, _nTilesY,
+                                      iY0, iY1, dfWY1);
+
+    const int aiX[2] = {iX0, iX1};
+    const int aiY[2] = {iY0, iY1};
+    const double adfWX[2] = {1 - dfWX1, dfWX1};
+    const double adfWY[2] = {1 - dfWY1, dfWY1};
+    for (int j = 0; j < 2; ++j)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            const double dfWeight = adfWX[i] * adfWY[j];
+            if (dfWeight == 0)
+                continue;
+            double adfTileVars[VIZGEOREF_MAX_VARS] = {};
+            _tiles[static_cast<size_t>(aiY[j]) * _nTilesX + aiX[i]]->get_point(
+                Px, Py, adfTileVars);
+            for (int v = 0; v < _nof_vars; v++)
+                vars[v] += dfWeight * adfTileVars[v];
+        }
+    }
+    return 1;
+}
+
 /*! @endcond */
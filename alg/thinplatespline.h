@@ -38,6 +38,9 @@
 #include "gdal_alg.h"
 #include "cpl_conv.h"
 
+#include <memory>
+#include <vector>
+
 typedef enum
 {
     VIZ_GEOREF_SPLINE_ZERO_POINTS,
@@ -185,6 +188,49 @@ class VizGeorefSpline2D
     CPL_DISALLOW_COPY_ASSIGN(VizGeorefSpline2D)
 };
 
+/************************************************************************/
+/*                       VizGeorefLocalSpline2D                         */
+/************************************************************************/
+
+// Scalable variant of VizGeorefSpline2D for large numbers of points.
+// The extent of the points is split into a regular grid of tiles. A thin
+// plate spline is computed for each tile from the points of the tile and of
+// its surroundings (half a tile around it), and the values of the splines of
+// the 4 nearest tiles are blended with smooth weights. Interpolation is thus
+// still exact at the points, with a cost proportional to the number of points
+// rather than to its cube.
+class VizGeorefLocalSpline2D
+{
+  public:
+    VizGeorefLocalSpline2D(int nof_vars, int nof_points_per_tile);
+
+    bool add_point(const double Px, const double Py, const double *Pvars);
+    int get_point(const double Px, const double Py, double *Pvars) const;
+    int solve(int nThreads);
+
+  private:
+    const int _nof_vars;
+    const int _nof_points_per_tile;
+
+    std::vector<double> _x{};
+    std::vector<double> _y{};
+    std::vector<double> _vars{};  // _nof_vars values per point
+
+    int _nTilesX = 0;
+    int _nTilesY = 0;
+    double _minX = 0;
+    double _minY = 0;
+    double _tileWidth = 0;
+    double _tileHeight = 0;
+    std::vector<std::unique_ptr<VizGeorefSpline2D>> _tiles{};
+
+    bool solve_tile(int iTileX, int iTileY,
+                    const std::vector<std::vector<int>> &aanPointsPerTile);
+    static void SolveTileJob(void *pData);
+
+    CPL_DISALLOW_COPY_ASSIGN(VizGeorefLocalSpline2D)
+};
+
 #endif /* #ifndef DOXYGEN_SKIP */
 
 #endif /* THINPLATESPLINE_H_INCLUDED */
@@ -32,6 +32,10 @@
 #include "gdal_priv.h"
 #include "commonutils.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 /************************************************************************/
 /*                               Usage()                                */
 /************************************************************************/
@@ -44,6 +48,9 @@ static void Usage(const char *pszErrorMsg = nullptr)
         "{nearest,average,rms,gauss,cubic,cubicspline,lanczos,average_mp,"
         "average_magphase,mode}]\n"
         "                [-ro] [-clean] [-q] [-oo NAME=VALUE]* [-minsize val]\n"
+        "                [-partial_refresh_from_projwin ulx uly lrx lry]\n"
+        "                [-partial_refresh_from_source_extent "
+        "filename1[,filenameN]...]\n"
         "                [--help-general] filename [levels]\n"
         "\n"
         "  -r : choice of resampling method (default: nearest)\n"
@@ -57,6 +64,12 @@ static void Usage(const char *pszErrorMsg = nullptr)
         "be removed).\n"
         "  levels: A list of integral overview levels to build. Ignored with "
         "-clean option.\n"
+        "  -partial_refresh_from_projwin: refresh the existing overviews only "
+        "in the\n"
+        "        specified georeferenced area.\n"
+        "  -partial_refresh_from_source_extent: refresh the existing overviews "
+        "only in\n"
+        "        the area covered by the specified source files.\n"
         "\n"
         "Useful configuration variables :\n"
         "  --config USE_RRD YES : Use Erdas Imagine format (.aux) as overview "
@@ -109,6 +122,61 @@ static void CPL_STDCALL GDALAddoErrorHandler(CPLErr eErr, CPLErrorNum errNum,
     aoErrors.push_back(GDALError(eErr, errNum, pszMsg));
 }
 
+/************************************************************************/
+/*                          GetPixelWindow()                            */
+/************************************************************************/
+
+// Computes the window of pixels of hDataset that intersects a georeferenced
+// extent, as a "xoff,yoff,xsize,ysize" string for the REFRESH_REGIONS option
+// of GDALBuildOverviewsEx().
+static bool GetPixelWindow(GDALDatasetH hDataset, double dfMinX, double dfMinY,
+                           double dfMaxX, double dfMaxY, CPLString &osRegion)
+{
+    double adfGeoTransform[6] = {};
+    double adfInvGeoTransform[6] = {};
+    if (GDALGetGeoTransform(hDataset, adfGeoTransform) != CE_None ||
+        !GDALInvGeoTransform(adfGeoTransform, adfInvGeoTransform))
+    {
+        fprintf(stderr, "Dataset has no valid geotransform.\n");
+        return false;
+    }
+
+    double dfPixelMin = std::numeric_limits<double>::max();
+    double dfLineMin = std::numeric_limits<double>::max();
+    double dfPixelMax = -std::numeric_limits<double>::max();
+    double dfLineMax = -std::numeric_limits<double>::max();
+    const double adfX[] = {dfMinX, dfMaxX, dfMinX, dfMaxX};
+    const double adfY[] = {dfMinY, dfMinY, dfMaxY, dfMaxY};
+    for (int i = 0; i < 4; ++i)
+    {
+        double dfPixel = 0;
+        double dfLine = 0;
+        GDALApplyGeoTransform(adfInvGeoTransform, adfX[i], adfY[i], &dfPixel,
+                              &dfLine);
+        dfPixelMin = std::min(dfPixelMin, dfPixel);
+        dfLineMin = std::min(dfLineMin, dfLine);
+        dfPixelMax = std::max(dfPixelMax, dfPixel);
+        dfLineMax = std::max(dfLineMax, dfLine);
+    }
+
+    const double dfXSize = GDALGetRasterXSize(hDataset);
+    const double dfYSize = GDALGetRasterYSize(hDataset);
+    dfPixelMin = std::max(0.0, floor(dfPixelMin + 1e-8));
+    dfLineMin = std::max(0.0, floor(dfLineMin + 1e-8));
+    dfPixelMax = std::min(dfXSize, ceil(dfPixelMax - 1e-8));
+    dfLineMax = std::min(dfYSize, ceil(dfLineMax - 1e-8));
+    if (!(dfPixelMin < dfPixelMax && dfLineMin < dfLineMax))
+        return true;
+
+    if (!osRegion.empty())
+        osRegion += ';';
+    osRegion += CPLSPrintf("%d,%d,%d,%d", static_cast<int>(dfPixelMin),
+                           static_cast<int>(dfLineMin),
+                           static_cast<int>(dfPixelMax - dfPixelMin),
+                           static_cast<int>(dfLineMax - dfLineMin));
+    return true;
+}
+
 /************************************************************************/
 /*                                main()                                */
 /************************************************************************/
@@ -142,6 +210,7 @@ MAIN_START(nArgc, papszArgv)
         exit(-nArgc);
 
     const char *pszResampling = "nearest";
+    bool bResamplingSpecified = false;
     const char *pszFilename = nullptr;
     int anLevels[1024] = {};
     int nLevelCount = 0;
@@ -153,6 +222,12 @@ MAIN_START(nArgc, papszArgv)
     int nBandCount = 0;
     char **papszOpenOptions = nullptr;
     int nMinSize = 256;
+    bool bPartialRefreshFromProjWin = false;
+    double dfULX = 0;
+    double dfULY = 0;
+    double dfLRX = 0;
+    double dfLRY = 0;
+    CPLStringList aosPartialRefreshSources;
 
     /* -------------------------------------------------------------------- */
     /*      Parse command line.                                              */
@@ -176,6 +251,7 @@ MAIN_START(nArgc, papszArgv)
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
             pszResampling = papszArgv[++iArg];
+            bResamplingSpecified = true;
         }
         else if (EQUAL(papszArgv[iArg], "-ro"))
         {
@@ -219,6 +295,21 @@ MAIN_START(nArgc, papszArgv)
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
             nMinSize = atoi(papszArgv[++iArg]);
         }
+        else if (EQUAL(papszArgv[iArg], "-partial_refresh_from_projwin"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(4);
+            bPartialRefreshFromProjWin = true;
+            dfULX = CPLAtof(papszArgv[++iArg]);
+            dfULY = CPLAtof(papszArgv[++iArg]);
+            dfLRX = CPLAtof(papszArgv[++iArg]);
+            dfLRY = CPLAtof(papszArgv[++iArg]);
+        }
+        else if (EQUAL(papszArgv[iArg], "-partial_refresh_from_source_extent"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            aosPartialRefreshSources.Assign(
+                CSLTokenizeString2(papszArgv[++iArg], ",", 0), TRUE);
+        }
         else if (papszArgv[iArg][0] == '-')
         {
             Usage(CPLSPrintf("Unknown option name '%s'", papszArgv[iArg]));
@@ -248,6 +339,11 @@ MAIN_START(nArgc, papszArgv)
     if (pszFilename == nullptr)
         Usage("No datasource specified.");
 
+    const bool bPartialRefresh =
+        bPartialRefreshFromProjWin || !aosPartialRefreshSources.empty();
+    if (bPartialRefresh && bClean)
+        Usage("-partial_refresh_* options are not compatible with -clean.");
+
     /* -------------------------------------------------------------------- */
     /*      Open data file.                                                 */
     /* -------------------------------------------------------------------- */
@@ -300,7 +396,88 @@ MAIN_START(nArgc, papszArgv)
         /* --------------------------------------------------------------------
          */
 
-        if (nLevelCount == 0)
+        // Partial refresh of existing overviews
+        if (bPartialRefresh)
+        {
+            CPLString osRegions;
+            bool bOK = true;
+            if (bPartialRefreshFromProjWin)
+            {
+                bOK = GetPixelWindow(hDataset, std::min(dfULX, dfLRX),
+                                     std::min(dfULY, dfLRY),
+                                     std::max(dfULX, dfLRX),
+                                     std::max(dfULY, dfLRY), osRegions);
+            }
+            for (int i = 0; bOK && i < aosPartialRefreshSources.size(); ++i)
+            {
+                GDALDatasetH hSrcDS =
+                    GDALOpenEx(aosPartialRefreshSources[i],
+                               GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR, nullptr,
+                               nullptr, nullptr);
+                double adfGeoTransform[6] = {};
+                if (hSrcDS == nullptr ||
+                    GDALGetGeoTransform(hSrcDS, adfGeoTransform) != CE_None)
+                {
+                    fprintf(stderr, "Cannot get extent of %s.\n",
+                            aosPartialRefreshSources[i]);
+                    bOK = false;
+                }
+                else
+                {
+                    const double dfX1 = adfGeoTransform[0];
+                    const double dfY1 = adfGeoTransform[3];
+                    const double dfX2 =
+                        dfX1 + GDALGetRasterXSize(hSrcDS) * adfGeoTransform[1] +
+                        GDALGetRasterYSize(hSrcDS) * adfGeoTransform[2];
+                    const double dfY2 =
+                        dfY1 + GDALGetRasterXSize(hSrcDS) * adfGeoTransform[4] +
+                        GDALGetRasterYSize(hSrcDS) * adfGeoTransform[5];
+                    bOK = GetPixelWindow(hDataset, std::min(dfX1, dfX2),
+                                         std::min(dfY1, dfY2),
+                                         std::max(dfX1, dfX2),
+                                         std::max(dfY1, dfY2), osRegions);
+                }
+                if (hSrcDS)
+                    GDALClose(hSrcDS);
+            }
+
+            // Unless -r is specified, reuse the resampling method recorded
+            // in the existing overviews, if any.
+            CPLString osResampling(pszResampling);
+            if (!bResamplingSpecified && GDALGetRasterCount(hDataset) > 0)
+            {
+                GDALRasterBandH hBand = GDALGetRasterBand(hDataset, 1);
+                GDALRasterBandH hOvr = GDALGetOverviewCount(hBand) > 0
+                                           ? GDALGetOverview(hBand, 0)
+                                           : nullptr;
+                const char *pszOvrResampling =
+                    hOvr ? GDALGetMetadataItem(hOvr, "RESAMPLING", nullptr)
+                         : nullptr;
+                if (pszOvrResampling)
+                    osResampling = pszOvrResampling;
+            }
+
+            CPLStringList aosOptions;
+            aosOptions.SetNameValue("REFRESH_REGIONS", osRegions.c_str());
+            if (!bOK)
+            {
+                nResultStatus = 1;
+            }
+            else if (osRegions.empty())
+            {
+                if (pfnProgress != GDALDummyProgress)
+                    printf("Nothing to refresh.\n");
+            }
+            else if (GDALBuildOverviewsEx(
+                         hDataset, osResampling.c_str(), nLevelCount, anLevels,
+                         nBandCount, panBandList, pfnProgress, nullptr,
+                         aosOptions.List()) != CE_None)
+            {
+                printf("Overview refresh failed.\n");
+                nResultStatus = 100;
+            }
+        }
+        else if (nLevelCount == 0)
         {
             const int nXSize = GDALGetRasterXSize(hDataset);
             const int nYSize = GDALGetRasterYSize(hDataset);
@@ -314,10 +491,10 @@ MAIN_START(nArgc, papszArgv)
         }
 
         // Only HFA supports selected layers
-        if (nBandCount > 0)
+        if (nBandCount > 0 && !bPartialRefresh)
             CPLSetConfigOption("USE_RRD", "YES");
 
-        if (nLevelCount > 0 &&
+        if (!bPartialRefresh && nLevelCount > 0 &&
             GDALBuildOverviews(hDataset, pszResampling, nLevelCount, anLevels,
                                nBandCount, panBandList, pfnProgress,
                                nullptr) != CE_None)
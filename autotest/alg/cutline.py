@@ -31,6 +31,8 @@
 ###############################################################################
 
 
+import math
+
 import gdaltest
 import pytest
 
@@ -115,4 +117,53 @@ def test_cutline_4():
     gdal.Unlink("/vsimem/utmsmall.tif")
 
 
+###############################################################################
+# Test that warping with a cutline with many vertices in small chunks (which
+# clips the cutline to each chunk, and skips chunks fully inside or outside
+# of it) gives the same result as a single chunk.
+
+
+@pytest.mark.require_geos
+@pytest.mark.parametrize("all_touched", [False, True])
+def test_cutline_many_vertices_small_chunks(all_touched):
+
+    # Ring with a hole, both made of many vertices, partly outside of the
+    # raster extent
+    def circle(cx, cy, r, n):
+        return ",".join(
+            "%.6f %.6f"
+            % (
+                cx + r * math.cos(2 * math.pi * i / n),
+                cy + r * math.sin(2 * math.pi * i / n),
+            )
+            for i in list(range(n)) + [0]
+        )
+
+    wkt = "POLYGON((%s),(%s))" % (
+        circle(60, 45, 55, 20000),
+        circle(40, 50, 15, 5000),
+    )
+
+    src_ds = gdal.Open("../gcore/data/utmsmall.tif")
+
+    def warp(mem_limit):
+        options = ["CUTLINE=" + wkt]
+        if all_touched:
+            options.append("CUTLINE_ALL_TOUCHED=YES")
+        ds = gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            warpOptions=options,
+            warpMemoryLimit=mem_limit,
+        )
+        return ds.GetRasterBand(1).ReadRaster()
+
+    ref = warp(1e8)
+    assert ref != b"\0" * len(ref)
+    assert warp(3000) == ref
+    # Second run, using the cached masks
+    assert warp(3000) == ref
+
+
 ###############################################################################
@@ -1669,3 +1669,41 @@ def test_warp_average_oversampling():
             assert math.isnan(got_data[(y + 4) * 14 + (14 - 1 - x)])
         for x in range(6):
             assert got_data[(y + 4) * 14 + (x + 4)] == 3.0
+
+
+###############################################################################
+# Test that warping skips the empty regions of a sparse source
+
+
+def test_warp_sparse_source_skip_empty_regions(tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        src_filename,
+        1024,
+        1024,
+        options=["SPARSE_OK=YES", "TILED=YES"],
+    )
+    ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds = gdal.Open("../gcore/data/byte.tif")
+    ds.GetRasterBand(1).WriteRaster(
+        500, 600, 20, 20, src_ds.GetRasterBand(1).ReadRaster()
+    )
+    ds = None
+
+    ref_ds = gdal.Warp(
+        "", gdal.Translate("", src_filename, format="MEM"), format="MEM", xRes=2, yRes=2
+    )
+
+    out_ds = gdal.Warp(
+        str(tmp_path / "out.tif"),
+        src_filename,
+        xRes=2,
+        yRes=2,
+        warpMemoryLimit=64 * 1024,
+        creationOptions=["TILED=YES", "SPARSE_OK=YES"],
+    )
+    assert out_ds.GetRasterBand(1).Checksum() == ref_ds.GetRasterBand(1).Checksum()
+    (flags, _) = out_ds.GetRasterBand(1).GetDataCoverageStatus(0, 0, 16, 16)
+    assert flags == gdal.GDAL_DATA_COVERAGE_STATUS_EMPTY
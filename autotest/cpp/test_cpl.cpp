@@ -4175,6 +4175,62 @@ TEST_F(test_cpl, VSI_plugin_advise_read)
     VSIFCloseL(fp);
 }
 
+// Test ReadMultiRange() and AdviseRead() on a local file
+TEST_F(test_cpl, VSI_local_file_read_multi_range)
+{
+    const std::string osFilename =
+        CPLGenerateTempFilename("test_cpl_read_multi_range");
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
+    ASSERT_TRUE(fp != nullptr);
+    std::vector<GByte> abyContent(100000);
+    for (size_t i = 0; i < abyContent.size(); ++i)
+        abyContent[i] = static_cast<GByte>(i * 7 + i / 256);
+    EXPECT_EQ(VSIFWriteL(abyContent.data(), 1, abyContent.size(), fp),
+              abyContent.size());
+    VSIFCloseL(fp);
+
+    fp = VSIFOpenL(osFilename.c_str(), "rb");
+    ASSERT_TRUE(fp != nullptr);
+    EXPECT_EQ(VSIFSeekL(fp, 123, SEEK_SET), 0);
+
+    // Unordered and overlapping ranges are allowed by AdviseRead()
+    const vsi_l_offset anAdviseOffsets[] = {50000, 10, 0, 99990};
+    const size_t anAdviseSizes[] = {1000, 100, 20, 10};
+    reinterpret_cast<VSIVirtualHandle *>(fp)->AdviseRead(4, anAdviseOffsets,
+                                                         anAdviseSizes);
+
+    const vsi_l_offset anOffsets[] = {0, 4095, 65536, 99990};
+    const size_t anSizes[] = {10, 2, 30000, 10};
+    std::vector<std::vector<GByte>> aabyData;
+    void *apData[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        aabyData.emplace_back(anSizes[i]);
+        apData[i] = aabyData.back().data();
+    }
+    EXPECT_EQ(VSIFReadMultiRangeL(4, apData, anOffsets, anSizes, fp), 0);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(memcmp(aabyData[i].data(),
+                           abyContent.data() + anOffsets[i], anSizes[i]) == 0)
+            << i;
+    }
+    // The file position is not changed
+    EXPECT_EQ(VSIFTellL(fp), 123U);
+
+    // Range beyond end of file
+    const vsi_l_offset nOffsetBeyondEOF = 99995;
+    const size_t nSizeBeyondEOF = 10;
+    GByte abyBuffer[10];
+    void *pData = abyBuffer;
+    EXPECT_NE(
+        VSIFReadMultiRangeL(1, &pData, &nOffsetBeyondEOF, &nSizeBeyondEOF, fp),
+        0);
+
+    VSIFCloseL(fp);
+    VSIUnlink(osFilename.c_str());
+}
+
 // Test CPLIsASCII()
 TEST_F(test_cpl, CPLIsASCII)
 {
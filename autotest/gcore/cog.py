@@ -295,6 +295,47 @@ def test_cog_creation_of_overviews():
     gdal.Unlink(directory)
 
 
+###############################################################################
+# Test that temporary overview files are kept in memory, unless
+# COG_TMP_MAX_MEMORY=0
+
+
+@pytest.mark.parametrize("tmp_max_memory", [None, "0"])
+def test_cog_creation_of_overviews_tmp_max_memory(tmp_max_memory):
+
+    directory = "/vsimem/test_cog_creation_of_overviews_tmp_max_memory"
+    filename = directory + "/cog.tif"
+    src_ds = gdal.Translate("", "data/byte.tif", options="-of MEM -outsize 2048 300")
+
+    tmp_files = set()
+
+    def my_cbk(pct, _, arg):
+        for f in gdal.ReadDir(directory) or []:
+            if f.endswith(".tmp"):
+                tmp_files.add(f)
+        return 1
+
+    with gdal.config_options({"COG_TMP_MAX_MEMORY": tmp_max_memory}):
+        ds = gdal.GetDriverByName("COG").CreateCopy(
+            filename, src_ds, options=["BLOCKSIZE=256"], callback=my_cbk
+        )
+    assert ds.GetRasterBand(1).GetOverviewCount() == 2
+    ds = None
+    assert gdal.ReadDir(directory) == ["cog.tif"]
+    if tmp_max_memory is None:
+        assert not tmp_files
+    else:
+        assert "cog.tif.ovr.tmp" in tmp_files
+
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).Checksum() == src_ds.GetRasterBand(1).Checksum()
+    ds = None
+    _check_cog(filename)
+
+    gdal.GetDriverByName("GTiff").Delete(filename)
+    gdal.Unlink(directory)
+
+
 ###############################################################################
 # Test creation of overviews with a different compression method
 
@@ -618,3 +618,114 @@ def test_geoloc_warnings_inconsistent_size(
         else:
             assert gdal.GetLastErrorMsg() == ""
         assert tr
+
+
+###############################################################################
+# Test multi-threaded backmap generation and backmap persistence
+
+
+@pytest.mark.parametrize("use_temp_datasets", ["YES", "NO"])
+def test_geoloc_backmap_num_threads_and_persistence(tmp_path, use_temp_datasets):
+
+    ds = gdal.GetDriverByName("MEM").Create("", 200, 372)
+    md = {
+        "LINE_OFFSET": "0",
+        "LINE_STEP": "1",
+        "PIXEL_OFFSET": "0",
+        "PIXEL_STEP": "1",
+        "X_DATASET": "../alg/data/geoloc/longitude_including_pole.tif",
+        "X_BAND": "1",
+        "Y_DATASET": "../alg/data/geoloc/latitude_including_pole.tif",
+        "Y_BAND": "1",
+        "SRS": 'GEOGCS["WGS 84",DATUM["WGS_1984",SPHEROID["WGS 84",6378137,298.257223563,AUTHORITY["EPSG","7030"]],AUTHORITY["EPSG","6326"]],PRIMEM["Greenwich",0,AUTHORITY["EPSG","8901"]],UNIT["degree",0.0174532925199433,AUTHORITY["EPSG","9122"]],AXIS["Latitude",NORTH],AXIS["Longitude",EAST],AUTHORITY["EPSG","4326"]]',
+    }
+    ds.SetMetadata(md, "GEOLOCATION")
+    ds.GetRasterBand(1).Fill(1)
+
+    with gdaltest.config_option("GDAL_GEOLOC_USE_TEMP_DATASETS", use_temp_datasets):
+        ref_cs = gdal.Warp("", ds, format="MEM").GetRasterBand(1).Checksum()
+
+        # Multi-threaded backmap generation gives the same result
+        warped_ds = gdal.Warp(
+            "", ds, format="MEM", transformerOptions=["NUM_THREADS=4"]
+        )
+        assert warped_ds.GetRasterBand(1).Checksum() == ref_cs
+
+        # Backmap generation and saving
+        backmap_filename = str(tmp_path / "backmap.tif")
+        warped_ds = gdal.Warp(
+            "",
+            ds,
+            format="MEM",
+            transformerOptions=["GEOLOC_BACKMAP_FILENAME=" + backmap_filename],
+        )
+        assert warped_ds.GetRasterBand(1).Checksum() == ref_cs
+
+        backmap_ds = gdal.Open(backmap_filename, gdal.GA_Update)
+        assert backmap_ds.RasterCount == 2
+        assert backmap_ds.GetMetadataItem("GEOLOC_BACKMAP_SIGNATURE") is not None
+        # Alter the persisted backmap to check that it is actually reused
+        backmap_ds.GetRasterBand(1).Fill(-10)
+        backmap_ds = None
+
+        warped_ds = gdal.Warp(
+            "",
+            ds,
+            format="MEM",
+            transformerOptions=["GEOLOC_BACKMAP_FILENAME=" + backmap_filename],
+        )
+        assert warped_ds.GetRasterBand(1).Checksum() != ref_cs
+
+        # A backmap generated with other parameters is not reused
+        warped_ds = gdal.Warp(
+            "",
+            ds,
+            format="MEM",
+            transformerOptions=[
+                "GEOLOC_BACKMAP_FILENAME=" + backmap_filename,
+                "GEOLOC_BACKMAP_OVERSAMPLE_FACTOR=1.2",
+            ],
+        )
+        assert warped_ds.GetRasterBand(1).Checksum() != 0
+        backmap_ds = gdal.Open(backmap_filename)
+        assert backmap_ds.GetRasterBand(1).ComputeRasterMinMax()[1] > 0
+
+
+###############################################################################
+# Test that Float32 geolocation arrays, held as Float32 in memory, give the
+# same result as when they are promoted to Float64
+
+
+@pytest.mark.parametrize("use_temp_datasets", ["YES", "NO"])
+def test_geoloc_float32_geoloc_array(tmp_path, use_temp_datasets):
+
+    lon_filename = "../alg/data/geoloc/longitude_including_pole.tif"
+    lat_filename = "../alg/data/geoloc/latitude_including_pole.tif"
+    assert gdal.Open(lon_filename).GetRasterBand(1).DataType == gdal.GDT_Float32
+
+    lon_float64 = str(tmp_path / "lon_float64.tif")
+    lat_float64 = str(tmp_path / "lat_float64.tif")
+    gdal.Translate(lon_float64, lon_filename, outputType=gdal.GDT_Float64)
+    gdal.Translate(lat_float64, lat_filename, outputType=gdal.GDT_Float64)
+
+    def get_checksum(x_dataset, y_dataset):
+        ds = gdal.GetDriverByName("MEM").Create("", 200, 372)
+        md = {
+            "LINE_OFFSET": "0",
+            "LINE_STEP": "1",
+            "PIXEL_OFFSET": "0",
+            "PIXEL_STEP": "1",
+            "X_DATASET": x_dataset,
+            "X_BAND": "1",
+            "Y_DATASET": y_dataset,
+            "Y_BAND": "1",
+            "SRS": "EPSG:4326",
+        }
+        ds.SetMetadata(md, "GEOLOCATION")
+        ds.GetRasterBand(1).Fill(1)
+        return gdal.Warp("", ds, format="MEM").GetRasterBand(1).Checksum()
+
+    with gdaltest.config_option("GDAL_GEOLOC_USE_TEMP_DATASETS", use_temp_datasets):
+        assert get_checksum(lon_filename, lat_filename) == get_checksum(
+            lon_float64, lat_float64
+        )
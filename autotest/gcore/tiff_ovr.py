@@ -1817,6 +1817,52 @@ def test_tiff_ovr_sparse_ok_external_overview(apply_sparse):
     gdaltest.tiff_drv.Delete(filename)
 
 
+###############################################################################
+# Test that building overviews of a sparse file, skipping its empty regions,
+# gives the same result as on a non-sparse copy
+
+
+@pytest.mark.parametrize("resampling", ["NEAREST", "AVERAGE", "CUBIC"])
+def test_tiff_ovr_sparse_source_skip_empty_regions(tmp_path, resampling):
+
+    filename = str(tmp_path / "test_tiff_ovr_sparse_source_skip_empty_regions.tif")
+    ds = gdaltest.tiff_drv.Create(
+        filename,
+        512,
+        512,
+        2,
+        options=["SPARSE_OK=YES", "TILED=YES", "BLOCKXSIZE=64", "BLOCKYSIZE=64"],
+    )
+    for i in range(2):
+        ds.GetRasterBand(i + 1).SetNoDataValue(255)
+    src_ds = gdal.Open("data/byte.tif")
+    for i in range(2):
+        ds.GetRasterBand(i + 1).WriteRaster(
+            100, 300, 20, 20, src_ds.GetRasterBand(1).ReadRaster()
+        )
+    ds = None
+
+    ref_ds = gdal.Translate("", filename, format="MEM")
+    ref_ds.BuildOverviews(resampling, [2, 4, 8])
+
+    ds = gdal.Open(filename)
+    with gdaltest.config_option("SPARSE_OK_OVERVIEW", "YES"):
+        ds.BuildOverviews(resampling, [2, 4, 8])
+    ds = None
+
+    ds = gdal.Open(filename)
+    for i in range(2):
+        for j in range(3):
+            assert (
+                ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+                == ref_ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+            )
+    # Empty regions of the source are empty in the overviews too
+    (flags, _) = ds.GetRasterBand(1).GetOverview(0).GetDataCoverageStatus(0, 0, 64, 64)
+    assert flags == gdal.GDAL_DATA_COVERAGE_STATUS_EMPTY
+    ds = None
+
+
 ###############################################################################
 # Test overview on a dataset where width * height > 2 billion
 
@@ -2296,6 +2342,166 @@ def test_tiff_ovr_multithreading_multiband():
     gdal.Unlink("/vsimem/test.tif")
 
 
+###############################################################################
+# Test that computing all overview levels in a single pass gives the same
+# result as computing each level from the previous one read back
+
+
+@pytest.mark.parametrize("resampling", ["NEAREST", "AVERAGE", "CUBIC", "MODE"])
+@pytest.mark.parametrize("nodata", [None, 0])
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_tiff_ovr_multiband_cascade(resampling, nodata, num_threads):
+
+    width = 517
+    height = 301
+    src_ds = gdal.GetDriverByName("MEM").Create(
+        "", width, height, 3, gdal.GDT_UInt16
+    )
+    for i in range(3):
+        data = array.array(
+            "H",
+            [
+                ((x * 7 + y * 13 + i * 101) * (x + y)) % 1000
+                for y in range(height)
+                for x in range(width)
+            ],
+        )
+        src_ds.GetRasterBand(i + 1).WriteRaster(0, 0, width, height, data.tobytes())
+        if nodata is not None:
+            src_ds.GetRasterBand(i + 1).SetNoDataValue(nodata)
+
+    checksums = []
+    ovr_data = []
+    for max_memory in [None, "0"]:
+        filename = "/vsimem/test_tiff_ovr_multiband_cascade.tif"
+        ds = gdal.GetDriverByName("GTiff").CreateCopy(
+            filename,
+            src_ds,
+            options=["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=16", "COMPRESS=LZW"],
+        )
+        with gdaltest.config_options(
+            {
+                "GDAL_NUM_THREADS": num_threads,
+                "GDAL_OVR_CASCADE_MAX_MEMORY": max_memory,
+                "GDAL_TIFF_OVR_BLOCKSIZE": "16",
+            }
+        ):
+            ds.BuildOverviews(resampling, [2, 4, 8, 16])
+        ds = None
+
+        ds = gdal.Open(filename)
+        assert ds.GetRasterBand(1).GetOverviewCount() == 4
+        checksums.append(
+            [
+                ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+                for i in range(3)
+                for j in range(4)
+            ]
+        )
+        ovr_data.append(
+            [
+                ds.GetRasterBand(i + 1).GetOverview(j).ReadRaster()
+                for i in range(3)
+                for j in range(4)
+            ]
+        )
+        ds = None
+        gdal.Unlink(filename)
+
+    assert checksums[0] == checksums[1]
+    assert ovr_data[0] == ovr_data[1]
+
+
+###############################################################################
+# Test partial refresh of overviews with the REFRESH_REGIONS and
+# REFRESH_DIRTY_REGIONS options of BuildOverviews()
+
+
+@pytest.mark.parametrize("resampling", ["AVERAGE", "CUBIC"])
+@pytest.mark.parametrize("option", ["REFRESH_REGIONS", "REFRESH_DIRTY_REGIONS"])
+def test_tiff_ovr_partial_refresh(resampling, option):
+
+    filename = "/vsimem/test_tiff_ovr_partial_refresh.tif"
+    ref_filename = "/vsimem/test_tiff_ovr_partial_refresh_ref.tif"
+    ds = gdal.Translate(
+        filename,
+        "data/stefan_full_rgba.tif",
+        options="-b 1 -b 2 -b 3 -outsize 400 300",
+        creationOptions=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+    )
+    ds.BuildOverviews(resampling, [2, 4, 8])
+    ds = None
+
+    ds = gdal.Open(filename, gdal.GA_Update)
+    with gdaltest.config_option(
+        "GDAL_TRACK_DIRTY_REGIONS", "YES" if option == "REFRESH_DIRTY_REGIONS" else "NO"
+    ):
+        for i in range(3):
+            ds.GetRasterBand(i + 1).WriteRaster(
+                50,
+                60,
+                30,
+                20,
+                b"".join(bytes([(i * 40 + x) % 256]) for x in range(600)),
+            )
+    if option == "REFRESH_REGIONS":
+        ds.BuildOverviews(resampling, [], options=["REFRESH_REGIONS=50,60,30,20"])
+    else:
+        ds.BuildOverviews(resampling, [], options=["REFRESH_DIRTY_REGIONS=YES"])
+    ds = None
+
+    ref_ds = gdal.Translate(ref_filename, filename, options="-co TILED=YES")
+    ref_ds.BuildOverviews(resampling, [2, 4, 8])
+
+    ds = gdal.Open(filename)
+    for i in range(3):
+        for j in range(3):
+            assert (
+                ds.GetRasterBand(i + 1).GetOverview(j).ReadRaster()
+                == ref_ds.GetRasterBand(i + 1).GetOverview(j).ReadRaster()
+            ), (i, j)
+    ds = None
+    ref_ds = None
+
+    gdal.Unlink(filename)
+    gdal.Unlink(ref_filename)
+
+
+###############################################################################
+# Test partial refresh of overviews when there are none
+
+
+def test_tiff_ovr_partial_refresh_no_overviews():
+
+    filename = "/vsimem/test_tiff_ovr_partial_refresh_no_overviews.tif"
+    ds = gdal.Translate(filename, "data/byte.tif")
+    with gdaltest.error_handler():
+        assert (
+            ds.BuildOverviews("AVERAGE", [2], options=["REFRESH_REGIONS=0,0,10,10"])
+            != 0
+        )
+    ds = None
+    gdal.Unlink(filename)
+
+
+###############################################################################
+# Test that REFRESH_DIRTY_REGIONS requires dirty region tracking
+
+
+def test_tiff_ovr_partial_refresh_dirty_regions_not_tracked():
+
+    filename = "/vsimem/test_tiff_ovr_partial_refresh_dirty_regions_not_tracked.tif"
+    ds = gdal.Translate(filename, "data/byte.tif")
+    ds.BuildOverviews("AVERAGE", [2])
+    ds.GetRasterBand(1).WriteRaster(0, 0, 1, 1, b"\0")
+    with gdaltest.error_handler():
+        assert (
+            ds.BuildOverviews("AVERAGE", [], options=["REFRESH_DIRTY_REGIONS=YES"])
+            != 0
+        )
+    ds = None
+    gdal.Unlink(filename)
+
 ###############################################################################
 
 
@@ -2779,6 +2985,55 @@ def test_tiff_ovr_external_3_px_wide_1_px_tall():
     gdal.GetDriverByName("GTiff").Delete(temp_path)
 
 
+###############################################################################
+# Test nearest neighbour resampling by a factor of 2 (SIMD code path)
+
+
+@pytest.mark.parametrize(
+    "datatype,fmt",
+    [
+        (gdal.GDT_Byte, "B"),
+        (gdal.GDT_UInt16, "H"),
+        (gdal.GDT_Int16, "h"),
+        (gdal.GDT_Float32, "f"),
+    ],
+)
+@pytest.mark.parametrize("width", [2, 34, 66, 67])
+def test_tiff_ovr_nearest_factor_2(datatype, fmt, width):
+
+    height = 4
+    src_ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, datatype)
+    if fmt == "B":
+        vals = [(i * 37) % 256 for i in range(width * height)]
+    elif fmt == "H":
+        vals = [65535 - (i * 997) % 65536 for i in range(width * height)]
+    elif fmt == "h":
+        vals = [(i * 997) % 65536 - 32768 for i in range(width * height)]
+    else:
+        vals = [i * 1.5 - 100 for i in range(width * height)]
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, width, height, struct.pack(fmt * len(vals), *vals)
+    )
+
+    ovr_width = (width + 1) // 2
+    ovr_ds = gdal.GetDriverByName("MEM").Create(
+        "", ovr_width, height // 2, 1, datatype
+    )
+    gdal.RegenerateOverview(
+        src_ds.GetRasterBand(1), ovr_ds.GetRasterBand(1), "NEAREST"
+    )
+    got = struct.unpack(
+        fmt * (ovr_width * (height // 2)), ovr_ds.GetRasterBand(1).ReadRaster()
+    )
+
+    x_ratio = width / ovr_width
+    expected = []
+    for y in range(height // 2):
+        for x in range(ovr_width):
+            expected.append(vals[2 * y * width + int(0.5 + x * x_ratio)])
+    assert list(got) == expected
+
+
 ###############################################################################
 # Cleanup
 
@@ -2119,6 +2119,41 @@ def test_tiff_direct_and_virtual_mem_io():
             pytest.fail("missing code coverage in VirtualMemIO()")
 
 
+###############################################################################
+# Test GTIFF_VIRTUAL_MEM_IO=AUTO mode on local uncompressed files
+
+
+@pytest.mark.parametrize("truncated", [False, True])
+def test_tiff_read_virtual_mem_io_auto(tmp_path, truncated):
+
+    filename = str(tmp_path / "test_tiff_read_virtual_mem_io_auto.tif")
+    src_ds = gdal.Open("data/stefan_full_rgba.tif")
+    gdal.GetDriverByName("GTiff").CreateCopy(
+        filename, src_ds, options=["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=16"]
+    )
+    if truncated:
+        size = os.stat(filename).st_size
+        with open(filename, "r+b") as f:
+            f.truncate(size - 100)
+
+    def read():
+        ds = gdal.Open(filename)
+        with gdal.quiet_errors():
+            gdal.ErrorReset()
+            try:
+                data = ds.ReadRaster(1, 2, 100, 50, buf_xsize=50, buf_ysize=25)
+            except Exception:
+                data = None
+            band_data = ds.GetRasterBand(2).ReadRaster()
+            return data, band_data, gdal.GetLastErrorMsg()
+
+    with gdaltest.config_option("GTIFF_VIRTUAL_MEM_IO", "NO"):
+        ref = read()
+    with gdaltest.config_option("GTIFF_VIRTUAL_MEM_IO", "AUTO"):
+        got = read()
+    assert got == ref
+
+
 ###############################################################################
 # Check read Digital Globe metadata IMD & RPB format
 
@@ -4808,6 +4843,54 @@ def test_tiff_read_multi_threaded(
     gdal.Unlink(tmpfile)
 
 
+###############################################################################
+# Test multi-threaded decoding of implicit JPEG overviews
+
+
+@pytest.mark.parametrize(
+    "creation_options",
+    [
+        ["TILED=YES"],
+        ["TILED=YES", "PHOTOMETRIC=YCBCR"],
+        ["TILED=YES", "INTERLEAVE=BAND"],
+        [],
+    ],
+)
+@pytest.mark.require_driver("JPEG")
+def test_tiff_read_multi_threaded_implicit_jpeg_overviews(
+    tmp_path, creation_options
+):
+
+    tmpfile = str(tmp_path / "test.tif")
+    src_ds = gdal.Open("data/rgbsmall.tif")
+    gdal.Translate(
+        tmpfile,
+        src_ds,
+        width=1024,
+        height=1000,
+        creationOptions=["COMPRESS=JPEG", "BLOCKXSIZE=128", "BLOCKYSIZE=128"]
+        + creation_options,
+    )
+
+    def read_overviews(open_options):
+        ret = []
+        ds = gdal.OpenEx(tmpfile, open_options=open_options)
+        assert ds.GetRasterBand(1).GetOverviewCount() == 3
+        ovr = ds.GetRasterBand(1).GetOverview(0)
+        assert ovr.GetDataset().GetMetadataItem("COMPRESSION", "IMAGE_STRUCTURE")
+        ovr_ds = ovr.GetDataset()
+        ret.append(ovr_ds.ReadRaster())
+        ret.append(ovr_ds.ReadRaster(10, 20, 300, 200))
+        ret.append(ovr_ds.GetRasterBand(2).ReadRaster(50, 60, 400, 300))
+        ret.append(
+            ds.GetRasterBand(1).GetOverview(1).ReadRaster(buf_xsize=100, buf_ysize=90)
+        )
+        ret.append(ds.ReadRaster(buf_xsize=256, buf_ysize=250))
+        return ret
+
+    assert read_overviews(["NUM_THREADS=ALL_CPUS"]) == read_overviews([])
+
+
 ###############################################################################
 # Test multi-threaded decoding with /vsicurl
 
@@ -1345,3 +1345,73 @@ def test_tiff_srs_read_compound_without_EPSG_code():
     assert got_srs.IsSame(srs)
     ds = None
     gdal.Unlink(filename)
+
+
+###############################################################################
+# Test the process-wide cache of SRS built from GeoTIFF keys
+
+
+def test_tiff_srs_cache():
+
+    srs = osr.SpatialReference()
+    srs.SetFromUserInput("EPSG:4326+5709")
+    srs.SetAxisMappingStrategy(osr.OAMS_TRADITIONAL_GIS_ORDER)
+    filenames = ["/vsimem/test_tiff_srs_cache_%d.tif" % i for i in range(2)]
+    for filename in filenames:
+        ds = gdal.GetDriverByName("GTiff").Create(filename, 1, 1)
+        ds.SetSpatialRef(srs)
+        ds = None
+
+    with gdaltest.config_option("GTIFF_SRS_CACHE", "NO"):
+        ds = gdal.Open(filenames[0])
+        ref_wkt = ds.GetSpatialRef().ExportToWkt(["FORMAT=WKT2_2019"])
+        ds = None
+
+    def get_srs_and_cache_hit(filename):
+        msgs = []
+
+        def handler(eErrClass, err_no, msg):
+            msgs.append(msg)
+
+        with gdaltest.config_option("CPL_DEBUG", "GTiff"):
+            ds = gdal.Open(filename)
+            gdal.PushErrorHandler(handler)
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            try:
+                got_srs = ds.GetSpatialRef()
+            finally:
+                gdal.PopErrorHandler()
+        return got_srs, "GTiff: SRS found in cache" in msgs
+
+    try:
+        # The second and third opening are served from the cache
+        for i, filename in enumerate(filenames + [filenames[0]]):
+            got_srs, cache_hit = get_srs_and_cache_hit(filename)
+            if i > 0:
+                assert cache_hit
+            assert got_srs.ExportToWkt(["FORMAT=WKT2_2019"]) == ref_wkt
+            assert got_srs.IsSame(srs)
+
+        # Configuration options affecting the SRS are part of the cache key
+        for key, value in [
+            ("GTIFF_ESRI_CITATION", "NO"),
+            ("OSR_USE_NON_DEPRECATED", "NO"),
+        ]:
+            with gdaltest.config_option(key, value):
+                _, cache_hit = get_srs_and_cache_hit(filenames[0])
+                assert not cache_hit
+                _, cache_hit = get_srs_and_cache_hit(filenames[0])
+                assert cache_hit
+
+        # Post-processing of the cached SRS must still be applied
+        with gdaltest.config_option("GTIFF_REPORT_COMPD_CS", "NO"):
+            ds = gdal.Open(filenames[1])
+            assert not ds.GetSpatialRef().IsCompound()
+            ds = None
+
+        ds = gdal.Open(filenames[1])
+        assert ds.GetSpatialRef().IsCompound()
+        ds = None
+    finally:
+        for filename in filenames:
+            gdal.Unlink(filename)
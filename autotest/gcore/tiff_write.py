@@ -34,6 +34,7 @@ import os
 import shutil
 import struct
 import sys
+import threading
 
 import gdaltest
 import pytest
@@ -7578,6 +7579,41 @@ def test_tiff_write_156():
     gdaltest.tiff_drv.Delete("/vsimem/tiff_write_156.tif")
 
 
+###############################################################################
+# Test that GetDataCoverageStatus() in update mode takes into account blocks
+# not yet written, and that statistics skip empty blocks
+
+
+def test_tiff_write_sparse_coverage_and_statistics(tmp_path):
+
+    filename = str(tmp_path / "test_tiff_write_sparse_coverage_and_statistics.tif")
+    ds = gdaltest.tiff_drv.Create(
+        filename,
+        256,
+        256,
+        options=["SPARSE_OK=YES", "TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32"],
+    )
+    ds.GetRasterBand(1).SetNoDataValue(0)
+    ds.GetRasterBand(1).WriteRaster(32, 32, 2, 1, b"\x01\x03")
+
+    (flags, _) = ds.GetRasterBand(1).GetDataCoverageStatus(32, 32, 32, 32)
+    assert flags == gdal.GDAL_DATA_COVERAGE_STATUS_DATA
+    (flags, _) = ds.GetRasterBand(1).GetDataCoverageStatus(64, 32, 32, 32)
+    assert flags == gdal.GDAL_DATA_COVERAGE_STATUS_EMPTY
+    ds = None
+
+    ds = gdal.Open(filename)
+    cache_used_before = gdal.GetCacheUsed()
+    assert ds.GetRasterBand(1).ComputeRasterMinMax(False) == (1, 3)
+    assert ds.GetRasterBand(1).ComputeStatistics(False)[0:3] == [1, 3, 2]
+    assert (
+        ds.GetRasterBand(1).GetMetadataItem("STATISTICS_VALID_PERCENT") == "0.003052"
+    )
+    # Only the non-empty block must have been read
+    assert gdal.GetCacheUsed() - cache_used_before <= 32 * 32
+    ds = None
+
+
 ###############################################################################
 # Test Float16
 
@@ -11245,5 +11281,64 @@ def test_tiff_write_offset_in_GDAL_METADATA_tag_metadata_in_pam():
     gdal.GetDriverByName("GTiff").Delete(filename)
 
 
+###############################################################################
+# Test writing disjoint tiles from several threads with CONCURRENT_WRITE=YES
+
+
+@pytest.mark.parametrize("interleave", ["PIXEL", "BAND"])
+def test_tiff_write_concurrent_write(interleave):
+
+    src_ds = gdal.Translate(
+        "", "data/rgbsmall.tif", options="-of MEM -outsize 500 500 -r bilinear"
+    )
+    filename = "/vsimem/test_tiff_write_concurrent_write.tif"
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename,
+        500,
+        500,
+        3,
+        options=[
+            "TILED=YES",
+            "BLOCKXSIZE=32",
+            "BLOCKYSIZE=32",
+            "COMPRESS=DEFLATE",
+            "INTERLEAVE=" + interleave,
+            "NUM_THREADS=4",
+            "CONCURRENT_WRITE=YES",
+        ],
+    )
+
+    errors = []
+
+    def write_rows(first_row):
+        try:
+            # Each thread writes one row of tiles out of 4
+            for y in range(first_row * 32, 500, 4 * 32):
+                ysize = min(32, 500 - y)
+                for x in range(0, 500, 64):
+                    xsize = min(64, 500 - x)
+                    data = src_ds.ReadRaster(x, y, xsize, ysize)
+                    assert ds.WriteRaster(x, y, xsize, ysize, data) == gdal.CE_None
+                    if x == 0:
+                        ds.GetRasterBand(1).ReadRaster(x, y, xsize, ysize)
+        except Exception as e:
+            errors.append(e)
+
+    threads = [threading.Thread(target=write_rows, args=(i,)) for i in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert not errors
+    ds = None
+
+    ds = gdal.Open(filename)
+    assert [ds.GetRasterBand(i + 1).Checksum() for i in range(3)] == [
+        src_ds.GetRasterBand(i + 1).Checksum() for i in range(3)
+    ]
+    ds = None
+    gdal.Unlink(filename)
+
+
 def test_tiff_write_cleanup():
     gdaltest.tiff_drv = None
@@ -500,6 +500,77 @@ def test_transformer_9():
     gdal.Unlink("/vsimem/dem.tif")
 
 
+###############################################################################
+# Test that batched DEM sampling and RPC_INVERSE_GRID_STEP give the same
+# results as the point by point code path
+
+
+@pytest.mark.parametrize("dem_epsg", [4326, 32652])
+def test_transformer_rpc_dem_batch_and_inverse_grid(dem_epsg):
+
+    ds = gdal.Open("data/rpc.vrt")
+
+    ds_dem = gdal.GetDriverByName("GTiff").Create(
+        "/vsimem/dem.tif", 100, 100, 1, gdal.GDT_Byte
+    )
+    sr = osr.SpatialReference()
+    sr.ImportFromEPSG(dem_epsg)
+    ds_dem.SetProjection(sr.ExportToWkt())
+    if dem_epsg == 4326:
+        ds_dem.SetGeoTransform(
+            [
+                125.647968621436,
+                1.2111052640051412e-05,
+                0,
+                39.869926216038,
+                0,
+                -8.6569068979969188e-06,
+            ]
+        )
+    else:
+        ds_dem.SetGeoTransform([213300, 1, 0, 4418700, 0, -1])
+    import random
+
+    random.seed(0)
+    data = "".join([chr(40 + int(10 * random.random())) for _ in range(100 * 100)])
+    ds_dem.GetRasterBand(1).WriteRaster(0, 0, 100, 100, data)
+    ds_dem = None
+
+    try:
+        for method in ["near", "bilinear", "cubic"]:
+            options = [
+                "METHOD=RPC",
+                "RPC_DEM=/vsimem/dem.tif",
+                "RPC_DEMINTERPOLATION=%s" % method,
+            ]
+            tr = gdal.Transformer(ds, None, options)
+
+            # Points not on a same latitude, to avoid the whole line optimization
+            points = [(125.6482 + i * 1e-5, 39.86934 - i * 5e-6) for i in range(20)]
+            points.append((0, 0))
+            (pnts_batch, success_batch) = tr.TransformPoints(1, points)
+            for i, pnt in enumerate(points):
+                (success, pnt_ref) = tr.TransformPoint(1, pnt[0], pnt[1], 0)
+                assert success == success_batch[i], (method, i)
+                if success:
+                    assert pnts_batch[i] == pnt_ref, (method, i)
+
+            # Inverse transform with a coarse inverse grid
+            tr_grid = gdal.Transformer(ds, None, options + ["RPC_INVERSE_GRID_STEP=4"])
+            pixels = [(20 + 0.5 * i, 10 + 0.25 * i, 0) for i in range(20)]
+            (pnts_ref, success_ref) = tr.TransformPoints(0, pixels)
+            (pnts_grid, success_grid) = tr_grid.TransformPoints(0, pixels)
+            for i in range(len(pixels)):
+                assert success_grid[i] == success_ref[i], (method, i)
+                if not success_ref[i]:
+                    continue
+                (_, back) = tr.TransformPoint(1, pnts_grid[i][0], pnts_grid[i][1], 0)
+                assert back[0] == pytest.approx(pixels[i][0], abs=0.1), (method, i)
+                assert back[1] == pytest.approx(pixels[i][1], abs=0.1), (method, i)
+    finally:
+        gdal.Unlink("/vsimem/dem.tif")
+
+
 ###############################################################################
 # Test RPC DEM transform from geoid height to ellipsoidal height
 
@@ -1020,6 +1091,73 @@ def test_transformer_tps_precision():
     assert maxDiffResult < 1e-3, "at least one transformation exceeds the error bound"
 
 
+###############################################################################
+# Test local thin plate splines (TPS_METHOD=LOCAL) with lots of GCPs (2115).
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_transformer_tps_local(num_threads):
+
+    ds = gdal.Open("data/gcps_2115.vrt")
+    tr = gdal.Transformer(
+        ds,
+        None,
+        [
+            "METHOD=GCP_TPS",
+            "TPS_METHOD=LOCAL",
+            "TPS_LOCAL_GCPS_PER_TILE=32",
+            "NUM_THREADS=" + num_threads,
+        ],
+    )
+    assert tr, "tps transformation could not be computed"
+
+    # Interpolation must still be exact at the GCPs
+    gcps = ds.GetGCPs()
+    points = [(gcp.GCPPixel, gcp.GCPLine) for gcp in gcps]
+    results, successes = tr.TransformPoints(0, points)
+    assert all(successes)
+    for gcp, result in zip(gcps, results):
+        assert result[0] == pytest.approx(gcp.GCPX, abs=1e-3)
+        assert result[1] == pytest.approx(gcp.GCPY, abs=1e-3)
+
+    points = [(gcp.GCPX, gcp.GCPY) for gcp in gcps]
+    results, successes = tr.TransformPoints(1, points)
+    assert all(successes)
+    for gcp, result in zip(gcps, results):
+        assert result[0] == pytest.approx(gcp.GCPPixel, abs=1e-3)
+        assert result[1] == pytest.approx(gcp.GCPLine, abs=1e-3)
+
+    # Continuity between GCPs: close points have close results
+    (_, pnt1) = tr.TransformPoint(0, 100, 100)
+    (_, pnt2) = tr.TransformPoint(0, 100.001, 100)
+    (_, pnt_global) = gdal.Transformer(ds, None, ["METHOD=GCP_TPS"]).TransformPoint(
+        0, 100, 100
+    )
+    assert pnt1[0] == pytest.approx(pnt2[0], abs=1e-1)
+    assert pnt1[1] == pytest.approx(pnt2[1], abs=1e-1)
+    assert pnt1[0] == pytest.approx(pnt_global[0], rel=1e-3)
+    assert pnt1[1] == pytest.approx(pnt_global[1], rel=1e-3)
+
+
+def test_transformer_tps_local_invalid_options():
+
+    ds = gdal.Open("data/gcps_2115.vrt")
+    with gdaltest.error_handler():
+        assert (
+            gdal.Transformer(ds, None, ["METHOD=GCP_TPS", "TPS_METHOD=INVALID"])
+            is None
+        )
+    with gdaltest.error_handler():
+        assert (
+            gdal.Transformer(
+                ds,
+                None,
+                ["METHOD=GCP_TPS", "TPS_METHOD=LOCAL", "TPS_LOCAL_GCPS_PER_TILE=0"],
+            )
+            is None
+        )
+
+
 ###############################################################################
 def test_transformer_image_no_srs():
 
@@ -1051,6 +1051,36 @@ def test_vrt_read_25():
     )
 
 
+###############################################################################
+# Test that GetDataCoverageStatus() is forwarded to a simple source without
+# resampling
+
+
+@pytest.mark.require_geos
+def test_vrt_read_data_coverage_status_forwarded_to_source(tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        src_filename,
+        256,
+        256,
+        options=["SPARSE_OK=YES", "TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32"],
+    )
+    ds.GetRasterBand(1).WriteRaster(64, 64, 1, 1, b"\x01")
+    ds = None
+
+    ds = gdal.Translate("", src_filename, format="VRT", srcWin=[32, 32, 128, 128])
+    (flags, pct) = ds.GetRasterBand(1).GetDataCoverageStatus(0, 0, 32, 32)
+    assert flags == gdal.GDAL_DATA_COVERAGE_STATUS_EMPTY and pct == 0.0
+    (flags, pct) = ds.GetRasterBand(1).GetDataCoverageStatus(32, 32, 32, 32)
+    assert flags == gdal.GDAL_DATA_COVERAGE_STATUS_DATA and pct == 100.0
+
+    # Not forwarded if there is resampling
+    ds = gdal.Translate("", src_filename, format="VRT", width=128, height=128)
+    (flags, pct) = ds.GetRasterBand(1).GetDataCoverageStatus(0, 0, 16, 16)
+    assert flags == gdal.GDAL_DATA_COVERAGE_STATUS_DATA and pct == 100.0
+
+
 ###############################################################################
 # Test consistency of RasterIO() with resampling, that is extracting different
 # sub-windows give consistent results
@@ -825,6 +825,116 @@ def test_vsiaz_write_appendblob_retry():
                 gdal.VSIFCloseL(f)
 
 
+###############################################################################
+# Test write of a block blob whose blocks are uploaded by background threads
+
+
+def test_vsiaz_write_blockblob_background_upload():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    with gdaltest.config_options(
+        {"VSIAZ_CHUNK_SIZE_BYTES": "10", "CPL_VSIL_CURL_UPLOAD_NUM_THREADS": "2"},
+        thread_local=False,
+    ):
+        f = gdal.VSIFOpenL("/vsiaz/test_copy/file.bin", "wb")
+        assert f is not None
+
+        handler = webserver.SequentialHandler()
+        # Blocks may be received in any order
+        for block_id, block_content in (
+            (1, b"0123456789"),
+            (2, b"abcdefghij"),
+            (3, b"klmno"),
+        ):
+            handler.add_unordered(
+                "PUT",
+                "/azure/blob/myaccount/test_copy/file.bin?blockid=%012d&comp=block"
+                % block_id,
+                201,
+                expected_headers={"Content-Length": str(len(block_content))},
+                expected_body=block_content,
+            )
+
+        expected_content = """<?xml version="1.0" encoding="utf-8"?>
+<BlockList>
+<Latest>000000000001</Latest>
+<Latest>000000000002</Latest>
+<Latest>000000000003</Latest>
+</BlockList>
+"""
+
+        def method(request):
+            h = request.headers
+            if h.get("Content-Length") != str(len(expected_content)):
+                sys.stderr.write("Bad headers: %s\n" % str(h))
+                request.send_response(403)
+                request.send_header("Content-Length", 0)
+                request.end_headers()
+                return
+
+            request.protocol_version = "HTTP/1.1"
+            request.wfile.write("HTTP/1.1 100 Continue\r\n\r\n".encode("ascii"))
+            content = request.rfile.read(len(expected_content)).decode("ascii")
+            if content != expected_content:
+                sys.stderr.write("Bad content: %s\n" % str(content))
+                request.send_response(403)
+                request.send_header("Content-Length", 0)
+                request.end_headers()
+                return
+            request.send_response(201)
+            request.send_header("Content-Length", 0)
+            request.end_headers()
+
+        handler.add_unordered(
+            "PUT",
+            "/azure/blob/myaccount/test_copy/file.bin?comp=blocklist",
+            custom_method=method,
+        )
+
+        with webserver.install_http_handler(handler):
+            assert gdal.VSIFWriteL("0123456789abcdefghij", 1, 20, f) == 20
+            assert gdal.VSIFWriteL("klmno", 1, 5, f) == 5
+            assert gdal.VSIFCloseL(f) == 0
+
+        # A file smaller than the block size is created with a single PUT
+        f = gdal.VSIFOpenL("/vsiaz/test_copy/small_file.bin", "wb")
+        assert f is not None
+
+        def method(request):
+            if request.headers.get("x-ms-blob-type") != "BlockBlob":
+                sys.stderr.write("Bad headers: %s\n" % str(request.headers))
+                request.send_response(403)
+                request.send_header("Content-Length", 0)
+                request.end_headers()
+                return
+            request.protocol_version = "HTTP/1.1"
+            request.wfile.write("HTTP/1.1 100 Continue\r\n\r\n".encode("ascii"))
+            content = request.rfile.read(3).decode("ascii")
+            if content != "foo":
+                sys.stderr.write("Bad content: %s\n" % str(content))
+                request.send_response(403)
+                request.send_header("Content-Length", 0)
+                request.end_headers()
+                return
+            request.send_response(201)
+            request.send_header("Content-Length", 0)
+            request.end_headers()
+
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "PUT",
+            "/azure/blob/myaccount/test_copy/small_file.bin",
+            custom_method=method,
+        )
+        with webserver.install_http_handler(handler):
+            assert gdal.VSIFWriteL("foo", 1, 3, f) == 3
+            assert gdal.VSIFCloseL(f) == 0
+
+
 ###############################################################################
 # Test Unlink()
 
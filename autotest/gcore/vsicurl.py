@@ -28,7 +28,9 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import json
 import sys
+import threading
 import time
 
 import gdaltest
@@ -1092,6 +1094,381 @@ def test_vsicurl_test_CPL_VSIL_CURL_USE_HEAD_NO():
     gdal.VSIFCloseL(f)
 
 
+###############################################################################
+# Test that the read-ahead size is kept on small forward gaps once sequential
+# reading has been detected
+
+
+def test_vsicurl_read_ahead_kept_on_small_forward_gaps():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    handler = webserver.SequentialHandler()
+    handler.add("GET", "/test_read_ahead/", 404)
+    handler.add(
+        "HEAD", "/test_read_ahead/test.bin", 200, {"Content-Length": "1000000"}
+    )
+    for start, end in (
+        (0, 16383),
+        (16384, 49151),
+        (49152, 114687),
+        (131072, 196607),
+    ):
+        handler.add(
+            "GET",
+            "/test_read_ahead/test.bin",
+            206,
+            {"Content-Range": "bytes %d-%d/1000000" % (start, end)},
+            b"x" * (end - start + 1),
+            expected_headers={"Range": "bytes=%d-%d" % (start, end)},
+        )
+    with webserver.install_http_handler(handler):
+        f = gdal.VSIFOpenL(
+            "/vsicurl/http://localhost:%d/test_read_ahead/test.bin"
+            % gdaltest.webserver_port,
+            "rb",
+        )
+        assert f is not None
+        for offset in (0, 16384, 49152, 131072):
+            gdal.VSIFSeekL(f, offset, 0)
+            assert len(gdal.VSIFReadL(1, 100, f)) == 100
+        gdal.VSIFCloseL(f)
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test that concurrent reads of the same region issue a single request
+
+
+def test_vsicurl_merge_concurrent_reads():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    def method(request):
+        # Make sure the second thread starts reading while the first
+        # download is in progress
+        time.sleep(0.5)
+        assert request.headers["Range"] == "bytes=0-16383"
+        request.protocol_version = "HTTP/1.1"
+        request.send_response(206)
+        request.send_header("Content-Range", "bytes 0-16383/1000000")
+        request.send_header("Content-Length", 16384)
+        request.end_headers()
+        request.wfile.write(b"x" * 16384)
+
+    handler = webserver.SequentialHandler()
+    handler.add("GET", "/test_merge_concurrent_reads/", 404)
+    handler.add(
+        "HEAD",
+        "/test_merge_concurrent_reads/test.bin",
+        200,
+        {"Content-Length": "1000000"},
+    )
+    handler.add("GET", "/test_merge_concurrent_reads/test.bin", custom_method=method)
+
+    filename = (
+        "/vsicurl/http://localhost:%d/test_merge_concurrent_reads/test.bin"
+        % gdaltest.webserver_port
+    )
+    results = [None, None]
+
+    def read(idx):
+        f = gdal.VSIFOpenL(filename, "rb")
+        results[idx] = gdal.VSIFReadL(1, 100, f)
+        gdal.VSIFCloseL(f)
+
+    with webserver.install_http_handler(handler):
+        gdal.VSIStatL(filename)
+        threads = [threading.Thread(target=read, args=(i,)) for i in range(2)]
+        threads[0].start()
+        time.sleep(0.1)
+        threads[1].start()
+        for t in threads:
+            t.join()
+
+    assert results[0] == b"x" * 100
+    assert results[1] == b"x" * 100
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test splitting a large read into parallel range requests
+
+
+def test_vsicurl_parallel_range_requests():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    content = bytes(i % 251 for i in range(65536))
+
+    def method(request):
+        # Ranges may be received in any order
+        start, end = [
+            int(x) for x in request.headers["Range"][len("bytes=") :].split("-")
+        ]
+        request.send_response(206)
+        request.send_header("Content-Range", "bytes %d-%d/65536" % (start, end))
+        request.send_header("Content-Length", end - start + 1)
+        request.end_headers()
+        request.wfile.write(content[start : end + 1])
+
+    handler = webserver.SequentialHandler()
+    handler.add("GET", "/test_parallel_range/", 404)
+    handler.add(
+        "HEAD", "/test_parallel_range/test.bin", 200, {"Content-Length": "65536"}
+    )
+    handler.add("GET", "/test_parallel_range/test.bin", custom_method=method)
+    handler.add("GET", "/test_parallel_range/test.bin", custom_method=method)
+
+    with gdaltest.config_options(
+        {
+            "CPL_VSIL_CURL_PARALLEL_RANGE_COUNT": "2",
+            "CPL_VSIL_CURL_PARALLEL_RANGE_MIN_SIZE": "16384",
+        }
+    ), webserver.install_http_handler(handler):
+        f = gdal.VSIFOpenL(
+            "/vsicurl/http://localhost:%d/test_parallel_range/test.bin"
+            % gdaltest.webserver_port,
+            "rb",
+        )
+        assert f is not None
+        data = gdal.VSIFReadL(1, 65536, f)
+        gdal.VSIFCloseL(f)
+
+    assert data == content
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test that parallel range requests of a read-ahead extending past the end of
+# file are all within the file
+
+
+def test_vsicurl_parallel_range_requests_past_eof():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    # Sequential reads of 16 KB make the read-ahead grow to 8 chunks when
+    # reading at offset 114688, whereas only 2 chunks remain in the file.
+    size = 114688 + 2 * 16384
+    content = bytes(i % 251 for i in range(size))
+
+    class Handler:
+        def __init__(self):
+            self.ranges = []
+
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            if request.path != "/test_parallel_range_eof/test.bin":
+                request.send_response(404)
+                request.end_headers()
+                return
+            request.send_response(200)
+            request.send_header("Content-Length", size)
+            request.end_headers()
+
+        def do_GET(self, request):
+            if request.path != "/test_parallel_range_eof/test.bin":
+                request.send_response(404)
+                request.end_headers()
+                return
+            start, end = [
+                int(x) for x in request.headers["Range"][len("bytes=") :].split("-")
+            ]
+            self.ranges.append((start, end))
+            if start >= size:
+                request.send_response(416)
+                request.send_header("Content-Range", "bytes */%d" % size)
+                request.send_header("Content-Length", 0)
+                request.end_headers()
+                return
+            end = min(end, size - 1)
+            request.send_response(206)
+            request.send_header("Content-Range", "bytes %d-%d/%d" % (start, end, size))
+            request.send_header("Content-Length", end - start + 1)
+            request.end_headers()
+            request.wfile.write(content[start : end + 1])
+
+    handler = Handler()
+    with gdaltest.config_options(
+        {
+            "CPL_VSIL_CURL_PARALLEL_RANGE_COUNT": "2",
+            "CPL_VSIL_CURL_PARALLEL_RANGE_MIN_SIZE": "16384",
+        }
+    ), webserver.install_http_handler(handler):
+        f = gdal.VSIFOpenL(
+            "/vsicurl/http://localhost:%d/test_parallel_range_eof/test.bin"
+            % gdaltest.webserver_port,
+            "rb",
+        )
+        assert f is not None
+        data = b""
+        while len(data) < size:
+            chunk = gdal.VSIFReadL(1, 16384, f)
+            assert chunk
+            data += chunk
+        gdal.VSIFCloseL(f)
+
+    assert data == content
+    assert (114688, 131071) in handler.ranges
+    assert (131072, size - 1) in handler.ranges
+    for start, end in handler.ranges:
+        assert end < size, handler.ranges
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test that a hedged request is issued for a range request that does not
+# receive data within the hedge delay
+
+
+def test_vsicurl_hedged_requests():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    def slow_failing_method(request):
+        # As the test server is single-threaded, the hedged request can only
+        # be served after this one: make this one fail, so that the data can
+        # only come from the hedged request. Without it, the read would be
+        # retried with a regular request, served by the same handler,
+        # hence the check of the number of hedged requests below.
+        time.sleep(0.5)
+        request.send_response(500)
+        request.send_header("Content-Length", 0)
+        request.end_headers()
+
+    handler = webserver.SequentialHandler()
+    handler.add("GET", "/test_hedged/", 404)
+    handler.add("HEAD", "/test_hedged/test.bin", 200, {"Content-Length": "1000000"})
+    handler.add("GET", "/test_hedged/test.bin", custom_method=slow_failing_method)
+    handler.add(
+        "GET",
+        "/test_hedged/test.bin",
+        206,
+        {"Content-Range": "bytes 0-16383/1000000"},
+        b"x" * 16384,
+        expected_headers={"Range": "bytes=0-16383"},
+    )
+
+    gdal.NetworkStatsReset()
+    try:
+        with gdaltest.config_options(
+            {
+                "CPL_VSIL_CURL_HEDGED_REQUESTS": "YES",
+                "CPL_VSIL_CURL_HEDGE_DELAY": "0.1",
+                "CPL_VSIL_NETWORK_STATS_ENABLED": "YES",
+            },
+            thread_local=False,
+        ), webserver.install_http_handler(handler):
+            f = gdal.VSIFOpenL(
+                "/vsicurl/http://localhost:%d/test_hedged/test.bin"
+                % gdaltest.webserver_port,
+                "rb",
+            )
+            assert f is not None
+            data = gdal.VSIFReadL(1, 100, f)
+            gdal.VSIFCloseL(f)
+
+        assert data == b"x" * 100
+
+        j = json.loads(gdal.NetworkStatsGetAsSerializedJSON())
+        assert j["methods"]["GET"]["hedged_count"] == 1
+    finally:
+        gdal.NetworkStatsReset()
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test that connections to a host are reused between files
+
+
+@pytest.mark.skipif(not gdaltest.built_against_curl(), reason="curl not available")
+def test_vsicurl_connection_reuse_between_files():
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    def keep_alive_method(code, headers, body):
+        def method(request):
+            # Keep the connection open after the response
+            request.protocol_version = "HTTP/1.1"
+            request.send_response(code)
+            for k, v in headers.items():
+                request.send_header(k, v)
+            request.send_header("Content-Length", len(body))
+            request.end_headers()
+            if request.command != "HEAD":
+                request.wfile.write(body)
+
+        return method
+
+    handler = webserver.SequentialHandler()
+    for name in ("a.bin", "b.bin"):
+        handler.add(
+            "HEAD",
+            "/test_connection_reuse/" + name,
+            custom_method=keep_alive_method(200, {}, b"x" * 1000),
+        )
+        handler.add(
+            "GET",
+            "/test_connection_reuse/" + name,
+            custom_method=keep_alive_method(
+                206, {"Content-Range": "bytes 0-999/1000"}, b"x" * 1000
+            ),
+        )
+
+    gdal.VSICurlClearCache()
+    gdal.NetworkStatsReset()
+    try:
+        with gdaltest.config_options(
+            {
+                "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+                "CPL_VSIL_NETWORK_STATS_ENABLED": "YES",
+            },
+            thread_local=False,
+        ), webserver.install_http_handler(handler):
+            for name in ("a.bin", "b.bin"):
+                f = gdal.VSIFOpenL(
+                    "/vsicurl/http://localhost:%d/test_connection_reuse/%s"
+                    % (gdaltest.webserver_port, name),
+                    "rb",
+                )
+                assert f is not None
+                assert gdal.VSIFReadL(1, 10, f) == b"x" * 10
+                gdal.VSIFCloseL(f)
+
+        j = json.loads(gdal.NetworkStatsGetAsSerializedJSON())
+        assert j["connections"]["new"] <= 1
+        assert j["connections"]["reused"] >= 1
+    finally:
+        gdal.NetworkStatsReset()
+        # Close the kept-alive connection, since the Python server can only
+        # handle one connection at a time
+        gdal.VSICurlClearCache()
+
+
 ###############################################################################
 
 
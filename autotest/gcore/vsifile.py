@@ -29,8 +29,11 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import io
+import json
 import os
 import sys
+import tarfile
 import time
 
 import gdaltest
@@ -132,6 +135,111 @@ def test_vsifile_1():
     vsifile_generic("/vsimem/vsifile_1.bin")
 
 
+###############################################################################
+# Test /vsishm
+
+
+def test_vsifile_vsishm():
+
+    if "/vsishm/" not in gdal.GetFileSystemsPrefixes():
+        pytest.skip("/vsishm/ not available")
+
+    filename = "/vsishm/gdal_test_vsifile_vsishm_%d.bin" % os.getpid()
+    vsifile_generic(filename)
+
+    try:
+        fp = gdal.VSIFOpenL(filename, "wb")
+        assert fp is not None
+        assert gdal.VSIFWriteL(b"0123456789", 1, 10, fp) == 10
+        gdal.VSIFCloseL(fp)
+
+        # Check that the object is visible from another process
+        if sys.platform.startswith("linux"):
+            with open("/dev/shm/" + filename[len("/vsishm/") :], "rb") as f:
+                assert f.read() == b"0123456789"
+            assert filename[len("/vsishm/") :] in gdal.ReadDir("/vsishm/")
+            # Only accessible to its owner by default
+            st = os.stat("/dev/shm/" + filename[len("/vsishm/") :])
+            assert (st.st_mode & 0o077) == 0
+
+        fp = gdal.VSIFOpenL(filename, "rb")
+        assert fp is not None
+        gdal.VSIFSeekL(fp, 2, 0)
+        assert gdal.VSIFReadL(1, 3, fp) == b"234"
+        assert gdal.VSIFReadL(1, 10, fp) == b"56789"
+        assert gdal.VSIFEofL(fp)
+        gdal.VSIFCloseL(fp)
+
+        # Truncating a non-empty object is refused
+        with gdaltest.error_handler():
+            assert gdal.VSIFOpenL(filename, "wb") is None
+        assert gdal.VSIStatL(filename).size == 10
+
+        # Names with subdirectories are not supported
+        with gdaltest.error_handler():
+            assert gdal.VSIFOpenL("/vsishm/a/b", "wb") is None
+    finally:
+        gdal.Unlink(filename)
+
+    # Wider permissions must be requested explicitly
+    try:
+        with gdaltest.config_option("CPL_VSISHM_MODE", "0644"):
+            fp = gdal.VSIFOpenL(filename, "wb")
+        assert fp is not None
+        gdal.VSIFCloseL(fp)
+        if sys.platform.startswith("linux"):
+            umask = os.umask(0)
+            os.umask(umask)
+            st = os.stat("/dev/shm/" + filename[len("/vsishm/") :])
+            assert (st.st_mode & 0o777) == (0o644 & ~umask)
+    finally:
+        gdal.Unlink(filename)
+
+    with gdaltest.config_option("CPL_VSISHM_MODE", "rw"), gdaltest.error_handler():
+        assert gdal.VSIFOpenL(filename, "wb") is None
+
+
+###############################################################################
+# Test memory mapping of /vsishm/ files by the GTiff driver
+
+
+def test_vsifile_vsishm_gtiff_virtual_mem_io():
+
+    if "/vsishm/" not in gdal.GetFileSystemsPrefixes():
+        pytest.skip("/vsishm/ not available")
+    if not gdal.GetDriverByName("GTiff"):
+        pytest.skip("GTiff driver not available")
+
+    filename = "/vsishm/gdal_test_vsifile_vsishm_gtiff_%d.tif" % os.getpid()
+    debug_msgs = []
+
+    def handler(eErrClass, err_no, msg):
+        if eErrClass == gdal.CE_Debug:
+            debug_msgs.append(msg)
+
+    try:
+        gdal.Translate(filename, "data/byte.tif")
+
+        with gdaltest.config_options(
+            {"GTIFF_VIRTUAL_MEM_IO": "YES", "CPL_DEBUG": "GTiff"}
+        ):
+            ds = gdal.Open(filename)
+            gdal.PushErrorHandler(handler)
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            try:
+                data = ds.ReadRaster()
+            finally:
+                gdal.PopErrorHandler()
+            ds = None
+
+        # CPLVirtualMemFileMapNew() is only implemented on Linux
+        if sys.platform.startswith("linux"):
+            assert "GTiff: File mapped in memory for VirtualMemIO" in debug_msgs
+        assert data == gdal.Open("data/byte.tif").ReadRaster()
+    finally:
+        gdal.Unlink(filename)
+
+
 ###############################################################################
 # Test regular file system
 
@@ -766,6 +874,68 @@ def test_vsitar_bug_675():
     assert len(content) == 1
 
 
+###############################################################################
+# Test member lookup and persisted index of the list of members of a .tar
+
+
+def test_vsitar_archive_content_lookup_and_index():
+
+    members = {"a.txt": b"foo", "subdir/b.txt": b"bar"}
+    for i in range(500):
+        members["many/%d.txt" % i] = b"%d" % i
+
+    buf = io.BytesIO()
+    with tarfile.open(fileobj=buf, mode="w", format=tarfile.USTAR_FORMAT) as tar:
+        for name, content in members.items():
+            info = tarfile.TarInfo(name)
+            info.size = len(content)
+            info.mtime = 1000000000
+            tar.addfile(info, io.BytesIO(content))
+
+    tarfilename = "/vsimem/test_vsitar_archive_content.tar"
+    gdal.FileFromMemBuffer(tarfilename, buf.getvalue())
+
+    try:
+        with gdaltest.config_option("CPL_VSIL_ARCHIVE_WRITE_INDEX", "YES"):
+            assert gdal.ReadDir(f"/vsitar/{tarfilename}") == ["a.txt", "subdir", "many"]
+        assert gdal.VSIStatL(tarfilename + ".vsiidx") is not None
+
+        # Lookups by name of members and of implicit directories
+        assert len(gdal.ReadDir(f"/vsitar/{tarfilename}/many")) == 500
+        assert gdal.ReadDir(f"/vsitar/{tarfilename}/subdir") == ["b.txt"]
+        assert gdal.VSIStatL(f"/vsitar/{tarfilename}/subdir").IsDirectory()
+        assert gdal.VSIStatL(f"/vsitar/{tarfilename}/many/499.txt").size == 3
+        assert gdal.VSIStatL(f"/vsitar/{tarfilename}/many/500.txt") is None
+        assert gdal.VSIStatL(f"/vsitar/{tarfilename}/subdir/a.txt") is None
+        f = gdal.VSIFOpenL(f"/vsitar/{tarfilename}/many/123.txt", "rb")
+        assert f
+        assert gdal.VSIFReadL(1, 3, f) == b"123"
+        gdal.VSIFCloseL(f)
+
+        # Use another name, so that the cached content of the archive is not
+        # used, and patch the index to check that it is actually used
+        # (renaming preserves the modification time of the archive)
+        newtarfilename = "/vsimem/test_vsitar_archive_content_renamed.tar"
+        assert gdal.Rename(tarfilename, newtarfilename) == 0
+        f = gdal.VSIFOpenL(tarfilename + ".vsiidx", "rb")
+        index = gdal.VSIFReadL(1, 100000, f)
+        gdal.VSIFCloseL(f)
+        gdal.Unlink(tarfilename + ".vsiidx")
+        tarfilename = newtarfilename
+        gdal.FileFromMemBuffer(
+            tarfilename + ".vsiidx", index.replace(b"a.txt", b"z.txt")
+        )
+        assert gdal.ReadDir(f"/vsitar/{tarfilename}") == ["z.txt", "subdir", "many"]
+        f = gdal.VSIFOpenL(f"/vsitar/{tarfilename}/subdir/b.txt", "rb")
+        assert f
+        assert gdal.VSIFReadL(1, 3, f) == b"bar"
+        gdal.VSIFCloseL(f)
+
+    finally:
+        gdal.Unlink(tarfilename)
+        gdal.Unlink(tarfilename + ".vsiidx")
+
+
 ###############################################################################
 # Test multithreaded compression
 
@@ -795,6 +965,103 @@ def test_vsigzip_multi_thread():
         pytest.fail()
 
 
+###############################################################################
+# Test persistent seek index of /vsigzip/
+
+
+def test_vsigzip_seek_index():
+
+    filename = "/vsimem/vsigzip_seek_index.csv.gz"
+    content = "".join("%d,%d\n" % (i, (i * 7919) % 100003) for i in range(300000))
+    f = gdal.VSIFOpenL("/vsigzip/" + filename, "wb")
+    gdal.VSIFWriteL(content, 1, len(content), f)
+    gdal.VSIFCloseL(f)
+
+    try:
+        with gdaltest.config_options(
+            {"CPL_VSIL_GZIP_WRITE_INDEX": "YES", "CPL_VSIL_GZIP_INDEX_SPAN": "64K"}
+        ):
+            f = gdal.VSIFOpenL("/vsigzip/" + filename, "rb")
+            assert f
+            gdal.VSIFCloseL(f)
+        assert gdal.VSIStatL(filename + ".gzidx") is not None
+
+        # Copy to another file name so as not to hit the handle cache
+        filename2 = "/vsimem/vsigzip_seek_index2.csv.gz"
+        assert gdal.CopyFile(filename, filename2) == 0
+        assert gdal.CopyFile(filename + ".gzidx", filename2 + ".gzidx") == 0
+        assert gdal.VSIStatL("/vsigzip/" + filename2).size == len(content)
+
+        f = gdal.VSIFOpenL("/vsigzip/" + filename2, "rb")
+        assert f
+        for offset in (len(content) - 100, 1000000, 123456, 0, 2000000):
+            gdal.VSIFSeekL(f, offset, 0)
+            data = gdal.VSIFReadL(1, 100, f).decode("ascii")
+            assert data == content[offset : offset + 100], offset
+        gdal.VSIFSeekL(f, 0, 2)
+        assert gdal.VSIFTellL(f) == len(content)
+        gdal.VSIFCloseL(f)
+
+        # An index that does not match the .gz file must be ignored
+        filename3 = "/vsimem/vsigzip_seek_index3.csv.gz"
+        f = gdal.VSIFOpenL("/vsigzip/" + filename3, "wb")
+        gdal.VSIFWriteL(content[::-1], 1, len(content), f)
+        gdal.VSIFCloseL(f)
+        assert gdal.CopyFile(filename + ".gzidx", filename3 + ".gzidx") == 0
+        f = gdal.VSIFOpenL("/vsigzip/" + filename3, "rb")
+        assert f
+        gdal.VSIFSeekL(f, 1000000, 0)
+        data = gdal.VSIFReadL(1, 100, f).decode("ascii")
+        gdal.VSIFCloseL(f)
+        assert data == content[::-1][1000000:1000100]
+
+    finally:
+        for f in gdal.ReadDir("/vsimem/"):
+            if f.startswith("vsigzip_seek_index"):
+                gdal.Unlink("/vsimem/" + f)
+
+
+###############################################################################
+# Test parallel decompression of sequential reads using the seek index
+
+
+def test_vsigzip_seek_index_multithreaded_read():
+
+    filename = "/vsimem/vsigzip_seek_index_mt.csv.gz"
+    content = "".join("%d,%d\n" % (i, (i * 7919) % 100003) for i in range(300000))
+    f = gdal.VSIFOpenL("/vsigzip/" + filename, "wb")
+    gdal.VSIFWriteL(content, 1, len(content), f)
+    gdal.VSIFCloseL(f)
+
+    try:
+        with gdaltest.config_options(
+            {
+                "CPL_VSIL_GZIP_WRITE_INDEX": "YES",
+                "CPL_VSIL_GZIP_INDEX_SPAN": "64K",
+                "GDAL_NUM_THREADS": "4",
+            }
+        ):
+            f = gdal.VSIFOpenL("/vsigzip/" + filename, "rb")
+            assert f
+            data = b""
+            while True:
+                chunk = gdal.VSIFReadL(1, 100000, f)
+                data += chunk
+                if len(chunk) < 100000:
+                    break
+            assert data.decode("ascii") == content
+
+            # Backward seek, and sequential read again
+            gdal.VSIFSeekL(f, 12345, 0)
+            data = gdal.VSIFReadL(1, 2 * 1024 * 1024, f)
+            assert data.decode("ascii") == content[12345 : 12345 + 2 * 1024 * 1024]
+            gdal.VSIFCloseL(f)
+
+    finally:
+        gdal.Unlink(filename)
+        gdal.Unlink(filename + ".gzidx")
+
+
 ###############################################################################
 # Test vsisync()
 
@@ -1190,3 +1457,90 @@ def test_vsifile_copyfile():
     assert gdal.VSIStatL(dstfilename).size != 1000 * 1000
 
     gdal.Unlink(dstfilename)
+
+
+###############################################################################
+# Test I/O statistics
+
+
+def test_vsifile_io_stats():
+
+    filename = "/vsimem/test_vsifile_io_stats.bin"
+    gdal.FileFromMemBuffer(filename, b"x" * (2 * 1024 * 1024))
+
+    gdal.IOStatsReset()
+    try:
+        with gdaltest.config_option("CPL_VSIL_IO_STATS_ENABLED", "YES"):
+            assert gdal.VSIStatL(filename) is not None
+            f = gdal.VSIFOpenL(filename, "rb")
+            assert f
+            try:
+                assert len(gdal.VSIFReadL(1, 100, f)) == 100
+                assert len(gdal.VSIFReadL(1, 100, f)) == 100
+                gdal.VSIFSeekL(f, 2 * 1024 * 1024 - 100, 0)
+                assert len(gdal.VSIFReadL(1, 100000, f)) == 100
+                gdal.VSIFSeekL(f, 0, 0)
+                assert len(gdal.VSIFReadL(1, 10000, f)) == 10000
+            finally:
+                gdal.VSIFCloseL(f)
+
+        j = json.loads(gdal.IOStatsGetAsSerializedJSON())
+        fs = j["filesystems"]["vsimem"]
+        for stats in (fs, fs["files"][filename]):
+            assert stats["open_count"] == 1
+            assert stats["stat_count"] == 1
+            assert stats["read_count"] == 4
+            assert stats["read_bytes"] == 100 + 100 + 100 + 10000
+            assert stats["read_size_histogram"] == {"<=512": 3, "<=64K": 1}
+            assert stats["seek_distance_histogram"] == {
+                "sequential": 2,
+                "forward >1M": 1,
+                "backward >1M": 1,
+            }
+            assert sum(stats["read_latency_histogram"].values()) == 4
+            assert "write_count" not in stats
+
+        gdal.IOStatsReset()
+        assert json.loads(gdal.IOStatsGetAsSerializedJSON()) == {"filesystems": {}}
+
+        # Statistics collection is disabled by default
+        f = gdal.VSIFOpenL(filename, "rb")
+        gdal.VSIFReadL(1, 100, f)
+        gdal.VSIFCloseL(f)
+        assert json.loads(gdal.IOStatsGetAsSerializedJSON()) == {"filesystems": {}}
+
+    finally:
+        gdal.IOStatsReset()
+        gdal.Unlink(filename)
+
+
+###############################################################################
+# Test the limit on the number of files with individual I/O statistics
+
+
+def test_vsifile_io_stats_max_files():
+
+    filenames = ["/vsimem/test_vsifile_io_stats_max_files_%d.bin" % i for i in range(3)]
+    for filename in filenames:
+        gdal.FileFromMemBuffer(filename, b"x" * 100)
+
+    gdal.IOStatsReset()
+    try:
+        with gdaltest.config_options(
+            {"CPL_VSIL_IO_STATS_ENABLED": "YES", "CPL_VSIL_IO_STATS_MAX_FILES": "2"}
+        ):
+            for filename in filenames:
+                f = gdal.VSIFOpenL(filename, "rb")
+                assert len(gdal.VSIFReadL(1, 10, f)) == 10
+                gdal.VSIFCloseL(f)
+
+        fs = json.loads(gdal.IOStatsGetAsSerializedJSON())["filesystems"]["vsimem"]
+        assert fs["open_count"] == 3
+        assert set(fs["files"].keys()) == set(filenames[0:2])
+        assert fs["other_files"]["open_count"] == 1
+        assert fs["other_files"]["read_bytes"] == 10
+
+    finally:
+        gdal.IOStatsReset()
+        for filename in filenames:
+            gdal.Unlink(filename)
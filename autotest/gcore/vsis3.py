@@ -33,6 +33,7 @@ import os.path
 import stat
 import sys
 import tempfile
+import time
 import urllib
 
 import gdaltest
@@ -2046,6 +2047,20 @@ def test_vsis3_4(aws_test_config, webserver_port):
         assert gdal.GetLastErrorMsg() == ""
 
     j = json.loads(gdal.NetworkStatsGetAsSerializedJSON())
+
+    # Connection statistics contain timings, so check them separately
+    def pop_connections(obj):
+        if isinstance(obj, dict):
+            ret = obj.pop("connections", None)
+            for v in obj.values():
+                pop_connections(v)
+            return ret
+        return None
+
+    connections = pop_connections(j)
+    assert connections["new"] + connections["reused"] == 1
+    assert connections["time_to_first_byte_s"] >= 0
+
     assert j == {
         "methods": {"PUT": {"count": 1, "uploaded_bytes": 6}},
         "handlers": {
@@ -2966,6 +2981,118 @@ def test_vsis3_write_multipart_retry(aws_test_config, webserver_port):
                 gdal.VSIFCloseL(f)
 
 
+###############################################################################
+# Test multipart upload with parts uploaded by background threads
+
+
+def test_vsis3_write_multipart_background_upload(aws_test_config, webserver_port):
+
+    gdal.VSICurlClearCache()
+
+    with gdaltest.config_options(
+        {"VSIS3_CHUNK_SIZE_BYTES": "10", "CPL_VSIL_CURL_UPLOAD_NUM_THREADS": "2"},
+        thread_local=False,
+    ):
+        f = gdal.VSIFOpenL("/vsis3/s3_fake_bucket4/background_upload.bin", "wb")
+    assert f is not None
+
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "POST",
+        "/s3_fake_bucket4/background_upload.bin?uploads",
+        200,
+        {},
+        """<?xml version="1.0" encoding="UTF-8"?>
+        <InitiateMultipartUploadResult>
+        <UploadId>my_id</UploadId>
+        </InitiateMultipartUploadResult>""",
+    )
+    # Parts may be received in any order
+    for part_number, part_content in ((1, b"a" * 10), (2, b"b" * 10), (3, b"c" * 5)):
+        handler.add_unordered(
+            "PUT",
+            "/s3_fake_bucket4/background_upload.bin?partNumber=%d&uploadId=my_id"
+            % part_number,
+            200,
+            {"ETag": '"etag%d"' % part_number},
+            expected_headers={"Content-Length": str(len(part_content))},
+            expected_body=part_content,
+        )
+    handler.add_unordered(
+        "POST",
+        "/s3_fake_bucket4/background_upload.bin?uploadId=my_id",
+        200,
+        expected_body=b"""<CompleteMultipartUpload>
+<Part>
+<PartNumber>1</PartNumber><ETag>"etag1"</ETag></Part>
+<Part>
+<PartNumber>2</PartNumber><ETag>"etag2"</ETag></Part>
+<Part>
+<PartNumber>3</PartNumber><ETag>"etag3"</ETag></Part>
+</CompleteMultipartUpload>
+""",
+    )
+
+    with webserver.install_http_handler(handler):
+        assert gdal.VSIFWriteL("a" * 10 + "b" * 10, 1, 20, f) == 20
+        assert gdal.VSIFWriteL("c" * 5, 1, 5, f) == 5
+        assert gdal.VSIFCloseL(f) == 0
+
+
+###############################################################################
+# Test that a failure in the background upload of a part aborts the upload
+
+
+def test_vsis3_write_multipart_background_upload_failure(
+    aws_test_config, webserver_port
+):
+
+    gdal.VSICurlClearCache()
+
+    with gdaltest.config_options(
+        {"VSIS3_CHUNK_SIZE_BYTES": "10", "CPL_VSIL_CURL_UPLOAD_NUM_THREADS": "2"},
+        thread_local=False,
+    ):
+        f = gdal.VSIFOpenL("/vsis3/s3_fake_bucket4/background_upload.bin", "wb")
+    assert f is not None
+
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "POST",
+        "/s3_fake_bucket4/background_upload.bin?uploads",
+        200,
+        {},
+        """<?xml version="1.0" encoding="UTF-8"?>
+        <InitiateMultipartUploadResult>
+        <UploadId>my_id</UploadId>
+        </InitiateMultipartUploadResult>""",
+    )
+    handler.add_unordered(
+        "PUT",
+        "/s3_fake_bucket4/background_upload.bin?partNumber=1&uploadId=my_id",
+        200,
+        {"ETag": '"etag1"'},
+    )
+    handler.add_unordered(
+        "PUT",
+        "/s3_fake_bucket4/background_upload.bin?partNumber=2&uploadId=my_id",
+        403,
+    )
+    handler.add_unordered(
+        "DELETE",
+        "/s3_fake_bucket4/background_upload.bin?uploadId=my_id",
+        204,
+    )
+
+    with webserver.install_http_handler(handler):
+        assert gdal.VSIFWriteL("a" * 20, 1, 20, f) == 20
+        gdal.ErrorReset()
+        with gdaltest.error_handler():
+            assert gdal.VSIFCloseL(f) != 0
+        # The error emitted by the worker thread is reported to the caller
+        assert "UploadPart(2)" in gdal.GetLastErrorMsg()
+
+
 ###############################################################################
 # Test abort pending multipart uploads
 
@@ -4079,6 +4206,68 @@ def test_vsis3_no_useless_requests(aws_test_config, webserver_port):
         assert gdal.VSIStatL("/vsis3/no_useless_requests/baz.txt") is None
 
 
+###############################################################################
+# Test answering Stat() of side-car files from a single directory listing
+
+
+def test_vsis3_stat_use_dir_listing(aws_test_config, webserver_port):
+
+    gdal.VSICurlClearCache()
+
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "GET",
+        "/stat_use_dir_listing/?delimiter=%2F&prefix=subdir%2F",
+        200,
+        {"Content-type": "application/xml"},
+        """<?xml version="1.0" encoding="UTF-8"?>
+        <ListBucketResult>
+            <Prefix>subdir/</Prefix>
+            <Contents>
+                <Key>subdir/test.tif</Key>
+                <LastModified>2015-10-16T12:34:56.000Z</LastModified>
+                <Size>123</Size>
+            </Contents>
+        </ListBucketResult>
+        """,
+    )
+    with gdaltest.config_option(
+        "CPL_VSIL_CURL_STAT_USE_DIR_LISTING", "YES"
+    ), webserver.install_http_handler(handler):
+        stat_res = gdal.VSIStatL("/vsis3/stat_use_dir_listing/subdir/test.tif")
+        assert stat_res is not None
+        assert stat_res.size == 123
+        for ext in (".aux.xml", ".ovr", ".msk", ".tfw", ".prj"):
+            assert (
+                gdal.VSIStatL("/vsis3/stat_use_dir_listing/subdir/test" + ext) is None
+            )
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test expiration of cached file properties
+
+
+def test_vsis3_metadata_cache_ttl(aws_test_config, webserver_port):
+
+    gdal.VSICurlClearCache()
+
+    handler = webserver.SequentialHandler()
+    handler.add("HEAD", "/metadata_cache_ttl/test.bin", 200, {"Content-Length": "3"})
+    handler.add("HEAD", "/metadata_cache_ttl/test.bin", 200, {"Content-Length": "4"})
+    with gdaltest.config_option(
+        "CPL_VSIL_CURL_METADATA_CACHE_TTL", "0.2"
+    ), webserver.install_http_handler(handler):
+        assert gdal.VSIStatL("/vsis3/metadata_cache_ttl/test.bin").size == 3
+        # Served from the cache
+        assert gdal.VSIStatL("/vsis3/metadata_cache_ttl/test.bin").size == 3
+        time.sleep(0.3)
+        assert gdal.VSIStatL("/vsis3/metadata_cache_ttl/test.bin").size == 4
+
+    gdal.VSICurlClearCache()
+
+
 ###############################################################################
 # Test w+ access
 
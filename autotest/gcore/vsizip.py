@@ -935,6 +935,112 @@ def test_vsizip_byte_sozip():
         gdal.Unlink(zipfilename)
 
 
+###############################################################################
+# Test parallel decompression of SOZip chunks
+
+
+def test_vsizip_sozip_multithreaded_read():
+
+    zipfilename = "/vsimem/test_vsizip_sozip_multithreaded_read.zip"
+    srcfilename = "/vsimem/test_vsizip_sozip_multithreaded_read.txt"
+    dstfilename = f"/vsizip/{zipfilename}/test.txt"
+    content = "".join("%d,%d\n" % (i, (i * 7919) % 100003) for i in range(100000))
+    gdal.FileFromMemBuffer(srcfilename, content)
+    try:
+        options = ["SOZIP_ENABLED=YES", "SOZIP_CHUNK_SIZE=1024"]
+        assert gdal.CopyFile(srcfilename, dstfilename, options=options) == 0
+        md = gdal.GetFileMetadata(dstfilename, "ZIP")
+        assert md["SOZIP_VALID"] == "YES"
+
+        with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+            f = gdal.VSIFOpenL(dstfilename, "rb")
+            assert f
+            try:
+                data = gdal.VSIFReadL(1, len(content), f)
+                assert data.decode("ascii") == content
+                gdal.VSIFSeekL(f, 100000, 0)
+                data = gdal.VSIFReadL(1, 10000, f)
+                assert data.decode("ascii") == content[100000:110000]
+            finally:
+                gdal.VSIFCloseL(f)
+
+    finally:
+        gdal.Unlink(srcfilename)
+        gdal.Unlink(zipfilename)
+
+
+###############################################################################
+# Test persisted index of the list of members of an archive
+
+
+def test_vsizip_archive_index():
+
+    zipfilename = "/vsimem/test_vsizip_archive_index.zip"
+    for name, content in (("a.txt", "foo"), ("subdir/b.txt", "bar")):
+        f = gdal.VSIFOpenL(f"/vsizip/{zipfilename}/{name}", "wb")
+        assert f
+        gdal.VSIFWriteL(content, 1, len(content), f)
+        gdal.VSIFCloseL(f)
+
+    try:
+        with gdaltest.config_option("CPL_VSIL_ARCHIVE_WRITE_INDEX", "YES"):
+            assert gdal.ReadDir(f"/vsizip/{zipfilename}") == ["a.txt", "subdir"]
+        assert gdal.VSIStatL(zipfilename + ".vsiidx") is not None
+
+        # Use another name, so that the cached content of the archive is not
+        # used, and patch the index to check that it is actually used
+        # (renaming preserves the modification time of the archive)
+        newzipfilename = "/vsimem/test_vsizip_archive_index_renamed.zip"
+        assert gdal.Rename(zipfilename, newzipfilename) == 0
+        f = gdal.VSIFOpenL(zipfilename + ".vsiidx", "rb")
+        index = gdal.VSIFReadL(1, 10000, f)
+        gdal.VSIFCloseL(f)
+        gdal.Unlink(zipfilename + ".vsiidx")
+        gdal.FileFromMemBuffer(
+            newzipfilename + ".vsiidx", index.replace(b"a.txt", b"z.txt")
+        )
+        assert gdal.ReadDir(f"/vsizip/{newzipfilename}") == ["z.txt", "subdir"]
+        assert gdal.ReadDir(f"/vsizip/{newzipfilename}/subdir") == ["b.txt"]
+        assert gdal.VSIStatL(f"/vsizip/{newzipfilename}/subdir").IsDirectory()
+        assert gdal.VSIStatL(f"/vsizip/{newzipfilename}/subdir/b.txt").size == 3
+        f = gdal.VSIFOpenL(f"/vsizip/{newzipfilename}/subdir/b.txt", "rb")
+        assert f
+        assert gdal.VSIFReadL(1, 3, f) == b"bar"
+        gdal.VSIFCloseL(f)
+
+        # Index ignored
+        zipfilename = newzipfilename
+        newzipfilename = "/vsimem/test_vsizip_archive_index_renamed2.zip"
+        assert gdal.Rename(zipfilename, newzipfilename) == 0
+        assert gdal.Rename(zipfilename + ".vsiidx", newzipfilename + ".vsiidx") == 0
+        with gdaltest.config_option("CPL_VSIL_ARCHIVE_USE_INDEX", "NO"):
+            assert gdal.ReadDir(f"/vsizip/{newzipfilename}") == ["a.txt", "subdir"]
+
+        # Index written in a dedicated directory
+        zipfilename = newzipfilename
+        newzipfilename = "/vsimem/test_vsizip_archive_index_renamed3.zip"
+        assert gdal.Rename(zipfilename, newzipfilename) == 0
+        gdal.Unlink(zipfilename + ".vsiidx")
+        zipfilename = newzipfilename
+        with gdaltest.config_options(
+            {
+                "CPL_VSIL_ARCHIVE_WRITE_INDEX": "YES",
+                "CPL_VSIL_ARCHIVE_INDEX_DIR": "/vsimem/test_vsizip_archive_index_dir",
+            }
+        ):
+            assert gdal.ReadDir(f"/vsizip/{zipfilename}") == ["a.txt", "subdir"]
+        assert gdal.VSIStatL(zipfilename + ".vsiidx") is None
+        files = gdal.ReadDir("/vsimem/test_vsizip_archive_index_dir")
+        assert len(files) == 1
+        assert files[0].startswith("test_vsizip_archive_index_renamed3.zip.")
+        assert files[0].endswith(".vsiidx")
+
+    finally:
+        gdal.Unlink(zipfilename)
+        gdal.Unlink(zipfilename + ".vsiidx")
+        gdal.RmdirRecursive("/vsimem/test_vsizip_archive_index_dir")
+
+
 ###############################################################################
 
 
@@ -2304,3 +2304,149 @@ def test_vrtpansharpen_out_of_order_input_bands_and_nodata():
     cs2 = [vrt_ds.GetRasterBand(i + 1).Checksum() for i in range(vrt_ds.RasterCount)]
 
     assert cs2 == cs[::-1]
+
+
+###############################################################################
+# Test that multi-threaded processing (upsampling and pansharpening done by
+# each thread) gives the same result as single-threaded processing, for
+# sizes that are not a multiple of the vector width.
+
+
+@pytest.mark.parametrize(
+    "datatype", [gdal.GDT_Byte, gdal.GDT_UInt16, gdal.GDT_Float32]
+)
+@pytest.mark.parametrize("nodata", [None, 0])
+@pytest.mark.parametrize("bitdepth", [None, 7])
+def test_vrtpansharpen_multithreaded_same_as_single_threaded(
+    datatype, nodata, bitdepth
+):
+
+    if datatype == gdal.GDT_Float32 and bitdepth is not None:
+        pytest.skip("BitDepth not applicable to floating point")
+
+    ms_ds = gdal.Translate(
+        "", "data/small_world.tif", format="MEM", outputType=datatype
+    )
+    gt = list(ms_ds.GetGeoTransform())
+    gt[1] *= 400.0 / 803
+    gt[5] *= 200.0 / 401
+    pan_ds = gdal.Translate(
+        "",
+        ms_ds,
+        format="MEM",
+        bandList=[1],
+        width=803,
+        height=401,
+        resampleAlg="bilinear",
+    )
+    pan_ds.SetGeoTransform(gt)
+
+    def get_data(num_threads):
+        options = "<NumThreads>%s</NumThreads>" % num_threads
+        if nodata is not None:
+            options += "<NoData>%d</NoData>" % nodata
+        if bitdepth is not None:
+            options += "<BitDepth>%d</BitDepth>" % bitdepth
+        vrt_ds = gdal.CreatePansharpenedVRT(
+            """<VRTDataset subClass="VRTPansharpenedDataset">
+            <PansharpeningOptions>
+                <AlgorithmOptions>
+                    <Weights>0.3,0.2,0.5</Weights>
+                </AlgorithmOptions>
+                <Resampling>Cubic</Resampling>
+                %s
+                <SpectralBand dstBand="1">
+                </SpectralBand>
+                <SpectralBand dstBand="2">
+                </SpectralBand>
+                <SpectralBand dstBand="3">
+                </SpectralBand>
+            </PansharpeningOptions>
+        </VRTDataset>"""
+            % options,
+            pan_ds.GetRasterBand(1),
+            [ms_ds.GetRasterBand(i + 1) for i in range(3)],
+        )
+        assert vrt_ds is not None
+        return vrt_ds.ReadRaster()
+
+    assert get_data("ALL_CPUS") == get_data("1")
+
+
+###############################################################################
+# Test that the AVX weighted Brovey kernels give the same result as the
+# generic code.
+
+
+@pytest.mark.parametrize(
+    "datatype",
+    [
+        gdal.GDT_Byte,
+        gdal.GDT_UInt16,
+        gdal.GDT_Int16,
+        gdal.GDT_Float32,
+        gdal.GDT_Float64,
+    ],
+)
+@pytest.mark.parametrize(
+    "buf_type",
+    [
+        gdal.GDT_Byte,
+        gdal.GDT_UInt16,
+        gdal.GDT_Int16,
+        gdal.GDT_Float32,
+        gdal.GDT_Float64,
+    ],
+)
+@pytest.mark.parametrize("weights", ["0.3,0.2,0.5", "0.7,-0.2,0.5"])
+@pytest.mark.parametrize("nodata", [None, 0])
+def test_vrtpansharpen_avx_same_as_generic(datatype, buf_type, weights, nodata):
+
+    ms_ds = gdal.Translate(
+        "", "data/small_world.tif", format="MEM", outputType=datatype
+    )
+    gt = list(ms_ds.GetGeoTransform())
+    gt[1] *= 400.0 / 803
+    gt[5] *= 200.0 / 401
+    pan_ds = gdal.Translate(
+        "",
+        ms_ds,
+        format="MEM",
+        bandList=[1],
+        width=803,
+        height=401,
+        resampleAlg="bilinear",
+        scaleParams=[[0, 255, -100, 400]],
+        outputType=datatype,
+    )
+    pan_ds.SetGeoTransform(gt)
+
+    def get_data(use_avx):
+        options = ""
+        if nodata is not None:
+            options += "<NoData>%d</NoData>" % nodata
+        vrt_ds = gdal.CreatePansharpenedVRT(
+            """<VRTDataset subClass="VRTPansharpenedDataset">
+            <PansharpeningOptions>
+                <AlgorithmOptions>
+                    <Weights>%s</Weights>
+                </AlgorithmOptions>
+                <Resampling>Cubic</Resampling>
+                %s
+                <SpectralBand dstBand="1">
+                </SpectralBand>
+                <SpectralBand dstBand="2">
+                </SpectralBand>
+                <SpectralBand dstBand="3">
+                </SpectralBand>
+            </PansharpeningOptions>
+        </VRTDataset>"""
+            % (weights, options),
+            pan_ds.GetRasterBand(1),
+            [ms_ds.GetRasterBand(i + 1) for i in range(3)],
+        )
+        assert vrt_ds is not None
+        with gdaltest.config_option("GDAL_USE_AVX", use_avx, thread_local=False):
+            return vrt_ds.ReadRaster(buf_type=buf_type)
+
+    assert get_data("YES") == get_data("NO")
@@ -182,3 +182,61 @@ def test_gdaladdo_5(gdaladdo_path):
     assert cnt == 1
 
     os.remove("tmp/test_gdaladdo_5.tif")
+
+
+###############################################################################
+# Test -partial_refresh_from_projwin and -partial_refresh_from_source_extent
+
+
+@pytest.mark.parametrize("mode", ["projwin", "source_extent"])
+def test_gdaladdo_partial_refresh(gdaladdo_path, mode):
+
+    gdal.Translate(
+        "tmp/test_gdaladdo_partial_refresh.tif",
+        "../gcore/data/byte.tif",
+        options="-outsize 200 200 -co TILED=YES -co BLOCKXSIZE=16 -co BLOCKYSIZE=16",
+    )
+    gdaltest.runexternal(
+        gdaladdo_path + " -r average tmp/test_gdaladdo_partial_refresh.tif 2 4"
+    )
+
+    # Update a part of the image, and create a source file covering it
+    ds = gdal.Open("tmp/test_gdaladdo_partial_refresh.tif", gdal.GA_Update)
+    gt = ds.GetGeoTransform()
+    ds.GetRasterBand(1).WriteRaster(40, 30, 20, 10, b"\xff" * 200)
+    ds = None
+    gdal.Translate(
+        "tmp/test_gdaladdo_partial_refresh_src.tif",
+        "tmp/test_gdaladdo_partial_refresh.tif",
+        options="-srcwin 40 30 20 10",
+    )
+
+    if mode == "projwin":
+        ulx = gt[0] + 40 * gt[1]
+        uly = gt[3] + 30 * gt[5]
+        lrx = gt[0] + 60 * gt[1]
+        lry = gt[3] + 40 * gt[5]
+        gdaltest.runexternal(
+            gdaladdo_path
+            + f" -r average -partial_refresh_from_projwin {ulx} {uly} {lrx} {lry}"
+            + " tmp/test_gdaladdo_partial_refresh.tif"
+        )
+    else:
+        gdaltest.runexternal(
+            gdaladdo_path
+            + " -r average -partial_refresh_from_source_extent"
+            + " tmp/test_gdaladdo_partial_refresh_src.tif"
+            + " tmp/test_gdaladdo_partial_refresh.tif"
+        )
+
+    ref_ds = gdal.Translate("", "tmp/test_gdaladdo_partial_refresh.tif", format="MEM")
+    ref_ds.BuildOverviews("AVERAGE", [2, 4])
+
+    ds = gdal.Open("tmp/test_gdaladdo_partial_refresh.tif")
+    assert [
+        ds.GetRasterBand(1).GetOverview(i).Checksum() for i in range(2)
+    ] == [ref_ds.GetRasterBand(1).GetOverview(i).Checksum() for i in range(2)]
+    ds = None
+
+    os.remove("tmp/test_gdaladdo_partial_refresh.tif")
+    os.remove("tmp/test_gdaladdo_partial_refresh_src.tif")
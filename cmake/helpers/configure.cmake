@@ -136,6 +136,14 @@ else ()
   check_function_exists(posix_memalign HAVE_POSIX_MEMALIGN)
   check_function_exists(vfork HAVE_VFORK)
   check_function_exists(mmap HAVE_MMAP)
+  check_function_exists(shm_open HAVE_SHM_OPEN)
+  if (NOT HAVE_SHM_OPEN)
+    # glibc < 2.34 provides shm_open() in librt only
+    check_library_exists(rt shm_open "" HAVE_SHM_OPEN_IN_LIBRT)
+    if (HAVE_SHM_OPEN_IN_LIBRT)
+      set(HAVE_SHM_OPEN 1)
+    endif ()
+  endif ()
   check_function_exists(sigaction HAVE_SIGACTION)
   check_function_exists(statvfs HAVE_STATVFS)
   check_function_exists(statvfs64 HAVE_STATVFS64)
@@ -236,6 +244,7 @@ else ()
   check_type_size("off_t" SIZEOF_OFF_T)
 
   check_function_exists(pread64 HAVE_PREAD64)
+  check_function_exists(posix_fadvise64 HAVE_POSIX_FADVISE64)
 
   check_function_exists(ftruncate64 HAVE_FTRUNCATE64)
   if (HAVE_FTRUNCATE64)
@@ -267,6 +276,8 @@ else ()
     unset(HAVE_STATVFS64 CACHE)
     unset(HAVE_PREAD64)
     unset(HAVE_PREAD64 CACHE)
+    unset(HAVE_POSIX_FADVISE64)
+    unset(HAVE_POSIX_FADVISE64 CACHE)
   endif()
 
   if( NOT HAVE_PREAD64 )
@@ -280,6 +291,10 @@ else ()
       HAVE_PREAD_BSD)
   endif()
 
+  if( NOT HAVE_POSIX_FADVISE64 )
+    check_function_exists(posix_fadvise HAVE_POSIX_FADVISE)
+  endif()
+
   set(UNIX_STDIO_64 TRUE)
 
   set(INCLUDE_XLOCALE_H)
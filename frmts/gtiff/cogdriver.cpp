@@ -557,7 +557,7 @@ void COGRemoveWarpingOptions(CPLStringList &aosOptions)
 /************************************************************************/
 
 static std::unique_ptr<GDALDataset> CreateReprojectedDS(
-    const char *pszDstFilename, GDALDataset *poSrcDS,
+    const char *pszTmpFilename, GDALDataset *poSrcDS,
     const char *const *papszOptions, const CPLString &osResampling,
     const CPLString &osTargetSRS, const int nXSize, const int nYSize,
     const double dfMinX, const double dfMinY, const double dfMaxX,
@@ -660,7 +660,6 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
     CPLDebug("COG", "Reprojecting source dataset: start");
     GDALWarpAppOptionsSetProgress(psOptions, GDALScaledProgress,
                                   pScaledProgress);
-    CPLString osTmpFile(GetTmpFilename(pszDstFilename, "warped.tif.tmp"));
     auto hSrcDS = GDALDataset::ToHandle(poSrcDS);
 
     std::unique_ptr<CPLConfigOptionSetter> poWarpThreadSetter;
@@ -670,7 +669,8 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
             "GDAL_NUM_THREADS", pszNumThreads, false));
     }
 
-    auto hRet = GDALWarp(osTmpFile, nullptr, 1, &hSrcDS, psOptions, nullptr);
+    auto hRet =
+        GDALWarp(pszTmpFilename, nullptr, 1, &hSrcDS, psOptions, nullptr);
     GDALWarpAppOptionsFree(psOptions);
     CPLDebug("COG", "Reprojecting source dataset: end");
 
@@ -690,8 +690,14 @@ struct GDALCOGCreator final
     CPLString m_osTmpOverviewFilename{};
     CPLString m_osTmpMskOverviewFilename{};
 
+    // Remaining amount of memory that can be used to hold temporary files
+    GIntBig m_nTmpMaxMemory = 0;
+
     ~GDALCOGCreator();
 
+    CPLString GetTmpFilename(const char *pszFilename, const char *pszExt,
+                             GIntBig nEstimatedSize);
+
     GDALDataset *Create(const char *pszFilename, GDALDataset *const poSrcDS,
                         char **papszOptions, GDALProgressFunc pfnProgress,
                         void *pProgressData);
@@ -722,6 +728,31 @@ GDALCOGCreator::~GDALCOGCreator()
     }
 }
 
+/************************************************************************/
+/*                   GDALCOGCreator::GetTmpFilename()                   */
+/************************************************************************/
+
+// Returns the name of a temporary file, in /vsimem/ if its (uncompressed)
+// estimated size fits in the remaining memory allowed for temporary files,
+// so that the data is only written once to disk, in the final file.
+CPLString GDALCOGCreator::GetTmpFilename(const char *pszFilename,
+                                         const char *pszExt,
+                                         GIntBig nEstimatedSize)
+{
+    if (nEstimatedSize <= m_nTmpMaxMemory)
+    {
+        m_nTmpMaxMemory -= nEstimatedSize;
+        CPLString osTmpFilename;
+        osTmpFilename.Printf("/vsimem/cog_%p/%s.%s", this,
+                             CPLGetFilename(pszFilename), pszExt);
+        CPLDebug("COG", "Using in-memory temporary file %s",
+                 osTmpFilename.c_str());
+        VSIUnlink(osTmpFilename);
+        return osTmpFilename;
+    }
+    return ::GetTmpFilename(pszFilename, pszExt);
+}
+
 /************************************************************************/
 /*                    GDALCOGCreator::Create()                          */
 /************************************************************************/
@@ -745,6 +776,27 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     CPLConfigOptionSetter oSetterReportDirtyBlockFlushing(
         "GDAL_REPORT_DIRTY_BLOCK_FLUSHING", "NO", true);
 
+    // By default, allow temporary files as large as the GDAL block cache,
+    // whose size scales with the RAM (5% of it unless GDAL_CACHEMAX is set)
+    // and is already sized by the user for GDAL processing.
+    const char *pszTmpMaxMemory =
+        CPLGetConfigOption("COG_TMP_MAX_MEMORY", nullptr);
+    if (pszTmpMaxMemory == nullptr)
+    {
+        m_nTmpMaxMemory = GDALGetCacheMax64();
+    }
+    else if (strchr(pszTmpMaxMemory, '%') != nullptr)
+    {
+        const double dfPercent = CPLAtof(pszTmpMaxMemory);
+        m_nTmpMaxMemory = static_cast<GIntBig>(
+            std::max(0.0, std::min(100.0, dfPercent)) / 100.0 *
+            static_cast<double>(CPLGetUsablePhysicalRAM()));
+    }
+    else
+    {
+        m_nTmpMaxMemory = CPLAtoGIntBig(pszTmpMaxMemory);
+    }
+
     double dfCurPixels = 0;
     double dfTotalPixelsToProcess = 0;
     GDALDataset *poCurDS = poSrcDS;
@@ -815,8 +867,20 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
         }
         else
         {
+            // Keep room for the temporary overviews, which are ~1/3 of the
+            // size of the reprojected dataset.
+            const GIntBig nWarpedSize =
+                static_cast<GIntBig>(nTargetXSize) * nTargetYSize *
+                (poCurDS->GetRasterCount() + 1) *
+                GDALGetDataTypeSizeBytes(
+                    poCurDS->GetRasterBand(1)->GetRasterDataType());
+            const CPLString osTmpFilename =
+                nWarpedSize + nWarpedSize / 3 <= m_nTmpMaxMemory
+                    ? GetTmpFilename(pszFilename, "warped.tif.tmp",
+                                     nWarpedSize)
+                    : ::GetTmpFilename(pszFilename, "warped.tif.tmp");
             m_poReprojectedDS = CreateReprojectedDS(
-                pszFilename, poCurDS, papszOptions, osTargetResampling,
+                osTmpFilename, poCurDS, papszOptions, osTargetResampling,
                 osTargetSRS, nTargetXSize, nTargetYSize, dfTargetMinX,
                 dfTargetMinY, dfTargetMaxX, dfTargetMaxY, dfRes, pfnProgress,
                 pProgressData, dfCurPixels, dfTotalPixelsToProcess);
@@ -996,10 +1060,15 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     aosOverviewOptions.SetNameValue("BIGTIFF", "YES");
     aosOverviewOptions.SetNameValue("SPARSE_OK", "YES");
 
+    GIntBig nOverviewPixels = 0;
+    for (const auto &oDims : asOverviewDims)
+        nOverviewPixels += static_cast<GIntBig>(oDims.first) * oDims.second;
+
     if (bGenerateMskOvr)
     {
         CPLDebug("COG", "Generating overviews of the mask: start");
-        m_osTmpMskOverviewFilename = GetTmpFilename(pszFilename, "msk.ovr.tmp");
+        m_osTmpMskOverviewFilename =
+            GetTmpFilename(pszFilename, "msk.ovr.tmp", nOverviewPixels);
         GDALRasterBand *poSrcMask = poFirstBand->GetMaskBand();
         const char *pszResampling = CSLFetchNameValueDef(
             papszOptions, "OVERVIEW_RESAMPLING",
@@ -1029,7 +1098,10 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     if (bGenerateOvr)
     {
         CPLDebug("COG", "Generating overviews of the imagery: start");
-        m_osTmpOverviewFilename = GetTmpFilename(pszFilename, "ovr.tmp");
+        m_osTmpOverviewFilename = GetTmpFilename(
+            pszFilename, "ovr.tmp",
+            nOverviewPixels * nBands *
+                GDALGetDataTypeSizeBytes(poFirstBand->GetRasterDataType()));
         std::vector<GDALRasterBand *> apoSrcBands;
         for (int i = 0; i < nBands; i++)
             apoSrcBands.push_back(poCurDS->GetRasterBand(i + 1));
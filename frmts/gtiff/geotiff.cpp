@@ -930,6 +930,8 @@ void GTiffOneTimeInit()
 static void GDALDeregister_GTiff(GDALDriver *)
 
 {
+    GTiffClearSRSCache();
+
 #ifdef HAVE_JXL
     if (pJXLCodec)
         TIFFUnRegisterCODEC(pJXLCodec);
@@ -1287,6 +1289,9 @@ void GDALRegister_GTiff()
         "   </Option>"
         "   <Option name='SPARSE_OK' type='boolean' description='Should empty "
         "blocks be omitted on disk?' default='FALSE'/>"
+        "   <Option name='CONCURRENT_WRITE' type='boolean' "
+        "description='Whether several threads may read and write blocks of "
+        "the dataset concurrently' default='FALSE'/>"
         "   <Option name='ALPHA' type='string-select' description='Mark first "
         "extrasample as being alpha'>"
         "       <Value>NON-PREMULTIPLIED</Value>"
@@ -1393,6 +1398,9 @@ void GDALRegister_GTiff()
         "default='PAM,INTERNAL,TABFILE,WORLDFILE,XML'/>"
         "   <Option name='SPARSE_OK' type='boolean' description='Should empty "
         "blocks be omitted on disk?' default='FALSE'/>"
+        "   <Option name='CONCURRENT_WRITE' type='boolean' "
+        "description='Whether several threads may read and write blocks of "
+        "the dataset concurrently' default='FALSE'/>"
         "   <Option name='IGNORE_COG_LAYOUT_BREAK' type='boolean' "
         "description='Allow update mode on files with COG structure' "
         "default='FALSE'/>"
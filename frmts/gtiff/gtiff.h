@@ -87,6 +87,8 @@ CPLString CPL_DLL GTiffGetCompressValues(bool &bHasLZW, bool &bHasDEFLATE,
 
 int &GTIFFGetThreadLocalLibtiffError();
 
+void GTiffClearSRSCache();
+
 #if !defined(TIFFTAG_GDAL_METADATA)
 // The following 5 tags are now defined in tiff.h of libtiff > 4.1.0
 
@@ -124,6 +124,8 @@ GTiffDataset::GTiffDataset()
         CPLGetConfigOption("GTIFF_VIRTUAL_MEM_IO", "NO");
     if (EQUAL(pszVirtualMemIO, "IF_ENOUGH_RAM"))
         m_eVirtualMemIOUsage = VirtualMemIOEnum::IF_ENOUGH_RAM;
+    else if (EQUAL(pszVirtualMemIO, "AUTO"))
+        m_eVirtualMemIOUsage = VirtualMemIOEnum::AUTO;
     else if (CPLTestBool(pszVirtualMemIO))
         m_eVirtualMemIOUsage = VirtualMemIOEnum::YES;
 
@@ -466,6 +468,8 @@ CPLErr GTiffDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                                GDALRasterIOExtraArg *psExtraArg)
 
 {
+    const auto oConcurrentWriteLock = GetConcurrentWriteLock();
+
     // Try to pass the request to the most appropriate overview dataset.
     if (nBufXSize < nXSize && nBufYSize < nYSize)
     {
@@ -750,6 +754,44 @@ void GTiffDataset::InitCreationOrOpenOptions(bool bUpdateMode,
 
     m_eGeoTIFFKeysFlavor = GetGTIFFKeysFlavor(papszOptions);
     m_eGeoTIFFVersion = GetGeoTIFFVersion(papszOptions);
+
+    m_bConcurrentWrite =
+        bUpdateMode && CPLFetchBool(papszOptions, "CONCURRENT_WRITE", false);
+    InitConcurrentWrite();
+}
+
+/************************************************************************/
+/*                        InitConcurrentWrite()                         */
+/************************************************************************/
+
+// With CONCURRENT_WRITE=YES, initialize the block cache of the bands now,
+// as GDALRasterBand::InitBlockInfo() is not safe to call concurrently.
+void GTiffDataset::InitConcurrentWrite()
+{
+    if (!m_bConcurrentWrite)
+        return;
+    for (int i = 0; i < nBands; ++i)
+    {
+        auto poBand = cpl::down_cast<GTiffRasterBand *>(papoBands[i]);
+        CPL_IGNORE_RET_VAL(poBand->InitBlockInfo());
+    }
+}
+
+/************************************************************************/
+/*                       GetConcurrentWriteLock()                       */
+/************************************************************************/
+
+// Returns a lock on the mutex serializing the accesses to the TIFF handle,
+// shared by the dataset, its overviews and its mask, when the dataset has
+// been created or opened with CONCURRENT_WRITE=YES. Returns an unlocked
+// lock otherwise.
+std::unique_lock<std::recursive_mutex> GTiffDataset::GetConcurrentWriteLock()
+{
+    GTiffDataset *poBaseDS = m_poBaseDS ? m_poBaseDS : this;
+    if (!poBaseDS->m_bConcurrentWrite)
+        return std::unique_lock<std::recursive_mutex>();
+    return std::unique_lock<std::recursive_mutex>(
+        poBaseDS->m_oConcurrentWriteMutex);
 }
 
 /************************************************************************/
@@ -32,6 +32,7 @@
 
 #include "gdal_pam.h"
 
+#include <mutex>
 #include <queue>
 
 #include "cpl_mem_cache.h"
@@ -159,6 +160,11 @@ class GTiffDataset final : public GDALPamDataset
     std::unique_ptr<CPLJobQueue> m_poCompressQueue{};
     CPLMutex *m_hCompressThreadPoolMutex = nullptr;
 
+    // Serializes accesses to the TIFF handle when CONCURRENT_WRITE=YES.
+    // Only the one of the base dataset is used.
+    std::recursive_mutex m_oConcurrentWriteMutex{};
+    bool m_bConcurrentWrite = false;
+
 #ifdef SUPPORTS_GET_OFFSET_BYTECOUNT
     lru11::Cache<int, std::pair<vsi_l_offset, vsi_l_offset>>
         m_oCacheStrileToOffsetByteCount{1024};
@@ -236,7 +242,10 @@ class GTiffDataset final : public GDALPamDataset
     {
         NO,
         YES,
-        IF_ENOUGH_RAM
+        IF_ENOUGH_RAM,
+        // Like YES, but only for local files whose blocks all lie within the
+        // file, and for requests without progress callback.
+        AUTO
     };
 
     VirtualMemIOEnum m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
@@ -366,6 +375,8 @@ class GTiffDataset final : public GDALPamDataset
     void GetDiscardLsbOption(char **papszOptions);
     void InitCompressionThreads(bool bUpdateMode, CSLConstList papszOptions);
     void InitCreationOrOpenOptions(bool bUpdateMode, CSLConstList papszOptions);
+    void InitConcurrentWrite();
+    std::unique_lock<std::recursive_mutex> GetConcurrentWriteLock();
     static void ThreadCompressionFunc(void *pData);
     void WaitCompletionForJobIdx(int i);
     void WaitCompletionForBlock(int nBlockId);
@@ -1469,6 +1469,15 @@ int GTiffDataset::VirtualMemIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         return -1;
     }
 
+    // Progress is not reported by this routine, so in AUTO mode, leave the
+    // requests that want it to the regular code path.
+    if (m_eVirtualMemIOUsage == VirtualMemIOEnum::AUTO &&
+        psExtraArg != nullptr && psExtraArg->pfnProgress != nullptr &&
+        psExtraArg->pfnProgress != GDALDummyProgress)
+    {
+        return -1;
+    }
+
     const GDALDataType eDataType = GetRasterBand(1)->GetRasterDataType();
     const int nDTSizeBits = GDALGetDataTypeSizeBits(eDataType);
     if (!(m_nCompression == COMPRESSION_NONE &&
@@ -1483,7 +1492,8 @@ int GTiffDataset::VirtualMemIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 
     size_t nMappingSize = 0;
     GByte *pabySrcData = nullptr;
-    if (STARTS_WITH(m_pszFilename, "/vsimem/"))
+    if (STARTS_WITH(m_pszFilename, "/vsimem/") &&
+        m_eVirtualMemIOUsage != VirtualMemIOEnum::AUTO)
     {
         vsi_l_offset nDataLength = 0;
         pabySrcData = VSIGetMemFileBuffer(m_pszFilename, &nDataLength, FALSE);
@@ -1529,7 +1539,9 @@ int GTiffDataset::VirtualMemIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
             return -1;
         }
-        m_eVirtualMemIOUsage = VirtualMemIOEnum::YES;
+        CPLDebug("GTiff", "File mapped in memory for VirtualMemIO");
+        if (m_eVirtualMemIOUsage != VirtualMemIOEnum::AUTO)
+            m_eVirtualMemIOUsage = VirtualMemIOEnum::YES;
     }
 
     if (m_psVirtualMemIOMapping)
@@ -1542,6 +1554,49 @@ int GTiffDataset::VirtualMemIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             static_cast<GByte *>(CPLVirtualMemGetAddr(m_psVirtualMemIOMapping));
     }
 
+    if (m_eVirtualMemIOUsage == VirtualMemIOEnum::AUTO)
+    {
+        // Do not change the behavior on truncated or corrupted files, for
+        // which the regular code path reports errors per block. Only the
+        // blocks touched by the request are checked, so that the offsets
+        // and byte counts of the other ones are not loaded.
+        const int nBlockXStart = nXOff / m_nBlockXSize;
+        const int nBlockXEnd = (nXOff + nXSize - 1) / m_nBlockXSize;
+        const int nBlockYStart = nYOff / m_nBlockYSize;
+        const int nBlockYEnd = (nYOff + nYSize - 1) / m_nBlockYSize;
+        const int nPlanes =
+            m_nPlanarConfig == PLANARCONFIG_SEPARATE ? nBandCount : 1;
+        for (int iPlane = 0; iPlane < nPlanes; ++iPlane)
+        {
+            const int nPlaneOffset =
+                m_nPlanarConfig == PLANARCONFIG_SEPARATE
+                    ? (panBandMap[iPlane] - 1) * m_nBlocksPerBand
+                    : 0;
+            for (int iY = nBlockYStart; iY <= nBlockYEnd; ++iY)
+            {
+                for (int iX = nBlockXStart; iX <= nBlockXEnd; ++iX)
+                {
+                    const uint32_t nBlockId = static_cast<uint32_t>(
+                        nPlaneOffset + iY * m_nBlocksPerRow + iX);
+                    int nErrOccurred = 0;
+                    const auto nOffset = TIFFGetStrileOffsetWithErr(
+                        m_hTIFF, nBlockId, &nErrOccurred);
+                    const auto nByteCount = TIFFGetStrileByteCountWithErr(
+                        m_hTIFF, nBlockId, &nErrOccurred);
+                    if (nErrOccurred || nOffset > nMappingSize ||
+                        nByteCount > nMappingSize - nOffset)
+                    {
+                        CPLDebug("GTiff",
+                                 "Not using VirtualMemIO, since block %u "
+                                 "is not fully within the file",
+                                 nBlockId);
+                        return -1;
+                    }
+                }
+            }
+        }
+    }
+
     if (TIFFIsByteSwapped(m_hTIFF) && m_pTempBufferForCommonDirectIO == nullptr)
     {
         const int nDTSize = nDTSizeBits / 8;
@@ -3994,6 +4049,86 @@ void GTiffDataset::LookForProjection()
     }
 }
 
+/************************************************************************/
+/*                          GeoTIFF SRS cache                           */
+/************************************************************************/
+
+// Process-wide cache of the SRS built from GeoTIFF keys, since building it
+// may involve costly lookups in the PROJ database. It is keyed by the content
+// of the GeoTIFF keys (and configuration options affecting their
+// interpretation), so it never returns stale results, and can also be hit by
+// different files sharing the same CRS.
+
+constexpr size_t GTIFF_SRS_CACHE_SIZE = 128;
+
+static std::mutex goSRSCacheMutex;
+// Allocated on the heap, and freed when the driver is unloaded, so that no
+// OGRSpatialReference is destroyed after PROJ has been cleaned up at exit.
+static lru11::Cache<std::string, OGRSpatialReference> *gpoSRSCache = nullptr;
+
+/************************************************************************/
+/*                         GTiffClearSRSCache()                         */
+/************************************************************************/
+
+void GTiffClearSRSCache()
+{
+    std::lock_guard<std::mutex> oLock(goSRSCacheMutex);
+    delete gpoSRSCache;
+    gpoSRSCache = nullptr;
+}
+
+/************************************************************************/
+/*                        GetGeoTIFFSRSCacheKey()                       */
+/************************************************************************/
+
+// Returns a key identifying the GeoTIFF keys of the current directory, or an
+// empty string if the SRS cannot be cached.
+static std::string GetGeoTIFFSRSCacheKey(TIFF *hTIFF)
+{
+    if (!CPLTestBool(CPLGetConfigOption("GTIFF_SRS_CACHE", "YES")))
+        return std::string();
+
+    uint16_t nKeyCount = 0;
+    uint16_t *panKeys = nullptr;
+    if (!TIFFGetField(hTIFF, TIFFTAG_GEOKEYDIRECTORY, &nKeyCount, &panKeys) ||
+        nKeyCount == 0 || panKeys == nullptr)
+    {
+        return std::string();
+    }
+
+    std::string osKey;
+    osKey.append(reinterpret_cast<const char *>(panKeys),
+                 nKeyCount * sizeof(uint16_t));
+    osKey += '\0';
+
+    uint16_t nDoubleCount = 0;
+    double *padfDoubles = nullptr;
+    if (TIFFGetField(hTIFF, TIFFTAG_GEODOUBLEPARAMS, &nDoubleCount,
+                     &padfDoubles) &&
+        padfDoubles)
+    {
+        osKey.append(reinterpret_cast<const char *>(padfDoubles),
+                     nDoubleCount * sizeof(double));
+    }
+    osKey += '\0';
+
+    char *pszAscii = nullptr;
+    if (TIFFGetField(hTIFF, TIFFTAG_GEOASCIIPARAMS, &pszAscii) && pszAscii)
+        osKey += pszAscii;
+
+    // Configuration options that affect GTIFGetOGISDefnAsOSR()
+    for (const char *pszOption :
+         {"GTIFF_LINEAR_UNITS", "GTIFF_SRS_SOURCE", "GTIFF_IMPORT_FROM_EPSG",
+          "GTIFF_ESRI_CITATION", "OSR_STRIP_TOWGS84",
+          "OSR_USE_NON_DEPRECATED"})
+    {
+        osKey += '\0';
+        osKey += CPLGetConfigOption(pszOption, "");
+    }
+
+    return osKey;
+}
+
 /************************************************************************/
 /*                      LookForProjectionFromGeoTIFF()                  */
 /************************************************************************/
@@ -4013,42 +4148,81 @@ void GTiffDataset::LookForProjectionFromGeoTIFF()
     }
     else
     {
-        GTIFDefn *psGTIFDefn = GTIFAllocDefn();
+        const std::string osCacheKey = GetGeoTIFFSRSCacheKey(m_hTIFF);
 
         bool bHasErrorBefore = CPLGetLastErrorType() != 0;
         // Collect (PROJ) error messages and remit them later as warnings
         std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
-        CPLInstallErrorHandlerAccumulator(aoErrors);
-        const int ret = GTIFGetDefn(hGTIF, psGTIFDefn);
-        CPLUninstallErrorHandlerAccumulator();
-
         bool bWarnAboutEllipsoid = true;
+        int ret = FALSE;
 
-        if (ret)
+        bool bFoundInCache = false;
+        if (!osCacheKey.empty())
         {
-            CPLInstallErrorHandlerAccumulator(aoErrors);
+            std::lock_guard<std::mutex> oLock(goSRSCacheMutex);
+            if (gpoSRSCache && gpoSRSCache->tryGet(osCacheKey, m_oSRS))
+                bFoundInCache = true;
+        }
 
-            if (psGTIFDefn->Ellipsoid == 4326 &&
-                psGTIFDefn->SemiMajor == 6378137 &&
-                psGTIFDefn->SemiMinor == 6356752.314245)
-            {
-                // Buggy Sentinel1 geotiff files use a wrong 4326 code for the
-                // ellipsoid instead of 7030.
-                psGTIFDefn->Ellipsoid = 7030;
-                bWarnAboutEllipsoid = false;
-            }
+        if (bFoundInCache)
+        {
+            CPLDebug("GTiff", "SRS found in cache");
+            ret = TRUE;
+            CPLFree(m_pszXMLFilename);
+            m_pszXMLFilename = nullptr;
+        }
+        else
+        {
+            GTIFDefn *psGTIFDefn = GTIFAllocDefn();
 
-            OGRSpatialReferenceH hSRS = GTIFGetOGISDefnAsOSR(hGTIF, psGTIFDefn);
+            CPLInstallErrorHandlerAccumulator(aoErrors);
+            ret = GTIFGetDefn(hGTIF, psGTIFDefn);
             CPLUninstallErrorHandlerAccumulator();
 
-            if (hSRS)
+            if (ret)
             {
-                CPLFree(m_pszXMLFilename);
-                m_pszXMLFilename = nullptr;
+                CPLInstallErrorHandlerAccumulator(aoErrors);
+
+                if (psGTIFDefn->Ellipsoid == 4326 &&
+                    psGTIFDefn->SemiMajor == 6378137 &&
+                    psGTIFDefn->SemiMinor == 6356752.314245)
+                {
+                    // Buggy Sentinel1 geotiff files use a wrong 4326 code for
+                    // the ellipsoid instead of 7030.
+                    psGTIFDefn->Ellipsoid = 7030;
+                    bWarnAboutEllipsoid = false;
+                }
+
+                OGRSpatialReferenceH hSRS =
+                    GTIFGetOGISDefnAsOSR(hGTIF, psGTIFDefn);
+                CPLUninstallErrorHandlerAccumulator();
+
+                if (hSRS)
+                {
+                    CPLFree(m_pszXMLFilename);
+                    m_pszXMLFilename = nullptr;
 
-                m_oSRS = *(OGRSpatialReference::FromHandle(hSRS));
-                OSRDestroySpatialReference(hSRS);
+                    m_oSRS = *(OGRSpatialReference::FromHandle(hSRS));
+                    OSRDestroySpatialReference(hSRS);
+
+                    // Only cache results that did not emit any message, so
+                    // that a cache hit behaves exactly as a cache miss.
+                    if (!osCacheKey.empty() && aoErrors.empty())
+                    {
+                        std::lock_guard<std::mutex> oLock(goSRSCacheMutex);
+                        if (!gpoSRSCache)
+                        {
+                            gpoSRSCache =
+                                new lru11::Cache<std::string,
+                                                 OGRSpatialReference>(
+                                    GTIFF_SRS_CACHE_SIZE);
+                        }
+                        gpoSRSCache->insert(osCacheKey, m_oSRS);
+                    }
+                }
             }
+
+            GTIFFreeDefn(psGTIFDefn);
         }
 
         std::set<std::string> oSetErrorMsg;
@@ -4104,8 +4278,6 @@ void GTiffDataset::LookForProjectionFromGeoTIFF()
             }
         }
 
-        GTIFFreeDefn(psGTIFDefn);
-
         GTiffDatasetSetAreaOrPointMD(hGTIF, m_oGTiffMDMD);
 
         GTIFFree(hGTIF);
@@ -2081,6 +2081,7 @@ void GTiffDataset::Crystalize()
 CPLErr GTiffDataset::FlushCache(bool bAtClosing)
 
 {
+    const auto oConcurrentWriteLock = GetConcurrentWriteLock();
     return FlushCacheInternal(bAtClosing, true);
 }
 
@@ -2912,6 +2913,8 @@ CPLErr GTiffDataset::IBuildOverviews(const char *pszResampling, int nOverviews,
                                      CSLConstList papszOptions)
 
 {
+    const auto oConcurrentWriteLock = GetConcurrentWriteLock();
+
     ScanDirectories();
 
     // Make implicit JPEG overviews invisible, but do not destroy
@@ -6199,6 +6202,7 @@ GDALDataset *GTiffDataset::Create(const char *pszFilename, int nXSize,
     }
 
     poDS->GetDiscardLsbOption(papszParamList);
+    poDS->InitConcurrentWrite();
 
     if (poDS->m_nPlanarConfig == PLANARCONFIG_CONTIG && l_nBands != 1)
         poDS->SetMetadataItem("INTERLEAVE", "PIXEL", "IMAGE_STRUCTURE");
@@ -31,6 +31,13 @@
 
 #include "gtiffdataset.h"
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "cpl_error_internal.h"  // CPLErrorHandlerAccumulatorStruct
+#include "cpl_vsi_virtual.h"
+#include "cpl_worker_thread_pool.h"
 #include "tifvsi.h"
 
 /************************************************************************/
@@ -48,6 +55,17 @@ class GTiffJPEGOverviewBand final : public GDALRasterBand
     }
 
     virtual CPLErr IReadBlock(int, int, void *) override;
+    virtual CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                             GDALDataType, GSpacing nPixelSpace,
+                             GSpacing nLineSpace,
+                             GDALRasterIOExtraArg *psExtraArg) override;
+    virtual int IGetDataCoverageStatus(int nXOff, int nYOff, int nXSize,
+                                       int nYSize, int nMaskFlagStop,
+                                       double *pdfDataPct) override;
+
+    CPLErr ReadFromJPEGDS(GDALDataset *poJPEGDS, int nBlockXOff,
+                          int nBlockYOff, void *pImage);
+
     GDALColorInterp GetColorInterpretation() override
     {
         return cpl::down_cast<GTiffJPEGOverviewDS *>(poDS)
@@ -131,6 +149,12 @@ CPLErr GTiffJPEGOverviewDS::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                                       GDALRasterIOExtraArg *psExtraArg)
 
 {
+    if (eRWFlag == GF_Read && m_poParentDS->m_poThreadPool != nullptr)
+    {
+        MultiThreadedRead(nXOff, nYOff, nXSize, nYSize, nBandCount,
+                          panBandMap);
+    }
+
     // For non-single strip JPEG-IN-TIFF, the block based strategy will
     // be the most efficient one, to avoid decompressing the JPEG content
     // for each requested band.
@@ -151,6 +175,357 @@ CPLErr GTiffJPEGOverviewDS::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                                   nBandSpace, psExtraArg);
 }
 
+/************************************************************************/
+/*                        IsSingleStripAsSplit()                        */
+/************************************************************************/
+
+bool GTiffJPEGOverviewDS::IsSingleStripAsSplit() const
+{
+    int nParentBlockXSize, nParentBlockYSize;
+    m_poParentDS->GetRasterBand(1)->GetBlockSize(&nParentBlockXSize,
+                                                 &nParentBlockYSize);
+    return nParentBlockYSize == 1 &&
+           m_poParentDS->m_nBlockYSize != nParentBlockYSize;
+}
+
+/************************************************************************/
+/*                          GetParentBlockId()                          */
+/************************************************************************/
+
+int GTiffJPEGOverviewDS::GetParentBlockId(int nBand, int nBlockXOff,
+                                          int nBlockYOff) const
+{
+    int nBlockId = 0;
+    if (!IsSingleStripAsSplit())
+    {
+        nBlockId = nBlockYOff * m_poParentDS->m_nBlocksPerRow + nBlockXOff;
+    }
+    if (m_poParentDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE)
+    {
+        nBlockId += (nBand - 1) * m_poParentDS->m_nBlocksPerBand;
+    }
+    return nBlockId;
+}
+
+/************************************************************************/
+/*                             OpenJPEGDS()                             */
+/************************************************************************/
+
+// Opens the JPEG file forged from a tile/strip of the parent dataset.
+std::unique_ptr<GDALDataset>
+GTiffJPEGOverviewDS::OpenJPEGDS(const char *pszFilename) const
+{
+    const char *const apszDrivers[] = {"JPEG", nullptr};
+
+    CPLConfigOptionSetter oJPEGtoRGBSetter(
+        "GDAL_JPEG_TO_RGB",
+        m_poParentDS->m_nPlanarConfig == PLANARCONFIG_CONTIG && nBands == 4
+            ? "NO"
+            : "YES",
+        false);
+
+    std::unique_ptr<GDALDataset> poJPEGDS(
+        GDALDataset::Open(pszFilename, GDAL_OF_RASTER | GDAL_OF_INTERNAL,
+                          apszDrivers, nullptr, nullptr));
+
+    if (poJPEGDS != nullptr)
+    {
+        // Force all implicit overviews to be available, even for
+        // small tiles.
+        CPLConfigOptionSetter oInternalOverviewsSetter(
+            "JPEG_FORCE_INTERNAL_OVERVIEWS", "YES", false);
+        GDALGetOverviewCount(GDALGetRasterBand(poJPEGDS.get(), 1));
+    }
+
+    return poJPEGDS;
+}
+
+/************************************************************************/
+/*                 GTiffJPEGOverviewDecompressContext                   */
+/************************************************************************/
+
+struct GTiffJPEGOverviewDecompressContext
+{
+    std::mutex oMutex{};
+
+    GTiffJPEGOverviewDS *poDS = nullptr;
+    VSIVirtualHandle *poHandle = nullptr;
+    bool bHasPRead = false;
+};
+
+struct GTiffJPEGOverviewDecompressJob
+{
+    GTiffJPEGOverviewDecompressContext *psContext = nullptr;
+    int nXBlock = 0;
+    int nYBlock = 0;
+    std::vector<int> anBands{};  // bands decoded from the tile/strip
+    vsi_l_offset nOffset = 0;    // after the leading 0xFF 0xD8 marker
+    vsi_l_offset nSize = 0;
+
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    bool bSuccess = false;
+};
+
+/************************************************************************/
+/*             GTiffJPEGOverviewThreadDecompressionFuncErrorHandler()   */
+/************************************************************************/
+
+static void CPL_STDCALL GTiffJPEGOverviewThreadDecompressionFuncErrorHandler(
+    CPLErr eErr, CPLErrorNum eErrorNum, const char *pszMsg)
+{
+    auto psJob = static_cast<GTiffJPEGOverviewDecompressJob *>(
+        CPLGetErrorHandlerUserData());
+    psJob->aoErrors.emplace_back(eErr, eErrorNum, pszMsg);
+}
+
+/************************************************************************/
+/*                      ThreadDecompressionFunc()                       */
+/************************************************************************/
+
+/* static */ void GTiffJPEGOverviewDS::ThreadDecompressionFunc(void *pData)
+{
+    auto psJob = static_cast<GTiffJPEGOverviewDecompressJob *>(pData);
+    auto psContext = psJob->psContext;
+    auto poDS = psContext->poDS;
+
+    CPLErrorHandlerPusher oErrorHandler(
+        GTiffJPEGOverviewThreadDecompressionFuncErrorHandler, psJob);
+
+    // Forge an in-memory JPEG file with the JPEG table followed by the
+    // JPEG data of the tile/strip.
+    const size_t nJPEGTableSize = static_cast<size_t>(poDS->m_nJPEGTableSize);
+    const size_t nSize = static_cast<size_t>(psJob->nSize);
+    GByte *pabyJPEG =
+        static_cast<GByte *>(VSI_MALLOC_VERBOSE(nJPEGTableSize + nSize));
+    if (pabyJPEG == nullptr)
+        return;
+    memcpy(pabyJPEG, poDS->m_pabyJPEGTable, nJPEGTableSize);
+    bool bReadOK;
+    if (psContext->bHasPRead)
+    {
+        bReadOK = psContext->poHandle->PRead(pabyJPEG + nJPEGTableSize, nSize,
+                                             psJob->nOffset) == nSize;
+    }
+    else
+    {
+        std::lock_guard<std::mutex> oLock(psContext->oMutex);
+        bReadOK =
+            psContext->poHandle->Seek(psJob->nOffset, SEEK_SET) == 0 &&
+            psContext->poHandle->Read(pabyJPEG + nJPEGTableSize, nSize, 1) == 1;
+    }
+    if (!bReadOK)
+    {
+        VSIFree(pabyJPEG);
+        return;
+    }
+
+    CPLString osTmpFilename;
+    osTmpFilename.Printf("/vsimem/gtiffjpegoverview_%p.jpg", psJob);
+    CPL_IGNORE_RET_VAL(VSIFCloseL(VSIFileFromMemBuffer(
+        osTmpFilename, pabyJPEG, nJPEGTableSize + nSize, TRUE)));
+
+    // Decode the tile/strip outside of the block cache, so that a failure
+    // does not leave partially initialized blocks behind.
+    int nBlockXSize, nBlockYSize;
+    poDS->papoBands[0]->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const size_t nBlockBytes =
+        static_cast<size_t>(nBlockXSize) * nBlockYSize *
+        GDALGetDataTypeSizeBytes(poDS->papoBands[0]->GetRasterDataType());
+    std::vector<std::vector<GByte>> aabyBlocks(psJob->anBands.size());
+    bool bRet = true;
+    {
+        auto poJPEGDS = poDS->OpenJPEGDS(osTmpFilename);
+        if (poJPEGDS == nullptr)
+            bRet = false;
+        for (size_t i = 0; bRet && i < psJob->anBands.size(); ++i)
+        {
+            auto poBand = cpl::down_cast<GTiffJPEGOverviewBand *>(
+                poDS->papoBands[psJob->anBands[i] - 1]);
+            try
+            {
+                aabyBlocks[i].resize(nBlockBytes);
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate working buffer");
+                bRet = false;
+                break;
+            }
+            bRet = poBand->ReadFromJPEGDS(poJPEGDS.get(), psJob->nXBlock,
+                                          psJob->nYBlock,
+                                          aabyBlocks[i].data()) == CE_None;
+        }
+    }
+    VSIUnlink(osTmpFilename);
+    if (!bRet)
+        return;
+
+    std::lock_guard<std::mutex> oLock(psContext->oMutex);
+    for (size_t i = 0; i < psJob->anBands.size(); ++i)
+    {
+        auto poBand = poDS->papoBands[psJob->anBands[i] - 1];
+        GDALRasterBlock *poBlock =
+            poBand->TryGetLockedBlockRef(psJob->nXBlock, psJob->nYBlock);
+        if (poBlock == nullptr)
+        {
+            // Coverity Scan notices that GDALRasterBlock::Internalize() calls
+            // CPLSleep() in a debug code path, and warns about that while
+            // holding the above mutex.
+            // coverity[sleep]
+            poBlock = poBand->GetLockedBlockRef(psJob->nXBlock,
+                                                psJob->nYBlock, TRUE);
+            if (poBlock == nullptr)
+                return;
+            memcpy(poBlock->GetDataRef(), aabyBlocks[i].data(), nBlockBytes);
+        }
+        poBlock->DropLock();
+    }
+    psJob->bSuccess = true;
+}
+
+/************************************************************************/
+/*                         MultiThreadedRead()                          */
+/************************************************************************/
+
+// Decodes, using the thread pool of the parent dataset, the tiles/strips
+// intersecting the window of interest into the block cache. This is only an
+// optimization: blocks that are not handled here (already cached, sparse,
+// or whose decoding failed) are left to IReadBlock().
+void GTiffJPEGOverviewDS::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
+                                            int nYSize, int nBandCount,
+                                            const int *panBandMap)
+{
+    if (IsSingleStripAsSplit())
+        return;
+
+    int nBlockXSize, nBlockYSize;
+    papoBands[0]->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlockXStart = nXOff / nBlockXSize;
+    const int nBlockYStart = nYOff / nBlockYSize;
+    const int nBlockXEnd = (nXOff + nXSize - 1) / nBlockXSize;
+    const int nBlockYEnd = (nYOff + nYSize - 1) / nBlockYSize;
+    const int nXBlocks = nBlockXEnd - nBlockXStart + 1;
+    const int nYBlocks = nBlockYEnd - nBlockYStart + 1;
+
+    // In contig mode, all bands are decoded from the same tile/strip, so
+    // cache them all.
+    const bool bContig = m_poParentDS->m_nPlanarConfig == PLANARCONFIG_CONTIG;
+    std::vector<int> anBands;
+    if (bContig)
+    {
+        for (int i = 1; i <= nBands; ++i)
+            anBands.push_back(i);
+    }
+    else
+    {
+        anBands.assign(panBandMap, panBandMap + nBandCount);
+    }
+
+    const GIntBig nRequiredMem =
+        static_cast<GIntBig>(anBands.size()) * nXBlocks * nYBlocks *
+        nBlockXSize * nBlockYSize *
+        GDALGetDataTypeSizeBytes(papoBands[0]->GetRasterDataType());
+    if (nRequiredMem > GDALGetCacheMax64())
+        return;
+
+    GTiffJPEGOverviewDecompressContext sContext;
+    sContext.poDS = this;
+    sContext.poHandle =
+        VSI_TIFFGetVSILFile(TIFFClientdata(m_poParentDS->m_hTIFF));
+    sContext.bHasPRead = sContext.poHandle->HasPRead();
+
+    // Create one job per tile/strip not yet in the block cache
+    std::vector<GTiffJPEGOverviewDecompressJob> asJobs;
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for (int y = nBlockYStart; y <= nBlockYEnd; ++y)
+    {
+        for (int x = nBlockXStart; x <= nBlockXEnd; ++x)
+        {
+            for (size_t i = 0; i < (bContig ? 1 : anBands.size()); ++i)
+            {
+                GTiffJPEGOverviewDecompressJob sJob;
+                sJob.psContext = &sContext;
+                sJob.nXBlock = x;
+                sJob.nYBlock = y;
+                if (bContig)
+                    sJob.anBands = anBands;
+                else
+                    sJob.anBands.push_back(anBands[i]);
+
+                bool bAllCached = true;
+                for (const int iBand : sJob.anBands)
+                {
+                    auto poBlock =
+                        papoBands[iBand - 1]->TryGetLockedBlockRef(x, y);
+                    if (poBlock == nullptr)
+                    {
+                        bAllCached = false;
+                        break;
+                    }
+                    poBlock->DropLock();
+                }
+                if (bAllCached)
+                    continue;
+
+                // Sparse, corrupted or unreasonably large tiles/strips are
+                // left to IReadBlock().
+                const int nBlockId = GetParentBlockId(sJob.anBands[0], x, y);
+                if (!m_poParentDS->IsBlockAvailable(nBlockId, &sJob.nOffset,
+                                                    &sJob.nSize) ||
+                    sJob.nSize < 2 || sJob.nSize > 100U * 1024 * 1024)
+                {
+                    continue;
+                }
+                sJob.nOffset += 2;  // Skip leading 0xFF 0xD8.
+                sJob.nSize -= 2;
+
+                anOffsets.push_back(sJob.nOffset);
+                anSizes.push_back(static_cast<size_t>(sJob.nSize));
+                asJobs.emplace_back(std::move(sJob));
+            }
+        }
+    }
+    if (asJobs.size() < 2)
+        return;
+
+    auto poQueue = m_poParentDS->m_poThreadPool->CreateJobQueue();
+    if (poQueue == nullptr)
+        return;
+
+    // Potentially start asynchronous fetching of ranges depending on file
+    // implementation
+    sContext.poHandle->AdviseRead(static_cast<int>(anOffsets.size()),
+                                  anOffsets.data(), anSizes.data());
+
+    // We need to do that as threads will access the block cache
+    TemporarilyDropReadWriteLock();
+
+    for (auto &sJob : asJobs)
+    {
+        poQueue->SubmitJob(ThreadDecompressionFunc, &sJob);
+    }
+
+    // Wait for all jobs to have been completed
+    poQueue->WaitCompletion();
+
+    // Undo effect of above TemporarilyDropReadWriteLock()
+    ReacquireReadWriteLock();
+
+    // Re-emit warnings caught in threads for the blocks that have been
+    // cached. Errors of failed blocks will be reported by IReadBlock().
+    for (const auto &sJob : asJobs)
+    {
+        if (!sJob.bSuccess)
+            continue;
+        for (const auto &oError : sJob.aoErrors)
+        {
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        }
+    }
+}
+
 /************************************************************************/
 /*                        GTiffJPEGOverviewBand()                       */
 /************************************************************************/
@@ -179,22 +554,8 @@ CPLErr GTiffJPEGOverviewBand::IReadBlock(int nBlockXOff, int nBlockYOff,
     GTiffJPEGOverviewDS *m_poGDS = cpl::down_cast<GTiffJPEGOverviewDS *>(poDS);
 
     // Compute the source block ID.
-    int nBlockId = 0;
-    int nParentBlockXSize, nParentBlockYSize;
-    m_poGDS->m_poParentDS->GetRasterBand(1)->GetBlockSize(&nParentBlockXSize,
-                                                          &nParentBlockYSize);
-    const bool bIsSingleStripAsSplit =
-        (nParentBlockYSize == 1 &&
-         m_poGDS->m_poParentDS->m_nBlockYSize != nParentBlockYSize);
-    if (!bIsSingleStripAsSplit)
-    {
-        nBlockId =
-            nBlockYOff * m_poGDS->m_poParentDS->m_nBlocksPerRow + nBlockXOff;
-    }
-    if (m_poGDS->m_poParentDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE)
-    {
-        nBlockId += (nBand - 1) * m_poGDS->m_poParentDS->m_nBlocksPerBand;
-    }
+    const int nBlockId =
+        m_poGDS->GetParentBlockId(nBand, nBlockXOff, nBlockYOff);
 
     // Make sure it is available.
     const int nDataTypeSize = GDALGetDataTypeSizeBytes(eDataType);
@@ -212,7 +573,6 @@ CPLErr GTiffJPEGOverviewBand::IReadBlock(int nBlockXOff, int nBlockYOff,
         return CE_None;
     }
 
-    const int nScaleFactor = 1 << m_poGDS->m_nOverviewLevel;
     if (m_poGDS->m_poJPEGDS == nullptr || nBlockId != m_poGDS->m_nBlockId)
     {
         if (nByteCount < 2)
@@ -290,108 +650,157 @@ CPLErr GTiffJPEGOverviewBand::IReadBlock(int nBlockXOff, int nBlockYOff,
         }
         CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
 
-        const char *const apszDrivers[] = {"JPEG", nullptr};
+        m_poGDS->m_poJPEGDS = m_poGDS->OpenJPEGDS(osFileToOpen);
+        if (m_poGDS->m_poJPEGDS != nullptr)
+            m_poGDS->m_nBlockId = nBlockId;
+    }
+
+    if (m_poGDS->m_poJPEGDS == nullptr)
+        return CE_Failure;
 
-        CPLConfigOptionSetter oJPEGtoRGBSetter(
-            "GDAL_JPEG_TO_RGB",
-            m_poGDS->m_poParentDS->m_nPlanarConfig == PLANARCONFIG_CONTIG &&
-                    m_poGDS->nBands == 4
-                ? "NO"
-                : "YES",
-            false);
+    return ReadFromJPEGDS(m_poGDS->m_poJPEGDS.get(), nBlockXOff, nBlockYOff,
+                          pImage);
+}
 
-        m_poGDS->m_poJPEGDS.reset(
-            GDALDataset::Open(osFileToOpen, GDAL_OF_RASTER | GDAL_OF_INTERNAL,
-                              apszDrivers, nullptr, nullptr));
+/************************************************************************/
+/*                          ReadFromJPEGDS()                            */
+/************************************************************************/
 
-        if (m_poGDS->m_poJPEGDS != nullptr)
-        {
-            // Force all implicit overviews to be available, even for
-            // small tiles.
-            CPLConfigOptionSetter oInternalOverviewsSetter(
-                "JPEG_FORCE_INTERNAL_OVERVIEWS", "YES", false);
-            GDALGetOverviewCount(
-                GDALGetRasterBand(m_poGDS->m_poJPEGDS.get(), 1));
+// Reads the content of block (nBlockXOff, nBlockYOff) from poJPEGDS, the
+// JPEG dataset forged from the corresponding tile/strip of the parent dataset.
+CPLErr GTiffJPEGOverviewBand::ReadFromJPEGDS(GDALDataset *poJPEGDS,
+                                             int nBlockXOff, int nBlockYOff,
+                                             void *pImage)
+{
+    GTiffJPEGOverviewDS *m_poGDS = cpl::down_cast<GTiffJPEGOverviewDS *>(poDS);
 
-            m_poGDS->m_nBlockId = nBlockId;
-        }
-    }
+    const bool bIsSingleStripAsSplit = m_poGDS->IsSingleStripAsSplit();
+    const int nDataTypeSize = GDALGetDataTypeSizeBytes(eDataType);
+    const int nScaleFactor = 1 << m_poGDS->m_nOverviewLevel;
 
-    CPLErr eErr = CE_Failure;
-    if (m_poGDS->m_poJPEGDS)
+    int nReqXOff = 0;
+    int nReqYOff = 0;
+    int nReqXSize = 0;
+    int nReqYSize = 0;
+    if (bIsSingleStripAsSplit)
     {
-        GDALDataset *l_poDS = m_poGDS->m_poJPEGDS.get();
-
-        int nReqXOff = 0;
-        int nReqYOff = 0;
-        int nReqXSize = 0;
-        int nReqYSize = 0;
-        if (bIsSingleStripAsSplit)
+        nReqYOff = nBlockYOff * nScaleFactor;
+        nReqXSize = poJPEGDS->GetRasterXSize();
+        nReqYSize = nScaleFactor;
+    }
+    else
+    {
+        if (nBlockXSize == m_poGDS->GetRasterXSize())
         {
-            nReqYOff = nBlockYOff * nScaleFactor;
-            nReqXSize = l_poDS->GetRasterXSize();
-            nReqYSize = nScaleFactor;
+            nReqXSize = poJPEGDS->GetRasterXSize();
         }
         else
         {
-            if (nBlockXSize == m_poGDS->GetRasterXSize())
-            {
-                nReqXSize = l_poDS->GetRasterXSize();
-            }
-            else
-            {
-                nReqXSize = nBlockXSize * nScaleFactor;
-            }
-            nReqYSize = nBlockYSize * nScaleFactor;
-        }
-        int nBufXSize = nBlockXSize;
-        int nBufYSize = nBlockYSize;
-        if (nBlockXOff == m_poGDS->m_poParentDS->m_nBlocksPerRow - 1)
-        {
-            nReqXSize = m_poGDS->m_poParentDS->nRasterXSize -
-                        nBlockXOff * m_poGDS->m_poParentDS->m_nBlockXSize;
-        }
-        if (nReqXOff + nReqXSize > l_poDS->GetRasterXSize())
-        {
-            nReqXSize = l_poDS->GetRasterXSize() - nReqXOff;
-        }
-        if (!bIsSingleStripAsSplit &&
-            nBlockYOff == m_poGDS->m_poParentDS->m_nBlocksPerColumn - 1)
-        {
-            nReqYSize = m_poGDS->m_poParentDS->nRasterYSize -
-                        nBlockYOff * m_poGDS->m_poParentDS->m_nBlockYSize;
-        }
-        if (nReqYOff + nReqYSize > l_poDS->GetRasterYSize())
-        {
-            nReqYSize = l_poDS->GetRasterYSize() - nReqYOff;
-        }
-        if (nBlockXOff * nBlockXSize > m_poGDS->GetRasterXSize() - nBufXSize)
-        {
-            memset(pImage, 0,
-                   static_cast<GPtrDiff_t>(nBlockXSize) * nBlockYSize *
-                       nDataTypeSize);
-            nBufXSize = m_poGDS->GetRasterXSize() - nBlockXOff * nBlockXSize;
-        }
-        if (nBlockYOff * nBlockYSize > m_poGDS->GetRasterYSize() - nBufYSize)
-        {
-            memset(pImage, 0,
-                   static_cast<GPtrDiff_t>(nBlockXSize) * nBlockYSize *
-                       nDataTypeSize);
-            nBufYSize = m_poGDS->GetRasterYSize() - nBlockYOff * nBlockYSize;
+            nReqXSize = nBlockXSize * nScaleFactor;
         }
+        nReqYSize = nBlockYSize * nScaleFactor;
+    }
+    int nBufXSize = nBlockXSize;
+    int nBufYSize = nBlockYSize;
+    if (nBlockXOff == m_poGDS->m_poParentDS->m_nBlocksPerRow - 1)
+    {
+        nReqXSize = m_poGDS->m_poParentDS->nRasterXSize -
+                    nBlockXOff * m_poGDS->m_poParentDS->m_nBlockXSize;
+    }
+    if (nReqXOff + nReqXSize > poJPEGDS->GetRasterXSize())
+    {
+        nReqXSize = poJPEGDS->GetRasterXSize() - nReqXOff;
+    }
+    if (!bIsSingleStripAsSplit &&
+        nBlockYOff == m_poGDS->m_poParentDS->m_nBlocksPerColumn - 1)
+    {
+        nReqYSize = m_poGDS->m_poParentDS->nRasterYSize -
+                    nBlockYOff * m_poGDS->m_poParentDS->m_nBlockYSize;
+    }
+    if (nReqYOff + nReqYSize > poJPEGDS->GetRasterYSize())
+    {
+        nReqYSize = poJPEGDS->GetRasterYSize() - nReqYOff;
+    }
+    if (nBlockXOff * nBlockXSize > m_poGDS->GetRasterXSize() - nBufXSize)
+    {
+        memset(pImage, 0,
+               static_cast<GPtrDiff_t>(nBlockXSize) * nBlockYSize *
+                   nDataTypeSize);
+        nBufXSize = m_poGDS->GetRasterXSize() - nBlockXOff * nBlockXSize;
+    }
+    if (nBlockYOff * nBlockYSize > m_poGDS->GetRasterYSize() - nBufYSize)
+    {
+        memset(pImage, 0,
+               static_cast<GPtrDiff_t>(nBlockXSize) * nBlockYSize *
+                   nDataTypeSize);
+        nBufYSize = m_poGDS->GetRasterYSize() - nBlockYOff * nBlockYSize;
+    }
 
-        const int nSrcBand =
-            m_poGDS->m_poParentDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE
-                ? 1
-                : nBand;
-        if (nSrcBand <= l_poDS->GetRasterCount())
-        {
-            eErr = l_poDS->GetRasterBand(nSrcBand)->RasterIO(
-                GF_Read, nReqXOff, nReqYOff, nReqXSize, nReqYSize, pImage,
-                nBufXSize, nBufYSize, eDataType, 0,
-                static_cast<GPtrDiff_t>(nBlockXSize) * nDataTypeSize, nullptr);
-        }
+    const int nSrcBand =
+        m_poGDS->m_poParentDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE
+            ? 1
+            : nBand;
+    if (nSrcBand > poJPEGDS->GetRasterCount())
+        return CE_Failure;
+
+    return poJPEGDS->GetRasterBand(nSrcBand)->RasterIO(
+        GF_Read, nReqXOff, nReqYOff, nReqXSize, nReqYSize, pImage, nBufXSize,
+        nBufYSize, eDataType, 0,
+        static_cast<GPtrDiff_t>(nBlockXSize) * nDataTypeSize, nullptr);
+}
+
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+CPLErr GTiffJPEGOverviewBand::IRasterIO(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    GSpacing nPixelSpace, GSpacing nLineSpace, GDALRasterIOExtraArg *psExtraArg)
+{
+    GTiffJPEGOverviewDS *m_poGDS = cpl::down_cast<GTiffJPEGOverviewDS *>(poDS);
+
+    if (eRWFlag == GF_Read && m_poGDS->m_poParentDS->m_poThreadPool != nullptr)
+    {
+        m_poGDS->MultiThreadedRead(nXOff, nYOff, nXSize, nYSize, 1, &nBand);
     }
 
-    return eErr;
+    return GDALRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                                     pData, nBufXSize, nBufYSize, eBufType,
+                                     nPixelSpace, nLineSpace, psExtraArg);
+}
+
+/************************************************************************/
+/*                       IGetDataCoverageStatus()                       */
+/************************************************************************/
+
+int GTiffJPEGOverviewBand::IGetDataCoverageStatus(int nXOff, int nYOff,
+                                                  int nXSize, int nYSize,
+                                                  int nMaskFlagStop,
+                                                  double *pdfDataPct)
+{
+    GTiffJPEGOverviewDS *m_poGDS = cpl::down_cast<GTiffJPEGOverviewDS *>(poDS);
+    GDALRasterBand *poParentBand = m_poGDS->m_poParentDS->GetRasterBand(nBand);
+
+    // Each block of the overview is decoded from the block of the parent
+    // dataset at the same index, so forward the request to the parent band
+    // with the window scaled accordingly.
+    const int nScaleFactor = 1 << m_poGDS->m_nOverviewLevel;
+    const int nParentXSize = poParentBand->GetXSize();
+    const int nParentYSize = poParentBand->GetYSize();
+    const int nParentXOff =
+        static_cast<int>(std::min(static_cast<GIntBig>(nXOff) * nScaleFactor,
+                                  static_cast<GIntBig>(nParentXSize - 1)));
+    const int nParentYOff =
+        static_cast<int>(std::min(static_cast<GIntBig>(nYOff) * nScaleFactor,
+                                  static_cast<GIntBig>(nParentYSize - 1)));
+    const int nParentXSizeReq = static_cast<int>(
+        std::min(static_cast<GIntBig>(nXSize) * nScaleFactor,
+                 static_cast<GIntBig>(nParentXSize - nParentXOff)));
+    const int nParentYSizeReq = static_cast<int>(
+        std::min(static_cast<GIntBig>(nYSize) * nScaleFactor,
+                 static_cast<GIntBig>(nParentYSize - nParentYOff)));
+    return poParentBand->GetDataCoverageStatus(
+        nParentXOff, nParentYOff, nParentXSizeReq, nParentYSizeReq,
+        nMaskFlagStop, pdfDataPct);
 }
@@ -32,6 +32,8 @@
 
 #include "gdal_priv.h"
 
+#include <memory>
+
 class GTiffDataset;
 
 /************************************************************************/
@@ -57,6 +59,14 @@ class GTiffJPEGOverviewDS final : public GDALDataset
     // Valid block id of the parent DS that match poJPEGDS.
     int m_nBlockId = -1;
 
+    bool IsSingleStripAsSplit() const;
+    int GetParentBlockId(int nBand, int nBlockXOff, int nBlockYOff) const;
+    std::unique_ptr<GDALDataset> OpenJPEGDS(const char *pszFilename) const;
+
+    void MultiThreadedRead(int nXOff, int nYOff, int nXSize, int nYSize,
+                           int nBandCount, const int *panBandMap);
+    static void ThreadDecompressionFunc(void *pData);
+
   public:
     GTiffJPEGOverviewDS(GTiffDataset *poParentDS, int nOverviewLevel,
                         const void *pJPEGTable, int nJPEGTableSize);
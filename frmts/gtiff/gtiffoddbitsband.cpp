@@ -69,6 +69,8 @@ CPLErr GTiffOddBitsBand::IWriteBlock(int nBlockXOff, int nBlockYOff,
                                      void *pImage)
 
 {
+    const auto oConcurrentWriteLock = m_poGDS->GetConcurrentWriteLock();
+
     m_poGDS->Crystalize();
 
     if (m_poGDS->m_bWriteError)
@@ -589,6 +591,8 @@ CPLErr GTiffOddBitsBand::IReadBlock(int nBlockXOff, int nBlockYOff,
                                     void *pImage)
 
 {
+    const auto oConcurrentWriteLock = m_poGDS->GetConcurrentWriteLock();
+
     m_poGDS->Crystalize();
 
     const int nBlockId = ComputeBlockId(nBlockXOff, nBlockYOff);
@@ -239,6 +239,8 @@ CPLErr GTiffRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
              nYSize, nBufXSize, nBufYSize);
 #endif
 
+    const auto oConcurrentWriteLock = m_poGDS->GetConcurrentWriteLock();
+
     // Try to pass the request to the most appropriate overview dataset.
     if (nBufXSize < nXSize && nBufYSize < nYSize)
     {
@@ -73,6 +73,8 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
                           int nBufXSize, int nBufYSize,
                           GDALRasterIOExtraArg *psExtraArg);
 
+    bool HasPendingWrite(int nBlockXOff, int nBlockYOff, int nBlockId);
+
   protected:
     GTiffDataset *m_poGDS = nullptr;
     GDALMultiDomainMetadata m_oGTiffMDMD{};
@@ -1086,6 +1086,40 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
     return pBufferedData;
 }
 
+/************************************************************************/
+/*                          HasPendingWrite()                           */
+/************************************************************************/
+
+// Returns whether the block has been modified but not yet written to the
+// file, either because it is dirty in the block cache, or because it is the
+// currently loaded block of the dataset.
+bool GTiffRasterBand::HasPendingWrite(int nBlockXOff, int nBlockYOff,
+                                      int nBlockId)
+{
+    if (m_poGDS->m_nLoadedBlock == nBlockId && m_poGDS->m_bLoadedBlockDirty)
+        return true;
+
+    const int nBandStart =
+        m_poGDS->m_nPlanarConfig == PLANARCONFIG_CONTIG ? 1 : nBand;
+    const int nBandEnd =
+        m_poGDS->m_nPlanarConfig == PLANARCONFIG_CONTIG ? m_poGDS->nBands
+                                                        : nBand;
+    for (int iBand = nBandStart; iBand <= nBandEnd; ++iBand)
+    {
+        GDALRasterBlock *poBlock =
+            m_poGDS->GetRasterBand(iBand)->TryGetLockedBlockRef(nBlockXOff,
+                                                                nBlockYOff);
+        if (poBlock)
+        {
+            const bool bDirty = poBlock->GetDirty();
+            poBlock->DropLock();
+            if (bDirty)
+                return true;
+        }
+    }
+    return false;
+}
+
 /************************************************************************/
 /*                       IGetDataCoverageStatus()                       */
 /************************************************************************/
@@ -1094,8 +1128,12 @@ int GTiffRasterBand::IGetDataCoverageStatus(int nXOff, int nYOff, int nXSize,
                                             int nYSize, int nMaskFlagStop,
                                             double *pdfDataPct)
 {
+    // In update mode, do not flush the block cache (which would evict it),
+    // but make sure the directory is written so that strile offsets and
+    // byte counts are up to date. Blocks that are still dirty in the cache
+    // are reported as containing data.
     if (eAccess == GA_Update)
-        m_poGDS->FlushCache(false);
+        m_poGDS->Crystalize();
 
     const int iXBlockStart = nXOff / nBlockXSize;
     const int iXBlockEnd = (nXOff + nXSize - 1) / nBlockXSize;
@@ -1116,7 +1154,11 @@ int GTiffRasterBand::IGetDataCoverageStatus(int nXOff, int nYOff, int nXSize,
             vsi_l_offset nOffset = 0;
             vsi_l_offset nLength = 0;
             bool bHasData = false;
-            if (!m_poGDS->IsBlockAvailable(nBlockId, &nOffset, &nLength))
+            if (eAccess == GA_Update && HasPendingWrite(iX, iY, nBlockId))
+            {
+                bHasData = true;
+            }
+            else if (!m_poGDS->IsBlockAvailable(nBlockId, &nOffset, &nLength))
             {
                 nStatus |= GDAL_DATA_COVERAGE_STATUS_EMPTY;
             }
@@ -1185,6 +1227,8 @@ int GTiffRasterBand::IGetDataCoverageStatus(int nXOff, int nYOff, int nXSize,
 CPLErr GTiffRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
 
 {
+    const auto oConcurrentWriteLock = m_poGDS->GetConcurrentWriteLock();
+
     m_poGDS->Crystalize();
 
     GPtrDiff_t nBlockBufSize = 0;
@@ -55,6 +55,8 @@ CPLErr GTiffRasterBand::IWriteBlock(int nBlockXOff, int nBlockYOff,
                                     void *pImage)
 
 {
+    const auto oConcurrentWriteLock = m_poGDS->GetConcurrentWriteLock();
+
     m_poGDS->Crystalize();
 
     if (m_poGDS->m_bDebugDontWriteBlocks)
@@ -634,6 +634,10 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
     bool IsMosaicOfNonOverlappingSimpleSourcesOfFullRasterNoResAndTypeChange(
         bool bAllowMaxValAdjustment) const;
 
+    bool GetDataCoverageStatusFromSource(VRTSimpleSource *poSS, int nXOff,
+                                         int nYOff, int nXSize, int nYSize,
+                                         int &nSrcXOff, int &nSrcYOff);
+
     CPL_DISALLOW_COPY_ASSIGN(VRTSourcedRasterBand)
 
   protected:
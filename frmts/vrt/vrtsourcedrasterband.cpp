@@ -339,6 +339,51 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
     return eErr;
 }
 
+/************************************************************************/
+/*                  GetDataCoverageStatusFromSource()                   */
+/************************************************************************/
+
+// Returns whether the data coverage status of a window fully inside the
+// destination window of a source can be forwarded to the source band, in
+// which case the offsets of the window in the source band are returned.
+// This requires a simple source without resampling, whose empty regions
+// read with the same value as the empty regions of this band.
+bool VRTSourcedRasterBand::GetDataCoverageStatusFromSource(
+    VRTSimpleSource *poSS, int nXOff, int nYOff, int nXSize, int nYSize,
+    int &nSrcXOff, int &nSrcYOff)
+{
+    if (!EQUAL(poSS->GetType(), "SimpleSource") || poSS->m_bGetMaskBand ||
+        poSS->m_dfSrcXSize != poSS->m_dfDstXSize ||
+        poSS->m_dfSrcYSize != poSS->m_dfDstYSize)
+    {
+        return false;
+    }
+    const double dfSrcXOff = nXOff - poSS->m_dfDstXOff + poSS->m_dfSrcXOff;
+    const double dfSrcYOff = nYOff - poSS->m_dfDstYOff + poSS->m_dfSrcYOff;
+    auto poSrcBand = poSS->GetRasterBand();
+    if (poSrcBand == nullptr || dfSrcXOff != std::floor(dfSrcXOff) ||
+        dfSrcYOff != std::floor(dfSrcYOff) || dfSrcXOff < 0 ||
+        dfSrcYOff < 0 || dfSrcXOff + nXSize > poSrcBand->GetXSize() ||
+        dfSrcYOff + nYSize > poSrcBand->GetYSize())
+    {
+        return false;
+    }
+
+    int bSrcHasNoData = FALSE;
+    const double dfSrcNoData = poSrcBand->GetNoDataValue(&bSrcHasNoData);
+    const double dfSrcEmptyValue = bSrcHasNoData ? dfSrcNoData : 0.0;
+    const double dfEmptyValue = m_bNoDataValueSet ? m_dfNoDataValue : 0.0;
+    if (!(dfSrcEmptyValue == dfEmptyValue ||
+          (std::isnan(dfSrcEmptyValue) && std::isnan(dfEmptyValue))))
+    {
+        return false;
+    }
+
+    nSrcXOff = static_cast<int>(dfSrcXOff);
+    nSrcYOff = static_cast<int>(dfSrcYOff);
+    return true;
+}
+
 /************************************************************************/
 /*                         IGetDataCoverageStatus()                     */
 /************************************************************************/
@@ -400,6 +445,24 @@ int VRTSourcedRasterBand::IGetDataCoverageStatus(int nXOff, int nYOff,
             nXOff + nXSize <= dfDstXOff + dfDstXSize &&
             nYOff + nYSize <= dfDstYOff + dfDstYSize)
         {
+            // If the window is read from a single simple source without
+            // resampling and with the same nodata value, the source may
+            // know that it is empty (e.g. missing tiles of a sparse GeoTIFF
+            // file).
+            if (nSources == 1)
+            {
+                int nSrcXOff = 0;
+                int nSrcYOff = 0;
+                if (GetDataCoverageStatusFromSource(poSS, nXOff, nYOff,
+                                                    nXSize, nYSize, nSrcXOff,
+                                                    nSrcYOff))
+                {
+                    delete poPolyNonCoveredBySources;
+                    return l_poBand->GetDataCoverageStatus(
+                        nSrcXOff, nSrcYOff, nXSize, nYSize, nMaskFlagStop,
+                        pdfDataPct);
+                }
+            }
             if (pdfDataPct)
                 *pdfDataPct = 100.0;
             delete poPolyNonCoveredBySources;
@@ -343,6 +343,21 @@ typedef struct GDALSQLParseInfo GDALSQLParseInfo;
 #endif
 //! @endcond
 
+/** Window of a raster, in pixel coordinates.
+ * @since GDAL 3.8
+ */
+struct GDALRasterWindow
+{
+    /** Left offset of the window */
+    int nXOff = 0;
+    /** Top offset of the window */
+    int nYOff = 0;
+    /** Width of the window */
+    int nXSize = 0;
+    /** Height of the window */
+    int nYSize = 0;
+};
+
 /** A set of associated raster bands, usually from one file. */
 class CPL_DLL GDALDataset : public GDALMajorObject
 {
@@ -640,6 +655,11 @@ class CPL_DLL GDALDataset : public GDALMajorObject
 
     void MarkSuppressOnClose();
 
+    void SetDirtyRegionTracking(bool bEnable);
+    bool IsDirtyRegionTrackingEnabled();
+    void MarkRegionDirty(int nXOff, int nYOff, int nXSize, int nYSize);
+    std::vector<GDALRasterWindow> GetDirtyRegions(bool bClear = false);
+
     /** Return open options.
      * @return open options.
      */
@@ -1323,6 +1343,7 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
     void LeaveReadWrite();
     void InitRWLock();
     void SetValidPercent(GUIntBig nSampleCount, GUIntBig nValidCount);
+    void MarkDatasetRegionDirty(int nXOff, int nYOff, int nXSize, int nYSize);
 
     //! @endcond
 
@@ -3634,6 +3655,12 @@ GDALResampleFunction GDALGetResampleFunction(const char *pszResampling,
 GDALDataType GDALGetOvrWorkDataType(const char *pszResampling,
                                     GDALDataType eSrcDataType);
 
+CPLErr GDALRegenerateOverviewsInRegions(
+    GDALDataset *poDS, const char *pszResampling, int nOverviews,
+    const int *panOverviewList, int nListBands, const int *panBandList,
+    const std::vector<GDALRasterWindow> &aoRegions,
+    GDALProgressFunc pfnProgress, void *pProgressData);
+
 CPL_C_START
 
 CPLErr CPL_DLL
@@ -37,7 +37,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <new>
 #include <set>
 #include <string>
@@ -121,6 +123,12 @@ class GDALDataset::Private
 
     bool m_bOverviewsEnabled = true;
 
+    // -1 until the GDAL_TRACK_DIRTY_REGIONS configuration option has been
+    // read, or SetDirtyRegionTracking() called.
+    std::atomic<int> m_nTrackDirtyRegions{-1};
+    std::mutex m_oDirtyRegionsMutex{};
+    std::vector<GDALRasterWindow> m_aoDirtyRegions{};
+
     Private() = default;
 };
 
@@ -1630,6 +1638,197 @@ void GDALDataset::MarkSuppressOnClose()
     bSuppressOnClose = true;
 }
 
+/************************************************************************/
+/*                          MarkRegionDirty()                           */
+/************************************************************************/
+
+// Returns whether the union of two windows is a window, and computes it.
+static bool GDALMergeRasterWindows(const GDALRasterWindow &oA,
+                                   const GDALRasterWindow &oB,
+                                   GDALRasterWindow &oUnion)
+{
+    const int nXEndA = oA.nXOff + oA.nXSize;
+    const int nYEndA = oA.nYOff + oA.nYSize;
+    const int nXEndB = oB.nXOff + oB.nXSize;
+    const int nYEndB = oB.nYOff + oB.nYSize;
+    const bool bSameX = oA.nXOff == oB.nXOff && nXEndA == nXEndB;
+    const bool bSameY = oA.nYOff == oB.nYOff && nYEndA == nYEndB;
+    const bool bXTouch = oA.nXOff <= nXEndB && oB.nXOff <= nXEndA;
+    const bool bYTouch = oA.nYOff <= nYEndB && oB.nYOff <= nYEndA;
+    const bool bAContainsB = oA.nXOff <= oB.nXOff && nXEndB <= nXEndA &&
+                             oA.nYOff <= oB.nYOff && nYEndB <= nYEndA;
+    const bool bBContainsA = oB.nXOff <= oA.nXOff && nXEndA <= nXEndB &&
+                             oB.nYOff <= oA.nYOff && nYEndA <= nYEndB;
+    if (!(bSameX && bYTouch) && !(bSameY && bXTouch) && !bAContainsB &&
+        !bBContainsA)
+    {
+        return false;
+    }
+    oUnion.nXOff = std::min(oA.nXOff, oB.nXOff);
+    oUnion.nYOff = std::min(oA.nYOff, oB.nYOff);
+    oUnion.nXSize = std::max(nXEndA, nXEndB) - oUnion.nXOff;
+    oUnion.nYSize = std::max(nYEndA, nYEndB) - oUnion.nYOff;
+    return true;
+}
+
+/**
+ * \brief Record that a window of the raster bands has been modified.
+ *
+ * This is called by GDALDataset::RasterIO() and GDALRasterBand::RasterIO()
+ * and GDALRasterBand::WriteBlock() in write mode. Drivers that update their
+ * rasters through other ways may call it. The recorded regions can be
+ * retrieved with GetDirtyRegions(), or be used by BuildOverviews() with the
+ * REFRESH_DIRTY_REGIONS=YES option to refresh only the overview pixels that
+ * depend on them.
+ *
+ * This does nothing unless tracking has been enabled with
+ * SetDirtyRegionTracking(), or with the GDAL_TRACK_DIRTY_REGIONS=YES
+ * configuration option set before the first write.
+ *
+ * Adjacent windows that form a rectangle, such as successive lines or tiles,
+ * are merged together.
+ *
+ * @param nXOff left offset of the window.
+ * @param nYOff top offset of the window.
+ * @param nXSize width of the window.
+ * @param nYSize height of the window.
+ * @since GDAL 3.8
+ */
+void GDALDataset::MarkRegionDirty(int nXOff, int nYOff, int nXSize,
+                                  int nYSize)
+{
+    if (nXSize <= 0 || nYSize <= 0 || !IsDirtyRegionTrackingEnabled())
+        return;
+
+    GDALRasterWindow oNewRegion;
+    oNewRegion.nXOff = nXOff;
+    oNewRegion.nYOff = nYOff;
+    oNewRegion.nXSize = nXSize;
+    oNewRegion.nYSize = nYSize;
+
+    std::lock_guard<std::mutex> oLock(m_poPrivate->m_oDirtyRegionsMutex);
+    auto &aoRegions = m_poPrivate->m_aoDirtyRegions;
+
+    // Merge the new region with the existing ones as long as possible.
+    bool bMerged = true;
+    while (bMerged)
+    {
+        bMerged = false;
+        for (size_t i = 0; i < aoRegions.size(); ++i)
+        {
+            GDALRasterWindow oUnion;
+            if (GDALMergeRasterWindows(aoRegions[i], oNewRegion, oUnion))
+            {
+                oNewRegion = oUnion;
+                aoRegions.erase(aoRegions.begin() + i);
+                bMerged = true;
+                break;
+            }
+        }
+    }
+    aoRegions.push_back(oNewRegion);
+
+    // Avoid the list to grow unbounded with scattered writes.
+    constexpr size_t MAX_DIRTY_REGIONS = 1024;
+    if (aoRegions.size() > MAX_DIRTY_REGIONS)
+    {
+        GDALRasterWindow oUnion = aoRegions[0];
+        for (const auto &oRegion : aoRegions)
+        {
+            const int nXEnd = std::max(oUnion.nXOff + oUnion.nXSize,
+                                       oRegion.nXOff + oRegion.nXSize);
+            const int nYEnd = std::max(oUnion.nYOff + oUnion.nYSize,
+                                       oRegion.nYOff + oRegion.nYSize);
+            oUnion.nXOff = std::min(oUnion.nXOff, oRegion.nXOff);
+            oUnion.nYOff = std::min(oUnion.nYOff, oRegion.nYOff);
+            oUnion.nXSize = nXEnd - oUnion.nXOff;
+            oUnion.nYSize = nYEnd - oUnion.nYOff;
+        }
+        aoRegions.clear();
+        aoRegions.push_back(oUnion);
+    }
+}
+
+/************************************************************************/
+/*                       SetDirtyRegionTracking()                       */
+/************************************************************************/
+
+/**
+ * \brief Enable or disable the recording of modified windows.
+ *
+ * Tracking is disabled by default, unless the GDAL_TRACK_DIRTY_REGIONS
+ * configuration option is set to YES when the dataset is first written.
+ * It must be enabled before the writes whose windows must be recorded.
+ * Disabling it discards the recorded regions.
+ *
+ * @param bEnable whether modified windows must be recorded.
+ * @see MarkRegionDirty()
+ * @since GDAL 3.8
+ */
+void GDALDataset::SetDirtyRegionTracking(bool bEnable)
+{
+    if (m_poPrivate == nullptr)
+        return;
+    m_poPrivate->m_nTrackDirtyRegions = bEnable ? 1 : 0;
+    if (!bEnable)
+    {
+        std::lock_guard<std::mutex> oLock(m_poPrivate->m_oDirtyRegionsMutex);
+        m_poPrivate->m_aoDirtyRegions.clear();
+    }
+}
+
+/************************************************************************/
+/*                    IsDirtyRegionTrackingEnabled()                    */
+/************************************************************************/
+
+/**
+ * \brief Return whether modified windows are recorded.
+ *
+ * @see SetDirtyRegionTracking()
+ * @since GDAL 3.8
+ */
+bool GDALDataset::IsDirtyRegionTrackingEnabled()
+{
+    if (m_poPrivate == nullptr)
+        return false;
+    int nTrack = m_poPrivate->m_nTrackDirtyRegions;
+    if (nTrack < 0)
+    {
+        nTrack = CPLTestBool(
+                     CPLGetConfigOption("GDAL_TRACK_DIRTY_REGIONS", "NO"))
+                     ? 1
+                     : 0;
+        m_poPrivate->m_nTrackDirtyRegions = nTrack;
+    }
+    return nTrack == 1;
+}
+
+/************************************************************************/
+/*                          GetDirtyRegions()                           */
+/************************************************************************/
+
+/**
+ * \brief Return the windows of the raster bands that have been modified.
+ *
+ * @param bClear whether the recorded regions should be cleared.
+ * @return the list of modified windows, that do not contain each other.
+ * @see MarkRegionDirty()
+ * @since GDAL 3.8
+ */
+std::vector<GDALRasterWindow> GDALDataset::GetDirtyRegions(bool bClear)
+{
+    std::vector<GDALRasterWindow> aoRegions;
+    if (m_poPrivate == nullptr)
+        return aoRegions;
+
+    std::lock_guard<std::mutex> oLock(m_poPrivate->m_oDirtyRegionsMutex);
+    if (bClear)
+        std::swap(aoRegions, m_poPrivate->m_aoDirtyRegions);
+    else
+        aoRegions = m_poPrivate->m_aoDirtyRegions;
+    return aoRegions;
+}
+
 /************************************************************************/
 /*                        CleanupPostFileClosing()                      */
 /************************************************************************/
@@ -2011,6 +2210,19 @@ CPLErr GDALSetGCPs2(GDALDatasetH hDS, int nGCPCount, const GDAL_GCP *pasGCPList,
  *                              GDALDummyProgress, nullptr );
  * \endcode
  *
+ * Starting with GDAL 3.8, existing overviews can be partially refreshed with
+ * the following options, in which case nOverviews == 0 means all the existing
+ * overview levels:
+ * <ul>
+ * <li>REFRESH_REGIONS=xoff,yoff,xsize,ysize[;xoff,yoff,xsize,ysize]*: list of
+ * windows of the full resolution bands, in pixel coordinates, whose overview
+ * pixels must be recomputed.</li>
+ * <li>REFRESH_DIRTY_REGIONS=YES: recompute the overview pixels that depend on
+ * the windows modified since the dataset was opened, or since the last
+ * successful refresh. This requires dirty region tracking to have been
+ * enabled before writing. See SetDirtyRegionTracking().</li>
+ * </ul>
+ *
  * @see GDALRegenerateOverviewsEx()
  */
 
@@ -2045,7 +2257,8 @@ CPLErr GDALDataset::BuildOverviews(const char *pszResampling, int nOverviews,
     {
         char *pszKey = nullptr;
         const char *pszValue = CPLParseNameValue(*papszIter, &pszKey);
-        if (pszKey && pszValue)
+        if (pszKey && pszValue && !EQUAL(pszKey, "REFRESH_REGIONS") &&
+            !EQUAL(pszKey, "REFRESH_DIRTY_REGIONS"))
         {
             apoConfigOptionSetter.emplace_back(
                 cpl::make_unique<CPLConfigOptionSetter>(pszKey, pszValue,
@@ -2054,9 +2267,87 @@ CPLErr GDALDataset::BuildOverviews(const char *pszResampling, int nOverviews,
         CPLFree(pszKey);
     }
 
-    const CPLErr eErr =
-        IBuildOverviews(pszResampling, nOverviews, panOverviewList, nListBands,
-                        panBandList, pfnProgress, pProgressData, papszOptions);
+    CPLErr eErr = CE_None;
+    const char *pszRefreshRegions =
+        CSLFetchNameValue(papszOptions, "REFRESH_REGIONS");
+    const bool bRefreshDirtyRegions = CPLTestBool(
+        CSLFetchNameValueDef(papszOptions, "REFRESH_DIRTY_REGIONS", "NO"));
+    if (pszRefreshRegions || bRefreshDirtyRegions)
+    {
+        std::vector<GDALRasterWindow> aoRegions;
+        if (pszRefreshRegions)
+        {
+            const CPLStringList aosRegions(
+                CSLTokenizeString2(pszRefreshRegions, ";", 0));
+            for (int i = 0; i < aosRegions.size(); ++i)
+            {
+                const CPLStringList aosValues(
+                    CSLTokenizeString2(aosRegions[i], ",", 0));
+                if (aosValues.size() != 4)
+                {
+                    ReportError(CE_Failure, CPLE_IllegalArg,
+                                "Invalid value for REFRESH_REGIONS: %s",
+                                aosRegions[i]);
+                    CPLFree(panAllBandList);
+                    return CE_Failure;
+                }
+                GDALRasterWindow oRegion;
+                oRegion.nXOff = atoi(aosValues[0]);
+                oRegion.nYOff = atoi(aosValues[1]);
+                oRegion.nXSize = atoi(aosValues[2]);
+                oRegion.nYSize = atoi(aosValues[3]);
+                aoRegions.push_back(oRegion);
+            }
+        }
+        std::vector<GDALRasterWindow> aoDirtyRegions;
+        if (bRefreshDirtyRegions)
+        {
+            if (!IsDirtyRegionTrackingEnabled())
+            {
+                ReportError(CE_Failure, CPLE_NotSupported,
+                            "REFRESH_DIRTY_REGIONS=YES requires dirty region "
+                            "tracking to be enabled before writing");
+                CPLFree(panAllBandList);
+                return CE_Failure;
+            }
+            // Do not clear the regions now, so that they can be refreshed
+            // again if the regeneration fails.
+            aoDirtyRegions = GetDirtyRegions(/* bClear = */ false);
+            aoRegions.insert(aoRegions.end(), aoDirtyRegions.begin(),
+                             aoDirtyRegions.end());
+        }
+        eErr = GDALRegenerateOverviewsInRegions(
+            this, pszResampling, nOverviews, panOverviewList, nListBands,
+            panBandList, aoRegions, pfnProgress, pProgressData);
+        if (eErr == CE_None && !aoDirtyRegions.empty())
+        {
+            // Only forget the refreshed regions: the ones modified by
+            // writes done in the meantime must be kept.
+            std::lock_guard<std::mutex> oLock(
+                m_poPrivate->m_oDirtyRegionsMutex);
+            auto &aoCurRegions = m_poPrivate->m_aoDirtyRegions;
+            for (const auto &oRegion : aoDirtyRegions)
+            {
+                auto oIter = std::find_if(
+                    aoCurRegions.begin(), aoCurRegions.end(),
+                    [&oRegion](const GDALRasterWindow &oOther)
+                    {
+                        return oOther.nXOff == oRegion.nXOff &&
+                               oOther.nYOff == oRegion.nYOff &&
+                               oOther.nXSize == oRegion.nXSize &&
+                               oOther.nYSize == oRegion.nYSize;
+                    });
+                if (oIter != aoCurRegions.end())
+                    aoCurRegions.erase(oIter);
+            }
+        }
+    }
+    else
+    {
+        eErr = IBuildOverviews(pszResampling, nOverviews, panOverviewList,
+                               nListBands, panBandList, pfnProgress,
+                               pProgressData, papszOptions);
+    }
 
     if (panAllBandList != nullptr)
         CPLFree(panAllBandList);
@@ -2625,6 +2916,9 @@ CPLErr GDALDataset::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
     if (eErr != CE_None || bStopProcessing)
         return eErr;
 
+    if (eRWFlag == GF_Write)
+        MarkRegionDirty(nXOff, nYOff, nXSize, nYSize);
+
     /* -------------------------------------------------------------------- */
     /*      If pixel and line spacing are defaulted assign reasonable      */
     /*      value assuming a packed buffer.                                 */
@@ -365,6 +365,9 @@ CPLErr GDALRasterBand::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         return CE_Failure;
     }
 
+    if (eRWFlag == GF_Write)
+        MarkDatasetRegionDirty(nXOff, nYOff, nXSize, nYSize);
+
     /* -------------------------------------------------------------------- */
     /*      Call the format specific function.                              */
     /* -------------------------------------------------------------------- */
@@ -703,6 +706,12 @@ CPLErr GDALRasterBand::WriteBlock(int nXBlockOff, int nYBlockOff, void *pImage)
         return eErr;
     }
 
+    MarkDatasetRegionDirty(nXBlockOff * nBlockXSize, nYBlockOff * nBlockYSize,
+                           std::min(nBlockXSize,
+                                    nRasterXSize - nXBlockOff * nBlockXSize),
+                           std::min(nBlockYSize,
+                                    nRasterYSize - nYBlockOff * nBlockYSize));
+
     /* -------------------------------------------------------------------- */
     /*      Invoke underlying implementation method.                        */
     /* -------------------------------------------------------------------- */
@@ -715,6 +724,25 @@ CPLErr GDALRasterBand::WriteBlock(int nXBlockOff, int nYBlockOff, void *pImage)
     return eErr;
 }
 
+/************************************************************************/
+/*                       MarkDatasetRegionDirty()                       */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+// Records a modified window in the dataset of the band, if it has the same
+// dimensions (which excludes overview bands attached to their parent
+// dataset).
+void GDALRasterBand::MarkDatasetRegionDirty(int nXOff, int nYOff, int nXSize,
+                                            int nYSize)
+{
+    if (poDS != nullptr && poDS->GetRasterXSize() == nRasterXSize &&
+        poDS->GetRasterYSize() == nRasterYSize)
+    {
+        poDS->MarkRegionDirty(nXOff, nYOff, nXSize, nYSize);
+    }
+}
+//! @endcond
+
 /************************************************************************/
 /*                           GDALWriteBlock()                           */
 /************************************************************************/
@@ -5540,6 +5568,49 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
 }
 //! @endcond
 
+/************************************************************************/
+/*                      GDALCanSkipEmptyBlocks()                        */
+/************************************************************************/
+
+// Returns whether blocks reported as empty by GetDataCoverageStatus() (for
+// example missing tiles of a sparse GeoTIFF file) can be skipped without
+// being read when computing statistics, that is when the band has a nodata
+// value exactly representable in its data type (empty blocks being then
+// only made of nodata pixels), and it contains at least one empty region.
+static bool GDALCanSkipEmptyBlocks(GDALRasterBand *poBand, bool bGotNoDataValue,
+                                   double dfNoDataValue)
+{
+    if (!bGotNoDataValue)
+        return false;
+    int bClamped = FALSE;
+    int bRounded = FALSE;
+    CPL_IGNORE_RET_VAL(GDALAdjustValueToDataType(
+        poBand->GetRasterDataType(), dfNoDataValue, &bClamped, &bRounded));
+    if (bClamped || bRounded)
+        return false;
+    const int nStatus = poBand->GetDataCoverageStatus(
+        0, 0, poBand->GetXSize(), poBand->GetYSize(),
+        GDAL_DATA_COVERAGE_STATUS_EMPTY, nullptr);
+    return (nStatus & GDAL_DATA_COVERAGE_STATUS_UNIMPLEMENTED) == 0 &&
+           (nStatus & GDAL_DATA_COVERAGE_STATUS_EMPTY) != 0;
+}
+
+/************************************************************************/
+/*                         GDALIsBlockEmpty()                           */
+/************************************************************************/
+
+static bool GDALIsBlockEmpty(GDALRasterBand *poBand, int iXBlock, int iYBlock,
+                             int nXCheck, int nYCheck)
+{
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    return poBand->GetDataCoverageStatus(
+               iXBlock * nBlockXSize, iYBlock * nBlockYSize, nXCheck, nYCheck,
+               GDAL_DATA_COVERAGE_STATUS_DATA,
+               nullptr) == GDAL_DATA_COVERAGE_STATUS_EMPTY;
+}
+
 /************************************************************************/
 /*                         ComputeStatistics()                          */
 /************************************************************************/
@@ -5797,6 +5868,9 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
         if (nSampleRate == 1)
             bApproxOK = false;
 
+        const bool bSkipEmptyBlocks = GDALCanSkipEmptyBlocks(
+            this, CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue);
+
 #ifdef CPL_HAS_GINT64
         // Particular case for GDT_Byte that only use integral types for all
         // intermediate computations. Only possible if the number of pixels
@@ -5837,6 +5911,17 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                 const int iYBlock = iSampleBlock / nBlocksPerRow;
                 const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
 
+                int nXCheck = 0, nYCheck = 0;
+                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+                // Empty blocks only contain nodata: no need to read them.
+                if (bSkipEmptyBlocks &&
+                    GDALIsBlockEmpty(this, iXBlock, iYBlock, nXCheck, nYCheck))
+                {
+                    nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+                    continue;
+                }
+
                 GDALRasterBlock *const poBlock =
                     GetLockedBlockRef(iXBlock, iYBlock);
                 if (poBlock == nullptr)
@@ -5844,9 +5929,6 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
 
                 void *const pData = poBlock->GetDataRef();
 
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
                 if (eDataType == GDT_Byte)
                 {
                     ComputeStatisticsInternal<
@@ -5963,6 +6045,17 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             const int iYBlock = iSampleBlock / nBlocksPerRow;
             const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
 
+            int nXCheck = 0, nYCheck = 0;
+            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+            // Empty blocks only contain nodata: no need to read them.
+            if (bSkipEmptyBlocks &&
+                GDALIsBlockEmpty(this, iXBlock, iYBlock, nXCheck, nYCheck))
+            {
+                nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+                continue;
+            }
+
             GDALRasterBlock *const poBlock =
                 GetLockedBlockRef(iXBlock, iYBlock);
             if (poBlock == nullptr)
@@ -5973,9 +6066,6 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
 
             void *const pData = poBlock->GetDataRef();
 
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
             if (poMaskBand &&
                 poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
                                      iYBlock * nBlockYSize, nXCheck, nYCheck,
@@ -6361,7 +6451,8 @@ static bool ComputeMinMaxGenericIterBlocks(
     GDALRasterBand *poBand, GDALDataType eDataType, bool bSignedByte,
     int nTotalBlocks, int nSampleRate, int nBlocksPerRow, bool bGotNoDataValue,
     double dfNoDataValue, bool bGotFloatNoDataValue, float fNoDataValue,
-    GDALRasterBand *poMaskBand, double &dfMin, double &dfMax)
+    GDALRasterBand *poMaskBand, bool bSkipEmptyBlocks, double &dfMin,
+    double &dfMax)
 
 {
     GByte *pabyMaskData = nullptr;
@@ -6384,6 +6475,15 @@ static bool ComputeMinMaxGenericIterBlocks(
         const int iYBlock = iSampleBlock / nBlocksPerRow;
         const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
 
+        int nXCheck = 0, nYCheck = 0;
+        poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+        if (bSkipEmptyBlocks &&
+            GDALIsBlockEmpty(poBand, iXBlock, iYBlock, nXCheck, nYCheck))
+        {
+            continue;
+        }
+
         GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(iXBlock, iYBlock);
         if (poBlock == nullptr)
         {
@@ -6393,9 +6493,6 @@ static bool ComputeMinMaxGenericIterBlocks(
 
         void *const pData = poBlock->GetDataRef();
 
-        int nXCheck = 0, nYCheck = 0;
-        poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
         if (poMaskBand &&
             poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
                                  iYBlock * nBlockYSize, nXCheck, nYCheck,
@@ -6688,6 +6785,10 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 nSampleRate += 1;
         }
 
+        // Empty blocks only contain nodata: no need to read them.
+        const bool bSkipEmptyBlocks = GDALCanSkipEmptyBlocks(
+            this, CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue);
+
         if (bUseOptimizedPath)
         {
             for (int iSampleBlock = 0;
@@ -6697,15 +6798,21 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 const int iYBlock = iSampleBlock / nBlocksPerRow;
                 const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
 
+                int nXCheck = 0, nYCheck = 0;
+                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+                if (bSkipEmptyBlocks &&
+                    GDALIsBlockEmpty(this, iXBlock, iYBlock, nXCheck, nYCheck))
+                {
+                    continue;
+                }
+
                 GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
                 if (poBlock == nullptr)
                     return CE_Failure;
 
                 void *const pData = poBlock->GetDataRef();
 
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
                 ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
 
                 poBlock->DropLock();
@@ -6721,8 +6828,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
             if (!ComputeMinMaxGenericIterBlocks(
                     this, eDataType, bSignedByte, nTotalBlocks, nSampleRate,
                     nBlocksPerRow, CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
-                    bGotFloatNoDataValue, fNoDataValue, poMaskBand, dfMin,
-                    dfMax))
+                    bGotFloatNoDataValue, fNoDataValue, poMaskBand,
+                    bSkipEmptyBlocks, dfMin, dfMax))
             {
                 return CE_Failure;
             }
@@ -45,12 +45,14 @@
 #include <vector>
 
 #include "cpl_conv.h"
+#include "cpl_cpu_features.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_thread_pool.h"
 #include "gdalwarper.h"
+#include "overview_avx.h"
 
 // Restrict to 64bit processors because they are guaranteed to have SSE2,
 // or if __AVX2__ is defined.
@@ -74,6 +76,82 @@
 
 #endif
 
+#ifdef USE_SSE2
+
+/************************************************************************/
+/*                        NearDecimateBy2SSE2()                         */
+/************************************************************************/
+
+// Nearest neighbour resampling by a factor of 2 of a scanline: copies one
+// source value out of two. Returns the number of destination values
+// processed, the remaining ones being left to the caller. The loop
+// conditions ensure that we never read past the last source value used.
+
+static int NearDecimateBy2SSE2(int nDstXWidth,
+                               const GByte *CPL_RESTRICT pSrcScanline,
+                               GByte *CPL_RESTRICT pDstScanline)
+{
+    const auto mask = _mm_set1_epi16(0xFF);
+    int iDstPixel = 0;
+    for (; iDstPixel + 16 < nDstXWidth; iDstPixel += 16)
+    {
+        // Keep the even bytes, as 16-bit values, and pack them
+        const auto lo = _mm_and_si128(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                pSrcScanline + 2 * iDstPixel)),
+            mask);
+        const auto hi = _mm_and_si128(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                pSrcScanline + 2 * iDstPixel + 16)),
+            mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pDstScanline + iDstPixel),
+                         _mm_packus_epi16(lo, hi));
+    }
+    return iDstPixel;
+}
+
+static int NearDecimateBy2SSE2(int nDstXWidth,
+                               const GInt16 *CPL_RESTRICT pSrcScanline,
+                               GInt16 *CPL_RESTRICT pDstScanline)
+{
+    int iDstPixel = 0;
+    for (; iDstPixel + 8 < nDstXWidth; iDstPixel += 8)
+    {
+        // Sign-extend the even 16-bit values to 32-bit, so that the signed
+        // saturating pack leaves them unchanged.
+        const auto lo = _mm_srai_epi32(
+            _mm_slli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                               pSrcScanline + 2 * iDstPixel)),
+                           16),
+            16);
+        const auto hi = _mm_srai_epi32(
+            _mm_slli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                               pSrcScanline + 2 * iDstPixel + 8)),
+                           16),
+            16);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pDstScanline + iDstPixel),
+                         _mm_packs_epi32(lo, hi));
+    }
+    return iDstPixel;
+}
+
+static int NearDecimateBy2SSE2(int nDstXWidth,
+                               const float *CPL_RESTRICT pSrcScanline,
+                               float *CPL_RESTRICT pDstScanline)
+{
+    int iDstPixel = 0;
+    for (; iDstPixel + 4 < nDstXWidth; iDstPixel += 4)
+    {
+        const auto lo = _mm_loadu_ps(pSrcScanline + 2 * iDstPixel);
+        const auto hi = _mm_loadu_ps(pSrcScanline + 2 * iDstPixel + 4);
+        _mm_storeu_ps(pDstScanline + iDstPixel,
+                      _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+    return iDstPixel;
+}
+
+#endif
+
 /************************************************************************/
 /*                     GDALResampleChunk32R_Near()                      */
 /************************************************************************/
@@ -111,6 +189,7 @@ static CPLErr GDALResampleChunk32R_NearT(
     /* ==================================================================== */
     /*      Precompute inner loop constants.                                */
     /* ==================================================================== */
+    bool bSrcXSpacingIsTwo = true;
     for (int iDstPixel = nDstXOff; iDstPixel < nDstXOff2; ++iDstPixel)
     {
         int nSrcXOff = static_cast<int>(0.5 + iDstPixel * dfXRatioDstToSrc);
@@ -118,6 +197,11 @@ static CPLErr GDALResampleChunk32R_NearT(
             nSrcXOff = nChunkXOff;
 
         panSrcXOff[iDstPixel - nDstXOff] = nSrcXOff;
+        if (iDstPixel > nDstXOff &&
+            nSrcXOff != panSrcXOff[iDstPixel - nDstXOff - 1] + 2)
+        {
+            bSrcXSpacingIsTwo = false;
+        }
     }
 
     /* ==================================================================== */
@@ -140,7 +224,17 @@ static CPLErr GDALResampleChunk32R_NearT(
         /* --------------------------------------------------------------------
          */
         T *pDstScanline = pDstBuffer + (iDstLine - nDstYOff) * nDstXWidth;
-        for (int iDstPixel = 0; iDstPixel < nDstXWidth; ++iDstPixel)
+        int iDstPixel = 0;
+#ifdef USE_SSE2
+        if (bSrcXSpacingIsTwo)
+        {
+            iDstPixel = NearDecimateBy2SSE2(
+                nDstXWidth, pSrcScanline + panSrcXOff[0], pDstScanline);
+        }
+#else
+        CPL_IGNORE_RET_VAL(bSrcXSpacingIsTwo);
+#endif
+        for (; iDstPixel < nDstXWidth; ++iDstPixel)
         {
             pDstScanline[iDstPixel] = pSrcScanline[panSrcXOff[iDstPixel]];
         }
@@ -1153,10 +1247,23 @@ static int AverageFloatSSE2(int nDstXWidth, int nChunkXSize,
                             T *CPL_RESTRICT pDstScanline)
 {
     // Optimized implementation for average on Float32 by
-    // processing by group of 4 output pixels.
+    // processing by group of 8 (AVX) or 4 output pixels.
     const T *CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
 
     int iDstPixel = 0;
+
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+    if (nDstXWidth >= 8 && CPLHaveRuntimeAVX())
+    {
+        // coverity[incompatible_cast]
+        iDstPixel = GDALAverageFloat2x2AVX(
+            nDstXWidth, nChunkXSize,
+            reinterpret_cast<const float *>(pSrcScanlineShifted),
+            reinterpret_cast<float *>(pDstScanline));
+        pSrcScanlineShifted += 2 * iDstPixel;
+    }
+#endif
+
     const auto zeroDot25 = _mm_set1_ps(0.25f);
 
     for (; iDstPixel < nDstXWidth - 3; iDstPixel += 4)
@@ -3903,6 +4010,85 @@ static CPLErr GDALResampleChunkC32R(int nSrcWidth, int nSrcHeight,
     return CE_None;
 }
 
+/************************************************************************/
+/*                       GDALOvrHasEmptyRegions()                       */
+/************************************************************************/
+
+// Returns whether some regions of the band are reported as empty by
+// GetDataCoverageStatus() (e.g. missing tiles of a sparse GeoTIFF file), and
+// only contain its nodata value. The overview pixels computed from such
+// regions are nodata too, whatever the resampling method, so there is no
+// need to read and resample them.
+static bool GDALOvrHasEmptyRegions(GDALRasterBand *poBand)
+{
+    int bHasNoData = FALSE;
+    poBand->GetNoDataValue(&bHasNoData);
+    const GDALDataType eDT = poBand->GetRasterDataType();
+    if (!bHasNoData || eDT == GDT_Int64 || eDT == GDT_UInt64)
+        return false;
+    const int nStatus = poBand->GetDataCoverageStatus(
+        0, 0, poBand->GetXSize(), poBand->GetYSize(),
+        GDAL_DATA_COVERAGE_STATUS_EMPTY, nullptr);
+    return (nStatus & GDAL_DATA_COVERAGE_STATUS_UNIMPLEMENTED) == 0 &&
+           (nStatus & GDAL_DATA_COVERAGE_STATUS_EMPTY) != 0;
+}
+
+/************************************************************************/
+/*                        GDALOvrIsEmptyChunk()                         */
+/************************************************************************/
+
+static bool GDALOvrIsEmptyChunk(GDALRasterBand *poBand, int nXOff, int nYOff,
+                                int nXSize, int nYSize)
+{
+    return poBand->GetDataCoverageStatus(nXOff, nYOff, nXSize, nYSize,
+                                         GDAL_DATA_COVERAGE_STATUS_DATA,
+                                         nullptr) ==
+           GDAL_DATA_COVERAGE_STATUS_EMPTY;
+}
+
+/************************************************************************/
+/*                       GDALOvrFillWithNoData()                        */
+/************************************************************************/
+
+// Writes the nodata value of the source band in a window of an overview band.
+static CPLErr GDALOvrFillWithNoData(GDALRasterBand *poSrcBand,
+                                    GDALRasterBand *poOvrBand, int nXOff,
+                                    int nYOff, int nXSize, int nYSize)
+{
+    const double dfNoDataValue = poSrcBand->GetNoDataValue();
+
+    // Nothing to do if the overview region is already empty with the same
+    // nodata value, which is typically the case of overviews just created
+    // with SPARSE_OK=YES.
+    int bOvrHasNoData = FALSE;
+    const double dfOvrNoDataValue = poOvrBand->GetNoDataValue(&bOvrHasNoData);
+    if (bOvrHasNoData && dfOvrNoDataValue == dfNoDataValue &&
+        GDALOvrIsEmptyChunk(poOvrBand, nXOff, nYOff, nXSize, nYSize))
+    {
+        return CE_None;
+    }
+
+    std::vector<double> adfLine;
+    try
+    {
+        adfLine.resize(nXSize, dfNoDataValue);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALOvrFillWithNoData()");
+        return CE_Failure;
+    }
+    CPLErr eErr = CE_None;
+    for (int iY = 0; iY < nYSize && eErr == CE_None; ++iY)
+    {
+        eErr = poOvrBand->RasterIO(GF_Write, nXOff, nYOff + iY, nXSize, 1,
+                                   adfLine.data(), nXSize, 1, GDT_Float64, 0,
+                                   0, nullptr);
+    }
+    return eErr;
+}
+
 /************************************************************************/
 /*                  GDALRegenerateCascadingOverviews()                  */
 /*                                                                      */
@@ -4386,6 +4572,9 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
     int bHasNoData = FALSE;
     const float fNoDataValue =
         static_cast<float>(poSrcBand->GetNoDataValue(&bHasNoData));
+    const bool bSkipEmptyChunks =
+        !STARTS_WITH_CI(pszResampling, "AVERAGE_BIT2") &&
+        GDALOvrHasEmptyRegions(poSrcBand);
     const bool bPropagateNoData =
         CPLTestBool(CPLGetConfigOption("GDAL_OVR_PROPAGATE_NODATA", "NO"));
 
@@ -4604,13 +4793,20 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
             return CE_Failure;
         }
 
+        // Chunks that only contain nodata do not need to be read and
+        // resampled: the corresponding overview lines are set to nodata.
+        const bool bEmptyChunk =
+            bSkipEmptyChunks &&
+            GDALOvrIsEmptyChunk(poSrcBand, 0, nChunkYOffQueried, nWidth,
+                                nChunkYSizeQueried);
+
         // Read chunk.
-        if (eErr == CE_None)
+        if (eErr == CE_None && !bEmptyChunk)
             eErr = poSrcBand->RasterIO(GF_Read, 0, nChunkYOffQueried, nWidth,
                                        nChunkYSizeQueried, pChunk, nWidth,
                                        nChunkYSizeQueried, eWrkDataType, 0, 0,
                                        nullptr);
-        if (eErr == CE_None && bUseNoDataMask)
+        if (eErr == CE_None && !bEmptyChunk && bUseNoDataMask)
             eErr = poMaskBand->RasterIO(GF_Read, 0, nChunkYOffQueried, nWidth,
                                         nChunkYSizeQueried, pabyChunkNodataMask,
                                         nWidth, nChunkYSizeQueried, GDT_Byte, 0,
@@ -4740,6 +4936,13 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
 
             if (nChunkYOff + nFullResYChunk == nHeight)
                 nDstYOff2 = nDstHeight;
+
+            if (bEmptyChunk)
+            {
+                eErr = GDALOvrFillWithNoData(poSrcBand, poDstBand, 0, nDstYOff,
+                                             nDstWidth, nDstYOff2 - nDstYOff);
+                continue;
+            }
 #if DEBUG_VERBOSE
             CPLDebug("GDAL",
                      "Reading (%dx%d -> %dx%d) for output (%dx%d -> %dx%d)", 0,
@@ -4832,196 +5035,1084 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
 }
 
 /************************************************************************/
-/*            GDALRegenerateOverviewsMultiBand()                        */
+/*                       GetOvrChunkSrcWindow()                         */
 /************************************************************************/
 
-/**
- * \brief Variant of GDALRegenerateOverviews, specially dedicated for generating
- * compressed pixel-interleaved overviews (JPEG-IN-TIFF for example)
- *
- * This function will generate one or more overview images from a base
- * image using the requested downsampling algorithm.  Its primary use
- * is for generating overviews via GDALDataset::BuildOverviews(), but it
- * can also be used to generate downsampled images in one file from another
- * outside the overview architecture.
- *
- * The output bands need to exist in advance and share the same characteristics
- * (type, dimensions)
- *
- * The resampling algorithms supported for the moment are "NEAREST", "AVERAGE",
- * "RMS", "GAUSS", "CUBIC", "CUBICSPLINE", "LANCZOS" and "BILINEAR"
- *
- * It does not support color tables or complex data types.
- *
- * The pseudo-algorithm used by the function is :
- *    for each overview
- *       iterate on lines of the source by a step of deltay
- *           iterate on columns of the source  by a step of deltax
- *               read the source data of size deltax * deltay for all the bands
- *               generate the corresponding overview block for all the bands
- *
- * This function will honour properly NODATA_VALUES tuples (special dataset
- * metadata) so that only a given RGB triplet (in case of a RGB image) will be
- * considered as the nodata value and not each value of the triplet
- * independently per band.
- *
- * Starting with GDAL 3.2, the GDAL_NUM_THREADS configuration option can be set
- * to "ALL_CPUS" or a integer value to specify the number of threads to use for
- * overview computation.
- *
- * @param nBands the number of bands, size of papoSrcBands and size of
- *               first dimension of papapoOverviewBands
- * @param papoSrcBands the list of source bands to downsample
- * @param nOverviews the number of downsampled overview levels being generated.
- * @param papapoOverviewBands bidimension array of bands. First dimension is
- *                            indexed by nBands. Second dimension is indexed by
- *                            nOverviews.
- * @param pszResampling Resampling algorithm ("NEAREST", "AVERAGE", "RMS",
- * "GAUSS", "CUBIC", "CUBICSPLINE", "LANCZOS" or "BILINEAR").
- * @param pfnProgress progress report function.
- * @param pProgressData progress function callback data.
- * @param papszOptions (GDAL >= 3.6) NULL terminated list of options as
- *                     key=value pairs, or NULL
- * @return CE_None on success or CE_Failure on failure.
- */
-
-CPLErr GDALRegenerateOverviewsMultiBand(
-    int nBands, GDALRasterBand *const *papoSrcBands, int nOverviews,
-    GDALRasterBand *const *const *papapoOverviewBands,
-    const char *pszResampling, GDALProgressFunc pfnProgress,
-    void *pProgressData, CSLConstList papszOptions)
+// Computes the source window (along one dimension) needed to compute the
+// overview pixels [nDstOff, nDstOff + nDstCount[, with a margin of nMargin
+// pixels for the kernel radius. Returns the size of the window without the
+// margin.
+static int GetOvrChunkSrcWindow(int nDstOff, int nDstCount, int nDstSize,
+                                double dfRatioDstToSrc, int nSrcSize,
+                                int nMargin, int &nSrcOffQueried,
+                                int &nSrcSizeQueried)
 {
-    CPL_IGNORE_RET_VAL(papszOptions);
+    const int nSrcOff = static_cast<int>(nDstOff * dfRatioDstToSrc);
+    int nSrcOff2 =
+        static_cast<int>(ceil((nDstOff + nDstCount) * dfRatioDstToSrc));
+    if (nSrcOff2 > nSrcSize || nDstOff + nDstCount == nDstSize)
+        nSrcOff2 = nSrcSize;
+    const int nCount = nSrcOff2 - nSrcOff;
+
+    nSrcOffQueried = nSrcOff - nMargin;
+    nSrcSizeQueried = nCount + 2 * nMargin;
+    if (nSrcOffQueried < 0)
+    {
+        nSrcSizeQueried += nSrcOffQueried;
+        nSrcOffQueried = 0;
+    }
+    if (nSrcSizeQueried + nSrcOffQueried > nSrcSize)
+        nSrcSizeQueried = nSrcSize - nSrcOffQueried;
+    return nCount;
+}
 
-    if (pfnProgress == nullptr)
-        pfnProgress = GDALDummyProgress;
+/************************************************************************/
+/*                         OvrLevelChunking                             */
+/************************************************************************/
 
-    if (EQUAL(pszResampling, "NONE"))
-        return CE_None;
+namespace
+{
+// How an overview level is computed by GDALRegenerateOverviewsMultiBand()
+struct OvrLevelChunking
+{
+    int iSrcOverview = -1;  // -1 means the source bands.
+    int nSrcWidth = 0;
+    int nSrcHeight = 0;
+    int nDstWidth = 0;
+    int nDstHeight = 0;
+    double dfXRatioDstToSrc = 0;
+    double dfYRatioDstToSrc = 0;
+    int nOvrFactor = 1;
+    int nDstChunkXSize = 0;
+    int nDstChunkYSize = 0;
+    int nFullResXChunk = 0;
+    int nFullResYChunk = 0;
+    int nFullResXChunkQueried = 0;
+    int nFullResYChunkQueried = 0;
+
+    // Window of the overview to compute, and width of the matching window
+    // of the source.
+    int nDstXStart = 0;
+    int nDstYStart = 0;
+    int nDstXEnd = 0;
+    int nDstYEnd = 0;
+    int nSrcXCount = 0;
+};
+}  // namespace
 
-    // Sanity checks.
-    if (!STARTS_WITH_CI(pszResampling, "NEAR") &&
-        !EQUAL(pszResampling, "RMS") && !EQUAL(pszResampling, "AVERAGE") &&
-        !EQUAL(pszResampling, "GAUSS") && !EQUAL(pszResampling, "CUBIC") &&
-        !EQUAL(pszResampling, "CUBICSPLINE") &&
-        !EQUAL(pszResampling, "LANCZOS") && !EQUAL(pszResampling, "BILINEAR") &&
-        !EQUAL(pszResampling, "MODE"))
-    {
-        CPLError(CE_Failure, CPLE_NotSupported,
-                 "GDALRegenerateOverviewsMultiBand: pszResampling='%s' "
-                 "not supported",
-                 pszResampling);
-        return CE_Failure;
-    }
+static OvrLevelChunking GetOvrLevelChunking(
+    int nBands, int nToplevelSrcWidth, int nToplevelSrcHeight,
+    GDALRasterBand *const *const *papapoOverviewBands, int iOverview,
+    int nKernelRadius, GDALDataType eWrkDataType, int nChunkMaxSize)
+{
+    OvrLevelChunking oLevel;
 
-    int nKernelRadius = 0;
-    GDALResampleFunction pfnResampleFn =
-        GDALGetResampleFunction(pszResampling, &nKernelRadius);
-    if (pfnResampleFn == nullptr)
-        return CE_Failure;
+    papapoOverviewBands[0][iOverview]->GetBlockSize(&oLevel.nDstChunkXSize,
+                                                    &oLevel.nDstChunkYSize);
 
-    const int nToplevelSrcWidth = papoSrcBands[0]->GetXSize();
-    const int nToplevelSrcHeight = papoSrcBands[0]->GetYSize();
-    GDALDataType eDataType = papoSrcBands[0]->GetRasterDataType();
-    for (int iBand = 1; iBand < nBands; ++iBand)
-    {
-        if (papoSrcBands[iBand]->GetXSize() != nToplevelSrcWidth ||
-            papoSrcBands[iBand]->GetYSize() != nToplevelSrcHeight)
-        {
-            CPLError(
-                CE_Failure, CPLE_NotSupported,
-                "GDALRegenerateOverviewsMultiBand: all the source bands must "
-                "have the same dimensions");
-            return CE_Failure;
-        }
-        if (papoSrcBands[iBand]->GetRasterDataType() != eDataType)
-        {
-            CPLError(
-                CE_Failure, CPLE_NotSupported,
-                "GDALRegenerateOverviewsMultiBand: all the source bands must "
-                "have the same data type");
-            return CE_Failure;
-        }
-    }
+    oLevel.nDstWidth = papapoOverviewBands[0][iOverview]->GetXSize();
+    oLevel.nDstHeight = papapoOverviewBands[0][iOverview]->GetYSize();
 
-    for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+    // Try to use previous level of overview as the source to compute
+    // the next level.
+    oLevel.nSrcWidth = nToplevelSrcWidth;
+    oLevel.nSrcHeight = nToplevelSrcHeight;
+    if (iOverview > 0 &&
+        papapoOverviewBands[0][iOverview - 1]->GetXSize() > oLevel.nDstWidth)
     {
-        const int nDstWidth = papapoOverviewBands[0][iOverview]->GetXSize();
-        const int nDstHeight = papapoOverviewBands[0][iOverview]->GetYSize();
-        for (int iBand = 1; iBand < nBands; ++iBand)
-        {
-            if (papapoOverviewBands[iBand][iOverview]->GetXSize() !=
-                    nDstWidth ||
-                papapoOverviewBands[iBand][iOverview]->GetYSize() != nDstHeight)
-            {
-                CPLError(
-                    CE_Failure, CPLE_NotSupported,
-                    "GDALRegenerateOverviewsMultiBand: all the overviews bands "
-                    "of the same level must have the same dimensions");
-                return CE_Failure;
-            }
-            if (papapoOverviewBands[iBand][iOverview]->GetRasterDataType() !=
-                eDataType)
-            {
-                CPLError(
-                    CE_Failure, CPLE_NotSupported,
-                    "GDALRegenerateOverviewsMultiBand: all the overviews bands "
-                    "must have the same data type as the source bands");
-                return CE_Failure;
-            }
-        }
+        oLevel.nSrcWidth = papapoOverviewBands[0][iOverview - 1]->GetXSize();
+        oLevel.nSrcHeight = papapoOverviewBands[0][iOverview - 1]->GetYSize();
+        oLevel.iSrcOverview = iOverview - 1;
     }
 
-    // First pass to compute the total number of pixels to read.
-    double dfTotalPixelCount = 0;
-    for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+    oLevel.dfXRatioDstToSrc =
+        static_cast<double>(oLevel.nSrcWidth) / oLevel.nDstWidth;
+    oLevel.dfYRatioDstToSrc =
+        static_cast<double>(oLevel.nSrcHeight) / oLevel.nDstHeight;
+
+    oLevel.nOvrFactor =
+        std::max(static_cast<int>(0.5 + oLevel.dfXRatioDstToSrc),
+                 static_cast<int>(0.5 + oLevel.dfYRatioDstToSrc));
+    if (oLevel.nOvrFactor == 0)
+        oLevel.nOvrFactor = 1;
+
+    // Try to extend the chunk size so that the memory needed to acquire
+    // source pixels goes up to 10 MB.
+    // This can help for drivers that support multi-threaded reading
+    oLevel.nFullResYChunk =
+        2 + static_cast<int>(oLevel.nDstChunkYSize * oLevel.dfYRatioDstToSrc);
+    oLevel.nFullResYChunkQueried =
+        oLevel.nFullResYChunk + 2 * nKernelRadius * oLevel.nOvrFactor;
+    while (oLevel.nDstChunkXSize < oLevel.nDstWidth)
     {
-        int nSrcWidth = nToplevelSrcWidth;
-        int nSrcHeight = nToplevelSrcHeight;
-        const int nDstWidth = papapoOverviewBands[0][iOverview]->GetXSize();
-        // Try to use previous level of overview as the source to compute
-        // the next level.
-        if (iOverview > 0 &&
-            papapoOverviewBands[0][iOverview - 1]->GetXSize() > nDstWidth)
+        const int nFullResXChunk =
+            2 + static_cast<int>(2 * oLevel.nDstChunkXSize *
+                                 oLevel.dfXRatioDstToSrc);
+
+        const int nFullResXChunkQueried =
+            nFullResXChunk + 2 * nKernelRadius * oLevel.nOvrFactor;
+
+        if (static_cast<GIntBig>(nFullResXChunkQueried) *
+                oLevel.nFullResYChunkQueried * nBands *
+                GDALGetDataTypeSizeBytes(eWrkDataType) >
+            nChunkMaxSize)
         {
-            nSrcWidth = papapoOverviewBands[0][iOverview - 1]->GetXSize();
-            nSrcHeight = papapoOverviewBands[0][iOverview - 1]->GetYSize();
+            break;
         }
 
-        dfTotalPixelCount += static_cast<double>(nSrcWidth) * nSrcHeight;
+        oLevel.nDstChunkXSize *= 2;
     }
+    oLevel.nDstChunkXSize = std::min(oLevel.nDstChunkXSize, oLevel.nDstWidth);
 
-    const GDALDataType eWrkDataType =
-        GDALGetOvrWorkDataType(pszResampling, eDataType);
+    oLevel.nFullResXChunk =
+        2 + static_cast<int>(oLevel.nDstChunkXSize * oLevel.dfXRatioDstToSrc);
+    oLevel.nFullResXChunkQueried =
+        oLevel.nFullResXChunk + 2 * nKernelRadius * oLevel.nOvrFactor;
 
-    const bool bIsMask = papoSrcBands[0]->IsMaskBand();
+    oLevel.nDstXEnd = oLevel.nDstWidth;
+    oLevel.nDstYEnd = oLevel.nDstHeight;
+    oLevel.nSrcXCount = oLevel.nSrcWidth;
 
-    // If we have a nodata mask and we are doing something more complicated
-    // than nearest neighbouring, we have to fetch to nodata mask.
-    const bool bUseNoDataMask =
-        !STARTS_WITH_CI(pszResampling, "NEAR") &&
-        (bIsMask || (papoSrcBands[0]->GetMaskFlags() & GMF_ALL_VALID) == 0);
+    return oLevel;
+}
 
-    int *const pabHasNoData =
-        static_cast<int *>(VSI_MALLOC_VERBOSE(nBands * sizeof(int)));
-    float *const pafNoDataValue =
-        static_cast<float *>(VSI_MALLOC_VERBOSE(nBands * sizeof(float)));
-    if (pabHasNoData == nullptr || pafNoDataValue == nullptr)
+/************************************************************************/
+/*                         SetOvrLevelWindow()                          */
+/************************************************************************/
+
+// Restricts the overview pixels to compute to the ones that depend on the
+// source window [nSrcStart, nSrcEnd[ (along one dimension), taking into
+// account the kernel radius. The window is extended to block boundaries.
+static void SetOvrLevelWindow(int nSrcStart, int nSrcEnd,
+                              double dfRatioDstToSrc, int nMargin,
+                              int nDstSize, int nBlockSize, int &nDstStart,
+                              int &nDstEnd)
+{
+    nDstStart = static_cast<int>(
+        std::max(0.0, floor((nSrcStart - nMargin) / dfRatioDstToSrc)));
+    nDstEnd = static_cast<int>(std::min(
+        static_cast<double>(nDstSize),
+        ceil((nSrcEnd + nMargin) / dfRatioDstToSrc)));
+    if (nBlockSize > 0)
     {
-        CPLFree(pabHasNoData);
-        CPLFree(pafNoDataValue);
-        return CE_Failure;
+        nDstStart = (nDstStart / nBlockSize) * nBlockSize;
+        if (nDstEnd < nDstSize)
+            nDstEnd = std::min(nDstSize, DIV_ROUND_UP(nDstEnd, nBlockSize) *
+                                             nBlockSize);
     }
+    if (nDstEnd < nDstStart)
+        nDstEnd = nDstStart;
+}
 
-    for (int iBand = 0; iBand < nBands; ++iBand)
+/************************************************************************/
+/*                     GDALOvrComputeNoDataMask()                       */
+/************************************************************************/
+
+template <class T, class TWork>
+static void GDALOvrComputeNoDataMask(const T *paData, size_t nValues,
+                                     TWork nNoData, GByte *pabyMask)
+{
+    for (size_t i = 0; i < nValues; ++i)
     {
-        pabHasNoData[iBand] = FALSE;
-        pafNoDataValue[iBand] = static_cast<float>(
-            papoSrcBands[iBand]->GetNoDataValue(&pabHasNoData[iBand]));
+        pabyMask[i] = static_cast<TWork>(paData[i]) == nNoData ? 0 : 255;
+    }
+}
+
+// Computes the validity mask of integer values the same way as
+// GDALNoDataMaskBand does.
+static void GDALOvrComputeNoDataMask(const void *pData, GDALDataType eDT,
+                                     size_t nValues, double dfNoDataValue,
+                                     GByte *pabyMask)
+{
+    if (!GDALNoDataMaskBand::IsNoDataInRange(dfNoDataValue, eDT))
+    {
+        memset(pabyMask, 255, nValues);
+        return;
+    }
+
+    switch (eDT)
+    {
+        case GDT_Byte:
+            GDALOvrComputeNoDataMask(static_cast<const GByte *>(pData),
+                                     nValues, static_cast<GByte>(dfNoDataValue),
+                                     pabyMask);
+            break;
+        case GDT_UInt16:
+            GDALOvrComputeNoDataMask(static_cast<const GUInt16 *>(pData),
+                                     nValues,
+                                     static_cast<GUInt32>(dfNoDataValue),
+                                     pabyMask);
+            break;
+        case GDT_UInt32:
+            GDALOvrComputeNoDataMask(static_cast<const GUInt32 *>(pData),
+                                     nValues,
+                                     static_cast<GUInt32>(dfNoDataValue),
+                                     pabyMask);
+            break;
+        case GDT_Int8:
+            GDALOvrComputeNoDataMask(static_cast<const GInt8 *>(pData),
+                                     nValues,
+                                     static_cast<GInt32>(dfNoDataValue),
+                                     pabyMask);
+            break;
+        case GDT_Int16:
+            GDALOvrComputeNoDataMask(static_cast<const GInt16 *>(pData),
+                                     nValues,
+                                     static_cast<GInt32>(dfNoDataValue),
+                                     pabyMask);
+            break;
+        case GDT_Int32:
+            GDALOvrComputeNoDataMask(static_cast<const GInt32 *>(pData),
+                                     nValues,
+                                     static_cast<GInt32>(dfNoDataValue),
+                                     pabyMask);
+            break;
+        default:
+            CPLAssert(false);
+            memset(pabyMask, 255, nValues);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                       GDALOvrCascadeGenerator                        */
+/************************************************************************/
+
+namespace
+{
+// Computes all the overview levels of GDALRegenerateOverviewsMultiBand() in a
+// single pass over the source bands. Each level is computed from the lines of
+// the previous level, which are kept in memory only as long as they are
+// needed, instead of being read back from the overview bands.
+class GDALOvrCascadeGenerator
+{
+    CPL_DISALLOW_COPY_ASSIGN(GDALOvrCascadeGenerator)
+
+  public:
+    int nBands = 0;
+    GDALRasterBand *const *papoSrcBands = nullptr;
+    GDALRasterBand *const *const *papapoOverviewBands = nullptr;
+    const char *pszResampling = nullptr;
+    GDALResampleFunction pfnResampleFn = nullptr;
+    int nKernelRadius = 0;
+    GDALDataType eDataType = GDT_Unknown;
+    GDALDataType eWrkDataType = GDT_Unknown;
+    bool bUseNoDataMask = false;
+    const int *pabHasNoData = nullptr;
+    const float *pafNoDataValue = nullptr;
+    bool bPropagateNoData = false;
+    CPLJobQueue *poJobQueue = nullptr;
+    GDALProgressFunc pfnProgress = nullptr;
+    void *pProgressData = nullptr;
+    double dfTotalPixelCount = 0;
+
+    GDALOvrCascadeGenerator() = default;
+
+    static GIntBig
+    EstimateMemory(const std::vector<OvrLevelChunking> &aoChunking,
+                   int nBands, GDALDataType eDataType,
+                   GDALDataType eWrkDataType, bool bUseNoDataMask);
+
+    CPLErr Run(const std::vector<OvrLevelChunking> &aoChunking);
+
+  private:
+    struct Level
+    {
+        OvrLevelChunking oChunking{};
+
+        // First line of the next strip of the overview to compute.
+        int nDstYOff = 0;
+
+        // Lines [nSrcBufYOff, nSrcBufYOff + nSrcBufYSize[ of the source of
+        // this level, for each band, in the working data type.
+        int nSrcBufYOff = 0;
+        int nSrcBufYSize = 0;
+        std::vector<std::vector<GByte>> aabySrcBuf{};
+        std::vector<std::vector<GByte>> aabySrcMaskBuf{};
+    };
+
+    struct Job
+    {
+        const GDALOvrCascadeGenerator *poGenerator = nullptr;
+        const OvrLevelChunking *poChunking = nullptr;
+        int iBand = 0;
+        std::vector<GByte> abyChunk{};
+        std::vector<GByte> abyChunkMask{};
+        int nChunkXOff = 0;
+        int nChunkXSize = 0;
+        int nChunkYOff = 0;
+        int nChunkYSize = 0;
+        int nDstXOff = 0;
+        int nDstXOff2 = 0;
+        int nDstYOff = 0;
+        int nDstYOff2 = 0;
+        GDALRasterBand *poOverview = nullptr;
+
+        CPLErr eErr = CE_Failure;
+        void *pDstBuffer = nullptr;
+        GDALDataType eDstBufferDataType = GDT_Unknown;
+
+        Job() = default;
+        ~Job()
+        {
+            CPLFree(pDstBuffer);
+        }
+        CPL_DISALLOW_COPY_ASSIGN(Job)
+    };
+
+    std::vector<Level> m_aoLevels{};
+    double m_dfCurPixelCount = 0;
+    std::vector<std::vector<GByte>> m_aabyDstStrip{};
+
+    static void JobResampleFunc(void *pData);
+    int GetStripSrcWindow(const Level &oLevel, int &nDstYCount,
+                          int &nSrcYOffQueried, int &nSrcYSizeQueried) const;
+    void DiscardSrcLines(Level &oLevel, int nNewSrcBufYOff) const;
+    CPLErr ReadSrcLines(Level &oLevel, int nSrcYOff, int nSrcYOff2) const;
+    CPLErr ProcessStrip(int iLevel);
+    CPLErr ProcessAvailableStrips(int iLevel);
+};
+
+/************************************************************************/
+/*                           EstimateMemory()                           */
+/************************************************************************/
+
+GIntBig GDALOvrCascadeGenerator::EstimateMemory(
+    const std::vector<OvrLevelChunking> &aoChunking, int nBands,
+    GDALDataType eDataType, GDALDataType eWrkDataType, bool bUseNoDataMask)
+{
+    const int nWrkPixelSize =
+        GDALGetDataTypeSizeBytes(eWrkDataType) + (bUseNoDataMask ? 1 : 0);
+    GIntBig nMem = 0;
+    for (size_t i = 0; i < aoChunking.size(); ++i)
+    {
+        const OvrLevelChunking &oChunking = aoChunking[i];
+        // Source lines needed by a strip, plus at most one strip of the
+        // previous level that is appended before they are discarded.
+        const int nSrcLines =
+            oChunking.nFullResYChunkQueried +
+            (i > 0 ? aoChunking[i - 1].nDstChunkYSize : 0);
+        nMem += static_cast<GIntBig>(nSrcLines) * oChunking.nSrcWidth *
+                nBands * nWrkPixelSize;
+        // Strip of the overview, and its chunks
+        nMem += static_cast<GIntBig>(oChunking.nDstChunkYSize) *
+                oChunking.nDstWidth * nBands *
+                GDALGetDataTypeSizeBytes(eDataType);
+        nMem += static_cast<GIntBig>(oChunking.nFullResYChunkQueried) *
+                oChunking.nSrcWidth * nBands * nWrkPixelSize;
+    }
+    return nMem;
+}
+
+/************************************************************************/
+/*                          JobResampleFunc()                           */
+/************************************************************************/
+
+void GDALOvrCascadeGenerator::JobResampleFunc(void *pData)
+{
+    Job *poJob = static_cast<Job *>(pData);
+    const GDALOvrCascadeGenerator *poGenerator = poJob->poGenerator;
+
+    poJob->eErr = poGenerator->pfnResampleFn(
+        poJob->poChunking->dfXRatioDstToSrc,
+        poJob->poChunking->dfYRatioDstToSrc, 0.0, 0.0,
+        poGenerator->eWrkDataType, poJob->abyChunk.data(),
+        poGenerator->bUseNoDataMask ? poJob->abyChunkMask.data() : nullptr,
+        poJob->nChunkXOff, poJob->nChunkXSize, poJob->nChunkYOff,
+        poJob->nChunkYSize, poJob->nDstXOff, poJob->nDstXOff2, poJob->nDstYOff,
+        poJob->nDstYOff2, poJob->poOverview, &(poJob->pDstBuffer),
+        &(poJob->eDstBufferDataType), poGenerator->pszResampling,
+        poGenerator->pabHasNoData[poJob->iBand],
+        poGenerator->pafNoDataValue[poJob->iBand], nullptr,
+        poGenerator->eDataType, poGenerator->bPropagateNoData);
+}
+
+/************************************************************************/
+/*                         GetStripSrcWindow()                          */
+/************************************************************************/
+
+// Computes the source lines needed by the next strip of a level. Returns
+// the number of source lines without the kernel margin.
+int GDALOvrCascadeGenerator::GetStripSrcWindow(const Level &oLevel,
+                                               int &nDstYCount,
+                                               int &nSrcYOffQueried,
+                                               int &nSrcYSizeQueried) const
+{
+    const OvrLevelChunking &oChunking = oLevel.oChunking;
+    nDstYCount = std::min(oChunking.nDstChunkYSize,
+                          oChunking.nDstHeight - oLevel.nDstYOff);
+    return GetOvrChunkSrcWindow(
+        oLevel.nDstYOff, nDstYCount, oChunking.nDstHeight,
+        oChunking.dfYRatioDstToSrc, oChunking.nSrcHeight,
+        nKernelRadius * oChunking.nOvrFactor, nSrcYOffQueried,
+        nSrcYSizeQueried);
+}
+
+/************************************************************************/
+/*                          DiscardSrcLines()                           */
+/************************************************************************/
+
+void GDALOvrCascadeGenerator::DiscardSrcLines(Level &oLevel,
+                                              int nNewSrcBufYOff) const
+{
+    if (nNewSrcBufYOff <= oLevel.nSrcBufYOff)
+        return;
+
+    const int nLines =
+        std::min(nNewSrcBufYOff - oLevel.nSrcBufYOff, oLevel.nSrcBufYSize);
+    const size_t nValues =
+        static_cast<size_t>(nLines) * oLevel.oChunking.nSrcWidth;
+    const size_t nWrkDTSize = GDALGetDataTypeSizeBytes(eWrkDataType);
+    for (int iBand = 0; iBand < nBands; ++iBand)
+    {
+        auto &abySrcBuf = oLevel.aabySrcBuf[iBand];
+        abySrcBuf.erase(abySrcBuf.begin(),
+                        abySrcBuf.begin() + nValues * nWrkDTSize);
+        if (bUseNoDataMask)
+        {
+            auto &abySrcMaskBuf = oLevel.aabySrcMaskBuf[iBand];
+            abySrcMaskBuf.erase(abySrcMaskBuf.begin(),
+                                abySrcMaskBuf.begin() + nValues);
+        }
+    }
+    oLevel.nSrcBufYOff += nLines;
+    oLevel.nSrcBufYSize -= nLines;
+}
+
+/************************************************************************/
+/*                           ReadSrcLines()                             */
+/************************************************************************/
+
+// Reads the lines of the source bands up to nSrcYOff2 that are not already
+// in the buffer of the first level.
+CPLErr GDALOvrCascadeGenerator::ReadSrcLines(Level &oLevel, int nSrcYOff,
+                                             int nSrcYOff2) const
+{
+    if (oLevel.nSrcBufYSize == 0)
+        oLevel.nSrcBufYOff = nSrcYOff;
+    const int nReadYOff = oLevel.nSrcBufYOff + oLevel.nSrcBufYSize;
+    const int nReadYSize = nSrcYOff2 - nReadYOff;
+    if (nReadYSize <= 0)
+        return CE_None;
+
+    const int nSrcWidth = oLevel.oChunking.nSrcWidth;
+    const size_t nValues = static_cast<size_t>(nReadYSize) * nSrcWidth;
+    const size_t nWrkDTSize = GDALGetDataTypeSizeBytes(eWrkDataType);
+    CPLErr eErr = CE_None;
+    for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+    {
+        auto &abySrcBuf = oLevel.aabySrcBuf[iBand];
+        const size_t nOldSize = abySrcBuf.size();
+        try
+        {
+            abySrcBuf.resize(nOldSize + nValues * nWrkDTSize);
+            if (bUseNoDataMask)
+                oLevel.aabySrcMaskBuf[iBand].resize(nOldSize / nWrkDTSize +
+                                                    nValues);
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALRegenerateOverviewsMultiBand()");
+            return CE_Failure;
+        }
+
+        GDALRasterBand *poSrcBand = papoSrcBands[iBand];
+        eErr = poSrcBand->RasterIO(GF_Read, 0, nReadYOff, nSrcWidth,
+                                   nReadYSize, abySrcBuf.data() + nOldSize,
+                                   nSrcWidth, nReadYSize, eWrkDataType, 0, 0,
+                                   nullptr);
+
+        if (bUseNoDataMask && eErr == CE_None)
+        {
+            auto poMaskBand = poSrcBand->IsMaskBand()
+                                  ? poSrcBand
+                                  : poSrcBand->GetMaskBand();
+            eErr = poMaskBand->RasterIO(
+                GF_Read, 0, nReadYOff, nSrcWidth, nReadYSize,
+                oLevel.aabySrcMaskBuf[iBand].data() + nOldSize / nWrkDTSize,
+                nSrcWidth, nReadYSize, GDT_Byte, 0, 0, nullptr);
+        }
+    }
+    oLevel.nSrcBufYSize += nReadYSize;
+    return eErr;
+}
+
+/************************************************************************/
+/*                           ProcessStrip()                             */
+/************************************************************************/
+
+// Computes the next strip of lines of an overview level, writes it, and
+// appends it to the source lines of the next level.
+CPLErr GDALOvrCascadeGenerator::ProcessStrip(int iLevel)
+{
+    Level &oLevel = m_aoLevels[iLevel];
+    const OvrLevelChunking &oChunking = oLevel.oChunking;
+    const int nMargin = nKernelRadius * oChunking.nOvrFactor;
+    const int nDstYOff = oLevel.nDstYOff;
+
+    int nDstYCount = 0;
+    int nSrcYOffQueried = 0;
+    int nSrcYSizeQueried = 0;
+    const int nYCount = GetStripSrcWindow(oLevel, nDstYCount, nSrcYOffQueried,
+                                          nSrcYSizeQueried);
+
+    if (!pfnProgress(m_dfCurPixelCount / dfTotalPixelCount, nullptr,
+                     pProgressData))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    DiscardSrcLines(oLevel, nSrcYOffQueried);
+    if (iLevel == 0)
+    {
+        const CPLErr eErr = ReadSrcLines(oLevel, nSrcYOffQueried,
+                                         nSrcYOffQueried + nSrcYSizeQueried);
+        if (eErr != CE_None)
+            return eErr;
+    }
+    CPLAssert(oLevel.nSrcBufYOff == nSrcYOffQueried);
+    CPLAssert(oLevel.nSrcBufYSize >= nSrcYSizeQueried);
+
+    /* -------------------------------------------------------------------- */
+    /*      Resample the strip, chunk by chunk.                             */
+    /* -------------------------------------------------------------------- */
+    const int nSrcWidth = oChunking.nSrcWidth;
+    const int nDstWidth = oChunking.nDstWidth;
+    const size_t nWrkDTSize = GDALGetDataTypeSizeBytes(eWrkDataType);
+    std::vector<std::unique_ptr<Job>> apoJobs;
+    for (int nDstXOff = 0; nDstXOff < nDstWidth;
+         nDstXOff += oChunking.nDstChunkXSize)
+    {
+        const int nDstXCount =
+            std::min(oChunking.nDstChunkXSize, nDstWidth - nDstXOff);
+        int nSrcXOffQueried = 0;
+        int nSrcXSizeQueried = 0;
+        GetOvrChunkSrcWindow(nDstXOff, nDstXCount, nDstWidth,
+                             oChunking.dfXRatioDstToSrc, nSrcWidth, nMargin,
+                             nSrcXOffQueried, nSrcXSizeQueried);
+
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            auto poJob = cpl::make_unique<Job>();
+            poJob->poGenerator = this;
+            poJob->poChunking = &oChunking;
+            poJob->iBand = iBand;
+            poJob->nChunkXOff = nSrcXOffQueried;
+            poJob->nChunkXSize = nSrcXSizeQueried;
+            poJob->nChunkYOff = nSrcYOffQueried;
+            poJob->nChunkYSize = nSrcYSizeQueried;
+            poJob->nDstXOff = nDstXOff;
+            poJob->nDstXOff2 = nDstXOff + nDstXCount;
+            poJob->nDstYOff = nDstYOff;
+            poJob->nDstYOff2 = nDstYOff + nDstYCount;
+            poJob->poOverview = papapoOverviewBands[iBand][iLevel];
+
+            // Extract the source window of the chunk.
+            try
+            {
+                poJob->abyChunk.resize(static_cast<size_t>(nSrcXSizeQueried) *
+                                       nSrcYSizeQueried * nWrkDTSize);
+                if (bUseNoDataMask)
+                    poJob->abyChunkMask.resize(
+                        static_cast<size_t>(nSrcXSizeQueried) *
+                        nSrcYSizeQueried);
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory in GDALRegenerateOverviewsMultiBand()");
+                if (poJobQueue)
+                    poJobQueue->WaitCompletion();
+                return CE_Failure;
+            }
+            for (int iY = 0; iY < nSrcYSizeQueried; ++iY)
+            {
+                const size_t nSrcOffset =
+                    static_cast<size_t>(iY) * nSrcWidth + nSrcXOffQueried;
+                const size_t nDstOffset =
+                    static_cast<size_t>(iY) * nSrcXSizeQueried;
+                memcpy(poJob->abyChunk.data() + nDstOffset * nWrkDTSize,
+                       oLevel.aabySrcBuf[iBand].data() +
+                           nSrcOffset * nWrkDTSize,
+                       nSrcXSizeQueried * nWrkDTSize);
+                if (bUseNoDataMask)
+                {
+                    memcpy(poJob->abyChunkMask.data() + nDstOffset,
+                           oLevel.aabySrcMaskBuf[iBand].data() + nSrcOffset,
+                           nSrcXSizeQueried);
+                }
+            }
+
+            if (poJobQueue)
+                poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
+            else
+                JobResampleFunc(poJob.get());
+            apoJobs.emplace_back(std::move(poJob));
+        }
+    }
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+
+    /* -------------------------------------------------------------------- */
+    /*      Assemble the strip in the data type of the overview bands,      */
+    /*      and write it.                                                   */
+    /* -------------------------------------------------------------------- */
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    const size_t nStripValues = static_cast<size_t>(nDstWidth) * nDstYCount;
+    m_aabyDstStrip.resize(nBands);
+    for (int iBand = 0; iBand < nBands; ++iBand)
+        m_aabyDstStrip[iBand].resize(nStripValues * nDTSize);
+
+    for (const auto &poJob : apoJobs)
+    {
+        if (poJob->eErr != CE_None)
+            return poJob->eErr;
+        const int nDstXCount = poJob->nDstXOff2 - poJob->nDstXOff;
+        const int nDstBufferDTSize =
+            GDALGetDataTypeSizeBytes(poJob->eDstBufferDataType);
+        for (int iY = 0; iY < nDstYCount; ++iY)
+        {
+            GDALCopyWords64(
+                static_cast<const GByte *>(poJob->pDstBuffer) +
+                    static_cast<size_t>(iY) * nDstXCount * nDstBufferDTSize,
+                poJob->eDstBufferDataType, nDstBufferDTSize,
+                m_aabyDstStrip[poJob->iBand].data() +
+                    (static_cast<size_t>(iY) * nDstWidth + poJob->nDstXOff) *
+                        nDTSize,
+                eDataType, nDTSize, nDstXCount);
+        }
+    }
+    apoJobs.clear();
+
+    CPLErr eErr = CE_None;
+    for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+    {
+        eErr = papapoOverviewBands[iBand][iLevel]->RasterIO(
+            GF_Write, 0, nDstYOff, nDstWidth, nDstYCount,
+            m_aabyDstStrip[iBand].data(), nDstWidth, nDstYCount, eDataType, 0,
+            0, nullptr);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Append the strip to the source lines of the next level, as it   */
+    /*      would be read back from the overview bands.                     */
+    /* -------------------------------------------------------------------- */
+    if (eErr == CE_None && iLevel + 1 < static_cast<int>(m_aoLevels.size()))
+    {
+        Level &oNextLevel = m_aoLevels[iLevel + 1];
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            auto &abySrcBuf = oNextLevel.aabySrcBuf[iBand];
+            const size_t nOldValues = abySrcBuf.size() / nWrkDTSize;
+            try
+            {
+                abySrcBuf.resize((nOldValues + nStripValues) * nWrkDTSize);
+                if (bUseNoDataMask)
+                    oNextLevel.aabySrcMaskBuf[iBand].resize(nOldValues +
+                                                            nStripValues);
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory in GDALRegenerateOverviewsMultiBand()");
+                return CE_Failure;
+            }
+            GDALCopyWords64(m_aabyDstStrip[iBand].data(), eDataType, nDTSize,
+                            abySrcBuf.data() + nOldValues * nWrkDTSize,
+                            eWrkDataType, static_cast<int>(nWrkDTSize),
+                            nStripValues);
+            if (bUseNoDataMask)
+            {
+                GDALOvrComputeNoDataMask(
+                    m_aabyDstStrip[iBand].data(), eDataType, nStripValues,
+                    papoSrcBands[iBand]->GetNoDataValue(),
+                    oNextLevel.aabySrcMaskBuf[iBand].data() + nOldValues);
+            }
+        }
+        oNextLevel.nSrcBufYSize += nDstYCount;
+    }
+
+    oLevel.nDstYOff += nDstYCount;
+    m_dfCurPixelCount += static_cast<double>(nYCount) * nSrcWidth;
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                       ProcessAvailableStrips()                       */
+/************************************************************************/
+
+// Computes the strips of a level (and recursively of the next ones) whose
+// source lines are available.
+CPLErr GDALOvrCascadeGenerator::ProcessAvailableStrips(int iLevel)
+{
+    Level &oLevel = m_aoLevels[iLevel];
+    CPLErr eErr = CE_None;
+    while (eErr == CE_None &&
+           oLevel.nDstYOff < oLevel.oChunking.nDstHeight)
+    {
+        int nDstYCount = 0;
+        int nSrcYOffQueried = 0;
+        int nSrcYSizeQueried = 0;
+        GetStripSrcWindow(oLevel, nDstYCount, nSrcYOffQueried,
+                          nSrcYSizeQueried);
+        if (nSrcYOffQueried + nSrcYSizeQueried >
+            oLevel.nSrcBufYOff + oLevel.nSrcBufYSize)
+        {
+            break;
+        }
+
+        eErr = ProcessStrip(iLevel);
+        if (eErr == CE_None && iLevel + 1 < static_cast<int>(m_aoLevels.size()))
+            eErr = ProcessAvailableStrips(iLevel + 1);
+    }
+    return eErr;
+}
+
+/************************************************************************/
+/*                                Run()                                 */
+/************************************************************************/
+
+CPLErr GDALOvrCascadeGenerator::Run(
+    const std::vector<OvrLevelChunking> &aoChunking)
+{
+    m_aoLevels.resize(aoChunking.size());
+    for (size_t i = 0; i < aoChunking.size(); ++i)
+    {
+        m_aoLevels[i].oChunking = aoChunking[i];
+        m_aoLevels[i].aabySrcBuf.resize(nBands);
+        m_aoLevels[i].aabySrcMaskBuf.resize(nBands);
+    }
+
+    // Each strip of the first level makes the lines needed by the next
+    // levels available.
+    CPLErr eErr = CE_None;
+    Level &oFirstLevel = m_aoLevels[0];
+    while (eErr == CE_None &&
+           oFirstLevel.nDstYOff < oFirstLevel.oChunking.nDstHeight)
+    {
+        eErr = ProcessStrip(0);
+        if (eErr == CE_None && m_aoLevels.size() > 1)
+            eErr = ProcessAvailableStrips(1);
+    }
+    for (size_t iLevel = 1; iLevel < m_aoLevels.size() && eErr == CE_None;
+         ++iLevel)
+    {
+        const Level &oLevel = m_aoLevels[iLevel];
+        if (oLevel.nDstYOff < oLevel.oChunking.nDstHeight)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALRegenerateOverviewsMultiBand(): overview level %d "
+                     "has not been entirely computed",
+                     static_cast<int>(iLevel));
+            eErr = CE_Failure;
+        }
+    }
+
+    // Flush the data to overviews.
+    for (size_t iLevel = 0; iLevel < m_aoLevels.size(); ++iLevel)
+    {
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            if (papapoOverviewBands[iBand][iLevel]->FlushCache(false) !=
+                    CE_None &&
+                eErr == CE_None)
+            {
+                eErr = CE_Failure;
+            }
+        }
+    }
+
+    return eErr;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                        GDALOvrCanUseCascade()                        */
+/************************************************************************/
+
+// Returns whether GDALOvrCascadeGenerator can be used to compute all the
+// overview levels in a single pass, with the same result as computing each
+// level from the previous one read back from the overview bands.
+static bool GDALOvrCanUseCascade(
+    int nBands, GDALRasterBand *const *papoSrcBands, int nOverviews,
+    GDALRasterBand *const *const *papapoOverviewBands,
+    const std::vector<OvrLevelChunking> &aoChunking, GDALDataType eDataType,
+    GDALDataType eWrkDataType, bool bIsMask, bool bUseNoDataMask,
+    bool bPartialRefresh)
+{
+    if (nOverviews < 2 || bPartialRefresh)
+        return false;
+
+    const GIntBig nMaxMemory = CPLAtoGIntBig(
+        CPLGetConfigOption("GDAL_OVR_CASCADE_MAX_MEMORY", "268435456"));
+    if (nMaxMemory <= 0)
+        return false;
+
+    for (int iOverview = 1; iOverview < nOverviews; ++iOverview)
+    {
+        if (aoChunking[iOverview].iSrcOverview != iOverview - 1)
+            return false;
+    }
+
+    for (int iBand = 0; iBand < nBands; ++iBand)
+    {
+        for (int iOverview = 0; iOverview + 1 < nOverviews; ++iOverview)
+        {
+            // Values written to bands with NBITS set are not read back as is.
+            if (papapoOverviewBands[iBand][iOverview]->GetMetadataItem(
+                    "NBITS", "IMAGE_STRUCTURE") != nullptr)
+            {
+                return false;
+            }
+        }
+    }
+
+    if (bUseNoDataMask)
+    {
+        // The mask of the intermediate levels is computed from their nodata
+        // value, which is only supported for integer data types.
+        if (bIsMask)
+            return false;
+        switch (eDataType)
+        {
+            case GDT_Byte:
+            case GDT_Int8:
+            case GDT_UInt16:
+            case GDT_Int16:
+            case GDT_UInt32:
+            case GDT_Int32:
+                break;
+            default:
+                return false;
+        }
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            if (papoSrcBands[iBand]->GetMaskFlags() != GMF_NODATA)
+                return false;
+            const double dfNoDataValue = papoSrcBands[iBand]->GetNoDataValue();
+            for (int iOverview = 0; iOverview + 1 < nOverviews; ++iOverview)
+            {
+                auto poOvrBand = papapoOverviewBands[iBand][iOverview];
+                int bHasNoData = FALSE;
+                const double dfOvrNoDataValue =
+                    poOvrBand->GetNoDataValue(&bHasNoData);
+                if (poOvrBand->GetMaskFlags() != GMF_NODATA || !bHasNoData ||
+                    dfOvrNoDataValue != dfNoDataValue)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    const GIntBig nMemory = GDALOvrCascadeGenerator::EstimateMemory(
+        aoChunking, nBands, eDataType, eWrkDataType, bUseNoDataMask);
+    if (nMemory > nMaxMemory)
+    {
+        CPLDebug("GDAL",
+                 "Not computing overviews in a single pass, as it would "
+                 "require " CPL_FRMT_GIB " bytes, more than "
+                 "GDAL_OVR_CASCADE_MAX_MEMORY=" CPL_FRMT_GIB,
+                 nMemory, nMaxMemory);
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*            GDALRegenerateOverviewsMultiBand()                        */
+/************************************************************************/
+
+/**
+ * \brief Variant of GDALRegenerateOverviews, specially dedicated for generating
+ * compressed pixel-interleaved overviews (JPEG-IN-TIFF for example)
+ *
+ * This function will generate one or more overview images from a base
+ * image using the requested downsampling algorithm.  Its primary use
+ * is for generating overviews via GDALDataset::BuildOverviews(), but it
+ * can also be used to generate downsampled images in one file from another
+ * outside the overview architecture.
+ *
+ * The output bands need to exist in advance and share the same characteristics
+ * (type, dimensions)
+ *
+ * The resampling algorithms supported for the moment are "NEAREST", "AVERAGE",
+ * "RMS", "GAUSS", "CUBIC", "CUBICSPLINE", "LANCZOS" and "BILINEAR"
+ *
+ * It does not support color tables or complex data types.
+ *
+ * The pseudo-algorithm used by the function is :
+ *    for each overview
+ *       iterate on lines of the source by a step of deltay
+ *           iterate on columns of the source  by a step of deltax
+ *               read the source data of size deltax * deltay for all the bands
+ *               generate the corresponding overview block for all the bands
+ *
+ * This function will honour properly NODATA_VALUES tuples (special dataset
+ * metadata) so that only a given RGB triplet (in case of a RGB image) will be
+ * considered as the nodata value and not each value of the triplet
+ * independently per band.
+ *
+ * Starting with GDAL 3.2, the GDAL_NUM_THREADS configuration option can be set
+ * to "ALL_CPUS" or a integer value to specify the number of threads to use for
+ * overview computation.
+ *
+ * Starting with GDAL 3.8, when several overview levels are generated, each
+ * one being computed from the previous one, they are all computed in a single
+ * pass over the source bands: the lines of each level are kept in memory as
+ * long as they are needed to compute the next level, instead of being read
+ * back from the overview bands. The GDAL_OVR_CASCADE_MAX_MEMORY configuration
+ * option sets the maximum memory, in bytes, used by that mode (256 MB by
+ * default). Setting it to 0 disables it.
+ *
+ * @param nBands the number of bands, size of papoSrcBands and size of
+ *               first dimension of papapoOverviewBands
+ * @param papoSrcBands the list of source bands to downsample
+ * @param nOverviews the number of downsampled overview levels being generated.
+ * @param papapoOverviewBands bidimension array of bands. First dimension is
+ *                            indexed by nBands. Second dimension is indexed by
+ *                            nOverviews.
+ * @param pszResampling Resampling algorithm ("NEAREST", "AVERAGE", "RMS",
+ * "GAUSS", "CUBIC", "CUBICSPLINE", "LANCZOS" or "BILINEAR").
+ * @param pfnProgress progress report function.
+ * @param pProgressData progress function callback data.
+ * @param papszOptions (GDAL >= 3.6) NULL terminated list of options as
+ *                     key=value pairs, or NULL.
+ *                     Starting with GDAL 3.8, the XOFF, YOFF, XSIZE and YSIZE
+ *                     options can be set to a window of the source bands,
+ *                     to only refresh the overview pixels that depend on it.
+ * @return CE_None on success or CE_Failure on failure.
+ */
+
+CPLErr GDALRegenerateOverviewsMultiBand(
+    int nBands, GDALRasterBand *const *papoSrcBands, int nOverviews,
+    GDALRasterBand *const *const *papapoOverviewBands,
+    const char *pszResampling, GDALProgressFunc pfnProgress,
+    void *pProgressData, CSLConstList papszOptions)
+{
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    if (EQUAL(pszResampling, "NONE"))
+        return CE_None;
+
+    // Sanity checks.
+    if (!STARTS_WITH_CI(pszResampling, "NEAR") &&
+        !EQUAL(pszResampling, "RMS") && !EQUAL(pszResampling, "AVERAGE") &&
+        !EQUAL(pszResampling, "GAUSS") && !EQUAL(pszResampling, "CUBIC") &&
+        !EQUAL(pszResampling, "CUBICSPLINE") &&
+        !EQUAL(pszResampling, "LANCZOS") && !EQUAL(pszResampling, "BILINEAR") &&
+        !EQUAL(pszResampling, "MODE"))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GDALRegenerateOverviewsMultiBand: pszResampling='%s' "
+                 "not supported",
+                 pszResampling);
+        return CE_Failure;
+    }
+
+    int nKernelRadius = 0;
+    GDALResampleFunction pfnResampleFn =
+        GDALGetResampleFunction(pszResampling, &nKernelRadius);
+    if (pfnResampleFn == nullptr)
+        return CE_Failure;
+
+    const int nToplevelSrcWidth = papoSrcBands[0]->GetXSize();
+    const int nToplevelSrcHeight = papoSrcBands[0]->GetYSize();
+    GDALDataType eDataType = papoSrcBands[0]->GetRasterDataType();
+    for (int iBand = 1; iBand < nBands; ++iBand)
+    {
+        if (papoSrcBands[iBand]->GetXSize() != nToplevelSrcWidth ||
+            papoSrcBands[iBand]->GetYSize() != nToplevelSrcHeight)
+        {
+            CPLError(
+                CE_Failure, CPLE_NotSupported,
+                "GDALRegenerateOverviewsMultiBand: all the source bands must "
+                "have the same dimensions");
+            return CE_Failure;
+        }
+        if (papoSrcBands[iBand]->GetRasterDataType() != eDataType)
+        {
+            CPLError(
+                CE_Failure, CPLE_NotSupported,
+                "GDALRegenerateOverviewsMultiBand: all the source bands must "
+                "have the same data type");
+            return CE_Failure;
+        }
+    }
+
+    for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+    {
+        const int nDstWidth = papapoOverviewBands[0][iOverview]->GetXSize();
+        const int nDstHeight = papapoOverviewBands[0][iOverview]->GetYSize();
+        for (int iBand = 1; iBand < nBands; ++iBand)
+        {
+            if (papapoOverviewBands[iBand][iOverview]->GetXSize() !=
+                    nDstWidth ||
+                papapoOverviewBands[iBand][iOverview]->GetYSize() != nDstHeight)
+            {
+                CPLError(
+                    CE_Failure, CPLE_NotSupported,
+                    "GDALRegenerateOverviewsMultiBand: all the overviews bands "
+                    "of the same level must have the same dimensions");
+                return CE_Failure;
+            }
+            if (papapoOverviewBands[iBand][iOverview]->GetRasterDataType() !=
+                eDataType)
+            {
+                CPLError(
+                    CE_Failure, CPLE_NotSupported,
+                    "GDALRegenerateOverviewsMultiBand: all the overviews bands "
+                    "must have the same data type as the source bands");
+                return CE_Failure;
+            }
+        }
+    }
+
+    const GDALDataType eWrkDataType =
+        GDALGetOvrWorkDataType(pszResampling, eDataType);
+
+    const bool bIsMask = papoSrcBands[0]->IsMaskBand();
+
+    // If we have a nodata mask and we are doing something more complicated
+    // than nearest neighbouring, we have to fetch to nodata mask.
+    const bool bUseNoDataMask =
+        !STARTS_WITH_CI(pszResampling, "NEAR") &&
+        (bIsMask || (papoSrcBands[0]->GetMaskFlags() & GMF_ALL_VALID) == 0);
+
+    int *const pabHasNoData =
+        static_cast<int *>(VSI_MALLOC_VERBOSE(nBands * sizeof(int)));
+    float *const pafNoDataValue =
+        static_cast<float *>(VSI_MALLOC_VERBOSE(nBands * sizeof(float)));
+    if (pabHasNoData == nullptr || pafNoDataValue == nullptr)
+    {
+        CPLFree(pabHasNoData);
+        CPLFree(pafNoDataValue);
+        return CE_Failure;
+    }
+
+    for (int iBand = 0; iBand < nBands; ++iBand)
+    {
+        pabHasNoData[iBand] = FALSE;
+        pafNoDataValue[iBand] = static_cast<float>(
+            papoSrcBands[iBand]->GetNoDataValue(&pabHasNoData[iBand]));
     }
     const bool bPropagateNoData =
         CPLTestBool(CPLGetConfigOption("GDAL_OVR_PROPAGATE_NODATA", "NO"));
 
+    // Whether chunks that only contain nodata in all the source bands can
+    // be skipped.
+    bool bSkipEmptyChunks =
+        !bIsMask && !STARTS_WITH_CI(pszResampling, "AVERAGE_BIT2");
+    for (int iBand = 0; iBand < nBands && bSkipEmptyChunks; ++iBand)
+    {
+        bSkipEmptyChunks = GDALOvrHasEmptyRegions(papoSrcBands[iBand]);
+    }
+
     const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
     const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
                                                        ? CPLGetNumCPUs()
@@ -5035,75 +6126,140 @@ CPLErr GDALRegenerateOverviewsMultiBand(
     const int nChunkMaxSize =
         atoi(CPLGetConfigOption("GDAL_OVR_CHUNK_MAX_SIZE", "10485760"));
 
-    // Second pass to do the real job.
-    double dfCurPixelCount = 0;
-    CPLErr eErr = CE_None;
-    for (int iOverview = 0; iOverview < nOverviews && eErr == CE_None;
-         ++iOverview)
+    // Window of the source bands whose overview pixels must be refreshed.
+    const int nRegionXOff =
+        atoi(CSLFetchNameValueDef(papszOptions, "XOFF", "0"));
+    const int nRegionYOff =
+        atoi(CSLFetchNameValueDef(papszOptions, "YOFF", "0"));
+    const int nRegionXSize = atoi(CSLFetchNameValueDef(
+        papszOptions, "XSIZE", CPLSPrintf("%d", nToplevelSrcWidth)));
+    const int nRegionYSize = atoi(CSLFetchNameValueDef(
+        papszOptions, "YSIZE", CPLSPrintf("%d", nToplevelSrcHeight)));
+    if (nRegionXOff < 0 || nRegionYOff < 0 || nRegionXSize <= 0 ||
+        nRegionYSize <= 0 || nRegionXSize > nToplevelSrcWidth - nRegionXOff ||
+        nRegionYSize > nToplevelSrcHeight - nRegionYOff)
     {
-        int iSrcOverview = -1;  // -1 means the source bands.
-
-        int nDstChunkXSize = 0;
-        int nDstChunkYSize = 0;
-        papapoOverviewBands[0][iOverview]->GetBlockSize(&nDstChunkXSize,
-                                                        &nDstChunkYSize);
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "GDALRegenerateOverviewsMultiBand: invalid window "
+                 "XOFF=%d,YOFF=%d,XSIZE=%d,YSIZE=%d",
+                 nRegionXOff, nRegionYOff, nRegionXSize, nRegionYSize);
+        CPLFree(pabHasNoData);
+        CPLFree(pafNoDataValue);
+        return CE_Failure;
+    }
+    const bool bPartialRefresh =
+        nRegionXOff != 0 || nRegionYOff != 0 ||
+        nRegionXSize != nToplevelSrcWidth || nRegionYSize != nToplevelSrcHeight;
 
-        const int nDstWidth = papapoOverviewBands[0][iOverview]->GetXSize();
-        const int nDstHeight = papapoOverviewBands[0][iOverview]->GetYSize();
+    std::vector<OvrLevelChunking> aoChunking;
+    double dfTotalPixelCount = 0;
+    for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+    {
+        OvrLevelChunking oChunking = GetOvrLevelChunking(
+            nBands, nToplevelSrcWidth, nToplevelSrcHeight, papapoOverviewBands,
+            iOverview, nKernelRadius, eWrkDataType, nChunkMaxSize);
 
-        // Try to use previous level of overview as the source to compute
-        // the next level.
-        int nSrcWidth = nToplevelSrcWidth;
-        int nSrcHeight = nToplevelSrcHeight;
-        if (iOverview > 0 &&
-            papapoOverviewBands[0][iOverview - 1]->GetXSize() > nDstWidth)
+        if (bPartialRefresh)
         {
-            nSrcWidth = papapoOverviewBands[0][iOverview - 1]->GetXSize();
-            nSrcHeight = papapoOverviewBands[0][iOverview - 1]->GetYSize();
-            iSrcOverview = iOverview - 1;
+            // The source window of a level is the full resolution region, or
+            // the refreshed window of the previous level.
+            int nSrcXStart = nRegionXOff;
+            int nSrcYStart = nRegionYOff;
+            int nSrcXEnd = nRegionXOff + nRegionXSize;
+            int nSrcYEnd = nRegionYOff + nRegionYSize;
+            if (oChunking.iSrcOverview >= 0)
+            {
+                const auto &oSrcChunking = aoChunking[oChunking.iSrcOverview];
+                nSrcXStart = oSrcChunking.nDstXStart;
+                nSrcYStart = oSrcChunking.nDstYStart;
+                nSrcXEnd = oSrcChunking.nDstXEnd;
+                nSrcYEnd = oSrcChunking.nDstYEnd;
+            }
+            int nBlockXSize = 0;
+            int nBlockYSize = 0;
+            papapoOverviewBands[0][iOverview]->GetBlockSize(&nBlockXSize,
+                                                            &nBlockYSize);
+            const int nMargin = nKernelRadius * oChunking.nOvrFactor;
+            SetOvrLevelWindow(nSrcXStart, nSrcXEnd, oChunking.dfXRatioDstToSrc,
+                              nMargin, oChunking.nDstWidth, nBlockXSize,
+                              oChunking.nDstXStart, oChunking.nDstXEnd);
+            SetOvrLevelWindow(nSrcYStart, nSrcYEnd, oChunking.dfYRatioDstToSrc,
+                              nMargin, oChunking.nDstHeight, nBlockYSize,
+                              oChunking.nDstYStart, oChunking.nDstYEnd);
+            int nSrcOffQueried = 0;
+            int nSrcSizeQueried = 0;
+            oChunking.nSrcXCount = GetOvrChunkSrcWindow(
+                oChunking.nDstXStart, oChunking.nDstXEnd - oChunking.nDstXStart,
+                oChunking.nDstWidth, oChunking.dfXRatioDstToSrc,
+                oChunking.nSrcWidth, 0, nSrcOffQueried, nSrcSizeQueried);
         }
 
-        const double dfXRatioDstToSrc =
-            static_cast<double>(nSrcWidth) / nDstWidth;
-        const double dfYRatioDstToSrc =
-            static_cast<double>(nSrcHeight) / nDstHeight;
-
-        int nOvrFactor = std::max(static_cast<int>(0.5 + dfXRatioDstToSrc),
-                                  static_cast<int>(0.5 + dfYRatioDstToSrc));
-        if (nOvrFactor == 0)
-            nOvrFactor = 1;
-
-        // Try to extend the chunk size so that the memory needed to acquire
-        // source pixels goes up to 10 MB.
-        // This can help for drivers that support multi-threaded reading
-        const int nFullResYChunk =
-            2 + static_cast<int>(nDstChunkYSize * dfYRatioDstToSrc);
-        const int nFullResYChunkQueried =
-            nFullResYChunk + 2 * nKernelRadius * nOvrFactor;
-        while (nDstChunkXSize < nDstWidth)
-        {
-            const int nFullResXChunk =
-                2 + static_cast<int>(2 * nDstChunkXSize * dfXRatioDstToSrc);
-
-            const int nFullResXChunkQueried =
-                nFullResXChunk + 2 * nKernelRadius * nOvrFactor;
+        // Compute the total number of pixels to read.
+        int nSrcOffQueried = 0;
+        int nSrcSizeQueried = 0;
+        const int nSrcYCount = GetOvrChunkSrcWindow(
+            oChunking.nDstYStart, oChunking.nDstYEnd - oChunking.nDstYStart,
+            oChunking.nDstHeight, oChunking.dfYRatioDstToSrc,
+            oChunking.nSrcHeight, 0, nSrcOffQueried, nSrcSizeQueried);
+        dfTotalPixelCount +=
+            static_cast<double>(oChunking.nSrcXCount) * nSrcYCount;
+
+        aoChunking.push_back(oChunking);
+    }
 
-            if (static_cast<GIntBig>(nFullResXChunkQueried) *
-                    nFullResYChunkQueried * nBands *
-                    GDALGetDataTypeSizeBytes(eWrkDataType) >
-                nChunkMaxSize)
-            {
-                break;
-            }
+    CPLErr eErr = CE_None;
 
-            nDstChunkXSize *= 2;
-        }
-        nDstChunkXSize = std::min(nDstChunkXSize, nDstWidth);
+    // When each level is computed from the previous one, compute all of them
+    // in a single pass over the source bands, instead of reading back each
+    // level from the overview bands.
+    // Sparse sources are better handled by the chunked path, that can skip
+    // their empty regions.
+    const bool bCascade =
+        !bSkipEmptyChunks &&
+        GDALOvrCanUseCascade(nBands, papoSrcBands, nOverviews,
+                             papapoOverviewBands, aoChunking, eDataType,
+                             eWrkDataType, bIsMask, bUseNoDataMask,
+                             bPartialRefresh);
+    if (bCascade)
+    {
+        GDALOvrCascadeGenerator oGenerator;
+        oGenerator.nBands = nBands;
+        oGenerator.papoSrcBands = papoSrcBands;
+        oGenerator.papapoOverviewBands = papapoOverviewBands;
+        oGenerator.pszResampling = pszResampling;
+        oGenerator.pfnResampleFn = pfnResampleFn;
+        oGenerator.nKernelRadius = nKernelRadius;
+        oGenerator.eDataType = eDataType;
+        oGenerator.eWrkDataType = eWrkDataType;
+        oGenerator.bUseNoDataMask = bUseNoDataMask;
+        oGenerator.pabHasNoData = pabHasNoData;
+        oGenerator.pafNoDataValue = pafNoDataValue;
+        oGenerator.bPropagateNoData = bPropagateNoData;
+        oGenerator.poJobQueue = poJobQueue.get();
+        oGenerator.pfnProgress = pfnProgress;
+        oGenerator.pProgressData = pProgressData;
+        oGenerator.dfTotalPixelCount = dfTotalPixelCount;
+        eErr = oGenerator.Run(aoChunking);
+    }
 
-        const int nFullResXChunk =
-            2 + static_cast<int>(nDstChunkXSize * dfXRatioDstToSrc);
-        const int nFullResXChunkQueried =
-            nFullResXChunk + 2 * nKernelRadius * nOvrFactor;
+    // Second pass to do the real job.
+    double dfCurPixelCount = 0;
+    for (int iOverview = 0;
+         !bCascade && iOverview < nOverviews && eErr == CE_None; ++iOverview)
+    {
+        const OvrLevelChunking &oChunking = aoChunking[iOverview];
+        const int iSrcOverview = oChunking.iSrcOverview;
+        const int nDstChunkXSize = oChunking.nDstChunkXSize;
+        const int nDstChunkYSize = oChunking.nDstChunkYSize;
+        const int nDstWidth = oChunking.nDstWidth;
+        const int nDstHeight = oChunking.nDstHeight;
+        const int nSrcWidth = oChunking.nSrcWidth;
+        const int nSrcHeight = oChunking.nSrcHeight;
+        const double dfXRatioDstToSrc = oChunking.dfXRatioDstToSrc;
+        const double dfYRatioDstToSrc = oChunking.dfYRatioDstToSrc;
+        const int nMargin = nKernelRadius * oChunking.nOvrFactor;
+        const int nFullResXChunkQueried = oChunking.nFullResXChunkQueried;
+        const int nFullResYChunkQueried = oChunking.nFullResYChunkQueried;
 
         // Structure describing a resampling job
         struct OvrJob
@@ -5212,32 +6368,19 @@ CPLErr GDALRegenerateOverviewsMultiBand(
 
         int nDstYOff = 0;
         // Iterate on destination overview, block by block.
-        for (nDstYOff = 0; nDstYOff < nDstHeight && eErr == CE_None;
+        for (nDstYOff = oChunking.nDstYStart;
+             nDstYOff < oChunking.nDstYEnd && eErr == CE_None;
              nDstYOff += nDstChunkYSize)
         {
-            int nDstYCount;
-            if (nDstYOff + nDstChunkYSize <= nDstHeight)
-                nDstYCount = nDstChunkYSize;
-            else
-                nDstYCount = nDstHeight - nDstYOff;
-
-            int nChunkYOff = static_cast<int>(nDstYOff * dfYRatioDstToSrc);
-            int nChunkYOff2 = static_cast<int>(
-                ceil((nDstYOff + nDstYCount) * dfYRatioDstToSrc));
-            if (nChunkYOff2 > nSrcHeight || nDstYOff + nDstYCount == nDstHeight)
-                nChunkYOff2 = nSrcHeight;
-            int nYCount = nChunkYOff2 - nChunkYOff;
-            CPLAssert(nYCount <= nFullResYChunk);
-
-            int nChunkYOffQueried = nChunkYOff - nKernelRadius * nOvrFactor;
-            int nChunkYSizeQueried = nYCount + 2 * nKernelRadius * nOvrFactor;
-            if (nChunkYOffQueried < 0)
-            {
-                nChunkYSizeQueried += nChunkYOffQueried;
-                nChunkYOffQueried = 0;
-            }
-            if (nChunkYSizeQueried + nChunkYOffQueried > nSrcHeight)
-                nChunkYSizeQueried = nSrcHeight - nChunkYOffQueried;
+            const int nDstYCount =
+                std::min(nDstChunkYSize, oChunking.nDstYEnd - nDstYOff);
+
+            int nChunkYOffQueried = 0;
+            int nChunkYSizeQueried = 0;
+            const int nYCount = GetOvrChunkSrcWindow(
+                nDstYOff, nDstYCount, nDstHeight, dfYRatioDstToSrc, nSrcHeight,
+                nMargin, nChunkYOffQueried, nChunkYSizeQueried);
+            CPLAssert(nYCount <= oChunking.nFullResYChunk);
             CPLAssert(nChunkYSizeQueried <= nFullResYChunkQueried);
 
             if (!pfnProgress(dfCurPixelCount / dfTotalPixelCount, nullptr,
@@ -5249,34 +6392,20 @@ CPLErr GDALRegenerateOverviewsMultiBand(
 
             int nDstXOff = 0;
             // Iterate on destination overview, block by block.
-            for (nDstXOff = 0; nDstXOff < nDstWidth && eErr == CE_None;
+            for (nDstXOff = oChunking.nDstXStart;
+                 nDstXOff < oChunking.nDstXEnd && eErr == CE_None;
                  nDstXOff += nDstChunkXSize)
             {
-                int nDstXCount = 0;
-                if (nDstXOff + nDstChunkXSize <= nDstWidth)
-                    nDstXCount = nDstChunkXSize;
-                else
-                    nDstXCount = nDstWidth - nDstXOff;
-
-                int nChunkXOff = static_cast<int>(nDstXOff * dfXRatioDstToSrc);
-                int nChunkXOff2 = static_cast<int>(
-                    ceil((nDstXOff + nDstXCount) * dfXRatioDstToSrc));
-                if (nChunkXOff2 > nSrcWidth ||
-                    nDstXOff + nDstXCount == nDstWidth)
-                    nChunkXOff2 = nSrcWidth;
-                const int nXCount = nChunkXOff2 - nChunkXOff;
-                CPLAssert(nXCount <= nFullResXChunk);
-
-                int nChunkXOffQueried = nChunkXOff - nKernelRadius * nOvrFactor;
-                int nChunkXSizeQueried =
-                    nXCount + 2 * nKernelRadius * nOvrFactor;
-                if (nChunkXOffQueried < 0)
-                {
-                    nChunkXSizeQueried += nChunkXOffQueried;
-                    nChunkXOffQueried = 0;
-                }
-                if (nChunkXSizeQueried + nChunkXOffQueried > nSrcWidth)
-                    nChunkXSizeQueried = nSrcWidth - nChunkXOffQueried;
+                const int nDstXCount =
+                    std::min(nDstChunkXSize, oChunking.nDstXEnd - nDstXOff);
+
+                int nChunkXOffQueried = 0;
+                int nChunkXSizeQueried = 0;
+                const int nXCount = GetOvrChunkSrcWindow(
+                    nDstXOff, nDstXCount, nDstWidth, dfXRatioDstToSrc,
+                    nSrcWidth, nMargin, nChunkXOffQueried, nChunkXSizeQueried);
+                CPL_IGNORE_RET_VAL(nXCount);
+                CPLAssert(nXCount <= oChunking.nFullResXChunk);
                 CPLAssert(nChunkXSizeQueried <= nFullResXChunkQueried);
 #if DEBUG_VERBOSE
                 CPLDebug("GDAL",
@@ -5316,6 +6445,35 @@ CPLErr GDALRegenerateOverviewsMultiBand(
                     eErr = WaitAndFinalizeOldestJob(jobList);
                 }
 
+                // Chunks that only contain nodata do not need to be read
+                // and resampled: the overview block is set to nodata.
+                if (eErr == CE_None && bSkipEmptyChunks)
+                {
+                    bool bEmptyChunk = true;
+                    for (int iBand = 0; iBand < nBands && bEmptyChunk; ++iBand)
+                    {
+                        GDALRasterBand *poSrcBand =
+                            iSrcOverview == -1
+                                ? papoSrcBands[iBand]
+                                : papapoOverviewBands[iBand][iSrcOverview];
+                        bEmptyChunk = GDALOvrIsEmptyChunk(
+                            poSrcBand, nChunkXOffQueried, nChunkYOffQueried,
+                            nChunkXSizeQueried, nChunkYSizeQueried);
+                    }
+                    if (bEmptyChunk)
+                    {
+                        for (int iBand = 0; iBand < nBands && eErr == CE_None;
+                             ++iBand)
+                        {
+                            eErr = GDALOvrFillWithNoData(
+                                papoSrcBands[iBand],
+                                papapoOverviewBands[iBand][iOverview], nDstXOff,
+                                nDstYOff, nDstXCount, nDstYCount);
+                        }
+                        continue;
+                    }
+                }
+
                 // (Re)allocate buffers if needed
                 for (int iBand = 0; iBand < nBands; ++iBand)
                 {
@@ -5419,7 +6577,8 @@ CPLErr GDALRegenerateOverviewsMultiBand(
                 }
             }
 
-            dfCurPixelCount += static_cast<double>(nYCount) * nSrcWidth;
+            dfCurPixelCount +=
+                static_cast<double>(nYCount) * oChunking.nSrcXCount;
         }
 
         // Wait for all pending jobs to complete
@@ -5449,6 +6608,210 @@ CPLErr GDALRegenerateOverviewsMultiBand(
     return eErr;
 }
 
+/************************************************************************/
+/*                  GDALRegenerateOverviewsInRegions()                  */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+// Recomputes the pixels of the existing overviews of a dataset that depend on
+// a list of windows of its full resolution bands. This is the implementation
+// of the REFRESH_REGIONS and REFRESH_DIRTY_REGIONS options of
+// GDALDataset::BuildOverviews(). nOverviews == 0 means all existing overview
+// levels.
+CPLErr GDALRegenerateOverviewsInRegions(
+    GDALDataset *poDS, const char *pszResampling, int nOverviews,
+    const int *panOverviewList, int nListBands, const int *panBandList,
+    const std::vector<GDALRasterWindow> &aoRegions,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    std::vector<GDALRasterBand *> apoSrcBands;
+    for (int i = 0; i < nListBands; ++i)
+    {
+        GDALRasterBand *poBand = poDS->GetRasterBand(panBandList[i]);
+        if (poBand == nullptr)
+            return CE_Failure;
+        if (GDALDataTypeIsComplex(poBand->GetRasterDataType()))
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Partial refresh of overviews is not supported for "
+                     "complex data types");
+            return CE_Failure;
+        }
+        if (poBand->GetColorTable() != nullptr &&
+            !STARTS_WITH_CI(pszResampling, "NEAR") &&
+            !EQUAL(pszResampling, "MODE"))
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Partial refresh of overviews of bands with a color "
+                     "table is only supported with the NEAREST and MODE "
+                     "resampling methods");
+            return CE_Failure;
+        }
+        apoSrcBands.push_back(poBand);
+    }
+    if (apoSrcBands.empty())
+        return CE_None;
+
+    /* -------------------------------------------------------------------- */
+    /*      Find the overview levels to refresh, from the largest to the    */
+    /*      smallest.                                                       */
+    /* -------------------------------------------------------------------- */
+    GDALRasterBand *poFirstBand = apoSrcBands[0];
+    const int nXSize = poFirstBand->GetXSize();
+    const int nYSize = poFirstBand->GetYSize();
+    std::vector<int> anOvrIndices;
+    if (nOverviews == 0)
+    {
+        for (int j = 0; j < poFirstBand->GetOverviewCount(); ++j)
+            anOvrIndices.push_back(j);
+    }
+    for (int i = 0; i < nOverviews; ++i)
+    {
+        int iFound = -1;
+        for (int j = 0; j < poFirstBand->GetOverviewCount(); ++j)
+        {
+            GDALRasterBand *poOverview = poFirstBand->GetOverview(j);
+            const int nOvFactor =
+                GDALComputeOvFactor(poOverview->GetXSize(), nXSize,
+                                    poOverview->GetYSize(), nYSize);
+            if (nOvFactor == panOverviewList[i] ||
+                nOvFactor ==
+                    GDALOvLevelAdjust2(panOverviewList[i], nXSize, nYSize))
+            {
+                iFound = j;
+                break;
+            }
+        }
+        if (iFound < 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot refresh overview level %d, as it does not exist",
+                     panOverviewList[i]);
+            return CE_Failure;
+        }
+        if (std::find(anOvrIndices.begin(), anOvrIndices.end(), iFound) ==
+            anOvrIndices.end())
+        {
+            anOvrIndices.push_back(iFound);
+        }
+    }
+    if (anOvrIndices.empty())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot refresh overviews, as there are none");
+        return CE_Failure;
+    }
+    std::sort(anOvrIndices.begin(), anOvrIndices.end(),
+              [poFirstBand](int a, int b)
+              {
+                  return poFirstBand->GetOverview(a)->GetXSize() >
+                         poFirstBand->GetOverview(b)->GetXSize();
+              });
+
+    const int nOvrCount = static_cast<int>(anOvrIndices.size());
+    std::vector<std::vector<GDALRasterBand *>> aapoOverviewBands;
+    std::vector<GDALRasterBand **> apapoOverviewBands;
+    for (GDALRasterBand *poBand : apoSrcBands)
+    {
+        std::vector<GDALRasterBand *> apoOverviewBands;
+        for (int iOvr : anOvrIndices)
+        {
+            GDALRasterBand *poOverview = poBand->GetOverview(iOvr);
+            if (poOverview == nullptr)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "All bands must have the same overviews");
+                return CE_Failure;
+            }
+            apoOverviewBands.push_back(poOverview);
+        }
+        aapoOverviewBands.emplace_back(std::move(apoOverviewBands));
+    }
+    for (auto &apoOverviewBands : aapoOverviewBands)
+        apapoOverviewBands.push_back(apoOverviewBands.data());
+
+    // Also refresh the overviews of a per-dataset mask.
+    GDALRasterBand *poMaskBand = nullptr;
+    std::vector<GDALRasterBand *> apoMaskOverviewBands;
+    if (poFirstBand->GetMaskFlags() == GMF_PER_DATASET &&
+        poFirstBand->GetMaskBand()->GetOverviewCount() ==
+            poFirstBand->GetOverviewCount())
+    {
+        poMaskBand = poFirstBand->GetMaskBand();
+        for (int iOvr : anOvrIndices)
+            apoMaskOverviewBands.push_back(poMaskBand->GetOverview(iOvr));
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Refresh each region.                                            */
+    /* -------------------------------------------------------------------- */
+    const int nSteps =
+        static_cast<int>(aoRegions.size()) * (poMaskBand ? 2 : 1);
+    int iStep = 0;
+    CPLErr eErr = CE_None;
+    for (const auto &oRegion : aoRegions)
+    {
+        // Clip the region to the raster extent.
+        const int nXOff = std::max(0, oRegion.nXOff);
+        const int nYOff = std::max(0, oRegion.nYOff);
+        const int nXEnd = static_cast<int>(std::min<GIntBig>(
+            nXSize, static_cast<GIntBig>(oRegion.nXOff) + oRegion.nXSize));
+        const int nYEnd = static_cast<int>(std::min<GIntBig>(
+            nYSize, static_cast<GIntBig>(oRegion.nYOff) + oRegion.nYSize));
+        if (nXEnd <= nXOff || nYEnd <= nYOff)
+        {
+            iStep += poMaskBand ? 2 : 1;
+            continue;
+        }
+
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("XOFF", CPLSPrintf("%d", nXOff));
+        aosOptions.SetNameValue("YOFF", CPLSPrintf("%d", nYOff));
+        aosOptions.SetNameValue("XSIZE", CPLSPrintf("%d", nXEnd - nXOff));
+        aosOptions.SetNameValue("YSIZE", CPLSPrintf("%d", nYEnd - nYOff));
+
+        void *pScaledProgress = GDALCreateScaledProgress(
+            static_cast<double>(iStep) / nSteps,
+            static_cast<double>(iStep + 1) / nSteps, pfnProgress,
+            pProgressData);
+        eErr = GDALRegenerateOverviewsMultiBand(
+            static_cast<int>(apoSrcBands.size()), apoSrcBands.data(),
+            nOvrCount, apapoOverviewBands.data(), pszResampling,
+            GDALScaledProgress, pScaledProgress, aosOptions.List());
+        GDALDestroyScaledProgress(pScaledProgress);
+        ++iStep;
+        if (eErr != CE_None)
+            break;
+
+        if (poMaskBand)
+        {
+            GDALRasterBand *const *papoMaskOverviewBands =
+                apoMaskOverviewBands.data();
+            pScaledProgress = GDALCreateScaledProgress(
+                static_cast<double>(iStep) / nSteps,
+                static_cast<double>(iStep + 1) / nSteps, pfnProgress,
+                pProgressData);
+            eErr = GDALRegenerateOverviewsMultiBand(
+                1, &poMaskBand, nOvrCount, &papoMaskOverviewBands,
+                pszResampling, GDALScaledProgress, pScaledProgress,
+                aosOptions.List());
+            GDALDestroyScaledProgress(pScaledProgress);
+            ++iStep;
+            if (eErr != CE_None)
+                break;
+        }
+    }
+
+    if (eErr == CE_None)
+        pfnProgress(1.0, nullptr, pProgressData);
+
+    return eErr;
+}
+//! @endcond
+
 /************************************************************************/
 /*                        GDALComputeBandStats()                        */
 /************************************************************************/
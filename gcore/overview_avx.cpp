@@ -0,0 +1,85 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX implementation of overview resampling kernels
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+// This file is compiled with AVX enabled, and its functions must only be
+// called after having checked CPLHaveRuntimeAVX(). Consequently it must not
+// instantiate inline functions or templates that are also used by other
+// translation units, since the linker could pick the AVX version of them.
+
+#include "cpl_port.h"
+
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+#include "overview_avx.h"
+
+#include <immintrin.h>
+
+CPL_CVSID("$Id$")
+
+/************************************************************************/
+/*                     GDALAverageFloat2x2AVX()                         */
+/************************************************************************/
+
+// Average of 2x2 Float32 source pixels, processing 8 output pixels per
+// iteration. Returns the number of destination values processed, the
+// remaining ones being left to the caller.
+
+int GDALAverageFloat2x2AVX(int nDstXWidth, int nChunkXSize,
+                           const float *CPL_RESTRICT pSrcScanlineShifted,
+                           float *CPL_RESTRICT pDstScanline)
+{
+    const auto zeroDot25 = _mm256_set1_ps(0.25f);
+    int iDstPixel = 0;
+    for (; iDstPixel < nDstXWidth - 7; iDstPixel += 8)
+    {
+        // Load 16 Float32 from each line
+        const auto firstLineLo = _mm256_loadu_ps(pSrcScanlineShifted);
+        const auto firstLineHi = _mm256_loadu_ps(pSrcScanlineShifted + 8);
+        const auto secondLineLo =
+            _mm256_loadu_ps(pSrcScanlineShifted + nChunkXSize);
+        const auto secondLineHi =
+            _mm256_loadu_ps(pSrcScanlineShifted + 8 + nChunkXSize);
+
+        // Vertical addition
+        const auto sumLo = _mm256_add_ps(firstLineLo, secondLineLo);
+        const auto sumHi = _mm256_add_ps(firstLineHi, secondLineHi);
+
+        // Horizontal addition. _mm256_hadd_ps() operates on each 128-bit
+        // lane separately, so regroup the lanes beforehand: values 0-3 and
+        // 8-11 in the first operand, values 4-7 and 12-15 in the second one.
+        const auto sum = _mm256_hadd_ps(
+            _mm256_permute2f128_ps(sumLo, sumHi, 0x20),
+            _mm256_permute2f128_ps(sumLo, sumHi, 0x31));
+
+        _mm256_storeu_ps(pDstScanline + iDstPixel,
+                         _mm256_mul_ps(sum, zeroDot25));
+        pSrcScanlineShifted += 16;
+    }
+    _mm256_zeroupper();
+    return iDstPixel;
+}
+
+#endif  // HAVE_AVX_AT_COMPILE_TIME
@@ -0,0 +1,42 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX implementation of overview resampling kernels
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef OVERVIEW_AVX_H_INCLUDED
+#define OVERVIEW_AVX_H_INCLUDED
+
+#include "cpl_port.h"
+
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+
+// Must only be called after having checked CPLHaveRuntimeAVX()
+int GDALAverageFloat2x2AVX(int nDstXWidth, int nChunkXSize,
+                           const float *CPL_RESTRICT pSrcScanlineShifted,
+                           float *CPL_RESTRICT pDstScanline);
+
+#endif
+
+#endif /* OVERVIEW_AVX_H_INCLUDED */
@@ -0,0 +1,145 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Test performance of overview computation, for the various
+ *           data types and resampling methods.
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdal.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static void Usage()
+{
+    printf("Usage: testperfoverview [-size <n>] [-iter <n>] "
+           "[-type <data_type>]* [-r <resampling>]*\n");
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    int nSize = 4096;
+    int nIters = 5;
+    CPLStringList aosTypes;
+    CPLStringList aosResamplings;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "-size") && i + 1 < argc)
+            nSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-iter") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-type") && i + 1 < argc)
+            aosTypes.AddString(argv[++i]);
+        else if (EQUAL(argv[i], "-r") && i + 1 < argc)
+            aosResamplings.AddString(argv[++i]);
+        else
+            Usage();
+    }
+    if (nSize < 2 || nIters < 1)
+        Usage();
+    if (aosTypes.empty())
+    {
+        for (const char *pszType :
+             {"Byte", "UInt16", "Int16", "Int32", "Float32", "Float64"})
+            aosTypes.AddString(pszType);
+    }
+    if (aosResamplings.empty())
+    {
+        for (const char *pszResampling :
+             {"NEAREST", "AVERAGE", "RMS", "BILINEAR", "CUBIC", "GAUSS",
+              "MODE"})
+            aosResamplings.AddString(pszResampling);
+    }
+
+    GDALAllRegister();
+    GDALDriverH hMEMDrv = GDALGetDriverByName("MEM");
+
+    // Pseudo-random content, so that no resampling method can take
+    // shortcuts on constant areas.
+    std::vector<GByte> abyContent(static_cast<size_t>(nSize) * nSize);
+    unsigned nSeed = 1;
+    for (auto &v : abyContent)
+    {
+        nSeed = nSeed * 1103515245U + 12345U;
+        v = static_cast<GByte>(nSeed >> 16);
+    }
+
+    for (const char *pszType : aosTypes)
+    {
+        const GDALDataType eDT = GDALGetDataTypeByName(pszType);
+        if (eDT == GDT_Unknown)
+        {
+            fprintf(stderr, "Invalid data type: %s\n", pszType);
+            return 1;
+        }
+
+        GDALDatasetH hSrcDS =
+            GDALCreate(hMEMDrv, "", nSize, nSize, 1, eDT, nullptr);
+        GDALDatasetH hOvrDS =
+            GDALCreate(hMEMDrv, "", nSize / 2, nSize / 2, 1, eDT, nullptr);
+        GDALRasterBandH hSrcBand = GDALGetRasterBand(hSrcDS, 1);
+        GDALRasterBandH hOvrBand = GDALGetRasterBand(hOvrDS, 1);
+        CPL_IGNORE_RET_VAL(GDALRasterIO(hSrcBand, GF_Write, 0, 0, nSize, nSize,
+                                        abyContent.data(), nSize, nSize,
+                                        GDT_Byte, 0, 0));
+
+        for (int bNoData = 0; bNoData <= 1; bNoData++)
+        {
+            if (bNoData)
+                GDALSetRasterNoDataValue(hSrcBand, 0);
+
+            for (const char *pszResampling : aosResamplings)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                for (int iIter = 0; iIter < nIters; iIter++)
+                {
+                    if (GDALRegenerateOverviews(hSrcBand, 1, &hOvrBand,
+                                                pszResampling, nullptr,
+                                                nullptr) != CE_None)
+                    {
+                        return 1;
+                    }
+                }
+                const auto end = std::chrono::steady_clock::now();
+                printf("%s %s%s : %.3f s\n", pszType, pszResampling,
+                       bNoData ? " (nodata)" : "",
+                       std::chrono::duration<double>(end - start).count() /
+                           nIters);
+            }
+        }
+
+        GDALClose(hOvrDS);
+        GDALClose(hSrcDS);
+    }
+
+    GDALDestroyDriverManager();
+
+    return 0;
+}
@@ -41,6 +41,7 @@
 
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -353,7 +354,19 @@ class VSIArchiveContent
     int nEntries = 0;
     VSIArchiveEntry *entries = nullptr;
 
+    /* Index in entries[] from the file name, and of the entries of each */
+    /* directory ("" for the root), to avoid linear scans */
+    std::unordered_map<std::string, int> oMapFileNameToEntry{};
+    std::unordered_map<std::string, std::vector<int>> oMapDirToEntries{};
+
     ~VSIArchiveContent();
+
+    void AddEntry(char *pszFileName, vsi_l_offset nSize,
+                  VSIArchiveEntryFileOffset *poFilePos, bool bIsDir,
+                  GIntBig nModifiedTime);
+
+  private:
+    int nEntriesAlloc = 0;
 };
 
 class VSIArchiveReader
@@ -374,6 +387,11 @@ class VSIArchiveFilesystemHandler : public VSIFilesystemHandler
 {
     CPL_DISALLOW_COPY_ASSIGN(VSIArchiveFilesystemHandler)
 
+    VSIArchiveContent *ReadArchiveIndex(const char *archiveFilename,
+                                        const VSIStatBufL &sStat);
+    void WriteArchiveIndex(const char *archiveFilename,
+                           const VSIArchiveContent *content);
+
   protected:
     CPLMutex *hMutex = nullptr;
     /* We use a cache that contains the list of files contained in a VSIArchive
@@ -387,6 +405,20 @@ class VSIArchiveFilesystemHandler : public VSIFilesystemHandler
     virtual std::vector<CPLString> GetExtensions() = 0;
     virtual VSIArchiveReader *CreateReader(const char *pszArchiveFileName) = 0;
 
+    /* Conversion of entry offsets from/to a pair of integers, so that the */
+    /* content of an archive can be persisted in an index file */
+    virtual bool GetFileOffsetAsIntegers(const VSIArchiveEntryFileOffset *,
+                                         GUIntBig & /* nVal1 */,
+                                         GUIntBig & /* nVal2 */)
+    {
+        return false;
+    }
+    virtual VSIArchiveEntryFileOffset *
+    CreateFileOffsetFromIntegers(GUIntBig /* nVal1 */, GUIntBig /* nVal2 */)
+    {
+        return nullptr;
+    }
+
   public:
     VSIArchiveFilesystemHandler();
     virtual ~VSIArchiveFilesystemHandler();
@@ -469,4 +501,9 @@ VSIVirtualHandle *VSICreateGZipWritable(VSIVirtualHandle *poBaseHandle,
 
 VSIVirtualHandle *VSICreateUploadOnCloseFile(VSIVirtualHandle *poBaseHandle);
 
+VSIVirtualHandle *VSICreateIOStatsHandle(VSIVirtualHandle *poBaseHandle,
+                                         const char *pszFilename);
+VSIVirtualHandle *VSIIOStatsGetBaseHandle(VSIVirtualHandle *poHandle);
+void VSIIOStatsRecordStat(const char *pszFilename);
+
 #endif /* ndef CPL_VSI_VIRTUAL_H_INCLUDED */
@@ -827,6 +827,8 @@ int VSIStatExL(const char *pszFilename, VSIStatBufL *psStatBuf, int nFlags)
         nFlags =
             VSI_STAT_EXISTS_FLAG | VSI_STAT_NATURE_FLAG | VSI_STAT_SIZE_FLAG;
 
+    VSIIOStatsRecordStat(pszFilename);
+
     return poFSHandler->Stat(pszFilename, psStatBuf, nFlags);
 }
 
@@ -1905,8 +1907,10 @@ VSILFILE *VSIFOpenEx2L(const char *pszFilename, const char *pszAccess,
 
     VSIFilesystemHandler *poFSHandler = VSIFileManager::GetHandler(pszFilename);
 
-    VSILFILE *fp = poFSHandler->Open(pszFilename, pszAccess,
-                                     CPL_TO_BOOL(bSetError), papszOptions);
+    VSILFILE *fp = VSICreateIOStatsHandle(
+        poFSHandler->Open(pszFilename, pszAccess, CPL_TO_BOOL(bSetError),
+                          papszOptions),
+        pszFilename);
 
     VSIDebug4("VSIFOpenEx2L(%s,%s,%d) = %p", pszFilename, pszAccess, bSetError,
               fp);
@@ -3115,6 +3119,7 @@ VSIFileManager *VSIFileManager::Get()
     VSIInstallHdfsHandler();
     VSIInstallStdoutHandler();
     VSIInstallSparseFileHandler();
+    VSIInstallShmFileHandler();
     VSIInstallTarFileHandler();
     VSIInstallCryptFileHandler();
 
@@ -3209,6 +3214,7 @@ void VSICleanupFileManager()
 
 #ifdef HAVE_CURL
     cpl::VSICURLDestroyCacheFileProp();
+    cpl::VSICURLDestroyShareHandle();
 #endif
 }
 
@@ -33,15 +33,17 @@
 #if HAVE_SYS_STAT_H
 #include <sys/stat.h>
 #endif
+#include <algorithm>
 #include <ctime>
+#include <limits>
 #include <map>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_md5.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
@@ -83,6 +85,41 @@ VSIArchiveContent::~VSIArchiveContent()
     CPLFree(entries);
 }
 
+/************************************************************************/
+/*                             AddEntry()                               */
+/************************************************************************/
+
+// Takes ownership of pszFileName (allocated with CPLMalloc()) and poFilePos.
+void VSIArchiveContent::AddEntry(char *pszFileName, vsi_l_offset nSize,
+                                 VSIArchiveEntryFileOffset *poFilePos,
+                                 bool bIsDir, GIntBig nModifiedTime)
+{
+    if (nEntries == nEntriesAlloc)
+    {
+        nEntriesAlloc = std::max(16, nEntriesAlloc + nEntriesAlloc / 2);
+        entries = static_cast<VSIArchiveEntry *>(
+            CPLRealloc(entries, sizeof(VSIArchiveEntry) * nEntriesAlloc));
+    }
+    entries[nEntries].fileName = pszFileName;
+    entries[nEntries].uncompressed_size = nSize;
+    entries[nEntries].file_pos = poFilePos;
+    entries[nEntries].bIsDir = bIsDir;
+    entries[nEntries].nModifiedTime = nModifiedTime;
+#ifdef DEBUG_VERBOSE
+    CPLDebug("VSIArchive", "[%d] %s : " CPL_FRMT_GUIB " bytes", nEntries + 1,
+             pszFileName, nSize);
+#endif
+
+    oMapFileNameToEntry[pszFileName] = nEntries;
+    const char *pszLastSlash = strrchr(pszFileName, '/');
+    const std::string osDir =
+        pszLastSlash ? std::string(pszFileName, pszLastSlash - pszFileName)
+                     : std::string();
+    oMapDirToEntries[osDir].push_back(nEntries);
+
+    nEntries++;
+}
+
 /************************************************************************/
 /*                   VSIArchiveFilesystemHandler()                      */
 /************************************************************************/
@@ -146,6 +183,284 @@ static CPLString GetStrippedFilename(const CPLString &osFileName, bool &bIsDir)
     return osRet;
 }
 
+/************************************************************************/
+/*                        GetArchiveIndexName()                         */
+/************************************************************************/
+
+// Returns the name of the file in which the list of members of an archive
+// is persisted: <archive>.vsiidx, or a file in CPL_VSIL_ARCHIVE_INDEX_DIR
+// (useful when the archive is on a read-only or remote storage).
+static std::string GetArchiveIndexName(const char *archiveFilename)
+{
+    const char *pszIndexDir =
+        CPLGetConfigOption("CPL_VSIL_ARCHIVE_INDEX_DIR", nullptr);
+    if (pszIndexDir == nullptr || pszIndexDir[0] == '\0')
+        return std::string(archiveFilename).append(".vsiidx");
+    return CPLFormFilename(pszIndexDir,
+                           CPLSPrintf("%s.%s", CPLGetFilename(archiveFilename),
+                                      CPLMD5String(archiveFilename)),
+                           "vsiidx");
+}
+
+/************************************************************************/
+/*                         UseArchiveIndex()                            */
+/************************************************************************/
+
+static bool UseArchiveIndex(const char *archiveFilename)
+{
+    const char *pszUseIndex =
+        CPLGetConfigOption("CPL_VSIL_ARCHIVE_USE_INDEX", nullptr);
+    if (pszUseIndex != nullptr)
+        return CPLTestBool(pszUseIndex);
+    // By default, only look for an index next to local archives, to avoid
+    // a network request for each remote archive opened.
+    const char *pszIndexDir =
+        CPLGetConfigOption("CPL_VSIL_ARCHIVE_INDEX_DIR", nullptr);
+    return (pszIndexDir != nullptr && pszIndexDir[0] != '\0') ||
+           VSIIsLocal(archiveFilename);
+}
+
+// Layout of the index file (all integers are little-endian):
+// - signature "GDALAIDX", version (uint32), archive size (uint64), archive
+//   modification time (int64), number of entries (uint32)
+// - for each entry: name length (uint32), name (not nul-terminated),
+//   uncompressed size (uint64), modification time (int64), flags (uint8,
+//   bit 0 = directory, bit 1 = has file offset), and if bit 1 is set, the
+//   two integers describing the file offset (uint64 each).
+constexpr const char ARCHIVE_INDEX_SIGNATURE[] = "GDALAIDX";
+constexpr int ARCHIVE_INDEX_SIGNATURE_SIZE = 8;
+constexpr GUInt32 ARCHIVE_INDEX_VERSION = 1;
+constexpr GByte ARCHIVE_INDEX_FLAG_DIR = 1;
+constexpr GByte ARCHIVE_INDEX_FLAG_HAS_OFFSET = 2;
+
+/************************************************************************/
+/*                         WriteArchiveIndex()                          */
+/************************************************************************/
+
+void VSIArchiveFilesystemHandler::WriteArchiveIndex(
+    const char *archiveFilename, const VSIArchiveContent *content)
+{
+    std::string osBuffer;
+    const auto AddUInt32 = [&osBuffer](GUInt32 nVal)
+    {
+        CPL_LSBPTR32(&nVal);
+        osBuffer.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+    };
+    const auto AddUInt64 = [&osBuffer](GUInt64 nVal)
+    {
+        CPL_LSBPTR64(&nVal);
+        osBuffer.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+    };
+
+    osBuffer.append(ARCHIVE_INDEX_SIGNATURE, ARCHIVE_INDEX_SIGNATURE_SIZE);
+    AddUInt32(ARCHIVE_INDEX_VERSION);
+    AddUInt64(content->nFileSize);
+    AddUInt64(static_cast<GUInt64>(static_cast<GIntBig>(content->mTime)));
+    AddUInt32(static_cast<GUInt32>(content->nEntries));
+    for (int i = 0; i < content->nEntries; i++)
+    {
+        const VSIArchiveEntry &entry = content->entries[i];
+        const size_t nNameLen = strlen(entry.fileName);
+        AddUInt32(static_cast<GUInt32>(nNameLen));
+        osBuffer.append(entry.fileName, nNameLen);
+        AddUInt64(entry.uncompressed_size);
+        AddUInt64(static_cast<GUInt64>(entry.nModifiedTime));
+        GByte nFlags = entry.bIsDir ? ARCHIVE_INDEX_FLAG_DIR : 0;
+        GUIntBig nVal1 = 0;
+        GUIntBig nVal2 = 0;
+        if (entry.file_pos)
+        {
+            if (!GetFileOffsetAsIntegers(entry.file_pos, nVal1, nVal2))
+            {
+                CPLDebug("VSIArchive",
+                         "Cannot write index for %s: unsupported entry",
+                         archiveFilename);
+                return;
+            }
+            nFlags |= ARCHIVE_INDEX_FLAG_HAS_OFFSET;
+        }
+        osBuffer.append(1, static_cast<char>(nFlags));
+        if (nFlags & ARCHIVE_INDEX_FLAG_HAS_OFFSET)
+        {
+            AddUInt64(nVal1);
+            AddUInt64(nVal2);
+        }
+    }
+
+    const std::string osIndexFilename = GetArchiveIndexName(archiveFilename);
+    VSILFILE *fp = VSIFOpenL(osIndexFilename.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        CPLError(CE_Warning, CPLE_FileIO, "Cannot create %s",
+                 osIndexFilename.c_str());
+        return;
+    }
+    bool bOK =
+        VSIFWriteL(osBuffer.data(), osBuffer.size(), 1, fp) == 1;
+    bOK &= VSIFCloseL(fp) == 0;
+    if (!bOK)
+    {
+        CPLError(CE_Warning, CPLE_FileIO, "Error while writing %s",
+                 osIndexFilename.c_str());
+        VSIUnlink(osIndexFilename.c_str());
+    }
+    else
+    {
+        CPLDebug("VSIArchive", "Index of %s written in %s", archiveFilename,
+                 osIndexFilename.c_str());
+    }
+}
+
+/************************************************************************/
+/*                          ReadArchiveIndex()                          */
+/************************************************************************/
+
+VSIArchiveContent *
+VSIArchiveFilesystemHandler::ReadArchiveIndex(const char *archiveFilename,
+                                              const VSIStatBufL &sStat)
+{
+    const std::string osIndexFilename = GetArchiveIndexName(archiveFilename);
+    VSIStatBufL sStatIndex;
+    if (VSIStatExL(osIndexFilename.c_str(), &sStatIndex,
+                   VSI_STAT_EXISTS_FLAG) != 0)
+    {
+        return nullptr;
+    }
+
+    GByte *pabyData = nullptr;
+    vsi_l_offset nDataSize = 0;
+    if (!VSIIngestFile(nullptr, osIndexFilename.c_str(), &pabyData,
+                       &nDataSize, -1))
+    {
+        return nullptr;
+    }
+
+    const GByte *pabyIter = pabyData;
+    const GByte *const pabyEnd = pabyData + static_cast<size_t>(nDataSize);
+    bool bOK = true;
+    const auto GetUInt32 = [&pabyIter, pabyEnd, &bOK]()
+    {
+        GUInt32 nVal = 0;
+        if (pabyEnd - pabyIter < static_cast<ptrdiff_t>(sizeof(nVal)))
+        {
+            bOK = false;
+            return nVal;
+        }
+        memcpy(&nVal, pabyIter, sizeof(nVal));
+        CPL_LSBPTR32(&nVal);
+        pabyIter += sizeof(nVal);
+        return nVal;
+    };
+    const auto GetUInt64 = [&pabyIter, pabyEnd, &bOK]()
+    {
+        GUInt64 nVal = 0;
+        if (pabyEnd - pabyIter < static_cast<ptrdiff_t>(sizeof(nVal)))
+        {
+            bOK = false;
+            return nVal;
+        }
+        memcpy(&nVal, pabyIter, sizeof(nVal));
+        CPL_LSBPTR64(&nVal);
+        pabyIter += sizeof(nVal);
+        return nVal;
+    };
+
+    if (nDataSize < ARCHIVE_INDEX_SIGNATURE_SIZE ||
+        memcmp(pabyData, ARCHIVE_INDEX_SIGNATURE,
+               ARCHIVE_INDEX_SIGNATURE_SIZE) != 0)
+    {
+        CPLDebug("VSIArchive", "%s is not a valid archive index",
+                 osIndexFilename.c_str());
+        VSIFree(pabyData);
+        return nullptr;
+    }
+    pabyIter += ARCHIVE_INDEX_SIGNATURE_SIZE;
+
+    const GUInt32 nVersion = GetUInt32();
+    const GUInt64 nArchiveSize = GetUInt64();
+    const GIntBig nArchiveMTime = static_cast<GIntBig>(GetUInt64());
+    const GUInt32 nEntries = GetUInt32();
+    if (!bOK || nVersion != ARCHIVE_INDEX_VERSION)
+    {
+        CPLDebug("VSIArchive", "%s is not a valid archive index",
+                 osIndexFilename.c_str());
+        VSIFree(pabyData);
+        return nullptr;
+    }
+    if (nArchiveSize != static_cast<GUInt64>(sStat.st_size) ||
+        nArchiveMTime != static_cast<GIntBig>(sStat.st_mtime))
+    {
+        CPLDebug("VSIArchive", "%s is out of date compared to %s. Ignoring it",
+                 osIndexFilename.c_str(), archiveFilename);
+        VSIFree(pabyData);
+        return nullptr;
+    }
+    // Minimum size of an entry is 4 + 8 + 8 + 1 bytes
+    if (nEntries > static_cast<GUInt32>(std::numeric_limits<int>::max()) ||
+        nEntries > static_cast<size_t>(pabyEnd - pabyIter) / 21)
+    {
+        CPLDebug("VSIArchive", "%s is corrupted", osIndexFilename.c_str());
+        VSIFree(pabyData);
+        return nullptr;
+    }
+
+    auto content = new VSIArchiveContent;
+    content->mTime = sStat.st_mtime;
+    content->nFileSize = static_cast<vsi_l_offset>(sStat.st_size);
+    for (GUInt32 i = 0; bOK && i < nEntries; i++)
+    {
+        const GUInt32 nNameLen = GetUInt32();
+        if (!bOK || nNameLen == 0 ||
+            nNameLen > static_cast<size_t>(pabyEnd - pabyIter))
+        {
+            bOK = false;
+            break;
+        }
+        std::string osName(reinterpret_cast<const char *>(pabyIter),
+                           nNameLen);
+        pabyIter += nNameLen;
+        const GUInt64 nSize = GetUInt64();
+        const GIntBig nMTime = static_cast<GIntBig>(GetUInt64());
+        if (!bOK || pabyIter == pabyEnd ||
+            osName.find('\0') != std::string::npos ||
+            content->oMapFileNameToEntry.find(osName) !=
+                content->oMapFileNameToEntry.end())
+        {
+            bOK = false;
+            break;
+        }
+        const GByte nFlags = *pabyIter;
+        pabyIter++;
+        VSIArchiveEntryFileOffset *poFilePos = nullptr;
+        if (nFlags & ARCHIVE_INDEX_FLAG_HAS_OFFSET)
+        {
+            const GUInt64 nVal1 = GetUInt64();
+            const GUInt64 nVal2 = GetUInt64();
+            if (bOK)
+                poFilePos = CreateFileOffsetFromIntegers(nVal1, nVal2);
+            if (poFilePos == nullptr)
+            {
+                bOK = false;
+                break;
+            }
+        }
+        content->AddEntry(CPLStrdup(osName.c_str()), nSize, poFilePos,
+                          (nFlags & ARCHIVE_INDEX_FLAG_DIR) != 0, nMTime);
+    }
+    VSIFree(pabyData);
+
+    if (!bOK)
+    {
+        CPLDebug("VSIArchive", "%s is corrupted", osIndexFilename.c_str());
+        delete content;
+        return nullptr;
+    }
+
+    CPLDebug("VSIArchive", "Content of %s read from %s", archiveFilename,
+             osIndexFilename.c_str());
+    return content;
+}
+
 /************************************************************************/
 /*                       GetContentOfArchive()                          */
 /************************************************************************/
@@ -178,6 +493,16 @@ VSIArchiveFilesystemHandler::GetContentOfArchive(const char *archiveFilename,
         }
     }
 
+    if (UseArchiveIndex(archiveFilename))
+    {
+        VSIArchiveContent *content = ReadArchiveIndex(archiveFilename, sStat);
+        if (content)
+        {
+            oFileList[archiveFilename] = content;
+            return content;
+        }
+    }
+
     bool bMustClose = poReader == nullptr;
     if (poReader == nullptr)
     {
@@ -200,7 +525,7 @@ VSIArchiveFilesystemHandler::GetContentOfArchive(const char *archiveFilename,
     content->entries = nullptr;
     oFileList[archiveFilename] = content;
 
-    std::set<CPLString> oSet;
+    const auto &oMapFileNameToEntry = content->oMapFileNameToEntry;
 
     do
     {
@@ -214,10 +539,9 @@ VSIArchiveFilesystemHandler::GetContentOfArchive(const char *archiveFilename,
             continue;
         }
 
-        if (oSet.find(osStrippedFilename) == oSet.end())
+        if (oMapFileNameToEntry.find(osStrippedFilename) ==
+            oMapFileNameToEntry.end())
         {
-            oSet.insert(osStrippedFilename);
-
             // Add intermediate directory structure.
             const char *pszBegin = osStrippedFilename.c_str();
             for (const char *pszIter = pszBegin; *pszIter; pszIter++)
@@ -226,31 +550,11 @@ VSIArchiveFilesystemHandler::GetContentOfArchive(const char *archiveFilename,
                 {
                     char *pszStrippedFileName2 = CPLStrdup(osStrippedFilename);
                     pszStrippedFileName2[pszIter - pszBegin] = 0;
-                    if (oSet.find(pszStrippedFileName2) == oSet.end())
+                    if (oMapFileNameToEntry.find(pszStrippedFileName2) ==
+                        oMapFileNameToEntry.end())
                     {
-                        oSet.insert(pszStrippedFileName2);
-
-                        content->entries =
-                            static_cast<VSIArchiveEntry *>(CPLRealloc(
-                                content->entries, sizeof(VSIArchiveEntry) *
-                                                      (content->nEntries + 1)));
-                        content->entries[content->nEntries].fileName =
-                            pszStrippedFileName2;
-                        content->entries[content->nEntries].nModifiedTime =
-                            poReader->GetModifiedTime();
-                        content->entries[content->nEntries].uncompressed_size =
-                            0;
-                        content->entries[content->nEntries].bIsDir = TRUE;
-                        content->entries[content->nEntries].file_pos = nullptr;
-#ifdef DEBUG_VERBOSE
-                        const int nEntries = content->nEntries;
-                        CPLDebug("VSIArchive",
-                                 "[%d] %s : " CPL_FRMT_GUIB " bytes",
-                                 content->nEntries + 1,
-                                 content->entries[nEntries].fileName,
-                                 content->entries[nEntries].uncompressed_size);
-#endif
-                        content->nEntries++;
+                        content->AddEntry(pszStrippedFileName2, 0, nullptr,
+                                          true, poReader->GetModifiedTime());
                     }
                     else
                     {
@@ -259,25 +563,10 @@ VSIArchiveFilesystemHandler::GetContentOfArchive(const char *archiveFilename,
                 }
             }
 
-            content->entries = static_cast<VSIArchiveEntry *>(
-                CPLRealloc(content->entries,
-                           sizeof(VSIArchiveEntry) * (content->nEntries + 1)));
-            content->entries[content->nEntries].fileName =
-                CPLStrdup(osStrippedFilename);
-            content->entries[content->nEntries].nModifiedTime =
-                poReader->GetModifiedTime();
-            content->entries[content->nEntries].uncompressed_size =
-                poReader->GetFileSize();
-            content->entries[content->nEntries].bIsDir = bIsDir;
-            content->entries[content->nEntries].file_pos =
-                poReader->GetFileOffset();
-#ifdef DEBUG_VERBOSE
-            CPLDebug("VSIArchive", "[%d] %s : " CPL_FRMT_GUIB " bytes",
-                     content->nEntries + 1,
-                     content->entries[content->nEntries].fileName,
-                     content->entries[content->nEntries].uncompressed_size);
-#endif
-            content->nEntries++;
+            content->AddEntry(CPLStrdup(osStrippedFilename),
+                              poReader->GetFileSize(),
+                              poReader->GetFileOffset(), bIsDir,
+                              poReader->GetModifiedTime());
         }
 
     } while (poReader->GotoNextFile());
@@ -285,6 +574,12 @@ VSIArchiveFilesystemHandler::GetContentOfArchive(const char *archiveFilename,
     if (bMustClose)
         delete (poReader);
 
+    if (CPLTestBool(
+            CPLGetConfigOption("CPL_VSIL_ARCHIVE_WRITE_INDEX", "NO")))
+    {
+        WriteArchiveIndex(archiveFilename, content);
+    }
+
     return content;
 }
 
@@ -302,14 +597,13 @@ int VSIArchiveFilesystemHandler::FindFileInArchive(
     const VSIArchiveContent *content = GetContentOfArchive(archiveFilename);
     if (content)
     {
-        for (int i = 0; i < content->nEntries; i++)
+        const auto oIter =
+            content->oMapFileNameToEntry.find(fileInArchiveName);
+        if (oIter != content->oMapFileNameToEntry.end())
         {
-            if (strcmp(fileInArchiveName, content->entries[i].fileName) == 0)
-            {
-                if (archiveEntry)
-                    *archiveEntry = &content->entries[i];
-                return TRUE;
-            }
+            if (archiveEntry)
+                *archiveEntry = &content->entries[oIter->second];
+            return TRUE;
         }
     }
     return FALSE;
@@ -832,46 +1126,24 @@ char **VSIArchiveFilesystemHandler::ReadDirEx(const char *pszDirname,
 #ifdef DEBUG_VERBOSE
     CPLDebug("VSIArchive", "Read dir %s", pszDirname);
 #endif
-    for (int i = 0; i < content->nEntries; i++)
+    // Only list entries at the same level of inArchiveSubDir
+    const auto oIter = content->oMapDirToEntries.find(osInArchiveSubDir);
+    if (oIter != content->oMapDirToEntries.end())
     {
-        const char *fileName = content->entries[i].fileName;
-        /* Only list entries at the same level of inArchiveSubDir */
-        if (lenInArchiveSubDir != 0 &&
-            strncmp(fileName, osInArchiveSubDir, lenInArchiveSubDir) == 0 &&
-            IsEitherSlash(fileName[lenInArchiveSubDir]) &&
-            fileName[lenInArchiveSubDir + 1] != 0)
-        {
-            const char *slash = strchr(fileName + lenInArchiveSubDir + 1, '/');
-            if (slash == nullptr)
-                slash = strchr(fileName + lenInArchiveSubDir + 1, '\\');
-            if (slash == nullptr || slash[1] == 0)
-            {
-                char *tmpFileName = CPLStrdup(fileName);
-                if (slash != nullptr)
-                {
-                    tmpFileName[strlen(tmpFileName) - 1] = 0;
-                }
-#ifdef DEBUG_VERBOSE
-                CPLDebug("VSIArchive", "Add %s as in directory %s",
-                         tmpFileName + lenInArchiveSubDir + 1, pszDirname);
-#endif
-                oDir.AddString(tmpFileName + lenInArchiveSubDir + 1);
-                CPLFree(tmpFileName);
-            }
-        }
-        else if (lenInArchiveSubDir == 0 && strchr(fileName, '/') == nullptr &&
-                 strchr(fileName, '\\') == nullptr)
+        for (const int iEntry : oIter->second)
         {
-            // Only list toplevel files and directories.
+            const char *fileName = content->entries[iEntry].fileName;
+            if (lenInArchiveSubDir != 0)
+                fileName += lenInArchiveSubDir + 1;
 #ifdef DEBUG_VERBOSE
             CPLDebug("VSIArchive", "Add %s as in directory %s", fileName,
                      pszDirname);
 #endif
             oDir.AddString(fileName);
-        }
 
-        if (nMaxFiles > 0 && oDir.Count() > nMaxFiles)
-            break;
+            if (nMaxFiles > 0 && oDir.Count() > nMaxFiles)
+                break;
+        }
     }
 
     CPLFree(archiveFilename);
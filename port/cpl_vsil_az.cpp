@@ -566,6 +566,16 @@ class VSIAzureFSHandler final : public IVSIS3LikeFSHandler
         return true;
     }
 
+    int GetUploadChunkSizeInBytes(const char * /* pszFilename */) override
+    {
+        return GetAzureBufferSize();
+    }
+
+    int GetMaximumPartCount() const override
+    {
+        return 50000;  // Limitation from Azure for block blobs
+    }
+
     bool SupportsSequentialWrite(const char * /* pszPath */,
                                  bool /* bAllowLocalTempFile */) override
     {
@@ -1366,8 +1376,28 @@ VSIVirtualHandle *VSIAzureFSHandler::Open(const char *pszFilename,
                 pszFilename + GetFSPrefix().size(), GetFSPrefix().c_str());
         if (poHandleHelper == nullptr)
             return nullptr;
-        auto poHandle = new VSIAzureWriteHandle(this, pszFilename,
-                                                poHandleHelper, papszOptions);
+        VSIVirtualHandle *poHandle;
+        if (atoi(VSIGetPathSpecificOption(
+                pszFilename, "CPL_VSIL_CURL_UPLOAD_NUM_THREADS", "0")) > 0)
+        {
+            // Parts can only be uploaded in parallel as the blocks of a
+            // block blob, not as appends to an append blob.
+            CPLStringList aosOptions(papszOptions);
+            aosOptions.SetNameValue("x-ms-blob-type", "BlockBlob");
+            auto poS3LikeHandle = new VSIS3WriteHandle(
+                this, pszFilename, poHandleHelper, false, aosOptions.List());
+            if (!poS3LikeHandle->IsOK())
+            {
+                delete poS3LikeHandle;
+                return nullptr;
+            }
+            poHandle = poS3LikeHandle;
+        }
+        else
+        {
+            poHandle = new VSIAzureWriteHandle(this, pszFilename,
+                                               poHandleHelper, papszOptions);
+        }
         if (strchr(pszAccess, '+') != nullptr)
         {
             return VSICreateUploadOnCloseFile(poHandle);
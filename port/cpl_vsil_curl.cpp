@@ -32,9 +32,11 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <set>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "cpl_aws.h"
 #include "cpl_json.h"
@@ -195,6 +197,28 @@ static int GetMaxRegions()
     return N_MAX_REGIONS_DO_NOT_USE_DIRECTLY;
 }
 
+/************************************************************************/
+/*                      IsMetadataCacheExpired()                        */
+/************************************************************************/
+
+// Whether a cached file property or directory listing inserted at
+// oCachedTime must be discarded, according to CPL_VSIL_CURL_METADATA_CACHE_TTL
+// (or CPL_VSIL_CURL_NEGATIVE_CACHE_TTL for a non-existing file).
+// A TTL of 0 means no expiration. Fractional values are accepted.
+static bool
+IsMetadataCacheExpired(std::chrono::steady_clock::time_point oCachedTime,
+                       bool bNegative)
+{
+    const char *pszTTL =
+        CPLGetConfigOption("CPL_VSIL_CURL_METADATA_CACHE_TTL", "0");
+    if (bNegative)
+        pszTTL = CPLGetConfigOption("CPL_VSIL_CURL_NEGATIVE_CACHE_TTL", pszTTL);
+    const double dfTTL = CPLAtof(pszTTL);
+    return dfTTL > 0 && std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - oCachedTime)
+                                .count() >= dfTTL;
+}
+
 /************************************************************************/
 /*          VSICurlFindStringSensitiveExceptEscapeSequences()           */
 /************************************************************************/
@@ -813,6 +837,36 @@ static GIntBig VSICurlGetExpiresFromS3LikeSignedURL(const char *pszURL)
     return CPLYMDHMSToUnixTime(&brokendowntime) + nDelay;
 }
 
+/************************************************************************/
+/*                       LogConnectionStatistics()                      */
+/************************************************************************/
+
+// Log whether a completed transfer reused a connection, and the time spent
+// in establishing it.
+static void LogConnectionStatistics(CURL *hEasyHandle)
+{
+    if (!NetworkStatisticsLogger::IsEnabled())
+        return;
+    long nNewConnections = 0;
+    double dfNameLookupTime = 0;
+    double dfConnectTime = 0;
+    double dfAppConnectTime = 0;
+    double dfStartTransferTime = 0;
+    curl_easy_getinfo(hEasyHandle, CURLINFO_NUM_CONNECTS, &nNewConnections);
+    curl_easy_getinfo(hEasyHandle, CURLINFO_NAMELOOKUP_TIME,
+                      &dfNameLookupTime);
+    curl_easy_getinfo(hEasyHandle, CURLINFO_CONNECT_TIME, &dfConnectTime);
+    curl_easy_getinfo(hEasyHandle, CURLINFO_APPCONNECT_TIME,
+                      &dfAppConnectTime);
+    curl_easy_getinfo(hEasyHandle, CURLINFO_STARTTRANSFER_TIME,
+                      &dfStartTransferTime);
+    NetworkStatisticsLogger::LogConnection(
+        nNewConnections, dfNameLookupTime,
+        dfAppConnectTime > dfConnectTime ? dfAppConnectTime - dfConnectTime
+                                         : 0.0,
+        dfStartTransferTime);
+}
+
 /************************************************************************/
 /*                           MultiPerform()                             */
 /************************************************************************/
@@ -833,12 +887,7 @@ void MultiPerform(CURLM *hCurlMultiHandle, CURL *hEasyHandle)
         {
             // loop
         }
-        if (!still_running)
-        {
-            break;
-        }
 
-#ifdef undef
         CURLMsg *msg;
         do
         {
@@ -846,10 +895,14 @@ void MultiPerform(CURLM *hCurlMultiHandle, CURL *hEasyHandle)
             msg = curl_multi_info_read(hCurlMultiHandle, &msgq);
             if (msg && (msg->msg == CURLMSG_DONE))
             {
-                CURL *e = msg->easy_handle;
+                LogConnectionStatistics(msg->easy_handle);
             }
         } while (msg);
-#endif
+
+        if (!still_running)
+        {
+            break;
+        }
 
         CPLMultiPerformWait(hCurlMultiHandle, repeats);
     }
@@ -1622,6 +1675,12 @@ std::string VSICurlHandle::DownloadRegion(const vsi_l_offset startOffset,
     CPLString osURL(GetRedirectURLIfValid(bHasExpired));
     bool bUsedRedirect = osURL != m_pszURL;
 
+    {
+        std::string osRet;
+        if (DownloadRegionParallel(osURL, startOffset, nBlocks, osRet))
+            return osRet;
+    }
+
     WriteFuncStruct sWriteFuncData;
     WriteFuncStruct sWriteFuncHeaderData;
     int nRetryCount = 0;
@@ -1900,6 +1959,427 @@ retry:
     return osRet;
 }
 
+/************************************************************************/
+/*                       RecordRangeLatency()                           */
+/************************************************************************/
+
+// History, per host, of the time to first byte of recent range requests
+// issued by DownloadRegionParallel(), used to derive the delay after which a
+// hedged request is issued.
+constexpr size_t HEDGE_LATENCY_HISTORY_SIZE = 100;
+constexpr size_t HEDGE_LATENCY_MIN_SAMPLES = 20;
+
+struct HedgeLatencyHistory
+{
+    std::vector<double> adfLatencies{};
+    size_t nIdx = 0;
+};
+
+static std::mutex goHedgeLatencyMutex;
+static std::map<std::string, HedgeLatencyHistory> goMapHedgeLatencies;
+
+// Returns "http://example.com:8080" for "http://example.com:8080/foo/bar"
+static std::string GetHedgeLatencyKey(const std::string &osURL)
+{
+    const auto nSchemePos = osURL.find("://");
+    if (nSchemePos == std::string::npos)
+        return osURL;
+    return osURL.substr(0, osURL.find('/', nSchemePos + strlen("://")));
+}
+
+static void RecordRangeLatency(const std::string &osURL, double dfLatency)
+{
+    std::lock_guard<std::mutex> oLock(goHedgeLatencyMutex);
+    auto &oHistory = goMapHedgeLatencies[GetHedgeLatencyKey(osURL)];
+    if (oHistory.adfLatencies.size() < HEDGE_LATENCY_HISTORY_SIZE)
+    {
+        oHistory.adfLatencies.push_back(dfLatency);
+    }
+    else
+    {
+        oHistory.adfLatencies[oHistory.nIdx] = dfLatency;
+        oHistory.nIdx = (oHistory.nIdx + 1) % HEDGE_LATENCY_HISTORY_SIZE;
+    }
+}
+
+/************************************************************************/
+/*                           GetHedgeDelay()                            */
+/************************************************************************/
+
+// Returns the delay, in seconds, after which a duplicate of a range request
+// to the host of osURL that has not received any data yet is issued, or 0 if
+// it is not known yet.
+static double GetHedgeDelay(const std::string &osURL)
+{
+    const char *pszDelay =
+        CPLGetConfigOption("CPL_VSIL_CURL_HEDGE_DELAY", nullptr);
+    if (pszDelay)
+        return std::max(0.0, CPLAtof(pszDelay));
+
+    const double dfPercentile = std::min(
+        100.0, std::max(0.0, CPLAtof(CPLGetConfigOption(
+                                 "CPL_VSIL_CURL_HEDGE_PERCENTILE", "95"))));
+    std::vector<double> adfLatencies;
+    {
+        std::lock_guard<std::mutex> oLock(goHedgeLatencyMutex);
+        const auto oIter =
+            goMapHedgeLatencies.find(GetHedgeLatencyKey(osURL));
+        if (oIter != goMapHedgeLatencies.end())
+            adfLatencies = oIter->second.adfLatencies;
+    }
+    if (adfLatencies.size() < HEDGE_LATENCY_MIN_SAMPLES)
+        return 0;
+    const size_t nIdx =
+        std::min(adfLatencies.size() - 1,
+                 static_cast<size_t>(dfPercentile / 100 * adfLatencies.size()));
+    std::nth_element(adfLatencies.begin(), adfLatencies.begin() + nIdx,
+                     adfLatencies.end());
+    return adfLatencies[nIdx];
+}
+
+/************************************************************************/
+/*                       DownloadRegionParallel()                       */
+/************************************************************************/
+
+// Download the region with several concurrent range requests when
+// CPL_VSIL_CURL_PARALLEL_RANGE_COUNT > 1, and/or issue a duplicate of a
+// request that has not received any data after the hedge delay, the first
+// complete response winning. Returns false if the region must be downloaded
+// through the regular code path (not applicable, or failure).
+bool VSICurlHandle::DownloadRegionParallel(const CPLString &osURL,
+                                           const vsi_l_offset startOffset,
+                                           const int nBlocks,
+                                           std::string &osRet)
+{
+    if (pfnReadCbk != nullptr || !oFileProp.bHasComputedFileSize ||
+        startOffset >= oFileProp.fileSize || !STARTS_WITH(osURL, "http"))
+    {
+        return false;
+    }
+
+    const int nParallelCount =
+        atoi(CPLGetConfigOption("CPL_VSIL_CURL_PARALLEL_RANGE_COUNT", "1"));
+    const bool bHedging = CPLTestBool(
+        CPLGetConfigOption("CPL_VSIL_CURL_HEDGED_REQUESTS", "NO"));
+    if (nParallelCount <= 1 && !bHedging)
+        return false;
+
+    const int nChunkSize = VSICURLGetDownloadChunkSize();
+    const vsi_l_offset nEndOffset =
+        std::min(startOffset + static_cast<vsi_l_offset>(nBlocks) * nChunkSize,
+                 oFileProp.fileSize);
+
+    int nParts = 1;
+    if (nParallelCount > 1)
+    {
+        const vsi_l_offset nMinPartSize = std::max(
+            static_cast<vsi_l_offset>(nChunkSize),
+            static_cast<vsi_l_offset>(CPLAtoGIntBig(CPLGetConfigOption(
+                "CPL_VSIL_CURL_PARALLEL_RANGE_MIN_SIZE", "1048576"))));
+        nParts = static_cast<int>(
+            std::min(static_cast<vsi_l_offset>(nParallelCount),
+                     (nEndOffset - startOffset) / nMinPartSize));
+        nParts = std::max(1, nParts);
+    }
+    if (nParts == 1 && !bHedging)
+        return false;
+
+    const double dfHedgeDelay = bHedging ? GetHedgeDelay(osURL) : 0.0;
+
+    // Sub-ranges are aligned on chunk boundaries, last one being possibly
+    // truncated at end of file. They are computed from the number of chunks
+    // of the range clamped at end of file, so that none of them starts past
+    // it.
+    const int nClampedBlocks = static_cast<int>(
+        (nEndOffset - startOffset + nChunkSize - 1) / nChunkSize);
+    struct RangePart
+    {
+        vsi_l_offset nStart = 0;
+        vsi_l_offset nEnd = 0;  // inclusive
+        std::string osData{};
+        bool bDone = false;
+        bool bHedged = false;
+    };
+    std::vector<RangePart> aoParts(nParts);
+    for (int i = 0; i < nParts; ++i)
+    {
+        aoParts[i].nStart =
+            startOffset +
+            static_cast<vsi_l_offset>(nClampedBlocks / nParts * i) *
+                nChunkSize;
+        aoParts[i].nEnd =
+            i + 1 < nParts
+                ? startOffset +
+                      static_cast<vsi_l_offset>(nClampedBlocks / nParts *
+                                                (i + 1)) *
+                          nChunkSize -
+                      1
+                : nEndOffset - 1;
+    }
+
+    struct RangeRequest
+    {
+        size_t iPart = 0;
+        CURL *hCurlHandle = nullptr;
+        struct curl_slist *headers = nullptr;
+        WriteFuncStruct sWriteFuncData{};
+        WriteFuncStruct sWriteFuncHeaderData{};
+        std::array<char, CURL_ERROR_SIZE + 1> szCurlErrBuf{};
+        std::chrono::steady_clock::time_point oStart{};
+    };
+    std::vector<std::unique_ptr<RangeRequest>> apoRequests;
+
+    CURLM *hMultiHandle = poFS->GetCurlMultiHandleFor(osURL);
+
+    const auto StartRequest = [this, &osURL, &aoParts, &apoRequests,
+                               hMultiHandle](size_t iPart)
+    {
+        auto poReq = cpl::make_unique<RangeRequest>();
+        poReq->iPart = iPart;
+        poReq->hCurlHandle = curl_easy_init();
+        CURL *hCurlHandle = poReq->hCurlHandle;
+
+        struct curl_slist *headers =
+            VSICurlSetOptions(hCurlHandle, osURL, m_papszHTTPOptions);
+
+        VSICURLInitWriteFuncStruct(&poReq->sWriteFuncData, this, nullptr,
+                                   nullptr);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA,
+                                   &poReq->sWriteFuncData);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEFUNCTION,
+                                   VSICurlHandleWriteFunc);
+
+        VSICURLInitWriteFuncStruct(&poReq->sWriteFuncHeaderData, nullptr,
+                                   nullptr, nullptr);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERDATA,
+                                   &poReq->sWriteFuncHeaderData);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERFUNCTION,
+                                   VSICurlHandleWriteFunc);
+        poReq->sWriteFuncHeaderData.bIsHTTP = true;
+        poReq->sWriteFuncHeaderData.nStartOffset = aoParts[iPart].nStart;
+        poReq->sWriteFuncHeaderData.nEndOffset = aoParts[iPart].nEnd;
+
+        CPLString osHeaderRange;
+        osHeaderRange.Printf("Range: bytes=" CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
+                             aoParts[iPart].nStart, aoParts[iPart].nEnd);
+        if (ENABLE_DEBUG)
+            CPLDebug(poFS->GetDebugKey(), "Downloading %s (%s)...",
+                     osHeaderRange.c_str() + strlen("Range: bytes="),
+                     osURL.c_str());
+        // So it gets included in Azure signature
+        headers = curl_slist_append(headers, osHeaderRange.c_str());
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, nullptr);
+
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_ERRORBUFFER,
+                                   &poReq->szCurlErrBuf[0]);
+
+        headers = VSICurlMergeHeaders(headers, GetCurlHeaders("GET", headers));
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
+        poReq->headers = headers;
+
+        poReq->oStart = std::chrono::steady_clock::now();
+        curl_multi_add_handle(hMultiHandle, hCurlHandle);
+        apoRequests.push_back(std::move(poReq));
+    };
+
+    const auto FinishRequest = [&apoRequests, hMultiHandle](size_t iReq)
+    {
+        RangeRequest *poReq = apoRequests[iReq].get();
+        curl_multi_remove_handle(hMultiHandle, poReq->hCurlHandle);
+        VSICURLResetHeaderAndWriterFunctions(poReq->hCurlHandle);
+        curl_easy_cleanup(poReq->hCurlHandle);
+        curl_slist_free_all(poReq->headers);
+        CPLFree(poReq->sWriteFuncData.pBuffer);
+        CPLFree(poReq->sWriteFuncHeaderData.pBuffer);
+        apoRequests.erase(apoRequests.begin() + iReq);
+    };
+
+    for (int i = 0; i < nParts; ++i)
+        StartRequest(i);
+
+    bool bOK = true;
+    int nPartsDone = 0;
+    void *old_handler = CPLHTTPIgnoreSigPipe();
+    while (bOK && nPartsDone < nParts)
+    {
+        int still_running = 0;
+        while (curl_multi_perform(hMultiHandle, &still_running) ==
+               CURLM_CALL_MULTI_PERFORM)
+        {
+            // loop
+        }
+
+        CURLMsg *msg;
+        int msgq = 0;
+        while ((msg = curl_multi_info_read(hMultiHandle, &msgq)) != nullptr)
+        {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+            LogConnectionStatistics(msg->easy_handle);
+
+            size_t iReq = 0;
+            while (iReq < apoRequests.size() &&
+                   apoRequests[iReq]->hCurlHandle != msg->easy_handle)
+                ++iReq;
+            if (iReq == apoRequests.size())
+                continue;
+            const RangeRequest *poReq = apoRequests[iReq].get();
+            const size_t iPart = poReq->iPart;
+            RangePart &oPart = aoParts[iPart];
+
+            long response_code = 0;
+            curl_easy_getinfo(poReq->hCurlHandle, CURLINFO_HTTP_CODE,
+                              &response_code);
+            if (msg->data.result == CURLE_OK && response_code == 206 &&
+                !poReq->sWriteFuncHeaderData.bError &&
+                poReq->sWriteFuncData.nSize == oPart.nEnd - oPart.nStart + 1)
+            {
+                double dfStartTransferTime = 0;
+                curl_easy_getinfo(poReq->hCurlHandle,
+                                  CURLINFO_STARTTRANSFER_TIME,
+                                  &dfStartTransferTime);
+                RecordRangeLatency(osURL, dfStartTransferTime);
+
+                oPart.osData.assign(poReq->sWriteFuncData.pBuffer,
+                                    poReq->sWriteFuncData.nSize);
+                oPart.bDone = true;
+                ++nPartsDone;
+                FinishRequest(iReq);
+
+                // Cancel the other request for the same range, if hedged
+                for (size_t j = 0; j < apoRequests.size();)
+                {
+                    if (apoRequests[j]->iPart == iPart)
+                    {
+                        NetworkStatisticsLogger::LogHedgedDuplicateBytes(
+                            apoRequests[j]->sWriteFuncData.nSize);
+                        CPLDebug(poFS->GetDebugKey(),
+                                 "Cancelling hedged request for range "
+                                 CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
+                                 oPart.nStart, oPart.nEnd);
+                        FinishRequest(j);
+                    }
+                    else
+                    {
+                        ++j;
+                    }
+                }
+            }
+            else
+            {
+                CPLDebug(poFS->GetDebugKey(),
+                         "DownloadRegionParallel(%s), " CPL_FRMT_GUIB
+                         "-" CPL_FRMT_GUIB ": response_code=%d, msg=%s",
+                         osURL.c_str(), oPart.nStart, oPart.nEnd,
+                         static_cast<int>(response_code),
+                         &poReq->szCurlErrBuf[0]);
+                FinishRequest(iReq);
+                // Failure is only fatal if there is no other request
+                // in flight for that range
+                if (!oPart.bDone &&
+                    std::none_of(apoRequests.begin(), apoRequests.end(),
+                                 [iPart](const std::unique_ptr<RangeRequest>
+                                             &poOtherReq)
+                                 { return poOtherReq->iPart == iPart; }))
+                {
+                    bOK = false;
+                }
+            }
+        }
+        if (!bOK || nPartsDone == nParts)
+            break;
+        if (apoRequests.empty())
+        {
+            bOK = false;
+            break;
+        }
+
+        // Issue hedged requests for ranges that have not received any data
+        // after the hedge delay, and otherwise wait until the nearest
+        // deadline.
+        int nTimeoutMs = 1000;
+        if (dfHedgeDelay > 0)
+        {
+            const auto oNow = std::chrono::steady_clock::now();
+            const size_t nRequests = apoRequests.size();
+            for (size_t j = 0; j < nRequests; ++j)
+            {
+                const size_t iPart = apoRequests[j]->iPart;
+                if (aoParts[iPart].bHedged ||
+                    apoRequests[j]->sWriteFuncData.nSize != 0)
+                {
+                    continue;
+                }
+                const double dfElapsed =
+                    std::chrono::duration<double>(oNow -
+                                                  apoRequests[j]->oStart)
+                        .count();
+                if (dfElapsed >= dfHedgeDelay)
+                {
+                    CPLDebug(poFS->GetDebugKey(),
+                             "No data received for range " CPL_FRMT_GUIB
+                             "-" CPL_FRMT_GUIB " after %.3f s. "
+                             "Issuing hedged request",
+                             aoParts[iPart].nStart, aoParts[iPart].nEnd,
+                             dfElapsed);
+                    aoParts[iPart].bHedged = true;
+                    NetworkStatisticsLogger::LogHedgedRequest();
+                    StartRequest(iPart);
+                    nTimeoutMs = 0;
+                }
+                else
+                {
+                    nTimeoutMs = std::min(
+                        nTimeoutMs,
+                        static_cast<int>((dfHedgeDelay - dfElapsed) * 1000) +
+                            1);
+                }
+            }
+        }
+
+        if (nTimeoutMs > 0)
+        {
+#if CURL_AT_LEAST_VERSION(7, 28, 0)
+            int numfds = 0;
+            if (curl_multi_wait(hMultiHandle, nullptr, 0, nTimeoutMs,
+                                &numfds) != CURLM_OK)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "curl_multi_wait() failed");
+                bOK = false;
+            }
+#else
+            int repeats = 0;
+            CPLMultiPerformWait(hMultiHandle, repeats);
+#endif
+        }
+    }
+    CPLHTTPRestoreSigPipeHandler(old_handler);
+
+    while (!apoRequests.empty())
+        FinishRequest(apoRequests.size() - 1);
+
+    if (!bOK)
+    {
+        CPLDebug(poFS->GetDebugKey(),
+                 "Parallel download of " CPL_FRMT_GUIB "-" CPL_FRMT_GUIB
+                 " failed. Retrying with a single request",
+                 startOffset, nEndOffset - 1);
+        return false;
+    }
+
+    osRet.clear();
+    osRet.reserve(static_cast<size_t>(nEndOffset - startOffset));
+    for (const auto &oPart : aoParts)
+        osRet += oPart.osData;
+
+    NetworkStatisticsLogger::LogGET(osRet.size());
+
+    DownloadRegionPostProcess(startOffset, nBlocks, osRet.data(),
+                              osRet.size());
+    return true;
+}
+
 /************************************************************************/
 /*                      UpdateRedirectInfo()                            */
 /************************************************************************/
@@ -2016,6 +2496,9 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
     vsi_l_offset iterOffset = curOffset;
     const int knMAX_REGIONS = GetMaxRegions();
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    const bool bMergeConcurrentReads =
+        m_bCached && CPLTestBool(CPLGetConfigOption(
+                         "CPL_VSIL_CURL_MERGE_CONCURRENT_READS", "YES"));
     while (nBufferRequestSize)
     {
         // Don't try to read after end of file.
@@ -2037,6 +2520,12 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
         std::string osRegion;
         std::shared_ptr<std::string> psRegion =
             poFS->GetRegion(m_pszURL, nOffsetToDownload);
+        if (psRegion == nullptr && bMergeConcurrentReads &&
+            poFS->WaitForDownloadInProgress(m_pszURL, nOffsetToDownload))
+        {
+            // Another thread was downloading the block: reuse its result.
+            psRegion = poFS->GetRegion(m_pszURL, nOffsetToDownload);
+        }
         if (psRegion != nullptr)
         {
             osRegion = *psRegion;
@@ -2051,11 +2540,25 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
                 // client/server roundtrips.
                 if (nBlocksToDownload < 100)
                     nBlocksToDownload *= 2;
+                m_nSequentialDownloads++;
+            }
+            else if (m_nSequentialDownloads >= 2 &&
+                     lastDownloadedOffset != VSI_L_OFFSET_MAX &&
+                     nOffsetToDownload > lastDownloadedOffset &&
+                     nOffsetToDownload - lastDownloadedOffset <=
+                         static_cast<vsi_l_offset>(nBlocksToDownload) *
+                             knDOWNLOAD_CHUNK_SIZE)
+            {
+                // Once sequential reading has been detected, forward reads
+                // skipping less than the current read-ahead size (e.g.
+                // streaming through data interleaved with unneeded parts)
+                // keep the current read-ahead size.
             }
             else
             {
                 // Random reads. Cancel the above heuristics.
                 nBlocksToDownload = 1;
+                m_nSequentialDownloads = 0;
             }
 
             // Ensure that we will request at least the number of blocks
@@ -2087,7 +2590,20 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
             if (nBlocksToDownload > knMAX_REGIONS)
                 nBlocksToDownload = knMAX_REGIONS;
 
-            osRegion = DownloadRegion(nOffsetToDownload, nBlocksToDownload);
+            if (bMergeConcurrentReads)
+            {
+                // Do not download blocks being downloaded by other threads,
+                // and let them wait for ours.
+                const int nBlocks = poFS->RegisterDownloadInProgress(
+                    m_pszURL, nOffsetToDownload, nBlocksToDownload);
+                osRegion = DownloadRegion(nOffsetToDownload, nBlocks);
+                poFS->UnregisterDownloadInProgress(m_pszURL, nOffsetToDownload,
+                                                   nBlocks);
+            }
+            else
+            {
+                osRegion = DownloadRegion(nOffsetToDownload, nBlocksToDownload);
+            }
             if (osRegion.empty())
             {
                 if (!bInterrupted)
@@ -3239,6 +3755,7 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
                 msg = curl_multi_info_read(hMultiHandle, &msgq);
                 if (msg && (msg->msg == CURLMSG_DONE))
                 {
+                    LogConnectionStatistics(msg->easy_handle);
                     DealWithRequest(msg->easy_handle);
                 }
             } while (msg);
@@ -3428,6 +3945,25 @@ bool VSICurlFilesystemHandlerBase::AllowCachedDataFor(const char *pszFilename)
     return bCachedAllowed;
 }
 
+/************************************************************************/
+/*                      UseDirListingForStat()                          */
+/************************************************************************/
+
+// Whether Stat() must answer for a file from the listing of its directory,
+// fetched once and cached, instead of issuing a request per file. This
+// saves a round-trip per probe of a missing side-car file.
+bool VSICurlFilesystemHandlerBase::UseDirListingForStat(
+    const char *pszFilename)
+{
+    const char *pszDisableReadDir = VSIGetPathSpecificOption(
+        pszFilename, "GDAL_DISABLE_READDIR_ON_OPEN", "NO");
+    return !EQUAL(pszDisableReadDir, "EMPTY_DIR") &&
+           !CPLTestBool(pszDisableReadDir) &&
+           CPLTestBool(VSIGetPathSpecificOption(
+               pszFilename, "CPL_VSIL_CURL_STAT_USE_DIR_LISTING", "NO")) &&
+           AllowCachedDataFor(pszFilename);
+}
+
 /************************************************************************/
 /*                     GetCurlMultiHandleFor()                          */
 /************************************************************************/
@@ -3439,6 +3975,24 @@ VSICurlFilesystemHandlerBase::GetCurlMultiHandleFor(const CPLString & /*osURL*/)
     if (conn.hCurlMultiHandle == nullptr)
     {
         conn.hCurlMultiHandle = curl_multi_init();
+
+        // Note that those limits apply to the multi handle of the current
+        // thread for this file system, and not process-wide.
+        const char *pszMaxHostConnections =
+            CPLGetConfigOption("CPL_VSIL_CURL_MAX_HOST_CONNECTIONS", nullptr);
+        if (pszMaxHostConnections)
+        {
+            curl_multi_setopt(conn.hCurlMultiHandle,
+                              CURLMOPT_MAX_HOST_CONNECTIONS,
+                              static_cast<long>(atoi(pszMaxHostConnections)));
+        }
+        const char *pszMaxCachedConnections = CPLGetConfigOption(
+            "CPL_VSIL_CURL_MAX_CACHED_CONNECTIONS", nullptr);
+        if (pszMaxCachedConnections)
+        {
+            curl_multi_setopt(conn.hCurlMultiHandle, CURLMOPT_MAXCONNECTS,
+                              static_cast<long>(atoi(pszMaxCachedConnections)));
+        }
     }
     return conn.hCurlMultiHandle;
 }
@@ -3499,6 +4053,87 @@ void VSICurlFilesystemHandlerBase::AddRegion(const char *pszURL,
         FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
 }
 
+/************************************************************************/
+/*                     WaitForDownloadInProgress()                      */
+/************************************************************************/
+
+// Waits for the completion of the downloads in progress of the block
+// starting at nFileOffsetStart. Returns whether there was one.
+bool VSICurlFilesystemHandlerBase::WaitForDownloadInProgress(
+    const char *pszURL, vsi_l_offset nFileOffsetStart)
+{
+    std::unique_lock<std::mutex> oLock(m_oMutexDownloadsInProgress);
+    const auto oKey = std::make_pair(std::string(pszURL), nFileOffsetStart);
+    if (m_oMapDownloadsInProgress.find(oKey) == m_oMapDownloadsInProgress.end())
+        return false;
+    m_oCVDownloadsInProgress.wait(
+        oLock,
+        [this, &oKey]() {
+            return m_oMapDownloadsInProgress.find(oKey) ==
+                   m_oMapDownloadsInProgress.end();
+        });
+    return true;
+}
+
+/************************************************************************/
+/*                    RegisterDownloadInProgress()                      */
+/************************************************************************/
+
+// Registers the download of nBlocks blocks starting at nFileOffsetStart.
+// The first block is always registered, but the following ones only until
+// one of them is already being downloaded by another thread. Returns the
+// number of registered blocks, which is the number of blocks to download.
+int VSICurlFilesystemHandlerBase::RegisterDownloadInProgress(
+    const char *pszURL, vsi_l_offset nFileOffsetStart, int nBlocks)
+{
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    const std::string osURL(pszURL);
+    std::lock_guard<std::mutex> oLock(m_oMutexDownloadsInProgress);
+    int i = 0;
+    for (; i < nBlocks; ++i)
+    {
+        const auto oKey = std::make_pair(
+            osURL, nFileOffsetStart +
+                       static_cast<vsi_l_offset>(i) * knDOWNLOAD_CHUNK_SIZE);
+        auto oIter = m_oMapDownloadsInProgress.find(oKey);
+        if (oIter == m_oMapDownloadsInProgress.end())
+            m_oMapDownloadsInProgress[oKey] = 1;
+        else if (i == 0)
+            oIter->second++;
+        else
+            break;
+    }
+    return i;
+}
+
+/************************************************************************/
+/*                   UnregisterDownloadInProgress()                     */
+/************************************************************************/
+
+void VSICurlFilesystemHandlerBase::UnregisterDownloadInProgress(
+    const char *pszURL, vsi_l_offset nFileOffsetStart, int nBlocks)
+{
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    const std::string osURL(pszURL);
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutexDownloadsInProgress);
+        for (int i = 0; i < nBlocks; ++i)
+        {
+            const vsi_l_offset nOffset =
+                nFileOffsetStart +
+                static_cast<vsi_l_offset>(i) * knDOWNLOAD_CHUNK_SIZE;
+            auto oIter =
+                m_oMapDownloadsInProgress.find(std::make_pair(osURL, nOffset));
+            if (oIter != m_oMapDownloadsInProgress.end() &&
+                --oIter->second == 0)
+            {
+                m_oMapDownloadsInProgress.erase(oIter);
+            }
+        }
+    }
+    m_oCVDownloadsInProgress.notify_all();
+}
+
 /************************************************************************/
 /*                         GetCachedFileProp()                          */
 /************************************************************************/
@@ -3543,7 +4178,8 @@ bool VSICurlFilesystemHandlerBase::GetCachedDirList(
     return oCacheDirList.tryGet(std::string(pszURL), oCachedDirList) &&
            // Let a chance to use new auth parameters
            gnGenerationAuthParameters ==
-               oCachedDirList.nGenerationAuthParameters;
+               oCachedDirList.nGenerationAuthParameters &&
+           !IsMetadataCacheExpired(oCachedDirList.oCachedTime, false);
 }
 
 /************************************************************************/
@@ -3574,6 +4210,7 @@ void VSICurlFilesystemHandlerBase::SetCachedDirList(
         oCacheDirList.remove(oldestKey);
     }
     oCachedDirList.nGenerationAuthParameters = gnGenerationAuthParameters;
+    oCachedDirList.oCachedTime = std::chrono::steady_clock::now();
 
     nCachedFilesInDirList += oCachedDirList.oFileList.size();
     oCacheDirList.insert(key, oCachedDirList);
@@ -4915,6 +5552,25 @@ int VSICurlFilesystemHandlerBase::Stat(const char *pszFilename,
             return -1;
         }
     }
+    else if (strchr(CPLGetFilename(osFilename), '.') != nullptr &&
+             !bSkipReadDir && UseDirListingForStat(osFilename))
+    {
+        bool bGotFileList = false;
+        char **papszFileList = ReadDirInternal(
+            (std::string(CPLGetDirname(osFilename)) + '/').c_str(), 0,
+            &bGotFileList);
+        // As in Open(), do a full check if there is a match with case
+        // difference.
+        const bool bFound =
+            VSICurlIsFileInList(papszFileList, CPLGetFilename(osFilename)) !=
+                -1 ||
+            CSLFindString(papszFileList, CPLGetFilename(osFilename)) != -1;
+        CSLDestroy(papszFileList);
+        if (bGotFileList && !bFound)
+        {
+            return -1;
+        }
+    }
 
     VSICurlHandle *poHandle = CreateFileHandle(osFilename);
     if (poHandle == nullptr)
@@ -5316,6 +5972,10 @@ long CurlRequestHelper::perform(CURL *hCurlHandle, struct curl_slist *headers,
 {
     unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
 
+    CURLSH *hShare = VSICURLGetShareHandle();
+    if (hShare)
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_SHARE, hShare);
+
     poS3HandleHelper->ResetQueryParameters();
 
     unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA, &sWriteFuncData);
@@ -5527,6 +6187,48 @@ void NetworkStatisticsLogger::LogDELETE()
     }
 }
 
+void NetworkStatisticsLogger::LogHedgedRequest()
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+    for (auto counters : gInstance.GetCountersForContext())
+    {
+        counters->nGETHedged++;
+    }
+}
+
+void NetworkStatisticsLogger::LogHedgedDuplicateBytes(size_t nDownloadedBytes)
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+    for (auto counters : gInstance.GetCountersForContext())
+    {
+        counters->nGETHedgedDuplicateBytes += nDownloadedBytes;
+    }
+}
+
+void NetworkStatisticsLogger::LogConnection(long nNewConnections,
+                                            double dfNameLookupTime,
+                                            double dfTLSHandshakeTime,
+                                            double dfTimeToFirstByte)
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+    for (auto counters : gInstance.GetCountersForContext())
+    {
+        if (nNewConnections > 0)
+            counters->nNewConnections += nNewConnections;
+        else
+            counters->nReusedConnections++;
+        counters->dfNameLookupTime += dfNameLookupTime;
+        counters->dfTLSHandshakeTime += dfTLSHandshakeTime;
+        counters->dfTimeToFirstByte += dfTimeToFirstByte;
+    }
+}
+
 void NetworkStatisticsLogger::Reset()
 {
     std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
@@ -5543,6 +6245,11 @@ void NetworkStatisticsLogger::Stats::AsJSON(CPLJSONObject &oJSON) const
         oMethods.Add("GET/count", counters.nGET);
     if (counters.nGETDownloadedBytes)
         oMethods.Add("GET/downloaded_bytes", counters.nGETDownloadedBytes);
+    if (counters.nGETHedged)
+        oMethods.Add("GET/hedged_count", counters.nGETHedged);
+    if (counters.nGETHedgedDuplicateBytes)
+        oMethods.Add("GET/hedged_duplicate_bytes",
+                     counters.nGETHedgedDuplicateBytes);
     if (counters.nPUT)
         oMethods.Add("PUT/count", counters.nPUT);
     if (counters.nPUTUploadedBytes)
@@ -5556,6 +6263,16 @@ void NetworkStatisticsLogger::Stats::AsJSON(CPLJSONObject &oJSON) const
     if (counters.nDELETE)
         oMethods.Add("DELETE/count", counters.nDELETE);
     oJSON.Add("methods", oMethods);
+    if (counters.nNewConnections || counters.nReusedConnections)
+    {
+        CPLJSONObject oConnections;
+        oConnections.Add("new", counters.nNewConnections);
+        oConnections.Add("reused", counters.nReusedConnections);
+        oConnections.Add("name_lookup_time_s", counters.dfNameLookupTime);
+        oConnections.Add("tls_handshake_time_s", counters.dfTLSHandshakeTime);
+        oConnections.Add("time_to_first_byte_s", counters.dfTimeToFirstByte);
+        oJSON.Add("connections", oConnections);
+    }
     CPLJSONObject oFiles;
     bool bFilesAdded = false;
     for (const auto &kv : children)
@@ -5640,10 +6357,19 @@ static lru11::Cache<std::string, FileProp> *poCacheFileProp = nullptr;
 bool VSICURLGetCachedFileProp(const char *pszURL, FileProp &oFileProp)
 {
     std::lock_guard<std::mutex> oLock(oCacheFilePropMutex);
-    return poCacheFileProp != nullptr &&
-           poCacheFileProp->tryGet(std::string(pszURL), oFileProp) &&
-           // Let a chance to use new auth parameters
-           !(oFileProp.eExists == EXIST_NO &&
+    if (poCacheFileProp == nullptr ||
+        !poCacheFileProp->tryGet(std::string(pszURL), oFileProp))
+    {
+        return false;
+    }
+    if (IsMetadataCacheExpired(oFileProp.oCachedTime,
+                               oFileProp.eExists == EXIST_NO))
+    {
+        poCacheFileProp->remove(std::string(pszURL));
+        return false;
+    }
+    // Let a chance to use new auth parameters
+    return !(oFileProp.eExists == EXIST_NO &&
              gnGenerationAuthParameters != oFileProp.nGenerationAuthParameters);
 }
 
@@ -5657,6 +6383,7 @@ void VSICURLSetCachedFileProp(const char *pszURL, FileProp &oFileProp)
     if (poCacheFileProp == nullptr)
         poCacheFileProp = new lru11::Cache<std::string, FileProp>(100 * 1024);
     oFileProp.nGenerationAuthParameters = gnGenerationAuthParameters;
+    oFileProp.oCachedTime = std::chrono::steady_clock::now();
     poCacheFileProp->insert(std::string(pszURL), oFileProp);
 }
 
@@ -5705,6 +6432,79 @@ void VSICURLDestroyCacheFileProp()
     poCacheFileProp = nullptr;
 }
 
+/************************************************************************/
+/*                        VSICURLGetShareHandle()                       */
+/************************************************************************/
+
+static std::mutex oShareHandleMutex;
+static bool bShareHandleInitialized = false;
+static CURLSH *hShareHandle = nullptr;
+static std::mutex aoShareDataMutex[CURL_LOCK_DATA_LAST];
+
+static void VSICurlShareLock(CURL *, curl_lock_data data, curl_lock_access,
+                             void *)
+{
+    aoShareDataMutex[data].lock();
+}
+
+static void VSICurlShareUnlock(CURL *, curl_lock_data data, void *)
+{
+    aoShareDataMutex[data].unlock();
+}
+
+// Returns the share handle, common to all the easy handles of the network
+// file systems, so that DNS resolutions and TLS sessions (and optionally
+// connections) are reused between file handles and threads. Returns nullptr
+// if CPL_VSIL_CURL_SHARE_HANDLE=NO.
+CURLSH *VSICURLGetShareHandle()
+{
+    std::lock_guard<std::mutex> oLock(oShareHandleMutex);
+    if (bShareHandleInitialized)
+        return hShareHandle;
+    bShareHandleInitialized = true;
+
+    if (!CPLTestBool(CPLGetConfigOption("CPL_VSIL_CURL_SHARE_HANDLE", "YES")))
+        return nullptr;
+
+    hShareHandle = curl_share_init();
+    if (hShareHandle == nullptr)
+        return nullptr;
+    curl_share_setopt(hShareHandle, CURLSHOPT_LOCKFUNC, VSICurlShareLock);
+    curl_share_setopt(hShareHandle, CURLSHOPT_UNLOCKFUNC, VSICurlShareUnlock);
+    curl_share_setopt(hShareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(hShareHandle, CURLSHOPT_SHARE,
+                      CURL_LOCK_DATA_SSL_SESSION);
+    if (CPLTestBool(
+            CPLGetConfigOption("CPL_VSIL_CURL_SHARE_CONNECTIONS", "NO")))
+    {
+#if CURL_AT_LEAST_VERSION(7, 57, 0)
+        curl_share_setopt(hShareHandle, CURLSHOPT_SHARE,
+                          CURL_LOCK_DATA_CONNECT);
+#else
+        CPLDebug("VSICURL", "CPL_VSIL_CURL_SHARE_CONNECTIONS=YES requires "
+                            "libcurl >= 7.57");
+#endif
+    }
+    return hShareHandle;
+}
+
+/************************************************************************/
+/*                      VSICURLDestroyShareHandle()                     */
+/************************************************************************/
+
+void VSICURLDestroyShareHandle()
+{
+    std::lock_guard<std::mutex> oLock(oShareHandleMutex);
+    if (hShareHandle)
+    {
+        // Fails if easy handles still use it, in which case it is leaked.
+        if (curl_share_cleanup(hShareHandle) != CURLSHE_OK)
+            return;
+        hShareHandle = nullptr;
+    }
+    bShareHandleInitialized = false;
+}
+
 } /* end of namespace cpl */
 
 /************************************************************************/
@@ -5714,8 +6514,9 @@ void VSICURLDestroyCacheFileProp()
 int VSICurlInstallReadCbk(VSILFILE *fp, VSICurlReadCbkFunc pfnReadCbk,
                           void *pfnUserData, int bStopOnInterruptUntilUninstall)
 {
-    return reinterpret_cast<cpl::VSICurlHandle *>(fp)->InstallReadCbk(
-        pfnReadCbk, pfnUserData, bStopOnInterruptUntilUninstall);
+    return cpl::down_cast<cpl::VSICurlHandle *>(VSIIOStatsGetBaseHandle(fp))
+        ->InstallReadCbk(pfnReadCbk, pfnUserData,
+                         bStopOnInterruptUntilUninstall);
 }
 
 /************************************************************************/
@@ -5724,7 +6525,8 @@ int VSICurlInstallReadCbk(VSILFILE *fp, VSICurlReadCbkFunc pfnReadCbk,
 
 int VSICurlUninstallReadCbk(VSILFILE *fp)
 {
-    return reinterpret_cast<cpl::VSICurlHandle *>(fp)->UninstallReadCbk();
+    return cpl::down_cast<cpl::VSICurlHandle *>(VSIIOStatsGetBaseHandle(fp))
+        ->UninstallReadCbk();
 }
 
 /************************************************************************/
@@ -5737,6 +6539,10 @@ struct curl_slist *VSICurlSetOptions(CURL *hCurlHandle, const char *pszURL,
     struct curl_slist *headers = static_cast<struct curl_slist *>(
         CPLHTTPSetOptions(hCurlHandle, pszURL, papszOptions));
 
+    CURLSH *hShare = cpl::VSICURLGetShareHandle();
+    if (hShare)
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_SHARE, hShare);
+
     long option = CURLFTPMETHOD_SINGLECWD;
     unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_FTP_FILEMETHOD, option);
 
@@ -5977,6 +6783,18 @@ void VSINetworkStatsReset(void)
  * Statistics can also be emitted on standard output at process termination if
  * the CPL_VSIL_SHOW_NETWORK_STATS configuration option is set to YES.
  *
+ * Starting with GDAL 3.8, a "connections" object reports, when available,
+ * the number of new connections and of requests that reused an existing
+ * connection, and the cumulated duration of name lookups, TLS handshakes and
+ * time to first byte of the requests.
+ *
+ * Starting with GDAL 3.8, when CPL_VSIL_CURL_HEDGED_REQUESTS is enabled, the
+ * "GET" object also reports the number of hedged (duplicate) range requests
+ * issued as "hedged_count", and the number of bytes received by the requests
+ * cancelled because their duplicate completed first as
+ * "hedged_duplicate_bytes". Those bytes are not included in
+ * "downloaded_bytes".
+ *
  * Example of output:
  * <pre>
  * {
@@ -38,10 +38,12 @@
 #include "cpl_string.h"
 #include "cpl_vsil_curl_priv.h"
 #include "cpl_mem_cache.h"
+#include "cpl_worker_thread_pool.h"
 
 #include "cpl_curl_priv.h"
 
 #include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <set>
 #include <map>
@@ -96,6 +98,8 @@ class FileProp
     int nMode = 0;  // st_mode member of struct stat
     bool bS3LikeRedirect = false;
     CPLString ETag{};
+    // time at which it was inserted in the cache
+    std::chrono::steady_clock::time_point oCachedTime{};
 };
 
 struct CachedDirList
@@ -103,6 +107,8 @@ struct CachedDirList
     bool bGotFileList = false;
     unsigned int nGenerationAuthParameters = 0;
     CPLStringList oFileList{}; /* only file name without path */
+    // time at which it was inserted in the cache
+    std::chrono::steady_clock::time_point oCachedTime{};
 };
 
 struct WriteFuncStruct
@@ -213,6 +219,14 @@ class VSICurlFilesystemHandlerBase : public VSIFilesystemHandler
     char **ParseHTMLFileList(const char *pszFilename, int nMaxFiles,
                              char *pszData, bool *pbGotFileList);
 
+    // Blocks being downloaded, with the number of downloads in progress for
+    // each of them, so that concurrent reads of the same block wait for the
+    // download in progress instead of issuing their own request.
+    std::mutex m_oMutexDownloadsInProgress{};
+    std::condition_variable m_oCVDownloadsInProgress{};
+    std::map<std::pair<std::string, vsi_l_offset>, int>
+        m_oMapDownloadsInProgress{};
+
   protected:
     CPLMutex *hMutex = nullptr;
 
@@ -280,6 +294,7 @@ class VSICurlFilesystemHandlerBase : public VSIFilesystemHandler
 
     virtual CPLString GetFSPrefix() const = 0;
     virtual bool AllowCachedDataFor(const char *pszFilename);
+    bool UseDirListingForStat(const char *pszFilename);
 
     virtual bool IsLocal(const char * /* pszPath */) override
     {
@@ -303,6 +318,14 @@ class VSICurlFilesystemHandlerBase : public VSIFilesystemHandler
     void AddRegion(const char *pszURL, vsi_l_offset nFileOffsetStart,
                    size_t nSize, const char *pData);
 
+    bool WaitForDownloadInProgress(const char *pszURL,
+                                   vsi_l_offset nFileOffsetStart);
+    int RegisterDownloadInProgress(const char *pszURL,
+                                   vsi_l_offset nFileOffsetStart, int nBlocks);
+    void UnregisterDownloadInProgress(const char *pszURL,
+                                      vsi_l_offset nFileOffsetStart,
+                                      int nBlocks);
+
     bool GetCachedFileProp(const char *pszURL, FileProp &oFileProp);
     void SetCachedFileProp(const char *pszURL, FileProp &oFileProp);
     void InvalidateCachedData(const char *pszURL);
@@ -369,6 +392,7 @@ class VSICurlHandle : public VSIVirtualHandle
 
     vsi_l_offset lastDownloadedOffset = VSI_L_OFFSET_MAX;
     int nBlocksToDownload = 1;
+    int m_nSequentialDownloads = 0;
 
     bool bStopOnInterruptUntilUninstall = false;
     bool bInterrupted = false;
@@ -390,6 +414,9 @@ class VSICurlHandle : public VSIVirtualHandle
     bool bEOF = false;
 
     virtual std::string DownloadRegion(vsi_l_offset startOffset, int nBlocks);
+    bool DownloadRegionParallel(const CPLString &osURL,
+                                vsi_l_offset startOffset, int nBlocks,
+                                std::string &osRet);
 
     bool m_bUseHead = false;
     bool m_bUseRedirectURLIfNoQueryStringParams = false;
@@ -525,6 +552,8 @@ class IVSIS3LikeFSHandler : public VSICurlFilesystemHandlerBase
 {
     CPL_DISALLOW_COPY_ASSIGN(IVSIS3LikeFSHandler)
 
+    friend class VSIS3WriteHandle;
+
     virtual int MkdirInternal(const char *pszDirname, long nMode,
                               bool bDoStatCheck);
 
@@ -584,6 +613,13 @@ class IVSIS3LikeFSHandler : public VSICurlFilesystemHandlerBase
         return false;
     }
 
+    virtual int GetUploadChunkSizeInBytes(const char *pszFilename);
+
+    virtual int GetMaximumPartCount() const
+    {
+        return 10000;  // Limitation from S3
+    }
+
     virtual CPLString InitiateMultipartUpload(
         const std::string &osFilename, IVSIS3LikeHandleHelper *poS3HandleHelper,
         int nMaxRetry, double dfRetryDelay, CSLConstList papszOptions);
@@ -669,6 +705,18 @@ class VSIS3WriteHandle final : public VSIVirtualHandle
     std::vector<CPLString> m_aosEtags{};
     bool m_bError = false;
 
+    // Background upload of parts
+    struct UploadPartJob;
+    int m_nUploadThreads = 0;
+    std::unique_ptr<CPLWorkerThreadPool> m_poUploadPool{};
+    std::mutex m_oMutexUpload{};
+    std::vector<GByte *> m_apabyFreeBuffers{};
+    bool m_bBackgroundUploadError = false;
+    bool m_bBackgroundUploadErrorReported = false;
+    // Last error emitted by the worker thread of the first failed part
+    CPLErrorNum m_nBackgroundUploadErrorNo = CPLE_None;
+    std::string m_osBackgroundUploadErrorMsg{};
+
     CURLM *m_hCurlMulti = nullptr;
     CURL *m_hCurl = nullptr;
     const void *m_pBuffer = nullptr;
@@ -682,6 +730,10 @@ class VSIS3WriteHandle final : public VSIVirtualHandle
     WriteFuncStruct m_sWriteFuncHeaderData{};
 
     bool UploadPart();
+    bool SubmitUploadPart();
+    static void UploadPartJobFunc(void *pData);
+    bool HasBackgroundUploadError();
+    bool WaitForPendingUploads();
     bool DoSinglePartPUT();
 
     static size_t ReadCallBackBufferChunked(char *buffer, size_t size,
@@ -808,9 +860,16 @@ class NetworkStatisticsLogger
         GIntBig nPOST = 0;
         GIntBig nDELETE = 0;
         GIntBig nGETDownloadedBytes = 0;
+        GIntBig nGETHedged = 0;
+        GIntBig nGETHedgedDuplicateBytes = 0;
         GIntBig nPUTUploadedBytes = 0;
         GIntBig nPOSTDownloadedBytes = 0;
         GIntBig nPOSTUploadedBytes = 0;
+        GIntBig nNewConnections = 0;
+        GIntBig nReusedConnections = 0;
+        double dfNameLookupTime = 0;
+        double dfTLSHandshakeTime = 0;
+        double dfTimeToFirstByte = 0;
     };
 
     enum class ContextPathType
@@ -890,6 +949,14 @@ class NetworkStatisticsLogger
 
     static void LogDELETE();
 
+    static void LogHedgedRequest();
+
+    static void LogHedgedDuplicateBytes(size_t nDownloadedBytes);
+
+    static void LogConnection(long nNewConnections, double dfNameLookupTime,
+                              double dfTLSHandshakeTime,
+                              double dfTimeToFirstByte);
+
     static void Reset();
 
     static CPLString GetReportAsSerializedJSON();
@@ -953,6 +1020,10 @@ void VSICURLInvalidateCachedFileProp(const char *pszURL);
 void VSICURLInvalidateCachedFilePropPrefix(const char *pszURL);
 void VSICURLDestroyCacheFileProp();
 
+// Process-wide libcurl share handle
+CURLSH *VSICURLGetShareHandle();
+void VSICURLDestroyShareHandle();
+
 }  // namespace cpl
 
 //! @endcond
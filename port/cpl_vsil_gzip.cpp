@@ -98,6 +98,9 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <iterator>
 #include <limits>
 #include <list>
@@ -157,6 +160,33 @@ typedef struct
     vsi_l_offset out;
 } GZipSnapshot;
 
+// Checkpoint of a persistent /vsigzip/ seek index, from which decompression
+// can be resumed without decompressing the preceding data (same principle
+// as zlib's examples/zran.c)
+struct VSIGZipIndexPoint
+{
+    // Offset in base file of the first compressed byte not yet consumed.
+    vsi_l_offset posInBaseHandle = 0;
+    // Number of bits of the previous byte that remain to be consumed.
+    int bits = 0;
+    vsi_l_offset out = 0;
+    uLong crc = 0;
+    // Last (up to) 32 KB of uncompressed data before the checkpoint, stored
+    // compressed.
+    size_t nWindowSize = 0;
+    std::vector<GByte> abyCompressedWindow{};
+};
+
+struct VSIGZipIndex
+{
+    // Compressed size and gzip trailer (CRC32 + ISIZE) of the indexed file,
+    // used to detect a stale index.
+    vsi_l_offset nCompressedSize = 0;
+    GByte abyTrailer[8] = {};
+    vsi_l_offset nUncompressedSize = 0; /* 0 if unknown */
+    std::vector<VSIGZipIndexPoint> aoPoints{};
+};
+
 class VSIGZipHandle final : public VSIVirtualHandle
 {
     VSIVirtualHandle *m_poBaseHandle = nullptr;
@@ -190,12 +220,39 @@ class VSIGZipHandle final : public VSIVirtualHandle
     vsi_l_offset snapshot_byte_interval =
         0; /* number of compressed bytes at which we create a "snapshot" */
 
+    std::shared_ptr<const VSIGZipIndex> m_poIndex{}; /* optional */
+
+    // Parallel decompression of the segments between index checkpoints,
+    // used for sequential reads when GDAL_NUM_THREADS is set.
+    struct IndexSegmentJob;
+    int m_nReadThreads = 1;
+    bool m_bParallelReadDisabled = false;
+    bool m_bStreamStateStale = false; /* stream not positioned at out */
+    vsi_l_offset m_nSequentialReadEnd = 0;
+    vsi_l_offset m_nSequentialReadSize = 0;
+    std::unique_ptr<CPLWorkerThreadPool> m_poPool{};
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    std::deque<std::unique_ptr<IndexSegmentJob>> m_apoSegmentJobs{};
+    std::mutex m_oSegmentJobsMutex{};
+    std::condition_variable m_oSegmentJobsCV{};
+
     void check_header();
     int get_byte();
     bool gzseek(vsi_l_offset nOffset, int nWhence);
     int gzrewind();
     uLong getLong();
 
+    bool ReadTrailer(GByte *pabyTrailer);
+    std::shared_ptr<VSIGZipIndex> BuildIndex(vsi_l_offset nSpan);
+    bool RestoreIndexPoint(const VSIGZipIndexPoint &oPoint);
+
+    size_t ReadSerial(void *pBuffer, size_t nSize, size_t nMemb);
+    size_t ReadFromIndexSegments(GByte *pabyBuffer, size_t nLen);
+    IndexSegmentJob *GetIndexSegmentJob(size_t iSegment);
+    void CancelIndexSegmentJobs();
+    void WaitIndexSegmentJob(IndexSegmentJob *poJob);
+    static void DecompressIndexSegmentFunc(void *pData);
+
     CPL_DISALLOW_COPY_ASSIGN(VSIGZipHandle)
 
   public:
@@ -221,6 +278,8 @@ class VSIGZipHandle final : public VSIVirtualHandle
     VSIGZipHandle *Duplicate();
     bool CloseBaseHandle();
 
+    void LoadOrBuildIndex();
+
     vsi_l_offset GetLastReadOffset()
     {
         return m_nLastReadOffset;
@@ -409,6 +468,8 @@ VSIGZipHandle *VSIGZipHandle::Duplicate()
     }
 
     poHandle->m_nLastReadOffset = m_nLastReadOffset;
+    poHandle->m_poIndex = m_poIndex;
+    poHandle->m_nReadThreads = m_nReadThreads;
 
     // Most important: duplicate the snapshots!
 
@@ -543,6 +604,8 @@ void VSIGZipHandle::SaveInfo_unlocked()
 
 VSIGZipHandle::~VSIGZipHandle()
 {
+    CancelIndexSegmentJobs();
+
     if (m_pszBaseFileName && m_bCanSaveInfo)
     {
         VSIFilesystemHandler *poFSHandler =
@@ -716,6 +779,7 @@ int VSIGZipHandle::get_byte()
 
 int VSIGZipHandle::gzrewind()
 {
+    m_bStreamStateStale = false;
     z_err = Z_OK;
     z_eof = 0;
     stream.avail_in = 0;
@@ -885,6 +949,7 @@ bool VSIGZipHandle::gzseek(vsi_l_offset offset, int whence)
 
             inflateEnd(&stream);
             inflateCopy(&stream, &snapshots[i].stream);
+            m_bStreamStateStale = false;
             crc = snapshots[i].crc;
             m_transparent = snapshots[i].transparent;
             in = snapshots[i].in;
@@ -893,6 +958,46 @@ bool VSIGZipHandle::gzseek(vsi_l_offset offset, int whence)
         }
     }
 
+    // Use the persistent index if it has a checkpoint closer to the target
+    // than the current position.
+    if (m_poIndex)
+    {
+        const vsi_l_offset nTarget = out + offset;
+        const auto &aoPoints = m_poIndex->aoPoints;
+        auto oIter = std::upper_bound(
+            aoPoints.begin(), aoPoints.end(), nTarget,
+            [](vsi_l_offset nVal, const VSIGZipIndexPoint &oPoint)
+            { return nVal < oPoint.out; });
+        if (oIter != aoPoints.begin())
+        {
+            --oIter;
+            if (oIter->out > out)
+            {
+#ifdef ENABLE_DEBUG
+                CPLDebug("GZIP",
+                         "using index point: posInBaseHandle=" CPL_FRMT_GUIB
+                         " out=" CPL_FRMT_GUIB,
+                         oIter->posInBaseHandle, oIter->out);
+#endif
+                if (RestoreIndexPoint(*oIter))
+                {
+                    offset = nTarget - out;
+                }
+                else
+                {
+                    CPLDebug("GZIP", "Cannot restore index point. "
+                                     "Decompressing from start of stream");
+                    if (gzrewind() < 0)
+                    {
+                        CPL_VSIL_GZ_RETURN(FALSE);
+                        return false;
+                    }
+                    offset = nTarget;
+                }
+            }
+        }
+    }
+
     // Offset is now the number of bytes to skip.
 
     if (offset != 0 && outbuf == nullptr)
@@ -988,12 +1093,301 @@ vsi_l_offset VSIGZipHandle::Tell()
     return out;
 }
 
+/************************************************************************/
+/*                       SetIndexPointDictionary()                      */
+/************************************************************************/
+
+// Set the window of an index checkpoint as the dictionary of a raw inflate
+// stream.
+static bool SetIndexPointDictionary(z_stream *psStream,
+                                    const VSIGZipIndexPoint &oPoint)
+{
+    if (oPoint.nWindowSize == 0)
+        return true;
+    std::vector<GByte> abyWindow(oPoint.nWindowSize);
+    size_t nOutBytes = 0;
+    return CPLZLibInflate(oPoint.abyCompressedWindow.data(),
+                          oPoint.abyCompressedWindow.size(), abyWindow.data(),
+                          abyWindow.size(), &nOutBytes) != nullptr &&
+           nOutBytes == oPoint.nWindowSize &&
+           inflateSetDictionary(psStream, abyWindow.data(),
+                                static_cast<uInt>(abyWindow.size())) == Z_OK;
+}
+
+/************************************************************************/
+/*                          IndexSegmentJob                             */
+/************************************************************************/
+
+// Decompression of the uncompressed range between two consecutive
+// checkpoints of the index, done by a worker thread.
+struct VSIGZipHandle::IndexSegmentJob
+{
+    VSIGZipHandle *poHandle = nullptr;
+    size_t iSegment = 0;
+    // nullptr for the start of the stream.
+    const VSIGZipIndexPoint *poStart = nullptr;
+    const VSIGZipIndexPoint *poEnd = nullptr;
+    // Starts with the partially consumed byte if poStart->bits != 0
+    std::vector<GByte> abyCompressed{};
+    std::vector<GByte> abyUncompressed{};
+    bool bOK = false;
+    bool bDone = false;  // protected by poHandle->m_oSegmentJobsMutex
+};
+
+/************************************************************************/
+/*                     DecompressIndexSegmentFunc()                     */
+/************************************************************************/
+
+void VSIGZipHandle::DecompressIndexSegmentFunc(void *pData)
+{
+    auto psJob = static_cast<IndexSegmentJob *>(pData);
+
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    if (inflateInit2(&sStream, -MAX_WBITS) == Z_OK)
+    {
+        const int nBits = psJob->poStart ? psJob->poStart->bits : 0;
+        sStream.next_in = psJob->abyCompressed.data();
+        sStream.avail_in = static_cast<uInt>(psJob->abyCompressed.size());
+        bool bOK = true;
+        if (nBits)
+        {
+            bOK = inflatePrime(&sStream, nBits,
+                               sStream.next_in[0] >> (8 - nBits)) == Z_OK;
+            sStream.next_in++;
+            sStream.avail_in--;
+        }
+        if (bOK && psJob->poStart)
+            bOK = SetIndexPointDictionary(&sStream, *(psJob->poStart));
+        if (bOK)
+        {
+            sStream.next_out = psJob->abyUncompressed.data();
+            sStream.avail_out =
+                static_cast<uInt>(psJob->abyUncompressed.size());
+            const int ret = inflate(&sStream, Z_NO_FLUSH);
+            // The CRC at the end checkpoint validates the whole segment.
+            const uLong nStartCRC = psJob->poStart ? psJob->poStart->crc : 0;
+            psJob->bOK =
+                (ret == Z_OK || ret == Z_STREAM_END) &&
+                sStream.avail_out == 0 &&
+                crc32(nStartCRC, psJob->abyUncompressed.data(),
+                      static_cast<uInt>(psJob->abyUncompressed.size())) ==
+                    psJob->poEnd->crc;
+        }
+        inflateEnd(&sStream);
+    }
+
+    std::lock_guard<std::mutex> oLock(psJob->poHandle->m_oSegmentJobsMutex);
+    psJob->bDone = true;
+    psJob->poHandle->m_oSegmentJobsCV.notify_all();
+}
+
+/************************************************************************/
+/*                       CancelIndexSegmentJobs()                       */
+/************************************************************************/
+
+void VSIGZipHandle::CancelIndexSegmentJobs()
+{
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+    m_apoSegmentJobs.clear();
+}
+
+/************************************************************************/
+/*                        WaitIndexSegmentJob()                         */
+/************************************************************************/
+
+void VSIGZipHandle::WaitIndexSegmentJob(IndexSegmentJob *poJob)
+{
+    std::unique_lock<std::mutex> oLock(m_oSegmentJobsMutex);
+    m_oSegmentJobsCV.wait(oLock, [poJob] { return poJob->bDone; });
+}
+
+/************************************************************************/
+/*                        GetIndexSegmentJob()                          */
+/************************************************************************/
+
+// Return the (completed) job of the iSegment-th segment, after having
+// submitted the jobs of the following segments.
+VSIGZipHandle::IndexSegmentJob *
+VSIGZipHandle::GetIndexSegmentJob(size_t iSegment)
+{
+    const auto &aoPoints = m_poIndex->aoPoints;
+
+    // Discard jobs of segments before the requested one, or everything if
+    // the requested one is not in the queue.
+    while (!m_apoSegmentJobs.empty() &&
+           m_apoSegmentJobs.front()->iSegment < iSegment)
+    {
+        WaitIndexSegmentJob(m_apoSegmentJobs.front().get());
+        m_apoSegmentJobs.pop_front();
+    }
+    if (!m_apoSegmentJobs.empty() &&
+        m_apoSegmentJobs.front()->iSegment != iSegment)
+    {
+        CancelIndexSegmentJobs();
+    }
+
+    if (m_poJobQueue == nullptr)
+    {
+        m_poPool.reset(new CPLWorkerThreadPool());
+        if (!m_poPool->Setup(m_nReadThreads, nullptr, nullptr, false))
+        {
+            m_poPool.reset();
+            return nullptr;
+        }
+        m_poJobQueue = m_poPool->CreateJobQueue();
+    }
+
+    // Keep one job per thread in advance of the one being consumed.
+    size_t iNext = m_apoSegmentJobs.empty()
+                       ? iSegment
+                       : m_apoSegmentJobs.back()->iSegment + 1;
+    while (iNext < aoPoints.size() &&
+           iNext <= iSegment + static_cast<size_t>(m_nReadThreads))
+    {
+        auto poJob = cpl::make_unique<IndexSegmentJob>();
+        poJob->poHandle = this;
+        poJob->iSegment = iNext;
+        poJob->poStart = iNext == 0 ? nullptr : &aoPoints[iNext - 1];
+        poJob->poEnd = &aoPoints[iNext];
+
+        // Read the compressed data of the segment. The next byte after the
+        // end checkpoint is included, as inflate() might need to peek at it.
+        const vsi_l_offset nStartPos =
+            poJob->poStart ? poJob->poStart->posInBaseHandle -
+                                 (poJob->poStart->bits ? 1 : 0)
+                           : startOff;
+        const vsi_l_offset nEndPos = std::min(
+            poJob->poEnd->posInBaseHandle + 1, offsetEndCompressedData);
+        m_bStreamStateStale = true;
+        if (nEndPos <= nStartPos ||
+            nEndPos - nStartPos > std::numeric_limits<uInt>::max() ||
+            poJob->poEnd->out - (poJob->poStart ? poJob->poStart->out : 0) >
+                std::numeric_limits<uInt>::max())
+        {
+            return nullptr;
+        }
+        try
+        {
+            poJob->abyCompressed.resize(
+                static_cast<size_t>(nEndPos - nStartPos));
+            poJob->abyUncompressed.resize(static_cast<size_t>(
+                poJob->poEnd->out -
+                (poJob->poStart ? poJob->poStart->out : 0)));
+        }
+        catch (const std::exception &)
+        {
+            return nullptr;
+        }
+        if (m_poBaseHandle->Seek(nStartPos, SEEK_SET) != 0 ||
+            m_poBaseHandle->Read(poJob->abyCompressed.data(), 1,
+                                 poJob->abyCompressed.size()) !=
+                poJob->abyCompressed.size())
+        {
+            return nullptr;
+        }
+
+        if (!m_poJobQueue->SubmitJob(DecompressIndexSegmentFunc, poJob.get()))
+            DecompressIndexSegmentFunc(poJob.get());
+        m_apoSegmentJobs.emplace_back(std::move(poJob));
+        ++iNext;
+    }
+
+    if (m_apoSegmentJobs.empty())
+        return nullptr;
+    auto poJob = m_apoSegmentJobs.front().get();
+    WaitIndexSegmentJob(poJob);
+    return poJob;
+}
+
+/************************************************************************/
+/*                       ReadFromIndexSegments()                        */
+/************************************************************************/
+
+// Serve the read from the segments decompressed in parallel. Returns the
+// number of bytes read, which is less than nLen when reaching the part of
+// the stream after the last checkpoint.
+size_t VSIGZipHandle::ReadFromIndexSegments(GByte *pabyBuffer, size_t nLen)
+{
+    const auto &aoPoints = m_poIndex->aoPoints;
+    size_t nRead = 0;
+    while (nRead < nLen)
+    {
+        const auto oIter = std::upper_bound(
+            aoPoints.begin(), aoPoints.end(), out,
+            [](vsi_l_offset nVal, const VSIGZipIndexPoint &oPoint)
+            { return nVal < oPoint.out; });
+        if (oIter == aoPoints.end())
+            break;
+        const size_t iSegment =
+            static_cast<size_t>(std::distance(aoPoints.begin(), oIter));
+        const IndexSegmentJob *poJob = GetIndexSegmentJob(iSegment);
+        if (poJob == nullptr || !poJob->bOK)
+        {
+            CPLDebug("GZIP", "Parallel decompression failed. Disabling it");
+            m_bParallelReadDisabled = true;
+            CancelIndexSegmentJobs();
+            break;
+        }
+        const vsi_l_offset nSegmentStart =
+            poJob->poStart ? poJob->poStart->out : 0;
+        const size_t nToCopy = static_cast<size_t>(
+            std::min(static_cast<vsi_l_offset>(nLen - nRead),
+                     poJob->poEnd->out - out));
+        memcpy(pabyBuffer + nRead,
+               poJob->abyUncompressed.data() + (out - nSegmentStart),
+               nToCopy);
+        nRead += nToCopy;
+        out += nToCopy;
+        m_bStreamStateStale = true;
+    }
+    return nRead;
+}
+
 /************************************************************************/
 /*                              Read()                                  */
 /************************************************************************/
 
 size_t VSIGZipHandle::Read(void *const buf, size_t const nSize,
                            size_t const nMemb)
+{
+    // Parallel decompression only kicks in after a bit of sequential
+    // reading, so as not to penalize random access or header probing.
+    constexpr vsi_l_offset SEQUENTIAL_READ_THRESHOLD = 1024 * 1024;
+    if (out != m_nSequentialReadEnd)
+        m_nSequentialReadSize = 0;
+
+    const size_t nLen = nSize * nMemb;
+    size_t nRead = 0;
+    if (m_poIndex && m_nReadThreads > 1 && !m_bParallelReadDisabled &&
+        m_nSequentialReadSize >= SEQUENTIAL_READ_THRESHOLD)
+    {
+        nRead = ReadFromIndexSegments(static_cast<GByte *>(buf), nLen);
+    }
+    if (nRead < nLen)
+    {
+        if (m_bStreamStateStale)
+        {
+            // Reposition the decompression stream at the current offset.
+            const vsi_l_offset nCurOffset = out;
+            if (gzrewind() < 0 || !gzseek(nCurOffset, SEEK_SET))
+                return nRead / nSize;
+        }
+        nRead += ReadSerial(static_cast<GByte *>(buf) + nRead, 1, nLen - nRead);
+    }
+
+    m_nSequentialReadSize += nRead;
+    m_nSequentialReadEnd = out;
+    return nRead / nSize;
+}
+
+/************************************************************************/
+/*                            ReadSerial()                              */
+/************************************************************************/
+
+size_t VSIGZipHandle::ReadSerial(void *const buf, size_t const nSize,
+                                 size_t const nMemb)
 {
 #ifdef ENABLE_DEBUG
     CPLDebug("GZIP", "Read(%p, %d, %d)", buf, static_cast<int>(nSize),
@@ -1235,6 +1629,418 @@ uLong VSIGZipHandle::getLong()
     return x;
 }
 
+/************************************************************************/
+/*                            ReadTrailer()                             */
+/************************************************************************/
+
+// Read the last 8 bytes of the compressed data, that is the CRC32 and
+// ISIZE fields of the trailer of the last gzip member.
+bool VSIGZipHandle::ReadTrailer(GByte *pabyTrailer)
+{
+    if (m_compressed_size < 8)
+        return false;
+    const vsi_l_offset nSavedPos = m_poBaseHandle->Tell();
+    const bool bOK =
+        m_poBaseHandle->Seek(offsetEndCompressedData - 8, SEEK_SET) == 0 &&
+        m_poBaseHandle->Read(pabyTrailer, 1, 8) == 8;
+    if (m_poBaseHandle->Seek(nSavedPos, SEEK_SET) != 0)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Seek() failed");
+        return false;
+    }
+    return bOK;
+}
+
+/************************************************************************/
+/*                             BuildIndex()                             */
+/************************************************************************/
+
+// Decompress the first gzip member and record a checkpoint at the first
+// deflate block boundary after every nSpan bytes of uncompressed data.
+std::shared_ptr<VSIGZipIndex> VSIGZipHandle::BuildIndex(vsi_l_offset nSpan)
+{
+    constexpr size_t WINDOW_SIZE = 32768;
+
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    if (inflateInit2(&sStream, -MAX_WBITS) != Z_OK)
+        return nullptr;
+
+    const vsi_l_offset nSavedPos = m_poBaseHandle->Tell();
+    if (m_poBaseHandle->Seek(startOff, SEEK_SET) != 0)
+    {
+        inflateEnd(&sStream);
+        return nullptr;
+    }
+
+    auto poIndex = std::make_shared<VSIGZipIndex>();
+    std::vector<GByte> abyIn(Z_BUFSIZE);
+    std::vector<GByte> abyWindow(WINDOW_SIZE);
+    std::vector<GByte> abyLinearWindow(WINDOW_SIZE);
+    std::vector<GByte> abyCompressedWindow(2 * WINDOW_SIZE);
+    vsi_l_offset nPosInBaseHandle = startOff;
+    vsi_l_offset nTotIn = 0;
+    vsi_l_offset nTotOut = 0;
+    vsi_l_offset nLastPointOut = 0;
+    uLong nCRC = crc32(0L, nullptr, 0);
+    int ret = Z_OK;
+    bool bOK = true;
+    sStream.avail_out = 0;
+    do
+    {
+        const size_t nToRead = static_cast<size_t>(
+            std::min(static_cast<vsi_l_offset>(Z_BUFSIZE),
+                     offsetEndCompressedData - nPosInBaseHandle));
+        const size_t nRead =
+            nToRead ? m_poBaseHandle->Read(abyIn.data(), 1, nToRead) : 0;
+        if (nRead == 0)
+        {
+            // Truncated stream.
+            bOK = false;
+            break;
+        }
+        nPosInBaseHandle += nRead;
+        sStream.avail_in = static_cast<uInt>(nRead);
+        sStream.next_in = abyIn.data();
+        do
+        {
+            if (sStream.avail_out == 0)
+            {
+                sStream.avail_out = static_cast<uInt>(WINDOW_SIZE);
+                sStream.next_out = abyWindow.data();
+            }
+            const Bytef *pStart = sStream.next_out;
+            nTotIn += sStream.avail_in;
+            nTotOut += sStream.avail_out;
+            ret = inflate(&sStream, Z_BLOCK);
+            nTotIn -= sStream.avail_in;
+            nTotOut -= sStream.avail_out;
+            nCRC = crc32(nCRC, pStart,
+                         static_cast<uInt>(sStream.next_out - pStart));
+            if (ret != Z_OK && ret != Z_BUF_ERROR && ret != Z_STREAM_END)
+            {
+                bOK = false;
+                break;
+            }
+            if (ret == Z_STREAM_END)
+                break;
+
+            // At the end of a deflate block (but not of the last one)?
+            if ((sStream.data_type & 128) != 0 &&
+                (sStream.data_type & 64) == 0 &&
+                nTotOut - nLastPointOut >= nSpan)
+            {
+                VSIGZipIndexPoint oPoint;
+                oPoint.posInBaseHandle = startOff + nTotIn;
+                oPoint.bits = sStream.data_type & 7;
+                oPoint.out = nTotOut;
+                oPoint.crc = nCRC;
+
+                // Linearize the last 32 KB of the circular output window.
+                const size_t nWinPos = WINDOW_SIZE - sStream.avail_out;
+                const size_t nWindowSize = static_cast<size_t>(
+                    std::min(nTotOut, static_cast<vsi_l_offset>(WINDOW_SIZE)));
+                if (nWindowSize <= nWinPos)
+                {
+                    memcpy(abyLinearWindow.data(),
+                           abyWindow.data() + nWinPos - nWindowSize,
+                           nWindowSize);
+                }
+                else
+                {
+                    const size_t nOlder = nWindowSize - nWinPos;
+                    memcpy(abyLinearWindow.data(),
+                           abyWindow.data() + WINDOW_SIZE - nOlder, nOlder);
+                    memcpy(abyLinearWindow.data() + nOlder, abyWindow.data(),
+                           nWinPos);
+                }
+                size_t nCompressedSize = 0;
+                if (CPLZLibDeflate(abyLinearWindow.data(), nWindowSize, -1,
+                                   abyCompressedWindow.data(),
+                                   abyCompressedWindow.size(),
+                                   &nCompressedSize) == nullptr)
+                {
+                    bOK = false;
+                    break;
+                }
+                oPoint.nWindowSize = nWindowSize;
+                oPoint.abyCompressedWindow.assign(
+                    abyCompressedWindow.data(),
+                    abyCompressedWindow.data() + nCompressedSize);
+                poIndex->aoPoints.emplace_back(std::move(oPoint));
+                nLastPointOut = nTotOut;
+            }
+        } while (sStream.avail_in != 0);
+    } while (bOK && ret != Z_STREAM_END);
+
+    inflateEnd(&sStream);
+
+    if (m_poBaseHandle->Seek(nSavedPos, SEEK_SET) != 0)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Seek() failed");
+        bOK = false;
+    }
+    if (!bOK)
+        return nullptr;
+
+    // The uncompressed size is only known if the file has a single member,
+    // that is if the deflate stream is just followed by the 8-byte trailer.
+    if (startOff + nTotIn + 8 == offsetEndCompressedData)
+        poIndex->nUncompressedSize = nTotOut;
+    return poIndex;
+}
+
+/************************************************************************/
+/*                         RestoreIndexPoint()                          */
+/************************************************************************/
+
+bool VSIGZipHandle::RestoreIndexPoint(const VSIGZipIndexPoint &oPoint)
+{
+    if (inflateReset(&stream) != Z_OK)
+        return false;
+    if (oPoint.bits)
+    {
+        // The checkpoint is in the middle of a byte: feed its remaining bits.
+        GByte byVal = 0;
+        if (m_poBaseHandle->Seek(oPoint.posInBaseHandle - 1, SEEK_SET) != 0 ||
+            m_poBaseHandle->Read(&byVal, 1, 1) != 1 ||
+            inflatePrime(&stream, oPoint.bits, byVal >> (8 - oPoint.bits)) !=
+                Z_OK)
+        {
+            return false;
+        }
+    }
+    else if (m_poBaseHandle->Seek(oPoint.posInBaseHandle, SEEK_SET) != 0)
+    {
+        return false;
+    }
+    if (!SetIndexPointDictionary(&stream, oPoint))
+        return false;
+
+    stream.avail_in = 0;
+    stream.next_in = inbuf;
+    m_bStreamStateStale = false;
+    z_err = Z_OK;
+    z_eof = 0;
+    crc = oPoint.crc;
+    m_transparent = 0;
+    in = oPoint.posInBaseHandle - startOff;
+    out = oPoint.out;
+    return true;
+}
+
+/************************************************************************/
+/*                           WriteGZipIndex()                           */
+/************************************************************************/
+
+constexpr const char GZIP_INDEX_SIGNATURE[] = "GDALGZIX";
+constexpr GUInt32 GZIP_INDEX_VERSION = 1;
+
+static bool WriteGZipIndex(const char *pszFilename, const VSIGZipIndex &oIndex)
+{
+    VSILFILE *fp = VSIFOpenL(pszFilename, "wb");
+    if (fp == nullptr)
+        return false;
+
+    bool bOK = true;
+    const auto WriteUInt32 = [fp, &bOK](GUInt32 nVal)
+    {
+        CPL_LSBPTR32(&nVal);
+        bOK &= VSIFWriteL(&nVal, sizeof(nVal), 1, fp) == 1;
+    };
+    const auto WriteUInt64 = [fp, &bOK](GUInt64 nVal)
+    {
+        CPL_LSBPTR64(&nVal);
+        bOK &= VSIFWriteL(&nVal, sizeof(nVal), 1, fp) == 1;
+    };
+
+    bOK &= VSIFWriteL(GZIP_INDEX_SIGNATURE, 8, 1, fp) == 1;
+    WriteUInt32(GZIP_INDEX_VERSION);
+    WriteUInt64(oIndex.nCompressedSize);
+    bOK &= VSIFWriteL(oIndex.abyTrailer, 8, 1, fp) == 1;
+    WriteUInt64(oIndex.nUncompressedSize);
+    WriteUInt64(oIndex.aoPoints.size());
+    for (const auto &oPoint : oIndex.aoPoints)
+    {
+        WriteUInt64(oPoint.posInBaseHandle);
+        WriteUInt64(oPoint.out);
+        WriteUInt32(static_cast<GUInt32>(oPoint.crc));
+        WriteUInt32(static_cast<GUInt32>(oPoint.bits));
+        WriteUInt32(static_cast<GUInt32>(oPoint.nWindowSize));
+        WriteUInt32(static_cast<GUInt32>(oPoint.abyCompressedWindow.size()));
+        bOK &= VSIFWriteL(oPoint.abyCompressedWindow.data(), 1,
+                          oPoint.abyCompressedWindow.size(),
+                          fp) == oPoint.abyCompressedWindow.size();
+    }
+    bOK &= VSIFCloseL(fp) == 0;
+    if (!bOK)
+        VSIUnlink(pszFilename);
+    return bOK;
+}
+
+/************************************************************************/
+/*                           ReadGZipIndex()                            */
+/************************************************************************/
+
+static std::shared_ptr<VSIGZipIndex> ReadGZipIndex(const char *pszFilename)
+{
+    VSILFILE *fp = VSIFOpenL(pszFilename, "rb");
+    if (fp == nullptr)
+        return nullptr;
+
+    bool bOK = true;
+    const auto ReadUInt32 = [fp, &bOK]()
+    {
+        GUInt32 nVal = 0;
+        bOK &= VSIFReadL(&nVal, sizeof(nVal), 1, fp) == 1;
+        CPL_LSBPTR32(&nVal);
+        return nVal;
+    };
+    const auto ReadUInt64 = [fp, &bOK]()
+    {
+        GUInt64 nVal = 0;
+        bOK &= VSIFReadL(&nVal, sizeof(nVal), 1, fp) == 1;
+        CPL_LSBPTR64(&nVal);
+        return nVal;
+    };
+
+    auto poIndex = std::make_shared<VSIGZipIndex>();
+    char szSignature[8] = {};
+    bOK &= VSIFReadL(szSignature, 8, 1, fp) == 1 &&
+           memcmp(szSignature, GZIP_INDEX_SIGNATURE, 8) == 0;
+    bOK &= bOK && ReadUInt32() == GZIP_INDEX_VERSION;
+    poIndex->nCompressedSize = ReadUInt64();
+    bOK &= VSIFReadL(poIndex->abyTrailer, 8, 1, fp) == 1;
+    poIndex->nUncompressedSize = ReadUInt64();
+    const GUInt64 nPoints = ReadUInt64();
+    for (GUInt64 i = 0; bOK && i < nPoints; ++i)
+    {
+        VSIGZipIndexPoint oPoint;
+        oPoint.posInBaseHandle = ReadUInt64();
+        oPoint.out = ReadUInt64();
+        oPoint.crc = ReadUInt32();
+        oPoint.bits = static_cast<int>(ReadUInt32());
+        oPoint.nWindowSize = ReadUInt32();
+        const GUInt32 nCompressedWindowSize = ReadUInt32();
+        if (!bOK || oPoint.posInBaseHandle == 0 ||
+            oPoint.posInBaseHandle > poIndex->nCompressedSize ||
+            oPoint.bits < 0 || oPoint.bits > 7 ||
+            oPoint.nWindowSize > 32768 || nCompressedWindowSize > 65536 ||
+            (!poIndex->aoPoints.empty() &&
+             oPoint.out <= poIndex->aoPoints.back().out))
+        {
+            bOK = false;
+            break;
+        }
+        oPoint.abyCompressedWindow.resize(nCompressedWindowSize);
+        bOK &= VSIFReadL(oPoint.abyCompressedWindow.data(), 1,
+                         nCompressedWindowSize,
+                         fp) == nCompressedWindowSize;
+        poIndex->aoPoints.emplace_back(std::move(oPoint));
+    }
+    CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
+
+    if (!bOK)
+    {
+        CPLDebug("GZIP", "%s is not a valid /vsigzip/ index", pszFilename);
+        return nullptr;
+    }
+    return poIndex;
+}
+
+/************************************************************************/
+/*                    GetDecompressionThreadCount()                     */
+/************************************************************************/
+
+// Number of threads for parallel decompression, from GDAL_NUM_THREADS.
+// Defaults to 1, as for compression.
+static int GetDecompressionThreadCount()
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszThreads == nullptr)
+        return 1;
+    const int nThreads =
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads);
+    return std::max(1, std::min(128, nThreads));
+}
+
+/************************************************************************/
+/*                          LoadOrBuildIndex()                          */
+/************************************************************************/
+
+// Load the <filename>.gzidx sidecar seek index if it exists and matches the
+// file, or build and write it if CPL_VSIL_GZIP_WRITE_INDEX=YES.
+void VSIGZipHandle::LoadOrBuildIndex()
+{
+    if (m_transparent || m_pszBaseFileName == nullptr || m_poIndex)
+        return;
+
+    const bool bWriteIndex =
+        CPLTestBool(CPLGetConfigOption("CPL_VSIL_GZIP_WRITE_INDEX", "NO"));
+    if (!bWriteIndex)
+    {
+        // By default, only look for an index next to local files, to avoid
+        // a network request for each remote .gz file opened.
+        const char *pszUseIndex =
+            CPLGetConfigOption("CPL_VSIL_GZIP_USE_INDEX", nullptr);
+        if (pszUseIndex ? !CPLTestBool(pszUseIndex)
+                        : !VSIIsLocal(m_pszBaseFileName))
+        {
+            return;
+        }
+    }
+
+    const std::string osIndexFilename =
+        std::string(m_pszBaseFileName) + ".gzidx";
+    auto poIndex = ReadGZipIndex(osIndexFilename.c_str());
+    if (!poIndex && !bWriteIndex)
+        return;
+
+    GByte abyTrailer[8] = {};
+    if (!ReadTrailer(abyTrailer))
+        return;
+    if (poIndex && (poIndex->nCompressedSize != m_compressed_size ||
+                    memcmp(poIndex->abyTrailer, abyTrailer, 8) != 0))
+    {
+        CPLDebug("GZIP", "%s does not match %s. Ignoring it",
+                 osIndexFilename.c_str(), m_pszBaseFileName);
+        poIndex.reset();
+    }
+
+    if (!poIndex && bWriteIndex)
+    {
+        const char *pszSpan =
+            CPLGetConfigOption("CPL_VSIL_GZIP_INDEX_SPAN", "4M");
+        vsi_l_offset nSpan = static_cast<vsi_l_offset>(
+            std::max(0.0, CPLAtof(pszSpan)));
+        if (strchr(pszSpan, 'K'))
+            nSpan *= 1024;
+        else if (strchr(pszSpan, 'M'))
+            nSpan *= 1024 * 1024;
+        nSpan = std::max(nSpan, static_cast<vsi_l_offset>(Z_BUFSIZE));
+
+        CPLDebug("GZIP", "Building index for %s", m_pszBaseFileName);
+        poIndex = BuildIndex(nSpan);
+        if (poIndex)
+        {
+            poIndex->nCompressedSize = m_compressed_size;
+            memcpy(poIndex->abyTrailer, abyTrailer, 8);
+            if (!WriteGZipIndex(osIndexFilename.c_str(), *poIndex))
+            {
+                CPLDebug("GZIP", "Cannot write %s", osIndexFilename.c_str());
+            }
+        }
+    }
+
+    if (poIndex)
+    {
+        if (m_uncompressed_size == 0)
+            m_uncompressed_size = poIndex->nUncompressedSize;
+        m_poIndex = std::move(poIndex);
+        m_nReadThreads = GetDecompressionThreadCount();
+    }
+}
+
 /************************************************************************/
 /*                              Write()                                 */
 /************************************************************************/
@@ -3069,6 +3875,7 @@ VSIGZipFilesystemHandler::OpenGZipReadOnly(const char *pszFilename,
         delete poHandle;
         return nullptr;
     }
+    poHandle->LoadOrBuildIndex();
     return poHandle;
 }
 
@@ -3231,11 +4038,21 @@ const char *VSIGZipFilesystemHandler::GetOptions()
 {
     return "<Options>"
            "  <Option name='GDAL_NUM_THREADS' type='string' "
-           "description='Number of threads for compression. Either a integer "
-           "or ALL_CPUS'/>"
+           "description='Number of threads for compression and parallel "
+           "decompression. Either a integer or ALL_CPUS'/>"
            "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
            "description='Chunk of uncompressed data for parallelization. "
            "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
+           "  <Option name='CPL_VSIL_GZIP_WRITE_INDEX' type='boolean' "
+           "description='Whether to build and write a .gzidx seek index when "
+           "opening a file that has none' default='NO'/>"
+           "  <Option name='CPL_VSIL_GZIP_USE_INDEX' type='boolean' "
+           "description='Whether to use an existing .gzidx seek index. By "
+           "default, only for local files'/>"
+           "  <Option name='CPL_VSIL_GZIP_INDEX_SPAN' type='string' "
+           "description='Distance between checkpoints of the seek index, in "
+           "uncompressed bytes. Use K(ilobytes) or M(egabytes) suffix' "
+           "default='4M'/>"
            "</Options>";
 }
 
@@ -3478,6 +4295,12 @@ class VSIZipFilesystemHandler final : public VSIArchiveFilesystemHandler
 
     bool GetFileInfo(const char *pszFilename, VSIFileInZipInfo &info);
 
+  protected:
+    bool GetFileOffsetAsIntegers(const VSIArchiveEntryFileOffset *pOffset,
+                                 GUIntBig &nVal1, GUIntBig &nVal2) override;
+    VSIArchiveEntryFileOffset *
+    CreateFileOffsetFromIntegers(GUIntBig nVal1, GUIntBig nVal2) override;
+
   public:
     VSIZipFilesystemHandler() = default;
     ~VSIZipFilesystemHandler() override;
@@ -3633,6 +4456,187 @@ VSIZipFilesystemHandler::CreateReader(const char *pszZipFileName)
     return poReader;
 }
 
+/************************************************************************/
+/*                      GetFileOffsetAsIntegers()                       */
+/************************************************************************/
+
+bool VSIZipFilesystemHandler::GetFileOffsetAsIntegers(
+    const VSIArchiveEntryFileOffset *pOffset, GUIntBig &nVal1,
+    GUIntBig &nVal2)
+{
+    const VSIZipEntryFileOffset *pZipOffset =
+        cpl::down_cast<const VSIZipEntryFileOffset *>(pOffset);
+    nVal1 = pZipOffset->m_file_pos.pos_in_zip_directory;
+    nVal2 = pZipOffset->m_file_pos.num_of_file;
+    return true;
+}
+
+/************************************************************************/
+/*                    CreateFileOffsetFromIntegers()                    */
+/************************************************************************/
+
+VSIArchiveEntryFileOffset *
+VSIZipFilesystemHandler::CreateFileOffsetFromIntegers(GUIntBig nVal1,
+                                                      GUIntBig nVal2)
+{
+    unz_file_pos file_pos;
+    file_pos.pos_in_zip_directory = nVal1;
+    file_pos.num_of_file = nVal2;
+    return new VSIZipEntryFileOffset(file_pos);
+}
+
+/************************************************************************/
+/*                        VSISOZipDecompressor                          */
+/************************************************************************/
+
+// Decompressor of SOZip chunks, that are independent raw deflate streams
+// terminated by a sync flush.
+class VSISOZipDecompressor
+{
+#ifdef HAVE_LIBDEFLATE
+    struct libdeflate_decompressor *pDecompressor_ = nullptr;
+#else
+    z_stream sStream_{};
+#endif
+    bool bOK_ = true;
+
+    VSISOZipDecompressor(const VSISOZipDecompressor &) = delete;
+    VSISOZipDecompressor &operator=(const VSISOZipDecompressor &) = delete;
+
+  public:
+    VSISOZipDecompressor();
+    ~VSISOZipDecompressor();
+
+    bool IsOK() const
+    {
+        return bOK_;
+    }
+
+    bool Decompress(GByte *pabyCompressedData, size_t nCompressedSize,
+                    GByte *pabyOut, size_t nOutSize, vsi_l_offset nPos,
+                    bool bEmitErrors);
+};
+
+/************************************************************************/
+/*                       VSISOZipDecompressor()                         */
+/************************************************************************/
+
+VSISOZipDecompressor::VSISOZipDecompressor()
+{
+#ifdef HAVE_LIBDEFLATE
+    pDecompressor_ = libdeflate_alloc_decompressor();
+    if (!pDecompressor_)
+        bOK_ = false;
+#else
+    memset(&sStream_, 0, sizeof(sStream_));
+    int err = inflateInit2(&sStream_, -MAX_WBITS);
+    if (err != Z_OK)
+        bOK_ = false;
+#endif
+}
+
+/************************************************************************/
+/*                      ~VSISOZipDecompressor()                         */
+/************************************************************************/
+
+VSISOZipDecompressor::~VSISOZipDecompressor()
+{
+    if (bOK_)
+    {
+#ifdef HAVE_LIBDEFLATE
+        libdeflate_free_decompressor(pDecompressor_);
+#else
+        inflateEnd(&sStream_);
+#endif
+    }
+}
+
+/************************************************************************/
+/*                            Decompress()                              */
+/************************************************************************/
+
+// Decompress a chunk, whose uncompressed size must be exactly nOutSize.
+// pabyCompressedData is modified.
+bool VSISOZipDecompressor::Decompress(GByte *pabyCompressedData,
+                                      size_t nCompressedSize, GByte *pabyOut,
+                                      size_t nOutSize, vsi_l_offset nPos,
+                                      bool bEmitErrors)
+{
+    if (nCompressedSize >= 5 &&
+        pabyCompressedData[nCompressedSize - 5] == 0x00 &&
+        memcmp(&pabyCompressedData[nCompressedSize - 4], "\x00\x00\xFF\xFF",
+               4) == 0)
+    {
+        // Tag this flush block as the last one.
+        pabyCompressedData[nCompressedSize - 5] = 0x01;
+    }
+
+#ifdef HAVE_LIBDEFLATE
+    size_t nOut = 0;
+    if (libdeflate_deflate_decompress(pDecompressor_, pabyCompressedData,
+                                      nCompressedSize, pabyOut, nOutSize,
+                                      &nOut) != LIBDEFLATE_SUCCESS)
+    {
+        if (bEmitErrors)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "libdeflate_deflate_decompress() failed at "
+                     "pos " CPL_FRMT_GUIB,
+                     static_cast<GUIntBig>(nPos));
+        }
+        return false;
+    }
+    if (nOut != nOutSize)
+    {
+        if (bEmitErrors)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Only %u bytes decompressed at pos " CPL_FRMT_GUIB
+                     " whereas %u where expected",
+                     static_cast<unsigned>(nOut), static_cast<GUIntBig>(nPos),
+                     static_cast<unsigned>(nOutSize));
+        }
+        return false;
+    }
+#else
+    sStream_.avail_in = static_cast<uInt>(nCompressedSize);
+    sStream_.next_in = pabyCompressedData;
+    sStream_.avail_out = static_cast<uInt>(nOutSize);
+    sStream_.next_out = pabyOut;
+
+    int err = inflate(&sStream_, Z_FINISH);
+    if ((err != Z_OK && err != Z_STREAM_END))
+    {
+        if (bEmitErrors)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "inflate() failed at pos " CPL_FRMT_GUIB,
+                     static_cast<GUIntBig>(nPos));
+        }
+        inflateReset(&sStream_);
+        return false;
+    }
+    if (sStream_.avail_in != 0)
+        CPLDebug("VSIZIP", "avail_in = %d", sStream_.avail_in);
+    if (sStream_.avail_out != 0)
+    {
+        if (bEmitErrors)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Only %u bytes decompressed at pos " CPL_FRMT_GUIB
+                     " whereas %u where expected",
+                     static_cast<unsigned>(nOutSize - sStream_.avail_out),
+                     static_cast<GUIntBig>(nPos),
+                     static_cast<unsigned>(nOutSize));
+        }
+        inflateReset(&sStream_);
+        return false;
+    }
+    inflateReset(&sStream_);
+#endif
+    return true;
+}
+
 /************************************************************************/
 /*                         VSISOZipHandle                               */
 /************************************************************************/
@@ -3648,12 +4652,18 @@ class VSISOZipHandle final : public VSIVirtualHandle
     uint32_t nChunkSize_;
     bool bEOF_ = false;
     vsi_l_offset nCurPos_ = 0;
-    bool bOK_ = true;
-#ifdef HAVE_LIBDEFLATE
-    struct libdeflate_decompressor *pDecompressor_ = nullptr;
-#else
-    z_stream sStream_{};
-#endif
+    VSISOZipDecompressor oDecompressor_{};
+    int nThreads_ = 1;
+    std::unique_ptr<CPLWorkerThreadPool> poPool_{};
+    vsi_l_offset nLastReadEnd_ = static_cast<vsi_l_offset>(-1);
+    vsi_l_offset nReadAheadPos_ = 0;
+    std::vector<GByte> abyReadAhead_{};
+
+    struct DecompressJob;
+    static void DecompressJobFunc(void *pData);
+
+    uint64_t ReadOffsetInCompressedStream(uint64_t nChunkIdx);
+    bool ReadParallel(GByte *pabyBuffer, vsi_l_offset nPos, size_t nToRead);
 
     VSISOZipHandle(const VSISOZipHandle &) = delete;
     VSISOZipHandle &operator=(const VSISOZipHandle &) = delete;
@@ -3662,7 +4672,7 @@ class VSISOZipHandle final : public VSIVirtualHandle
     VSISOZipHandle(VSIVirtualHandle *poVirtualHandle,
                    vsi_l_offset nPosCompressedStream, uint64_t compressed_size,
                    uint64_t uncompressed_size, vsi_l_offset indexPos,
-                   uint32_t nToSkip, uint32_t nChunkSize);
+                   uint32_t nToSkip, uint32_t nChunkSize, int nThreads);
     ~VSISOZipHandle() override;
 
     virtual int Seek(vsi_l_offset nOffset, int nWhence) override;
@@ -3683,7 +4693,7 @@ class VSISOZipHandle final : public VSIVirtualHandle
 
     bool IsOK() const
     {
-        return bOK_;
+        return oDecompressor_.IsOK();
     }
 };
 
@@ -3696,22 +4706,13 @@ VSISOZipHandle::VSISOZipHandle(VSIVirtualHandle *poVirtualHandle,
                                uint64_t compressed_size,
                                uint64_t uncompressed_size,
                                vsi_l_offset indexPos, uint32_t nToSkip,
-                               uint32_t nChunkSize)
+                               uint32_t nChunkSize, int nThreads)
     : poBaseHandle_(poVirtualHandle),
       nPosCompressedStream_(nPosCompressedStream),
       compressed_size_(compressed_size), uncompressed_size_(uncompressed_size),
-      indexPos_(indexPos), nToSkip_(nToSkip), nChunkSize_(nChunkSize)
+      indexPos_(indexPos), nToSkip_(nToSkip), nChunkSize_(nChunkSize),
+      nThreads_(nThreads)
 {
-#ifdef HAVE_LIBDEFLATE
-    pDecompressor_ = libdeflate_alloc_decompressor();
-    if (!pDecompressor_)
-        bOK_ = false;
-#else
-    memset(&sStream_, 0, sizeof(sStream_));
-    int err = inflateInit2(&sStream_, -MAX_WBITS);
-    if (err != Z_OK)
-        bOK_ = false;
-#endif
 }
 
 /************************************************************************/
@@ -3721,14 +4722,6 @@ VSISOZipHandle::VSISOZipHandle(VSIVirtualHandle *poVirtualHandle,
 VSISOZipHandle::~VSISOZipHandle()
 {
     VSISOZipHandle::Close();
-    if (bOK_)
-    {
-#ifdef HAVE_LIBDEFLATE
-        libdeflate_free_decompressor(pDecompressor_);
-#else
-        inflateEnd(&sStream_);
-#endif
-    }
 }
 
 /************************************************************************/
@@ -3758,6 +4751,166 @@ int VSISOZipHandle::Seek(vsi_l_offset nOffset, int nWhence)
     return 0;
 }
 
+/************************************************************************/
+/*                    ReadOffsetInCompressedStream()                    */
+/************************************************************************/
+
+uint64_t VSISOZipHandle::ReadOffsetInCompressedStream(uint64_t nChunkIdx)
+{
+    if (nChunkIdx == 0)
+        return 0;
+    if (nChunkIdx == 1 + (uncompressed_size_ - 1) / nChunkSize_)
+        return compressed_size_;
+    constexpr size_t nOffsetSize = 8;
+    if (poBaseHandle_->Seek(indexPos_ + 32 + nToSkip_ +
+                                (nChunkIdx - 1) * nOffsetSize,
+                            SEEK_SET) != 0)
+        return static_cast<uint64_t>(-1);
+
+    uint64_t nOffset;
+    if (poBaseHandle_->Read(&nOffset, sizeof(nOffset), 1) != 1)
+        return static_cast<uint64_t>(-1);
+    CPL_LSBPTR64(&nOffset);
+    return nOffset;
+}
+
+/************************************************************************/
+/*                           DecompressJob                              */
+/************************************************************************/
+
+// Decompression of a range of consecutive chunks by a worker thread
+struct VSISOZipHandle::DecompressJob
+{
+    GByte *pabyCompressedData = nullptr;  // of the first chunk of the read
+    const uint64_t *panOffsets = nullptr; // relative to the first chunk
+    GByte *pabyOut = nullptr;             // of the first chunk of the read
+    size_t nChunkSize = 0;
+    size_t nToRead = 0;
+    size_t iFirstChunk = 0;
+    size_t iLastChunk = 0;  // excluded
+    bool bOK = false;
+};
+
+/************************************************************************/
+/*                         DecompressJobFunc()                          */
+/************************************************************************/
+
+void VSISOZipHandle::DecompressJobFunc(void *pData)
+{
+    auto psJob = static_cast<DecompressJob *>(pData);
+    VSISOZipDecompressor oDecompressor;
+    psJob->bOK = oDecompressor.IsOK();
+    for (size_t i = psJob->iFirstChunk; psJob->bOK && i < psJob->iLastChunk;
+         ++i)
+    {
+        const size_t nOffsetOut = i * psJob->nChunkSize;
+        psJob->bOK = oDecompressor.Decompress(
+            psJob->pabyCompressedData + psJob->panOffsets[i],
+            static_cast<size_t>(psJob->panOffsets[i + 1] -
+                                psJob->panOffsets[i]),
+            psJob->pabyOut + nOffsetOut,
+            std::min(psJob->nChunkSize, psJob->nToRead - nOffsetOut), 0,
+            false);
+    }
+}
+
+/************************************************************************/
+/*                           ReadParallel()                             */
+/************************************************************************/
+
+// Read several chunks starting at nPos at once, and decompress them with
+// the global pool of worker threads.
+bool VSISOZipHandle::ReadParallel(GByte *pabyBuffer, vsi_l_offset nPos,
+                                  size_t nToRead)
+{
+    const uint64_t nFirstChunk = nPos / nChunkSize_;
+    const size_t nChunks = static_cast<size_t>(
+        (static_cast<uint64_t>(nToRead) + nChunkSize_ - 1) / nChunkSize_);
+
+    std::vector<uint64_t> anOffsets;
+    anOffsets.reserve(nChunks + 1);
+    for (size_t i = 0; i <= nChunks; ++i)
+    {
+        const uint64_t nOffset = ReadOffsetInCompressedStream(nFirstChunk + i);
+        if (nOffset == static_cast<uint64_t>(-1) ||
+            (i > 0 && (nOffset <= anOffsets.back() ||
+                       nOffset - anOffsets.back() > 13 + 2 * nChunkSize_)) ||
+            nOffset > compressed_size_)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Invalid value for offset of chunk " CPL_FRMT_GUIB
+                     " in compressed stream",
+                     static_cast<GUIntBig>(nFirstChunk + i));
+            return false;
+        }
+        anOffsets.push_back(nOffset);
+    }
+
+    const uint64_t nStartOffset = anOffsets[0];
+    for (auto &nOffset : anOffsets)
+        nOffset -= nStartOffset;
+    std::vector<GByte> abyCompressedData;
+    try
+    {
+        abyCompressedData.resize(static_cast<size_t>(anOffsets.back()));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for compressed data");
+        return false;
+    }
+    if (poBaseHandle_->Seek(nPosCompressedStream_ + nStartOffset, SEEK_SET) !=
+            0 ||
+        poBaseHandle_->Read(abyCompressedData.data(), 1,
+                            abyCompressedData.size()) !=
+            abyCompressedData.size())
+    {
+        return false;
+    }
+
+    if (poPool_ == nullptr)
+    {
+        poPool_.reset(new CPLWorkerThreadPool());
+        if (!poPool_->Setup(nThreads_, nullptr, nullptr, false))
+            poPool_.reset();
+    }
+    auto poJobQueue = poPool_ ? poPool_->CreateJobQueue() : nullptr;
+
+    const size_t nJobs = std::min(nChunks, static_cast<size_t>(nThreads_));
+    std::vector<DecompressJob> asJobs(nJobs);
+    for (size_t i = 0; i < nJobs; ++i)
+    {
+        auto &sJob = asJobs[i];
+        sJob.pabyCompressedData = abyCompressedData.data();
+        sJob.panOffsets = anOffsets.data();
+        sJob.pabyOut = pabyBuffer;
+        sJob.nChunkSize = nChunkSize_;
+        sJob.nToRead = nToRead;
+        sJob.iFirstChunk = i * nChunks / nJobs;
+        sJob.iLastChunk = (i + 1) * nChunks / nJobs;
+        if (!poJobQueue || !poJobQueue->SubmitJob(DecompressJobFunc, &sJob))
+            DecompressJobFunc(&sJob);
+    }
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+
+    for (const auto &sJob : asJobs)
+    {
+        if (!sJob.bOK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Decompression failed in chunks " CPL_FRMT_GUIB
+                     " to " CPL_FRMT_GUIB,
+                     static_cast<GUIntBig>(nFirstChunk + sJob.iFirstChunk),
+                     static_cast<GUIntBig>(nFirstChunk + sJob.iLastChunk - 1));
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /************************************************************************/
 /*                              Read()                                  */
 /************************************************************************/
@@ -3794,25 +4947,52 @@ size_t VSISOZipHandle::Read(void *pBuffer, size_t nSize, size_t nCount)
         return 0;
     }
 
-    const auto ReadOffsetInCompressedStream =
-        [this](uint64_t nChunkIdx) -> uint64_t
+    const bool bSequential = nCurPos_ == nLastReadEnd_;
+    nLastReadEnd_ = nCurPos_ + nToRead;
+
+    // Serve the request from chunks decompressed ahead by a previous
+    // sequential read.
+    if (nCurPos_ >= nReadAheadPos_ &&
+        nCurPos_ + nToRead <= nReadAheadPos_ + abyReadAhead_.size())
+    {
+        memcpy(pBuffer,
+               abyReadAhead_.data() +
+                   static_cast<size_t>(nCurPos_ - nReadAheadPos_),
+               nToRead);
+        nCurPos_ += nToRead;
+        return nCount;
+    }
+
+    // Only decompress several chunks in parallel for large reads, or when
+    // reading sequentially, in which case the following chunks are likely
+    // to be requested soon. Random small reads decompress only what they
+    // need.
+    if (nThreads_ > 1 && nToRead > nChunkSize_)
     {
-        if (nChunkIdx == 0)
+        if (!ReadParallel(static_cast<GByte *>(pBuffer), nCurPos_, nToRead))
             return 0;
-        if (nChunkIdx == 1 + (uncompressed_size_ - 1) / nChunkSize_)
-            return compressed_size_;
-        constexpr size_t nOffsetSize = 8;
-        if (poBaseHandle_->Seek(indexPos_ + 32 + nToSkip_ +
-                                    (nChunkIdx - 1) * nOffsetSize,
-                                SEEK_SET) != 0)
-            return static_cast<uint64_t>(-1);
-
-        uint64_t nOffset;
-        if (poBaseHandle_->Read(&nOffset, sizeof(nOffset), 1) != 1)
-            return static_cast<uint64_t>(-1);
-        CPL_LSBPTR64(&nOffset);
-        return nOffset;
-    };
+        nCurPos_ += nToRead;
+        return nCount;
+    }
+    if (nThreads_ > 1 && bSequential)
+    {
+        const size_t nReadAhead = static_cast<size_t>(
+            std::min(static_cast<uint64_t>(nChunkSize_) * nThreads_,
+                     static_cast<uint64_t>(uncompressed_size_ - nCurPos_)));
+        if (nReadAhead > nToRead)
+        {
+            abyReadAhead_.resize(nReadAhead);
+            if (ReadParallel(abyReadAhead_.data(), nCurPos_, nReadAhead))
+            {
+                nReadAheadPos_ = nCurPos_;
+                memcpy(pBuffer, abyReadAhead_.data(), nToRead);
+                nCurPos_ += nToRead;
+                return nCount;
+            }
+            abyReadAhead_.clear();
+            return 0;
+        }
+    }
 
     size_t nOffsetInOutputBuffer = 0;
     while (true)
@@ -3868,70 +5048,14 @@ size_t VSISOZipHandle::Read(void *pBuffer, size_t nSize, size_t nCount)
         size_t nToReadThisIter =
             std::min(nToRead, static_cast<size_t>(nChunkSize_));
 
-        if (nCompressedToRead >= 5 &&
-            abyCompressedData[nCompressedToRead - 5] == 0x00 &&
-            memcmp(&abyCompressedData[nCompressedToRead - 4],
-                   "\x00\x00\xFF\xFF", 4) == 0)
-        {
-            // Tag this flush block as the last one.
-            abyCompressedData[nCompressedToRead - 5] = 0x01;
-        }
-
-#ifdef HAVE_LIBDEFLATE
-        size_t nOut = 0;
-        if (libdeflate_deflate_decompress(
-                pDecompressor_, &abyCompressedData[0], nCompressedToRead,
-                static_cast<Bytef *>(pBuffer) + nOffsetInOutputBuffer,
-                nToReadThisIter, &nOut) != LIBDEFLATE_SUCCESS)
+        if (!oDecompressor_.Decompress(
+                &abyCompressedData[0], nCompressedToRead,
+                static_cast<GByte *>(pBuffer) + nOffsetInOutputBuffer,
+                nToReadThisIter, nCurPos_, true))
         {
-            CPLError(
-                CE_Failure, CPLE_AppDefined,
-                "libdeflate_deflate_decompress() failed at pos " CPL_FRMT_GUIB,
-                static_cast<GUIntBig>(nCurPos_));
             return 0;
         }
-        if (nOut != nToReadThisIter)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Only %u bytes decompressed at pos " CPL_FRMT_GUIB
-                     " whereas %u where expected",
-                     static_cast<unsigned>(nOut),
-                     static_cast<GUIntBig>(nCurPos_),
-                     static_cast<unsigned>(nToReadThisIter));
-            return 0;
-        }
-#else
-        sStream_.avail_in = nCompressedToRead;
-        sStream_.next_in = &abyCompressedData[0];
-        sStream_.avail_out = static_cast<int>(nToReadThisIter);
-        sStream_.next_out =
-            static_cast<Bytef *>(pBuffer) + nOffsetInOutputBuffer;
-
-        int err = inflate(&sStream_, Z_FINISH);
-        if ((err != Z_OK && err != Z_STREAM_END))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "inflate() failed at pos " CPL_FRMT_GUIB,
-                     static_cast<GUIntBig>(nCurPos_));
-            inflateReset(&sStream_);
-            return 0;
-        }
-        if (sStream_.avail_in != 0)
-            CPLDebug("VSIZIP", "avail_in = %d", sStream_.avail_in);
-        if (sStream_.avail_out != 0)
-        {
-            CPLError(
-                CE_Failure, CPLE_AppDefined,
-                "Only %u bytes decompressed at pos " CPL_FRMT_GUIB
-                " whereas %u where expected",
-                static_cast<unsigned>(nToReadThisIter - sStream_.avail_out),
-                static_cast<GUIntBig>(nCurPos_),
-                static_cast<unsigned>(nToReadThisIter));
-            inflateReset(&sStream_);
-            return 0;
-        }
-        inflateReset(&sStream_);
-#endif
+
         nOffsetInOutputBuffer += nToReadThisIter;
         nCurPos_ += nToReadThisIter;
         nToRead -= nToReadThisIter;
@@ -4242,16 +5366,24 @@ VSIVirtualHandle *VSIZipFilesystemHandler::Open(const char *pszFilename,
     {
         if (info.bSOZipIndexValid)
         {
+            // Number of chunks decompressed in parallel on large or
+            // sequential reads (up to 16 MB at a time).
+            const int nThreads = std::max(
+                1, std::min(GetDecompressionThreadCount(),
+                            static_cast<int>((16 * 1024 * 1024) /
+                                             info.nSOZIPChunkSize)));
             auto poSOZIPHandle = new VSISOZipHandle(
                 info.poVirtualHandle.release(), info.nStartDataStream,
                 info.nCompressedSize, info.nUncompressedSize,
-                info.nSOZIPStartData, info.nSOZIPToSkip, info.nSOZIPChunkSize);
+                info.nSOZIPStartData, info.nSOZIPToSkip, info.nSOZIPChunkSize,
+                nThreads);
             if (!poSOZIPHandle->IsOK())
             {
                 delete poSOZIPHandle;
                 return nullptr;
             }
-            return VSICreateCachedFile(poSOZIPHandle, info.nSOZIPChunkSize, 0);
+            return VSICreateCachedFile(poSOZIPHandle, info.nSOZIPChunkSize,
+                                       0);
         }
 
         VSIGZipHandle *poGZIPHandle = new VSIGZipHandle(
@@ -4562,8 +5694,8 @@ const char *VSIZipFilesystemHandler::GetOptions()
 {
     return "<Options>"
            "  <Option name='GDAL_NUM_THREADS' type='string' "
-           "description='Number of threads for compression. Either a integer "
-           "or ALL_CPUS'/>"
+           "description='Number of threads for compression and parallel "
+           "decompression. Either a integer or ALL_CPUS'/>"
            "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
            "description='Chunk of uncompressed data for parallelization. "
            "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
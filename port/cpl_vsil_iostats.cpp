@@ -0,0 +1,643 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Collection of I/O statistics on virtual file handles
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_vsi_virtual.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "cpl_conv.h"
+#include "cpl_json.h"
+#include "cpl_string.h"
+
+//! @cond Doxygen_Suppress
+
+namespace
+{
+
+/************************************************************************/
+/*                          IOStatsCounters                             */
+/************************************************************************/
+
+// Upper bounds (inclusive) of the buckets of the read size histogram.
+constexpr std::array<GUIntBig, 4> READ_SIZE_BOUNDS = {512, 4096, 65536,
+                                                      1024 * 1024};
+constexpr const char *const READ_SIZE_LABELS[] = {"<=512", "<=4K", "<=64K",
+                                                  "<=1M", ">1M"};
+
+// Upper bounds (inclusive) of the buckets of the seek distance histogram,
+// for each direction. The seek distance is the distance between the start
+// of a read and the end of the previous one on the same file handle.
+constexpr std::array<GUIntBig, 3> SEEK_DISTANCE_BOUNDS = {4096, 65536,
+                                                          1024 * 1024};
+constexpr const char *const SEEK_DISTANCE_LABELS[] = {
+    "sequential",     "forward <=4K",  "forward <=64K",
+    "forward <=1M",   "forward >1M",   "backward <=4K",
+    "backward <=64K", "backward <=1M", "backward >1M"};
+
+// Upper bounds (exclusive), in microseconds, of the buckets of the latency
+// histograms.
+constexpr std::array<double, 6> LATENCY_BOUNDS = {10, 100, 1e3,
+                                                  1e4, 1e5, 1e6};
+constexpr const char *const LATENCY_LABELS[] = {
+    "<10us", "<100us", "<1ms", "<10ms", "<100ms", "<1s", ">=1s"};
+
+template <size_t N, class T>
+static size_t GetBucket(const std::array<T, N> &anBounds, T nVal)
+{
+    size_t i = 0;
+    while (i < N && nVal > anBounds[i])
+        ++i;
+    return i;
+}
+
+struct IOStatsCounters
+{
+    GIntBig nOpen = 0;
+    GIntBig nStat = 0;
+    GIntBig nRead = 0;
+    GIntBig nReadBytes = 0;
+    GIntBig nReadMultiRange = 0;
+    GIntBig nWrite = 0;
+    GIntBig nWriteBytes = 0;
+    double dfReadTime = 0;
+    double dfWriteTime = 0;
+    std::array<GIntBig, READ_SIZE_BOUNDS.size() + 1> anReadSize{};
+    std::array<GIntBig, 1 + 2 * (SEEK_DISTANCE_BOUNDS.size() + 1)>
+        anSeekDistance{};
+    std::array<GIntBig, LATENCY_BOUNDS.size() + 1> anReadLatency{};
+    std::array<GIntBig, LATENCY_BOUNDS.size() + 1> anWriteLatency{};
+
+    void AddRead(size_t nBytes, double dfSeconds)
+    {
+        nRead++;
+        nReadBytes += static_cast<GIntBig>(nBytes);
+        dfReadTime += dfSeconds;
+        anReadSize[GetBucket(READ_SIZE_BOUNDS,
+                             static_cast<GUIntBig>(nBytes))]++;
+        anReadLatency[GetBucket(LATENCY_BOUNDS, dfSeconds * 1e6)]++;
+    }
+
+    void AddSeekDistance(vsi_l_offset nPrevEnd, vsi_l_offset nOffset)
+    {
+        if (nOffset == nPrevEnd)
+            anSeekDistance[0]++;
+        else if (nOffset > nPrevEnd)
+            anSeekDistance[1 + GetBucket(SEEK_DISTANCE_BOUNDS,
+                                         static_cast<GUIntBig>(
+                                             nOffset - nPrevEnd))]++;
+        else
+            anSeekDistance[2 + SEEK_DISTANCE_BOUNDS.size() +
+                           GetBucket(SEEK_DISTANCE_BOUNDS,
+                                     static_cast<GUIntBig>(nPrevEnd -
+                                                           nOffset))]++;
+    }
+
+    void AddWrite(size_t nBytes, double dfSeconds)
+    {
+        nWrite++;
+        nWriteBytes += static_cast<GIntBig>(nBytes);
+        dfWriteTime += dfSeconds;
+        anWriteLatency[GetBucket(LATENCY_BOUNDS, dfSeconds * 1e6)]++;
+    }
+
+    void AsJSON(CPLJSONObject &oJSON) const;
+};
+
+/************************************************************************/
+/*                      IOStatsCounters::AsJSON()                       */
+/************************************************************************/
+
+template <size_t N>
+static void AddHistogram(CPLJSONObject &oJSON, const char *pszName,
+                         const std::array<GIntBig, N> &anValues,
+                         const char *const *papszLabels)
+{
+    CPLJSONObject oHisto;
+    for (size_t i = 0; i < N; ++i)
+    {
+        if (anValues[i])
+            oHisto.Add(papszLabels[i], anValues[i]);
+    }
+    oJSON.Add(pszName, oHisto);
+}
+
+void IOStatsCounters::AsJSON(CPLJSONObject &oJSON) const
+{
+    if (nOpen)
+        oJSON.Add("open_count", nOpen);
+    if (nStat)
+        oJSON.Add("stat_count", nStat);
+    if (nRead)
+    {
+        oJSON.Add("read_count", nRead);
+        oJSON.Add("read_bytes", nReadBytes);
+        if (nReadMultiRange)
+            oJSON.Add("read_multi_range_count", nReadMultiRange);
+        oJSON.Add("read_time_s", dfReadTime);
+        AddHistogram(oJSON, "read_size_histogram", anReadSize,
+                     READ_SIZE_LABELS);
+        AddHistogram(oJSON, "seek_distance_histogram", anSeekDistance,
+                     SEEK_DISTANCE_LABELS);
+        AddHistogram(oJSON, "read_latency_histogram", anReadLatency,
+                     LATENCY_LABELS);
+    }
+    if (nWrite)
+    {
+        oJSON.Add("write_count", nWrite);
+        oJSON.Add("write_bytes", nWriteBytes);
+        oJSON.Add("write_time_s", dfWriteTime);
+        AddHistogram(oJSON, "write_latency_histogram", anWriteLatency,
+                     LATENCY_LABELS);
+    }
+}
+
+/************************************************************************/
+/*                          IOStatisticsLogger                          */
+/************************************************************************/
+
+class IOStatisticsLogger
+{
+    struct FileSystemStats
+    {
+        IOStatsCounters counters{};
+        std::map<std::string, IOStatsCounters> files{};
+        // Files beyond the CPL_VSIL_IO_STATS_MAX_FILES first ones
+        IOStatsCounters otherFiles{};
+        bool bHasOtherFiles = false;
+    };
+
+    static int gnEnabled;
+    static size_t gnMaxFiles;
+    static std::mutex gMutex;
+    static std::map<std::string, FileSystemStats> gMapStats;
+
+    static void ReadEnabled();
+
+  public:
+    static inline bool IsEnabled()
+    {
+        if (gnEnabled < 0)
+        {
+            ReadEnabled();
+        }
+        return gnEnabled == TRUE;
+    }
+
+    // Call the passed function on the counters of the file system and of
+    // the file, under the protection of the mutex.
+    template <class Func>
+    static void Update(const std::string &osFileSystem,
+                       const std::string &osFilename, Func func)
+    {
+        std::lock_guard<std::mutex> oLock(gMutex);
+        auto &oFSStats = gMapStats[osFileSystem];
+        func(oFSStats.counters);
+        auto oIter = oFSStats.files.find(osFilename);
+        if (oIter != oFSStats.files.end())
+            func(oIter->second);
+        else if (oFSStats.files.size() < gnMaxFiles)
+            func(oFSStats.files[osFilename]);
+        else
+        {
+            oFSStats.bHasOtherFiles = true;
+            func(oFSStats.otherFiles);
+        }
+    }
+
+    static void Reset();
+
+    static std::string GetReportAsSerializedJSON();
+};
+
+int IOStatisticsLogger::gnEnabled = -1;  // unknown state
+size_t IOStatisticsLogger::gnMaxFiles = 0;
+std::mutex IOStatisticsLogger::gMutex{};
+std::map<std::string, IOStatisticsLogger::FileSystemStats>
+    IOStatisticsLogger::gMapStats{};
+
+static void ShowIOStats()
+{
+    printf("I/O statistics:\n%s\n",  // ok
+           IOStatisticsLogger::GetReportAsSerializedJSON().c_str());
+}
+
+void IOStatisticsLogger::ReadEnabled()
+{
+    const bool bShowIOStats =
+        CPLTestBool(CPLGetConfigOption("CPL_VSIL_SHOW_IO_STATS", "NO"));
+    gnEnabled = (bShowIOStats || CPLTestBool(CPLGetConfigOption(
+                                     "CPL_VSIL_IO_STATS_ENABLED", "NO")))
+                    ? TRUE
+                    : FALSE;
+    gnMaxFiles = static_cast<size_t>(std::max(
+        0, atoi(CPLGetConfigOption("CPL_VSIL_IO_STATS_MAX_FILES", "1000"))));
+    if (bShowIOStats)
+    {
+        static bool bRegistered = false;
+        if (!bRegistered)
+        {
+            bRegistered = true;
+            atexit(ShowIOStats);
+        }
+    }
+}
+
+void IOStatisticsLogger::Reset()
+{
+    std::lock_guard<std::mutex> oLock(gMutex);
+    gMapStats.clear();
+    gnEnabled = -1;
+}
+
+std::string IOStatisticsLogger::GetReportAsSerializedJSON()
+{
+    std::lock_guard<std::mutex> oLock(gMutex);
+
+    CPLJSONObject oJSON;
+    CPLJSONObject oFileSystems;
+    for (const auto &kvFS : gMapStats)
+    {
+        CPLJSONObject oFS;
+        kvFS.second.counters.AsJSON(oFS);
+        CPLJSONObject oFiles;
+        for (const auto &kvFile : kvFS.second.files)
+        {
+            CPLJSONObject oFile;
+            kvFile.second.AsJSON(oFile);
+            oFiles.Add(kvFile.first, oFile);
+        }
+        oFS.Add("files", oFiles);
+        if (kvFS.second.bHasOtherFiles)
+        {
+            CPLJSONObject oOtherFiles;
+            kvFS.second.otherFiles.AsJSON(oOtherFiles);
+            oFS.Add("other_files", oOtherFiles);
+        }
+        oFileSystems.Add(kvFS.first, oFS);
+    }
+    oJSON.Add("filesystems", oFileSystems);
+    return oJSON.Format(CPLJSONObject::PrettyFormat::Pretty);
+}
+
+/************************************************************************/
+/*                          GetFileSystemName()                         */
+/************************************************************************/
+
+// Returns "vsimem" for "/vsimem/foo", and "local" for regular files.
+static std::string GetFileSystemName(const char *pszFilename)
+{
+    if (!STARTS_WITH(pszFilename, "/vsi"))
+        return "local";
+    const char *pszStart = pszFilename + 1;
+    const char *pszEnd = pszStart;
+    while (*pszEnd != '\0' && *pszEnd != '/' && *pszEnd != '?')
+        ++pszEnd;
+    return std::string(pszStart, pszEnd - pszStart);
+}
+
+/************************************************************************/
+/*                            VSIIOStatsHandle                          */
+/************************************************************************/
+
+class VSIIOStatsHandle final : public VSIVirtualHandle
+{
+    VSIVirtualHandle *m_poBaseHandle = nullptr;
+    const std::string m_osFileSystem;
+    const std::string m_osFilename;
+    vsi_l_offset m_nLastReadEnd = 0;
+
+    VSIIOStatsHandle(const VSIIOStatsHandle &) = delete;
+    VSIIOStatsHandle &operator=(const VSIIOStatsHandle &) = delete;
+
+    static double GetElapsed(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             start)
+            .count();
+    }
+
+  public:
+    VSIIOStatsHandle(VSIVirtualHandle *poBaseHandle, const char *pszFilename)
+        : m_poBaseHandle(poBaseHandle),
+          m_osFileSystem(GetFileSystemName(pszFilename)),
+          m_osFilename(pszFilename)
+    {
+        IOStatisticsLogger::Update(m_osFileSystem, m_osFilename,
+                                   [](IOStatsCounters &counters)
+                                   { counters.nOpen++; });
+    }
+
+    ~VSIIOStatsHandle() override
+    {
+        delete m_poBaseHandle;
+    }
+
+    VSIVirtualHandle *GetBaseHandle()
+    {
+        return m_poBaseHandle;
+    }
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override
+    {
+        return m_poBaseHandle->Seek(nOffset, nWhence);
+    }
+
+    vsi_l_offset Tell() override
+    {
+        return m_poBaseHandle->Tell();
+    }
+
+    size_t Read(void *pBuffer, size_t nSize, size_t nCount) override
+    {
+        const vsi_l_offset nOffset = m_poBaseHandle->Tell();
+        const auto start = std::chrono::steady_clock::now();
+        const size_t nRet = m_poBaseHandle->Read(pBuffer, nSize, nCount);
+        const double dfElapsed = GetElapsed(start);
+        const vsi_l_offset nPrevEnd = m_nLastReadEnd;
+        m_nLastReadEnd = nOffset + nRet * nSize;
+        IOStatisticsLogger::Update(
+            m_osFileSystem, m_osFilename,
+            [nOffset, nPrevEnd, nRet, nSize,
+             dfElapsed](IOStatsCounters &counters)
+            {
+                counters.AddRead(nRet * nSize, dfElapsed);
+                counters.AddSeekDistance(nPrevEnd, nOffset);
+            });
+        return nRet;
+    }
+
+    int ReadMultiRange(int nRanges, void **ppData,
+                       const vsi_l_offset *panOffsets,
+                       const size_t *panSizes) override
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const int nRet = m_poBaseHandle->ReadMultiRange(nRanges, ppData,
+                                                        panOffsets, panSizes);
+        const double dfElapsed = GetElapsed(start);
+        const vsi_l_offset nPrevEnd = m_nLastReadEnd;
+        if (nRet == 0 && nRanges > 0)
+            m_nLastReadEnd = panOffsets[nRanges - 1] + panSizes[nRanges - 1];
+        IOStatisticsLogger::Update(
+            m_osFileSystem, m_osFilename,
+            [nRet, nRanges, panOffsets, panSizes, nPrevEnd,
+             dfElapsed](IOStatsCounters &counters)
+            {
+                counters.nReadMultiRange++;
+                if (nRet != 0)
+                    return;
+                // The latency of the whole request is shared between ranges
+                vsi_l_offset nEnd = nPrevEnd;
+                for (int i = 0; i < nRanges; ++i)
+                {
+                    counters.AddRead(panSizes[i], dfElapsed / nRanges);
+                    counters.AddSeekDistance(nEnd, panOffsets[i]);
+                    nEnd = panOffsets[i] + panSizes[i];
+                }
+            });
+        return nRet;
+    }
+
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override
+    {
+        m_poBaseHandle->AdviseRead(nRanges, panOffsets, panSizes);
+    }
+
+    size_t Write(const void *pBuffer, size_t nSize, size_t nCount) override
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const size_t nRet = m_poBaseHandle->Write(pBuffer, nSize, nCount);
+        const double dfElapsed = GetElapsed(start);
+        IOStatisticsLogger::Update(
+            m_osFileSystem, m_osFilename,
+            [nRet, nSize, dfElapsed](IOStatsCounters &counters)
+            { counters.AddWrite(nRet * nSize, dfElapsed); });
+        return nRet;
+    }
+
+    int Eof() override
+    {
+        return m_poBaseHandle->Eof();
+    }
+
+    int Flush() override
+    {
+        return m_poBaseHandle->Flush();
+    }
+
+    int Close() override
+    {
+        return m_poBaseHandle->Close();
+    }
+
+    int Truncate(vsi_l_offset nNewSize) override
+    {
+        return m_poBaseHandle->Truncate(nNewSize);
+    }
+
+    void *GetNativeFileDescriptor() override
+    {
+        return m_poBaseHandle->GetNativeFileDescriptor();
+    }
+
+    VSIRangeStatus GetRangeStatus(vsi_l_offset nOffset,
+                                  vsi_l_offset nLength) override
+    {
+        return m_poBaseHandle->GetRangeStatus(nOffset, nLength);
+    }
+
+    bool HasPRead() const override
+    {
+        return m_poBaseHandle->HasPRead();
+    }
+
+    // Positional reads, possibly concurrent, do not update the end of the
+    // previous read, and are not taken into account in the seek distance
+    // histogram.
+    size_t PRead(void *pBuffer, size_t nSize,
+                 vsi_l_offset nOffset) const override
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const size_t nRet = m_poBaseHandle->PRead(pBuffer, nSize, nOffset);
+        const double dfElapsed = GetElapsed(start);
+        IOStatisticsLogger::Update(m_osFileSystem, m_osFilename,
+                                   [nRet, dfElapsed](IOStatsCounters &counters)
+                                   { counters.AddRead(nRet, dfElapsed); });
+        return nRet;
+    }
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                        VSICreateIOStatsHandle()                      */
+/************************************************************************/
+
+// Wraps poBaseHandle (taking ownership of it) into a handle collecting
+// I/O statistics, if CPL_VSIL_IO_STATS_ENABLED or CPL_VSIL_SHOW_IO_STATS are
+// set. Otherwise returns poBaseHandle.
+VSIVirtualHandle *VSICreateIOStatsHandle(VSIVirtualHandle *poBaseHandle,
+                                         const char *pszFilename)
+{
+    if (poBaseHandle == nullptr || !IOStatisticsLogger::IsEnabled())
+        return poBaseHandle;
+    return new VSIIOStatsHandle(poBaseHandle, pszFilename);
+}
+
+/************************************************************************/
+/*                      VSIIOStatsGetBaseHandle()                       */
+/************************************************************************/
+
+// Returns the handle wrapped by VSICreateIOStatsHandle(), or poHandle if it
+// is not such a handle.
+VSIVirtualHandle *VSIIOStatsGetBaseHandle(VSIVirtualHandle *poHandle)
+{
+    auto poStatsHandle = dynamic_cast<VSIIOStatsHandle *>(poHandle);
+    return poStatsHandle ? poStatsHandle->GetBaseHandle() : poHandle;
+}
+
+/************************************************************************/
+/*                         VSIIOStatsRecordStat()                       */
+/************************************************************************/
+
+void VSIIOStatsRecordStat(const char *pszFilename)
+{
+    if (!IOStatisticsLogger::IsEnabled())
+        return;
+    IOStatisticsLogger::Update(GetFileSystemName(pszFilename), pszFilename,
+                               [](IOStatsCounters &counters)
+                               { counters.nStat++; });
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                           VSIIOStatsReset()                          */
+/************************************************************************/
+
+/**
+ * \brief Clear I/O statistics.
+ *
+ * This also releases the per-file statistics, so that long running processes
+ * collecting statistics on many files may call it periodically to bound the
+ * memory used.
+ *
+ * The effect of the CPL_VSIL_IO_STATS_ENABLED and CPL_VSIL_IO_STATS_MAX_FILES
+ * configuration options will also be reset. That is, that the next file
+ * opening will check their value again. Files opened before the call will
+ * keep on collecting statistics if they were previously enabled.
+ *
+ * @since GDAL 3.8
+ */
+
+void VSIIOStatsReset(void)
+{
+    IOStatisticsLogger::Reset();
+}
+
+/************************************************************************/
+/*                    VSIIOStatsGetAsSerializedJSON()                   */
+/************************************************************************/
+
+/**
+ * \brief Return I/O statistics, as a JSON serialized object.
+ *
+ * Contrary to VSINetworkStatsGetAsSerializedJSON(), which reports network
+ * requests, this reports the operations issued on file handles of any
+ * virtual file system (including local files), as seen by their callers.
+ * That is, for a file opened through a chain of file systems (for example
+ * /vsizip/ on top of /vsis3/), statistics are collected for each level
+ * opened with VSIFOpenL(), under their respective file system name.
+ *
+ * Statistics collecting should be enabled with the CPL_VSIL_IO_STATS_ENABLED
+ * configuration option set to YES before files are opened
+ * (for efficiency, reading it is cached on first access, until
+ * VSIIOStatsReset() is called)
+ *
+ * Statistics can also be emitted on standard output at process termination if
+ * the CPL_VSIL_SHOW_IO_STATS configuration option is set to YES.
+ *
+ * Per-file statistics are only kept for the first files accessed on each
+ * file system, up to the number set with the CPL_VSIL_IO_STATS_MAX_FILES
+ * configuration option (1000 by default). Operations on other files are
+ * aggregated in a "other_files" object of the file system, which also
+ * contains the same counters.
+ *
+ * The seek distance histogram classifies reads according to the distance
+ * between their start and the end of the previous read on the same file
+ * handle. Buckets of histograms with no value are omitted.
+ *
+ * Example of output:
+ * <pre>
+ * {
+ *   "filesystems":{
+ *     "local":{
+ *       "open_count":1,
+ *       "stat_count":1,
+ *       "read_count":3,
+ *       "read_bytes":66048,
+ *       "read_time_s":0.000021,
+ *       "read_size_histogram":{
+ *         "<=512":2,
+ *         "<=64K":1
+ *       },
+ *       "seek_distance_histogram":{
+ *         "sequential":2,
+ *         "forward >1M":1
+ *       },
+ *       "read_latency_histogram":{
+ *         "<10us":3
+ *       },
+ *       "files":{
+ *         "\/home\/even\/byte.tif":{
+ *           [... same counters as above, for that file ...]
+ *         }
+ *       }
+ *     },
+ *     "vsimem":{
+ *       [...]
+ *     }
+ *   }
+ * }
+ * </pre>
+ *
+ * @param papszOptions Unused.
+ * @return a JSON serialized string to free with VSIFree(), or nullptr
+ * @since GDAL 3.8
+ */
+
+char *VSIIOStatsGetAsSerializedJSON(CPL_UNUSED char **papszOptions)
+{
+    return CPLStrdup(IOStatisticsLogger::GetReportAsSerializedJSON().c_str());
+}
@@ -28,6 +28,7 @@
 
 #include "cpl_atomic_ops.h"
 #include "cpl_port.h"
+#include "cpl_error_internal.h"
 #include "cpl_http.h"
 #include "cpl_md5.h"
 #include "cpl_minixml.h"
@@ -35,6 +36,7 @@
 #include "cpl_time.h"
 #include "cpl_vsil_curl_priv.h"
 #include "cpl_vsil_curl_class.h"
+#include "cpl_worker_thread_pool.h"
 
 #include <errno.h>
 
@@ -61,8 +63,6 @@ void VSIInstallS3FileHandler(void)
 
 #define ENABLE_DEBUG 0
 
-constexpr int knMAX_PART_NUMBER = 10000;  // Limitation from S3
-
 #define unchecked_curl_easy_setopt(handle, opt, param)                         \
     CPL_IGNORE_RET_VAL(curl_easy_setopt(handle, opt, param))
 
@@ -763,25 +763,15 @@ VSIS3WriteHandle::VSIS3WriteHandle(IVSIS3LikeFSHandler *poFS,
 
     if (!m_bUseChunked)
     {
-        const int nChunkSizeMB = atoi(VSIGetPathSpecificOption(
-            pszFilename,
-            (std::string("VSI") + poFS->GetDebugKey() + "_CHUNK_SIZE").c_str(),
-            "50"));
-        if (nChunkSizeMB <= 0 || nChunkSizeMB > 1000)
-            m_nBufferSize = 0;
-        else
-            m_nBufferSize = nChunkSizeMB * 1024 * 1024;
-
-        // For testing only !
-        const char *pszChunkSizeBytes = VSIGetPathSpecificOption(
-            pszFilename,
-            (std::string("VSI") + poFS->GetDebugKey() + "_CHUNK_SIZE_BYTES")
-                .c_str(),
-            nullptr);
-        if (pszChunkSizeBytes)
-            m_nBufferSize = atoi(pszChunkSizeBytes);
-        if (m_nBufferSize <= 0 || m_nBufferSize > 1000 * 1024 * 1024)
-            m_nBufferSize = 50 * 1024 * 1024;
+        m_nBufferSize = poFS->GetUploadChunkSizeInBytes(pszFilename);
+
+        // Number of parts that may be uploaded in the background while
+        // the caller goes on filling the next one. 0 means that parts are
+        // uploaded synchronously from Write().
+        m_nUploadThreads = std::max(
+            0, std::min(64, atoi(VSIGetPathSpecificOption(
+                                pszFilename, "CPL_VSIL_CURL_UPLOAD_NUM_THREADS",
+                                "0"))));
 
         m_pabyBuffer = static_cast<GByte *>(VSIMalloc(m_nBufferSize));
         if (m_pabyBuffer == nullptr)
@@ -800,8 +790,11 @@ VSIS3WriteHandle::VSIS3WriteHandle(IVSIS3LikeFSHandler *poFS,
 VSIS3WriteHandle::~VSIS3WriteHandle()
 {
     VSIS3WriteHandle::Close();
+    m_poUploadPool.reset();
     delete m_poS3HandleHelper;
     CPLFree(m_pabyBuffer);
+    for (GByte *pabyBuffer : m_apabyFreeBuffers)
+        CPLFree(pabyBuffer);
     if (m_hCurlMulti)
     {
         if (m_hCurl)
@@ -971,7 +964,7 @@ CPLString IVSIS3LikeFSHandler::InitiateMultipartUpload(
 bool VSIS3WriteHandle::UploadPart()
 {
     ++m_nPartNumber;
-    if (m_nPartNumber > knMAX_PART_NUMBER)
+    if (m_nPartNumber > m_poFS->GetMaximumPartCount())
     {
         m_bError = true;
         CPLError(
@@ -979,9 +972,11 @@ bool VSIS3WriteHandle::UploadPart()
             "%d parts have been uploaded for %s failed. "
             "This is the maximum. "
             "Increase VSIS3_CHUNK_SIZE to a higher value (e.g. 500 for 500 MB)",
-            knMAX_PART_NUMBER, m_osFilename.c_str());
+            m_poFS->GetMaximumPartCount(), m_osFilename.c_str());
         return false;
     }
+    if (m_nUploadThreads > 0)
+        return SubmitUploadPart();
     const CPLString osEtag = m_poFS->UploadPart(
         m_osFilename, m_nPartNumber, m_osUploadID,
         static_cast<vsi_l_offset>(m_nBufferSize) * (m_nPartNumber - 1),
@@ -995,6 +990,209 @@ bool VSIS3WriteHandle::UploadPart()
     return !osEtag.empty();
 }
 
+/************************************************************************/
+/*                           UploadPartJob                              */
+/************************************************************************/
+
+struct VSIS3WriteHandle::UploadPartJob
+{
+    VSIS3WriteHandle *poHandle = nullptr;
+    int nPartNumber = 0;
+    GByte *pabyBuffer = nullptr;
+    size_t nBufferSize = 0;
+    std::unique_ptr<IVSIS3LikeHandleHelper> poS3HandleHelper{};
+};
+
+/************************************************************************/
+/*                         SubmitUploadPart()                           */
+/************************************************************************/
+
+// Hand the current buffer to a worker thread, and switch to another buffer
+// so that the caller can go on writing while the part is uploaded.
+bool VSIS3WriteHandle::SubmitUploadPart()
+{
+    if (!m_poUploadPool)
+    {
+        m_poUploadPool = cpl::make_unique<CPLWorkerThreadPool>();
+        if (!m_poUploadPool->Setup(m_nUploadThreads, nullptr, nullptr))
+        {
+            m_poUploadPool.reset();
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot create threads to upload %s",
+                     m_osFilename.c_str());
+            return false;
+        }
+    }
+
+    // Bound the number of parts in flight, and thus the memory used.
+    m_poUploadPool->WaitCompletion(m_nUploadThreads - 1);
+    if (HasBackgroundUploadError())
+        return false;
+
+    auto poJob = cpl::make_unique<UploadPartJob>();
+    poJob->poHandle = this;
+    poJob->nPartNumber = m_nPartNumber;
+    poJob->nBufferSize = m_nBufferOff;
+    // The handle helper accumulates query parameters, so each part needs
+    // its own one.
+    poJob->poS3HandleHelper.reset(m_poFS->CreateHandleHelper(
+        m_osFilename.c_str() + m_poFS->GetFSPrefix().size(), false));
+    if (!poJob->poS3HandleHelper)
+        return false;
+    m_poFS->UpdateHandleFromMap(poJob->poS3HandleHelper.get());
+
+    GByte *pabyNewBuffer = nullptr;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutexUpload);
+        if (!m_apabyFreeBuffers.empty())
+        {
+            pabyNewBuffer = m_apabyFreeBuffers.back();
+            m_apabyFreeBuffers.pop_back();
+        }
+    }
+    if (pabyNewBuffer == nullptr)
+    {
+        pabyNewBuffer = static_cast<GByte *>(VSIMalloc(m_nBufferSize));
+        if (pabyNewBuffer == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate working buffer for %s",
+                     m_osFilename.c_str());
+            return false;
+        }
+    }
+    poJob->pabyBuffer = m_pabyBuffer;
+    m_pabyBuffer = pabyNewBuffer;
+    m_nBufferOff = 0;
+
+    if (!m_poUploadPool->SubmitJob(UploadPartJobFunc, poJob.get()))
+    {
+        CPLFree(poJob->pabyBuffer);
+        return false;
+    }
+    poJob.release();
+    return true;
+}
+
+/************************************************************************/
+/*                         UploadPartJobFunc()                          */
+/************************************************************************/
+
+void VSIS3WriteHandle::UploadPartJobFunc(void *pData)
+{
+    std::unique_ptr<UploadPartJob> poJob(static_cast<UploadPartJob *>(pData));
+    VSIS3WriteHandle *poThis = poJob->poHandle;
+
+    // Errors emitted in this thread would not be seen by the caller of
+    // Write() or Close(), so collect them to re-emit them later.
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+    CPLInstallErrorHandlerAccumulator(aoErrors);
+    CPLSetCurrentErrorHandlerCatchDebug(FALSE);
+    const CPLString osEtag = poThis->m_poFS->UploadPart(
+        poThis->m_osFilename, poJob->nPartNumber, poThis->m_osUploadID,
+        static_cast<vsi_l_offset>(poThis->m_nBufferSize) *
+            (poJob->nPartNumber - 1),
+        poJob->pabyBuffer, poJob->nBufferSize, poJob->poS3HandleHelper.get(),
+        poThis->m_nMaxRetry, poThis->m_dfRetryDelay, nullptr);
+    CPLUninstallErrorHandlerAccumulator();
+    // Warnings, such as retry notices, are emitted as before.
+    for (const auto &oError : aoErrors)
+    {
+        if (oError.type < CE_Failure)
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    }
+
+    std::lock_guard<std::mutex> oLock(poThis->m_oMutexUpload);
+    if (osEtag.empty())
+    {
+        if (!poThis->m_bBackgroundUploadError)
+        {
+            for (const auto &oError : aoErrors)
+            {
+                if (oError.type >= CE_Failure)
+                {
+                    poThis->m_nBackgroundUploadErrorNo = oError.no;
+                    poThis->m_osBackgroundUploadErrorMsg = oError.msg;
+                }
+            }
+        }
+        poThis->m_bBackgroundUploadError = true;
+    }
+    else
+    {
+        if (poThis->m_aosEtags.size() <
+            static_cast<size_t>(poJob->nPartNumber))
+        {
+            poThis->m_aosEtags.resize(poJob->nPartNumber);
+        }
+        poThis->m_aosEtags[poJob->nPartNumber - 1] = osEtag;
+    }
+    poThis->m_apabyFreeBuffers.push_back(poJob->pabyBuffer);
+}
+
+/************************************************************************/
+/*                      HasBackgroundUploadError()                      */
+/************************************************************************/
+
+bool VSIS3WriteHandle::HasBackgroundUploadError()
+{
+    std::lock_guard<std::mutex> oLock(m_oMutexUpload);
+    if (m_bBackgroundUploadError && !m_bBackgroundUploadErrorReported)
+    {
+        m_bBackgroundUploadErrorReported = true;
+        if (!m_osBackgroundUploadErrorMsg.empty())
+        {
+            CPLError(CE_Failure, m_nBackgroundUploadErrorNo, "%s",
+                     m_osBackgroundUploadErrorMsg.c_str());
+        }
+        else
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Upload of a part of %s failed", m_osFilename.c_str());
+        }
+    }
+    return m_bBackgroundUploadError;
+}
+
+/************************************************************************/
+/*                       WaitForPendingUploads()                        */
+/************************************************************************/
+
+bool VSIS3WriteHandle::WaitForPendingUploads()
+{
+    if (!m_poUploadPool)
+        return true;
+    m_poUploadPool->WaitCompletion();
+    return !HasBackgroundUploadError();
+}
+
+/************************************************************************/
+/*                      GetUploadChunkSizeInBytes()                     */
+/************************************************************************/
+
+int IVSIS3LikeFSHandler::GetUploadChunkSizeInBytes(const char *pszFilename)
+{
+    int nBufferSize;
+    const int nChunkSizeMB = atoi(VSIGetPathSpecificOption(
+        pszFilename,
+        (std::string("VSI") + GetDebugKey() + "_CHUNK_SIZE").c_str(), "50"));
+    if (nChunkSizeMB <= 0 || nChunkSizeMB > 1000)
+        nBufferSize = 0;
+    else
+        nBufferSize = nChunkSizeMB * 1024 * 1024;
+
+    // For testing only !
+    const char *pszChunkSizeBytes = VSIGetPathSpecificOption(
+        pszFilename,
+        (std::string("VSI") + GetDebugKey() + "_CHUNK_SIZE_BYTES").c_str(),
+        nullptr);
+    if (pszChunkSizeBytes)
+        nBufferSize = atoi(pszChunkSizeBytes);
+    if (nBufferSize <= 0 || nBufferSize > 1000 * 1024 * 1024)
+        nBufferSize = 50 * 1024 * 1024;
+    return nBufferSize;
+}
+
 CPLString IVSIS3LikeFSHandler::UploadPart(
     const CPLString &osFilename, int nPartNumber, const std::string &osUploadID,
     vsi_l_offset /* nPosition */, const void *pabyBuffer, size_t nBufferSize,
@@ -1413,6 +1611,11 @@ size_t VSIS3WriteHandle::Write(const void *pBuffer, size_t nSize, size_t nMemb)
 {
     if (m_bError)
         return 0;
+    if (m_poUploadPool && HasBackgroundUploadError())
+    {
+        m_bError = true;
+        return 0;
+    }
 
     size_t nBytesToWrite = nSize * nMemb;
     if (nBytesToWrite == 0)
@@ -2032,13 +2235,24 @@ int VSIS3WriteHandle::Close()
         {
             if (m_bError)
             {
+                WaitForPendingUploads();
                 if (!m_poFS->AbortMultipart(m_osFilename, m_osUploadID,
                                             m_poS3HandleHelper, m_nMaxRetry,
                                             m_dfRetryDelay))
                     nRet = -1;
             }
             else if (m_nBufferOff > 0 && !UploadPart())
+            {
+                WaitForPendingUploads();
+                nRet = -1;
+            }
+            else if (!WaitForPendingUploads())
+            {
+                m_poFS->AbortMultipart(m_osFilename, m_osUploadID,
+                                       m_poS3HandleHelper, m_nMaxRetry,
+                                       m_dfRetryDelay);
                 nRet = -1;
+            }
             else if (m_poFS->CompleteMultipart(
                          m_osFilename, m_osUploadID, m_aosEtags, m_nCurOffset,
                          m_poS3HandleHelper, m_nMaxRetry, m_dfRetryDelay))
@@ -3017,6 +3231,14 @@ int IVSIS3LikeFSHandler::Stat(const char *pszFilename, VSIStatBufL *pStatBuf,
     // to, use it to detect if the object does not exist
     CachedDirList cachedDirList;
     const CPLString osDirname(CPLGetDirname(osFilenameWithoutSlash));
+    if (STARTS_WITH_CI(osDirname, GetFSPrefix()) &&
+        !GetCachedDirList(osDirname, cachedDirList) &&
+        UseDirListingForStat(osFilename))
+    {
+        // List the directory once, so that this and the next probes of
+        // files in the same directory are answered from the listing.
+        CSLDestroy(ReadDirInternal(osDirname, 0, nullptr));
+    }
     if (STARTS_WITH_CI(osDirname, GetFSPrefix()) &&
         GetCachedDirList(osDirname, cachedDirList) &&
         cachedDirList.bGotFileList)
@@ -4109,7 +4331,7 @@ bool IVSIS3LikeFSHandler::Sync(const char *pszSource, const char *pszTarget,
                         ? 1
                         : (entry->nSize + nMaxChunkSize - 1) / nMaxChunkSize;
                 if (nChunksLarge >
-                    1000)  // must also be below knMAX_PART_NUMBER for upload
+                    1000)  // must also be below GetMaximumPartCount()
                 {
                     CPLError(CE_Failure, CPLE_AppDefined,
                              "Too small CHUNK_SIZE w.r.t file size");
@@ -4366,7 +4588,7 @@ bool IVSIS3LikeFSHandler::Sync(const char *pszSource, const char *pszTarget,
                 ? 1
                 : (sSource.st_size + nMaxChunkSize - 1) / nMaxChunkSize;
         if (nChunksLarge >
-            1000)  // must also be below knMAX_PART_NUMBER for upload
+            1000)  // must also be below GetMaximumPartCount()
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "Too small CHUNK_SIZE w.r.t file size");
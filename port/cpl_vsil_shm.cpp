@@ -0,0 +1,556 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Implement VSI large file api for POSIX shared memory objects
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "cpl_vsi.h"
+#include "cpl_vsi_virtual.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_string.h"
+
+#if defined(HAVE_SHM_OPEN) && defined(HAVE_MMAP)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <mutex>
+
+//! @cond Doxygen_Suppress
+
+constexpr const char *VSISHM_PREFIX = "/vsishm/";
+
+/************************************************************************/
+/* ==================================================================== */
+/*                            VSIShmHandle                              */
+/* ==================================================================== */
+/************************************************************************/
+
+// Handle on a POSIX shared memory object. In read-only mode, the object is
+// mapped lazily at the first read, and reads are served from the mapping,
+// which is shared with all the processes that map the same object.
+// In update mode, pread()/pwrite() are used, since the size may change.
+class VSIShmHandle final : public VSIVirtualHandle
+{
+    int m_fd = -1;
+    bool m_bUpdate = false;
+    bool m_bEOF = false;
+    vsi_l_offset m_nOffset = 0;
+
+    // Read-only mode only
+    vsi_l_offset m_nSize = 0;
+    std::once_flag m_oMapFlag{};
+    GByte *m_pabyMap = nullptr;
+
+    CPL_DISALLOW_COPY_ASSIGN(VSIShmHandle)
+
+    const GByte *GetMapping();
+    vsi_l_offset GetSize();
+
+  public:
+    VSIShmHandle(int fd, bool bUpdate, vsi_l_offset nSize)
+        : m_fd(fd), m_bUpdate(bUpdate), m_nSize(nSize)
+    {
+    }
+    ~VSIShmHandle() override;
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override;
+    vsi_l_offset Tell() override;
+    size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+    size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
+    int Eof() override;
+    int Close() override;
+    int Truncate(vsi_l_offset nNewSize) override;
+
+    void *GetNativeFileDescriptor() override
+    {
+        return reinterpret_cast<void *>(static_cast<uintptr_t>(m_fd));
+    }
+
+    VSIRangeStatus GetRangeStatus(vsi_l_offset /* nOffset */,
+                                  vsi_l_offset /* nLength */) override
+    {
+        return VSI_RANGE_STATUS_DATA;
+    }
+
+    bool HasPRead() const override
+    {
+        return true;
+    }
+    size_t PRead(void *pBuffer, size_t nSize,
+                 vsi_l_offset nOffset) const override;
+};
+
+/************************************************************************/
+/*                           ~VSIShmHandle()                            */
+/************************************************************************/
+
+VSIShmHandle::~VSIShmHandle()
+{
+    VSIShmHandle::Close();
+}
+
+/************************************************************************/
+/*                              Close()                                 */
+/************************************************************************/
+
+int VSIShmHandle::Close()
+{
+    int nRet = 0;
+    if (m_pabyMap)
+    {
+        munmap(m_pabyMap, static_cast<size_t>(m_nSize));
+        m_pabyMap = nullptr;
+    }
+    if (m_fd >= 0)
+    {
+        nRet = close(m_fd);
+        m_fd = -1;
+    }
+    return nRet;
+}
+
+/************************************************************************/
+/*                             GetMapping()                             */
+/************************************************************************/
+
+const GByte *VSIShmHandle::GetMapping()
+{
+    std::call_once(
+        m_oMapFlag,
+        [this]()
+        {
+            if (m_nSize == 0 ||
+                m_nSize != static_cast<vsi_l_offset>(
+                               static_cast<size_t>(m_nSize)))
+                return;
+            void *pMap = mmap(nullptr, static_cast<size_t>(m_nSize),
+                              PROT_READ, MAP_SHARED, m_fd, 0);
+            if (pMap == MAP_FAILED)
+            {
+                CPLError(CE_Failure, CPLE_FileIO, "mmap() failed: %s",
+                         VSIStrerror(errno));
+                return;
+            }
+            m_pabyMap = static_cast<GByte *>(pMap);
+        });
+    return m_pabyMap;
+}
+
+/************************************************************************/
+/*                              GetSize()                               */
+/************************************************************************/
+
+vsi_l_offset VSIShmHandle::GetSize()
+{
+    if (!m_bUpdate)
+        return m_nSize;
+    struct stat sStat;
+    if (fstat(m_fd, &sStat) != 0)
+        return 0;
+    return static_cast<vsi_l_offset>(sStat.st_size);
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSIShmHandle::Seek(vsi_l_offset nOffset, int nWhence)
+{
+    m_bEOF = false;
+    if (nWhence == SEEK_SET)
+        m_nOffset = nOffset;
+    else if (nWhence == SEEK_CUR)
+        m_nOffset += nOffset;
+    else if (nWhence == SEEK_END)
+        m_nOffset = GetSize() + nOffset;
+    else
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                                Tell()                                */
+/************************************************************************/
+
+vsi_l_offset VSIShmHandle::Tell()
+{
+    return m_nOffset;
+}
+
+/************************************************************************/
+/*                                PRead()                               */
+/************************************************************************/
+
+size_t VSIShmHandle::PRead(void *pBuffer, size_t nSize,
+                           vsi_l_offset nOffset) const
+{
+    if (!m_bUpdate)
+    {
+        const GByte *pabyMap =
+            const_cast<VSIShmHandle *>(this)->GetMapping();
+        if (pabyMap == nullptr || nOffset >= m_nSize)
+            return 0;
+        const size_t nToRead = static_cast<size_t>(
+            std::min(static_cast<vsi_l_offset>(nSize), m_nSize - nOffset));
+        memcpy(pBuffer, pabyMap + static_cast<size_t>(nOffset), nToRead);
+        return nToRead;
+    }
+
+    size_t nRead = 0;
+    while (nRead < nSize)
+    {
+        const ssize_t nRet =
+            pread(m_fd, static_cast<GByte *>(pBuffer) + nRead, nSize - nRead,
+                  static_cast<off_t>(nOffset + nRead));
+        if (nRet < 0 && errno == EINTR)
+            continue;
+        if (nRet <= 0)
+            break;
+        nRead += static_cast<size_t>(nRet);
+    }
+    return nRead;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIShmHandle::Read(void *pBuffer, size_t nSize, size_t nCount)
+{
+    if (nSize == 0 || nCount == 0)
+        return 0;
+    const size_t nBytes = nSize * nCount;
+    const size_t nRead = PRead(pBuffer, nBytes, m_nOffset);
+    m_nOffset += nRead;
+    if (nRead < nBytes)
+        m_bEOF = true;
+    return nRead / nSize;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+size_t VSIShmHandle::Write(const void *pBuffer, size_t nSize, size_t nCount)
+{
+    if (!m_bUpdate)
+    {
+        errno = EACCES;
+        return 0;
+    }
+    if (nSize == 0 || nCount == 0)
+        return 0;
+    const size_t nBytes = nSize * nCount;
+    size_t nWritten = 0;
+    while (nWritten < nBytes)
+    {
+        const ssize_t nRet =
+            pwrite(m_fd, static_cast<const GByte *>(pBuffer) + nWritten,
+                   nBytes - nWritten, static_cast<off_t>(m_nOffset));
+        if (nRet < 0 && errno == EINTR)
+            continue;
+        if (nRet <= 0)
+            break;
+        nWritten += static_cast<size_t>(nRet);
+        m_nOffset += static_cast<size_t>(nRet);
+    }
+    return nWritten / nSize;
+}
+
+/************************************************************************/
+/*                                Eof()                                 */
+/************************************************************************/
+
+int VSIShmHandle::Eof()
+{
+    return m_bEOF;
+}
+
+/************************************************************************/
+/*                              Truncate()                              */
+/************************************************************************/
+
+int VSIShmHandle::Truncate(vsi_l_offset nNewSize)
+{
+    if (!m_bUpdate)
+    {
+        errno = EACCES;
+        return -1;
+    }
+    return ftruncate(m_fd, static_cast<off_t>(nNewSize));
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                       VSIShmFilesystemHandler                        */
+/* ==================================================================== */
+/************************************************************************/
+
+class VSIShmFilesystemHandler final : public VSIFilesystemHandler
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIShmFilesystemHandler)
+
+    static std::string GetShmName(const char *pszFilename);
+
+  public:
+    VSIShmFilesystemHandler() = default;
+
+    VSIVirtualHandle *Open(const char *pszFilename, const char *pszAccess,
+                           bool bSetError, CSLConstList papszOptions) override;
+    int Stat(const char *pszFilename, VSIStatBufL *pStatBuf,
+             int nFlags) override;
+    int Unlink(const char *pszFilename) override;
+    char **ReadDirEx(const char *pszDirname, int nMaxFiles) override;
+};
+
+/************************************************************************/
+/*                             GetShmName()                             */
+/************************************************************************/
+
+// Returns the name of the shared memory object, that is "/<name>" for
+// "/vsishm/<name>", or an empty string if it is not a valid name.
+std::string VSIShmFilesystemHandler::GetShmName(const char *pszFilename)
+{
+    if (!STARTS_WITH(pszFilename, VSISHM_PREFIX))
+        return std::string();
+    const char *pszName = pszFilename + strlen(VSISHM_PREFIX);
+    if (pszName[0] == '\0' || strchr(pszName, '/') != nullptr)
+    {
+        errno = EINVAL;
+        return std::string();
+    }
+    return std::string("/").append(pszName);
+}
+
+/************************************************************************/
+/*                                Open()                                */
+/************************************************************************/
+
+VSIVirtualHandle *VSIShmFilesystemHandler::Open(const char *pszFilename,
+                                                const char *pszAccess,
+                                                bool bSetError,
+                                                CSLConstList /* papszOptions */)
+{
+    const std::string osName(GetShmName(pszFilename));
+    if (osName.empty())
+    {
+        if (bSetError)
+        {
+            VSIError(VSIE_FileError,
+                     "%s: invalid name. Must be %s<name>, without '/' "
+                     "in <name>",
+                     pszFilename, VSISHM_PREFIX);
+        }
+        return nullptr;
+    }
+
+    // "w" does not use O_TRUNC: truncating an object that other processes
+    // have mapped would make them crash with SIGBUS when accessing the
+    // pages beyond the new size. Opening an existing non-empty object with
+    // "w" is refused below instead.
+    int nFlags = O_RDONLY;
+    const bool bTruncate = strchr(pszAccess, 'w') != nullptr;
+    if (bTruncate)
+        nFlags = O_RDWR | O_CREAT;
+    else if (strchr(pszAccess, 'a'))
+        nFlags = O_RDWR | O_CREAT;
+    else if (strchr(pszAccess, '+'))
+        nFlags = O_RDWR;
+    const bool bUpdate = nFlags != O_RDONLY;
+
+    // Objects are only accessible to their owner by default. Sharing them
+    // with worker processes running under another account requires an
+    // explicit CPL_VSISHM_MODE, such as 0644.
+    const char *pszMode = CPLGetConfigOption("CPL_VSISHM_MODE", "0600");
+    char *pszEnd = nullptr;
+    const long nMode = strtol(pszMode, &pszEnd, 8);
+    if (pszEnd == pszMode || *pszEnd != '\0' || nMode < 0 || nMode > 0777)
+    {
+        if (bSetError)
+        {
+            VSIError(VSIE_FileError,
+                     "%s: invalid value for CPL_VSISHM_MODE: %s. "
+                     "Must be an octal permission mode, such as 0600",
+                     pszFilename, pszMode);
+        }
+        return nullptr;
+    }
+    const int fd =
+        shm_open(osName.c_str(), nFlags, static_cast<mode_t>(nMode));
+    if (fd < 0)
+    {
+        if (bSetError)
+        {
+            VSIError(VSIE_FileError, "%s: %s", pszFilename, strerror(errno));
+        }
+        return nullptr;
+    }
+
+    struct stat sStat;
+    if (fstat(fd, &sStat) != 0)
+    {
+        if (bSetError)
+        {
+            VSIError(VSIE_FileError, "%s: %s", pszFilename, strerror(errno));
+        }
+        close(fd);
+        return nullptr;
+    }
+    if (bTruncate && sStat.st_size != 0)
+    {
+        if (bSetError)
+        {
+            VSIError(VSIE_FileError,
+                     "%s: already exists and is not empty. Truncating it "
+                     "would crash processes that have it mapped. "
+                     "Unlink it first",
+                     pszFilename);
+        }
+        close(fd);
+        return nullptr;
+    }
+
+    auto poHandle = new VSIShmHandle(
+        fd, bUpdate, bUpdate ? 0 : static_cast<vsi_l_offset>(sStat.st_size));
+    if (strchr(pszAccess, 'a'))
+        poHandle->Seek(0, SEEK_END);
+    return poHandle;
+}
+
+/************************************************************************/
+/*                                Stat()                                */
+/************************************************************************/
+
+int VSIShmFilesystemHandler::Stat(const char *pszFilename,
+                                  VSIStatBufL *pStatBuf, int /* nFlags */)
+{
+    memset(pStatBuf, 0, sizeof(VSIStatBufL));
+
+    const std::string osName(GetShmName(pszFilename));
+    if (osName.empty())
+        return -1;
+
+    const int fd = shm_open(osName.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        return -1;
+    struct stat sStat;
+    const int nRet = fstat(fd, &sStat);
+    close(fd);
+    if (nRet != 0)
+        return -1;
+
+    pStatBuf->st_mode = sStat.st_mode;
+    pStatBuf->st_size = sStat.st_size;
+    pStatBuf->st_mtime = sStat.st_mtime;
+    return 0;
+}
+
+/************************************************************************/
+/*                               Unlink()                               */
+/************************************************************************/
+
+int VSIShmFilesystemHandler::Unlink(const char *pszFilename)
+{
+    const std::string osName(GetShmName(pszFilename));
+    if (osName.empty())
+        return -1;
+    return shm_unlink(osName.c_str());
+}
+
+/************************************************************************/
+/*                             ReadDirEx()                              */
+/************************************************************************/
+
+char **VSIShmFilesystemHandler::ReadDirEx(const char *pszDirname,
+                                          int nMaxFiles)
+{
+#ifdef __linux__
+    // On Linux, shared memory objects are files of the /dev/shm tmpfs
+    if (strcmp(pszDirname, VSISHM_PREFIX) == 0 ||
+        strcmp(pszDirname, "/vsishm") == 0)
+    {
+        return VSIReadDirEx("/dev/shm", nMaxFiles);
+    }
+#else
+    (void)pszDirname;
+    (void)nMaxFiles;
+#endif
+    return nullptr;
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                       VSIInstallShmFileHandler()                     */
+/************************************************************************/
+
+/*!
+ \brief Install /vsishm/ file system handler
+
+ A special file handler is installed that allows POSIX shared memory
+ objects to be treated as files, so that they can be shared among processes
+ of the same host.
+
+ \verbatim embed:rst
+ See :ref:`/vsishm/ documentation <vsishm>`
+ \endverbatim
+
+ @since GDAL 3.8
+ */
+void VSIInstallShmFileHandler()
+{
+    VSIFileManager::InstallHandler(VSISHM_PREFIX, new VSIShmFilesystemHandler);
+}
+
+#else
+
+/************************************************************************/
+/*                       VSIInstallShmFileHandler()                     */
+/************************************************************************/
+
+/*!
+ \brief Install /vsishm/ file system handler (non-functional stub)
+
+ @since GDAL 3.8
+ */
+void VSIInstallShmFileHandler(void)
+{
+    // Not supported.
+}
+
+#endif
@@ -535,6 +535,13 @@ class VSITarFilesystemHandler final : public VSIArchiveFilesystemHandler
     std::vector<CPLString> GetExtensions() override;
     VSIArchiveReader *CreateReader(const char *pszTarFileName) override;
 
+  protected:
+    bool GetFileOffsetAsIntegers(const VSIArchiveEntryFileOffset *pOffset,
+                                 GUIntBig &nVal1, GUIntBig &nVal2) override;
+    VSIArchiveEntryFileOffset *
+    CreateFileOffsetFromIntegers(GUIntBig nVal1, GUIntBig nVal2) override;
+
+  public:
     VSIVirtualHandle *Open(const char *pszFilename, const char *pszAccess,
                            bool bSetError,
                            CSLConstList /* papszOptions */) override;
@@ -587,6 +594,37 @@ VSITarFilesystemHandler::CreateReader(const char *pszTarFileName)
     return poReader;
 }
 
+/************************************************************************/
+/*                      GetFileOffsetAsIntegers()                       */
+/************************************************************************/
+
+bool VSITarFilesystemHandler::GetFileOffsetAsIntegers(
+    const VSIArchiveEntryFileOffset *pOffset, GUIntBig &nVal1,
+    GUIntBig &nVal2)
+{
+    const VSITarEntryFileOffset *pTarOffset =
+        cpl::down_cast<const VSITarEntryFileOffset *>(pOffset);
+#ifdef HAVE_FUZZER_FRIENDLY_ARCHIVE
+    // Entries of fuzzer friendly archives cannot be persisted
+    if (!pTarOffset->m_osFileName.empty())
+        return false;
+#endif
+    nVal1 = pTarOffset->m_nOffset;
+    nVal2 = 0;
+    return true;
+}
+
+/************************************************************************/
+/*                    CreateFileOffsetFromIntegers()                    */
+/************************************************************************/
+
+VSIArchiveEntryFileOffset *
+VSITarFilesystemHandler::CreateFileOffsetFromIntegers(GUIntBig nVal1,
+                                                      GUIntBig /* nVal2 */)
+{
+    return new VSITarEntryFileOffset(nVal1);
+}
+
 /************************************************************************/
 /*                                 Open()                               */
 /************************************************************************/
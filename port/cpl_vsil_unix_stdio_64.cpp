@@ -82,8 +82,11 @@
 #include <sys/uio.h>
 #endif
 
+#include <algorithm>
 #include <limits>
 #include <new>
+#include <utility>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -243,6 +246,13 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
     bool HasPRead() const override;
     size_t PRead(void * /*pBuffer*/, size_t /* nSize */,
                  vsi_l_offset /*nOffset*/) const override;
+    int ReadMultiRange(int nRanges, void **ppData,
+                       const vsi_l_offset *panOffsets,
+                       const size_t *panSizes) override;
+#endif
+#if defined(HAVE_POSIX_FADVISE64) || defined(HAVE_POSIX_FADVISE)
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override;
 #endif
 };
 
@@ -649,6 +659,84 @@ size_t VSIUnixStdioHandle::PRead(void *pBuffer, size_t nSize,
     return pread(fileno(fp), pBuffer, nSize, static_cast<off_t>(nOffset));
 #endif
 }
+
+/************************************************************************/
+/*                          ReadMultiRange()                            */
+/************************************************************************/
+
+int VSIUnixStdioHandle::ReadMultiRange(int nRanges, void **ppData,
+                                       const vsi_l_offset *panOffsets,
+                                       const size_t *panSizes)
+{
+    // pread() bypasses the buffer of the FILE*, which may hold data not
+    // yet written.
+    if (!bReadOnly)
+        return VSIVirtualHandle::ReadMultiRange(nRanges, ppData, panOffsets,
+                                                panSizes);
+
+#if defined(HAVE_POSIX_FADVISE64) || defined(HAVE_POSIX_FADVISE)
+    // Let the kernel queue the reads of all ranges at once, rather than
+    // waiting for each of them in turn below.
+    if (nRanges > 1)
+        AdviseRead(nRanges, panOffsets, panSizes);
+#endif
+
+    for (int i = 0; i < nRanges; ++i)
+    {
+        GByte *pabyData = static_cast<GByte *>(ppData[i]);
+        size_t nDone = 0;
+        while (nDone < panSizes[i])
+        {
+            const size_t nRead = PRead(pabyData + nDone, panSizes[i] - nDone,
+                                       panOffsets[i] + nDone);
+            // pread() returns -1 on error, hence the second test.
+            if (nRead == 0 || nRead > panSizes[i] - nDone)
+                return -1;
+            nDone += nRead;
+        }
+#ifdef VSI_COUNT_BYTES_READ
+        nTotalBytesRead += nDone;
+#endif
+    }
+    return 0;
+}
+#endif
+
+/************************************************************************/
+/*                            AdviseRead()                              */
+/************************************************************************/
+
+#if defined(HAVE_POSIX_FADVISE64) || defined(HAVE_POSIX_FADVISE)
+void VSIUnixStdioHandle::AdviseRead(int nRanges,
+                                    const vsi_l_offset *panOffsets,
+                                    const size_t *panSizes)
+{
+    // Sort and coalesce the ranges to limit the number of system calls.
+    std::vector<std::pair<vsi_l_offset, vsi_l_offset>> aoRanges;
+    for (int i = 0; i < nRanges; ++i)
+    {
+        if (panSizes[i] > 0)
+            aoRanges.emplace_back(panOffsets[i], panOffsets[i] + panSizes[i]);
+    }
+    std::sort(aoRanges.begin(), aoRanges.end());
+
+    const int fd = fileno(fp);
+    for (size_t i = 0; i < aoRanges.size();)
+    {
+        const vsi_l_offset nStart = aoRanges[i].first;
+        vsi_l_offset nEnd = aoRanges[i].second;
+        for (++i; i < aoRanges.size() && aoRanges[i].first <= nEnd; ++i)
+            nEnd = std::max(nEnd, aoRanges[i].second);
+
+        // Asynchronously starts reading the pages into the page cache.
+#ifdef HAVE_POSIX_FADVISE64
+        posix_fadvise64(fd, nStart, nEnd - nStart, POSIX_FADV_WILLNEED);
+#else
+        posix_fadvise(fd, static_cast<off_t>(nStart),
+                      static_cast<off_t>(nEnd - nStart), POSIX_FADV_WILLNEED);
+#endif
+    }
+}
 #endif
 
 /************************************************************************/
@@ -118,6 +118,23 @@ void CPLWorkerThreadPool::WorkerThreadFunction(void *user_data)
     }
 }
 
+/************************************************************************/
+/*                       IsCurrentThreadWorker()                        */
+/************************************************************************/
+
+/** Return whether the calling thread is a worker thread of a pool.
+ *
+ * This can be used by code that may be called from a job, to avoid
+ * splitting its own work into further jobs.
+ *
+ * @return true if the calling thread belongs to a CPLWorkerThreadPool.
+ * @since GDAL 3.8
+ */
+bool CPLWorkerThreadPool::IsCurrentThreadWorker()
+{
+    return threadLocalCurrentThreadPool != nullptr;
+}
+
 /************************************************************************/
 /*                             SubmitJob()                              */
 /************************************************************************/
@@ -116,6 +116,8 @@ class CPL_DLL CPLWorkerThreadPool
     {
         return m_nMaxThreads;
     }
+
+    static bool IsCurrentThreadWorker();
 };
 
 /** Job queue */
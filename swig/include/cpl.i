@@ -214,6 +214,8 @@ void CPL_STDCALL PyCPLErrorHandler(CPLErr eErrClass, int err_no, const char* psz
 %rename (HasThreadSupport) wrapper_HasThreadSupport;
 %rename (NetworkStatsReset) VSINetworkStatsReset;
 %rename (NetworkStatsGetAsSerializedJSON) VSINetworkStatsGetAsSerializedJSON;
+%rename (IOStatsReset) VSIIOStatsReset;
+%rename (IOStatsGetAsSerializedJSON) VSIIOStatsGetAsSerializedJSON;
 
 %apply Pointer NONNULL {const char *pszScope};
 retStringAndCPLFree*
@@ -895,6 +897,9 @@ void VSICurlPartialClearCache( const char* utf8_path );
 void VSINetworkStatsReset();
 retStringAndCPLFree* VSINetworkStatsGetAsSerializedJSON( char** options = NULL );
 
+void VSIIOStatsReset();
+retStringAndCPLFree* VSIIOStatsGetAsSerializedJSON( char** options = NULL );
+
 #endif /* !defined(SWIGJAVA) */
 
 %apply (char **CSL) {char **};